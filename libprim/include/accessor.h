@@ -0,0 +1,43 @@
+/**
+ * @file accessor.h
+ *
+ * Selects how the trivial field accessors of the ELF64 headers, such as
+ * `elf64_get_section_offset` or `elf64_get_segment_vaddr`, are declared.
+ *
+ * By default each accessor is an `extern` function defined in its format's
+ * source file, so without link time optimisation every use costs a call.
+ * Building with the `PRIM_INLINE_ACCESSORS` Cmake option, which defines
+ * `PRIM_ENABLE_INLINE_ACCESSORS`, declares them `static inline` instead, and
+ * defines them at the end of their headers, so a loop over headers compiles
+ * to plain loads.
+ *
+ * The source files defining accessors define `PRIM_ACCESSOR_DEFINITIONS`
+ * before any include, which keeps the inline definitions out of them. They
+ * are compiled in either configuration, so the library exports the same
+ * symbols for its consumers either way.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef ACCESSOR_H
+#define ACCESSOR_H
+
+#if defined(PRIM_ENABLE_INLINE_ACCESSORS)                                      \
+    && !defined(PRIM_ACCESSOR_DEFINITIONS)
+
+/** Accessors are defined inline, at the end of their headers. */
+#define PRIM_ACCESSORS_INLINE
+
+/** Storage class of an accessor declaration. */
+#define PRIM_ACCESSOR static inline
+
+#else
+
+/** Storage class of an accessor declaration. */
+#define PRIM_ACCESSOR extern
+
+#endif
+
+#endif
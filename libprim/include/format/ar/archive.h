@@ -0,0 +1,182 @@
+/**
+ * @file include/format/ar/archive.h
+ *
+ * `archive.h` reads `ar` archives, such as static libraries.
+ *
+ * Opening an archive maps it and walks its member headers once. Members are
+ * never copied: each is a view of the mapped archive, and can be opened as a
+ * lazily parsed ELF64 image without reading anything else.
+ *
+ * The archive's symbol index, `/` or `/SYM64/`, is hashed when the archive
+ * is opened, so finding the member which defines a symbol costs a single
+ * hash probe rather than a walk of every member's symbol table.
+ *
+ * GNU and System V archives are supported, including long member names held
+ * in the `//` member, as are BSD style `#1/<length>` member names. Thin
+ * archives, whose members live in other files, are not.
+ *
+ * @note Members start at even offsets in the archive, so a member's ELF64
+ * structures may not be naturally aligned. Prim relies on the host allowing
+ * unaligned access.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef FORMAT_AR_ARCHIVE_H
+#define FORMAT_AR_ARCHIVE_H
+
+#include "format/elf64/image.h"
+#include "platform/mapping.h"
+#include "platform/types.h"
+#include "status.h"
+
+/** First bytes of every archive. */
+#define AR_MAGIC "!<arch>\n"
+
+/** Length of `AR_MAGIC`, without its terminator. */
+#define AR_MAGIC_SIZE 8
+
+/** The fixed header before every archive member. */
+typedef struct
+{
+    /** Member name, padded with spaces. */
+    char name[16];
+
+    /** Modification time, in decimal. */
+    char modified[12];
+
+    /** Owner ID, in decimal. */
+    char owner[6];
+
+    /** Group ID, in decimal. */
+    char group[6];
+
+    /** File mode, in octal. */
+    char mode[8];
+
+    /** Size of the member's contents, in decimal. */
+    char size[10];
+
+    /** The characters "`\n". */
+    char terminator[2];
+} Ar_Member_Header;
+
+/** A member of an archive. */
+typedef struct
+{
+    /** The member's name. Not terminated. */
+    const char* name;
+
+    /** Length of `name`. */
+    prim_usize name_length;
+
+    /** The member's contents. */
+    const prim_u8* data;
+
+    /** Length of the member's contents, in bytes. */
+    prim_usize size;
+
+    /** Offset of the member's header in the archive. */
+    prim_usize offset;
+} Ar_Member;
+
+/** An archive mapped into memory. */
+typedef struct
+{
+    /** The mapped archive. */
+    PrimMapping mapping;
+
+    /** The regular members, in archive order. */
+    Ar_Member* members;
+
+    /** Number of entries in `members`. */
+    prim_usize member_count;
+
+    /** Index of the member defining each symbol, in symbol index order. */
+    prim_usize* symbol_members;
+
+    /** Each symbol's name, in symbol index order. */
+    const char** symbol_names;
+
+    /** Number of symbols in the symbol index. */
+    prim_usize symbol_count;
+
+    /**
+     * Open addressed hash table of symbol indexes, keyed by symbol name.
+     * Slots hold a symbol index plus one, so zero marks an empty slot.
+     */
+    prim_usize* symbol_slots;
+
+    /** Number of slots in `symbol_slots`. A power of two, or zero. */
+    prim_usize symbol_slot_count;
+} Ar_Archive;
+
+/**
+ * Parse one member of an archive, in parallel with others.
+ *
+ * @param context The context passed to `ar_archive_parse_members`.
+ * @param archive The archive.
+ * @param index Index of the member in `archive->members`.
+ */
+typedef void (*Ar_Member_Task)(
+    void* context, const Ar_Archive* archive, prim_usize index);
+
+/**
+ * Open an archive, and index its members and symbols.
+ *
+ * @param archive The archive to initialise.
+ * @param path Path to the archive.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the file is not an
+ * archive or is malformed, otherwise an error code. Nothing is left open on
+ * failure.
+ */
+extern PrimStatus ar_archive_open(Ar_Archive* archive, const char* path);
+
+/**
+ * Close an archive. Images opened on its members must be closed first.
+ *
+ * @param archive The archive to close.
+ */
+extern void ar_archive_close(Ar_Archive* archive);
+
+/**
+ * Find the member which defines a symbol, through the symbol index.
+ *
+ * @param archive The archive to search.
+ * @param name The symbol to find.
+ * @param result Location to return the index of the member in `members`.
+ * @return STATUS_OKAY if the symbol is found, STATUS_INVALID if the archive
+ * has no symbol index or the symbol is not in it.
+ */
+extern PrimStatus ar_archive_find_symbol(
+    const Ar_Archive* archive, const char* name, prim_usize* result);
+
+/**
+ * Open an archive member as a lazily parsed ELF64 image.
+ *
+ * The image borrows the archive's mapping, so it must be closed before the
+ * archive. Members are only 2-byte aligned in the archive, so a member which
+ * is not 8-byte aligned is copied, and the image reads the copy instead.
+ *
+ * @param member The member to open.
+ * @param image The image to initialise.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the member is not an
+ * ELF64 object, otherwise an error code.
+ */
+extern PrimStatus ar_member_open_image(
+    const Ar_Member* member, Elf64_Image* image);
+
+/**
+ * Run a task for every member of an archive, spread across threads.
+ *
+ * @param archive The archive.
+ * @param task The task to run for each member.
+ * @param context Passed unchanged to every call of `task`.
+ * @return STATUS_OKAY once every member has been parsed.
+ */
+extern PrimStatus ar_archive_parse_members(
+    const Ar_Archive* archive, Ar_Member_Task task, void* context);
+
+#endif
@@ -0,0 +1,182 @@
+/**
+ * @file include/format/elf64/core.h
+ *
+ * `core.h` reads ELF64 core files a window at a time, so cores far larger
+ * than the memory available can be inspected.
+ *
+ * Opening a core reads its file header, program headers and notes, but none
+ * of the memory it holds. The `PT_LOAD` segments are indexed by virtual
+ * address in an interval tree. Thread status (`NT_PRSTATUS`) and mapped file
+ * (`NT_FILE`) notes are decoded in place, from the note segment, which stays
+ * mapped while the core is open.
+ *
+ * Memory is read through a windowed view of the file, so the core never has
+ * more than `window_count * window_size` bytes of memory mapped, on top of
+ * its notes.
+ *
+ * @note A core is not thread safe: reads update its window cache.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef FORMAT_ELF64_CORE_H
+#define FORMAT_ELF64_CORE_H
+
+#include "format/elf64/header/header.h"
+#include "format/elf64/types.h"
+#include "platform/mapping.h"
+#include "platform/types.h"
+#include "status.h"
+
+/** Default length of each window of a core, in bytes. */
+#define ELF64_CORE_DEFAULT_WINDOW_SIZE 0x100000
+
+/** Default number of windows a core keeps mapped. */
+#define ELF64_CORE_DEFAULT_WINDOW_COUNT 16
+
+/** Number of general purpose registers saved for each AMD64 thread. */
+#define ELF64_CORE_REGISTER_COUNT 27
+
+/** Index of the instruction pointer in a thread's saved registers. */
+#define ELF64_CORE_REGISTER_RIP 16
+
+/** Index of the stack pointer in a thread's saved registers. */
+#define ELF64_CORE_REGISTER_RSP 19
+
+/** A range of process memory saved in a core. */
+typedef struct
+{
+    /** The range's first virtual address. */
+    Elf64_Address start;
+
+    /** The virtual address after the range. */
+    Elf64_Address end;
+
+    /** Offset of the range's saved contents in the core. */
+    Elf64_Offset offset;
+
+    /** Length of the saved contents. Memory past them was not saved. */
+    Elf64_Xword file_size;
+
+    /** The range's `ELF64_PF_*` flags. */
+    Elf64_Word flags;
+} Elf64_Core_Segment;
+
+/** A thread of the crashed process, from its `NT_PRSTATUS` note. */
+typedef struct
+{
+    /** The thread's ID. */
+    prim_u32 pid;
+
+    /** The signal the thread stopped with, or zero. */
+    prim_u32 signal;
+
+    /** The thread's saved registers. */
+    prim_u64 registers[ELF64_CORE_REGISTER_COUNT];
+} Elf64_Core_Thread;
+
+/** A file mapped into the crashed process, from its `NT_FILE` note. */
+typedef struct
+{
+    /** The mapping's first virtual address. */
+    Elf64_Address start;
+
+    /** The virtual address after the mapping. */
+    Elf64_Address end;
+
+    /** Offset of the mapping in the file, in bytes. */
+    Elf64_Offset offset;
+
+    /** The file's path. */
+    const char* path;
+} Elf64_Core_File;
+
+/** An ELF64 core file, opened for reading a window at a time. */
+typedef struct
+{
+    /** The core file, read through a window cache. */
+    PrimWindowedView view;
+
+    /** A copy of the core's file header. */
+    Elf64_Header header;
+
+    /** The saved memory ranges, sorted by start address. */
+    Elf64_Core_Segment* segments;
+
+    /**
+     * Interval tree over `segments`. The subtree rooted at the middle of a
+     * range of segments holds the whole range, and `segment_max_ends` holds
+     * the highest end address in each subtree.
+     */
+    Elf64_Address* segment_max_ends;
+
+    /** Number of entries in `segments`. */
+    prim_usize segment_count;
+
+    /** The mapped note segment, or no data if the core has none. */
+    PrimMapping notes;
+
+    /** The threads, in note order. */
+    Elf64_Core_Thread* threads;
+
+    /** Number of entries in `threads`. */
+    prim_usize thread_count;
+
+    /** The mapped files, in note order. */
+    Elf64_Core_File* files;
+
+    /** Number of entries in `files`. */
+    prim_usize file_count;
+} Elf64_Core;
+
+/**
+ * Open an ELF64 core file.
+ *
+ * @param core The core to initialise.
+ * @param path Path to the core file.
+ * @param window_size Length of each window, in bytes, or zero for
+ * `ELF64_CORE_DEFAULT_WINDOW_SIZE`. Rounded up to the page size.
+ * @param window_count Number of windows to keep mapped, or zero for
+ * `ELF64_CORE_DEFAULT_WINDOW_COUNT`.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the file is not an ELF64
+ * core or is malformed, otherwise an error code. Nothing is left open on
+ * failure.
+ */
+extern PrimStatus elf64_core_open(Elf64_Core* core, const char* path,
+    prim_usize window_size, prim_usize window_count);
+
+/**
+ * Close a core, and unmap its windows and notes.
+ *
+ * @param core The core to close.
+ */
+extern void elf64_core_close(Elf64_Core* core);
+
+/**
+ * Find the saved memory range holding an address.
+ *
+ * @param core The core to search.
+ * @param address The virtual address to find.
+ * @param result Location to return the range.
+ * @return STATUS_OKAY if the address was in the process, STATUS_INVALID if it
+ * was not.
+ */
+extern PrimStatus elf64_core_find_segment(const Elf64_Core* core,
+    Elf64_Address address, const Elf64_Core_Segment** result);
+
+/**
+ * Read process memory saved in a core.
+ *
+ * @param core The core to read.
+ * @param address The virtual address to read from.
+ * @param buffer Location to copy the memory to.
+ * @param size Number of bytes to read.
+ * @return STATUS_OKAY on success, STATUS_INVALID if any of the memory was not
+ * saved, otherwise an error code.
+ */
+extern PrimStatus elf64_core_read(Elf64_Core* core, Elf64_Address address,
+    void* buffer, prim_usize size);
+
+#endif
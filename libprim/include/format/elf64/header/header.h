@@ -11,6 +11,7 @@
 #ifndef FORMAT_ELF64_HEADER_HEADER_H
 #define FORMAT_ELF64_HEADER_HEADER_H
 
+#include "accessor.h"
 #include "format/elf64/header/ident.h"
 #include "format/elf64/types.h"
 #include "status.h"
@@ -72,7 +73,7 @@ typedef struct
  * @param header The ELF64 header to read.
  * @return The start virtual address for the process, or 0 if no such address.
  */
-extern Elf64_Address elf64_get_entry_address(Elf64_Header* header);
+PRIM_ACCESSOR Elf64_Address elf64_get_entry_address(Elf64_Header* header);
 
 /**
  * Get the offset to the program (segment) header table.
@@ -83,7 +84,7 @@ extern Elf64_Address elf64_get_entry_address(Elf64_Header* header);
  * @param header The ELF64 header to read.
  * @return The offset to the program header, or 0 if no such header.
  */
-extern Elf64_Offset elf64_get_ph_offset(Elf64_Header* header);
+PRIM_ACCESSOR Elf64_Offset elf64_get_ph_offset(Elf64_Header* header);
 
 /**
  * Get the offset to the section (linking) header table.
@@ -94,7 +95,7 @@ extern Elf64_Offset elf64_get_ph_offset(Elf64_Header* header);
  * @param header the ELF64 header to read.
  * @return The offset to the section header, or 0 if no such header.
  */
-extern Elf64_Offset elf64_get_sh_offset(Elf64_Header* header);
+PRIM_ACCESSOR Elf64_Offset elf64_get_sh_offset(Elf64_Header* header);
 
 /**
  * Get the CPU specific flags for this binary.
@@ -102,7 +103,7 @@ extern Elf64_Offset elf64_get_sh_offset(Elf64_Header* header);
  * @param header The ELF64 header to read.
  * @return The offset to the section header, or 0 if no such header.
  */
-extern Elf64_Word elf64_get_flags(Elf64_Header* header);
+PRIM_ACCESSOR Elf64_Word elf64_get_flags(Elf64_Header* header);
 
 /**
  * Get the size of the header according to this binary.
@@ -110,7 +111,7 @@ extern Elf64_Word elf64_get_flags(Elf64_Header* header);
  * @param header The ELF64 header to read.
  * @return The length of this version of the ELF64 header.
  */
-extern Elf64_Half elf64_get_header_size(Elf64_Header* header);
+PRIM_ACCESSOR Elf64_Half elf64_get_header_size(Elf64_Header* header);
 
 /**
  * Gets the size of a program header entry, according to this binary.
@@ -118,7 +119,7 @@ extern Elf64_Half elf64_get_header_size(Elf64_Header* header);
  * @param header The ELF64 header to read.
  * @return The length of a program header entry in this binary.
  */
-extern Elf64_Half elf64_get_ph_entry_size(Elf64_Header* header);
+PRIM_ACCESSOR Elf64_Half elf64_get_ph_entry_size(Elf64_Header* header);
 
 /**
  * Gets the number of program header entries (segments) in this binary.
@@ -128,7 +129,7 @@ extern Elf64_Half elf64_get_ph_entry_size(Elf64_Header* header);
  * @param header The ELF64 header to read.
  * @return The number of segments in the binary.
  */
-extern Elf64_Half elf64_get_ph_entry_count(Elf64_Header* header);
+PRIM_ACCESSOR Elf64_Half elf64_get_ph_entry_count(Elf64_Header* header);
 
 /**
  * Gets the size of a program header entry, according to this binary.
@@ -136,7 +137,7 @@ extern Elf64_Half elf64_get_ph_entry_count(Elf64_Header* header);
  * @param header The ELF64 header to read.
  * @return The length of a section header entry in this binary.
  */
-extern Elf64_Half elf64_get_sh_entry_size(Elf64_Header* header);
+PRIM_ACCESSOR Elf64_Half elf64_get_sh_entry_size(Elf64_Header* header);
 
 /**
  * Gets the number of section header entries in this binary.
@@ -147,7 +148,7 @@ extern Elf64_Half elf64_get_sh_entry_size(Elf64_Header* header);
  * @param header The ELF64 header to read.
  * @return The number of sections in the binary.
  */
-extern Elf64_Half elf64_get_sh_entry_count(Elf64_Header* header);
+PRIM_ACCESSOR Elf64_Half elf64_get_sh_entry_count(Elf64_Header* header);
 
 /**
  * Gets the index of the section name section index.
@@ -164,6 +165,60 @@ extern Elf64_Half elf64_get_sh_entry_count(Elf64_Header* header);
  * @param header The ELF64 header to read.
  * @return The index of the string table section in the section header table.
  */
-extern Elf64_Half elf64_get_shstr_index(Elf64_Header* header);
+PRIM_ACCESSOR Elf64_Half elf64_get_shstr_index(Elf64_Header* header);
+
+#ifdef PRIM_ACCESSORS_INLINE
+
+static inline Elf64_Address elf64_get_entry_address(Elf64_Header* header)
+{
+    return header->entry;
+}
+
+static inline Elf64_Offset elf64_get_ph_offset(Elf64_Header* header)
+{
+    return header->ph_offset;
+}
+
+static inline Elf64_Offset elf64_get_sh_offset(Elf64_Header* header)
+{
+    return header->sh_offset;
+}
+
+static inline Elf64_Word elf64_get_flags(Elf64_Header* header)
+{
+    return header->flags;
+}
+
+static inline Elf64_Half elf64_get_header_size(Elf64_Header* header)
+{
+    return header->header_size;
+}
+
+static inline Elf64_Half elf64_get_ph_entry_size(Elf64_Header* header)
+{
+    return header->ph_entry_size;
+}
+
+static inline Elf64_Half elf64_get_ph_entry_count(Elf64_Header* header)
+{
+    return header->ph_entry_count;
+}
+
+static inline Elf64_Half elf64_get_sh_entry_size(Elf64_Header* header)
+{
+    return header->sh_entry_size;
+}
+
+static inline Elf64_Half elf64_get_sh_entry_count(Elf64_Header* header)
+{
+    return header->sh_entry_count;
+}
+
+static inline Elf64_Half elf64_get_shstr_index(Elf64_Header* header)
+{
+    return header->header_name_strs_index;
+}
+
+#endif
 
 #endif
@@ -0,0 +1,556 @@
+/**
+ * @file include/format/elf64/image.h
+ *
+ * `image.h` provides a lazily parsed view of a whole ELF64 binary.
+ *
+ * Opening an image maps the binary and checks its file header, but nothing
+ * else. The section and segment header tables, the section name string table
+ * and the section name index are each validated or built the first time a
+ * query needs them, and remembered for later queries. A narrow query, such as
+ * asking for the interpreter, only touches the pages it needs.
+ *
+ * Compressed sections are inflated on demand into a single arena, sized for
+ * every compressed section in the image when the first is asked for, and
+ * each stays inflated until the image is closed.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef FORMAT_ELF64_IMAGE_H
+#define FORMAT_ELF64_IMAGE_H
+
+#include "format/elf64/header/header.h"
+#include "format/elf64/section/compression.h"
+#include "format/elf64/section/dynamic.h"
+#include "format/elf64/section/hash.h"
+#include "format/elf64/section/header.h"
+#include "format/elf64/section/note.h"
+#include "format/elf64/section/symbol.h"
+#include "format/elf64/section/type.h"
+#include "format/elf64/section/version.h"
+#include "format/elf64/segment/header.h"
+#include "format/elf64/types.h"
+#include "hash.h"
+#include "platform/mapping.h"
+#include "status.h"
+
+/** The section header table has been validated. */
+#define ELF64_IMAGE_SECTION_HEADERS 0x1
+
+/** The segment header table has been validated. */
+#define ELF64_IMAGE_SEGMENT_HEADERS 0x2
+
+/** The section name string table has been located. */
+#define ELF64_IMAGE_SECTION_NAMES 0x4
+
+/** The section name index has been built. */
+#define ELF64_IMAGE_SECTION_NAME_INDEX 0x8
+
+/** The interpreter segment has been searched for. */
+#define ELF64_IMAGE_INTERPRETER 0x10
+
+/** The static symbol table has been located. */
+#define ELF64_IMAGE_SYMBOLS 0x20
+
+/** The dynamic symbol table has been located. */
+#define ELF64_IMAGE_DYNAMIC_SYMBOLS 0x40
+
+/** The dynamic linking table has been located. */
+#define ELF64_IMAGE_DYNAMIC 0x80
+
+/** The GNU symbol hash table has been located. */
+#define ELF64_IMAGE_GNU_HASH 0x100
+
+/** The symbol version tables have been indexed. */
+#define ELF64_IMAGE_VERSIONS 0x200
+
+/** The compressed sections have been indexed, and their arena allocated. */
+#define ELF64_IMAGE_COMPRESSED_SECTIONS 0x400
+
+/** A symbol table, and the string table holding its names. */
+typedef struct
+{
+    /** The symbols in the table. */
+    const Elf64_Symbol* symbols;
+
+    /** Number of symbols in the table. Zero if the binary has no table. */
+    Elf64_Word count;
+
+    /** The string table header. */
+    const ELF64_Section_Header* strings_header;
+
+    /** The string table data. */
+    const char* strings;
+} Elf64_Symbol_Table;
+
+/** A dynamic linking table, and the string table its entries refer to. */
+typedef struct
+{
+    /** The entries in the table, up to but excluding `ELF64_DT_NULL`. */
+    const Elf64_Dynamic* entries;
+
+    /** Number of entries in the table. Zero if the binary has no table. */
+    Elf64_Word count;
+
+    /** The string table header. */
+    const ELF64_Section_Header* strings_header;
+
+    /** The string table data. */
+    const char* strings;
+} Elf64_Dynamic_Table;
+
+/** A symbol version an image defines or requires. */
+typedef struct
+{
+    /** The version's name, or `NULL` if the index is unused or unversioned. */
+    const char* name;
+
+    /** Non-zero if the image defines the version, zero if it requires it. */
+    int defined;
+} Elf64_Version;
+
+/** The symbol versions of an image's dynamic symbols. */
+typedef struct
+{
+    /** Each dynamic symbol's version entry, or `NULL` if it has none. */
+    const Elf64_Half* symbols;
+
+    /** Number of entries in `symbols`. */
+    Elf64_Word symbol_count;
+
+    /** The versions, indexed by version index. */
+    Elf64_Version* versions;
+
+    /** Number of entries in `versions`. */
+    Elf64_Half count;
+
+    /** Non-zero if the image defines any named versions. */
+    int defines_versions;
+} Elf64_Version_Table;
+
+/** A section's compressed contents, and where they inflate to. */
+typedef struct
+{
+    /** The compressed stream, or `NULL` if the section is not compressed. */
+    const prim_u8* source;
+
+    /** Length of the compressed stream, in bytes. */
+    Elf64_Xword source_size;
+
+    /** The stream's `ELF64_COMPRESS_*` format. */
+    Elf64_Word format;
+
+    /** The inflated contents, in the image's arena. */
+    prim_u8* data;
+
+    /** Length of the inflated contents, in bytes. */
+    Elf64_Xword size;
+
+    /** Non-zero once the section has been inflated, or failed to. */
+    int inflated;
+
+    /** The result of inflating the section. */
+    PrimStatus status;
+} Elf64_Compressed_Section;
+
+/** An ELF64 binary mapped into memory, parsed on demand. */
+typedef struct
+{
+    /** The mapped contents of the binary. */
+    PrimMapping mapping;
+
+    /**
+     * Non-zero if the mapping was lent by `elf64_image_open_mapping`, and is
+     * not released with the image.
+     */
+    int borrowed;
+
+    /** The file header, at the start of the mapping. */
+    const Elf64_Header* header;
+
+    /** Bitfield of the `ELF64_IMAGE_*` components built so far. */
+    prim_u32 materialised;
+
+    /** The section header table, once validated. */
+    const ELF64_Section_Header* section_headers;
+
+    /** The segment header table, once validated. */
+    const Elf64_Segment_Header* segment_headers;
+
+    /** The section name string table header, if the binary has one. */
+    const ELF64_Section_Header* section_names_header;
+
+    /** The section name string table data, if the binary has one. */
+    const char* section_names;
+
+    /**
+     * Open addressed hash table of section indexes, keyed by section name.
+     * Slots hold a section index plus one, so zero marks an empty slot.
+     */
+    Elf64_Word* section_name_index;
+
+    /** Number of slots in `section_name_index`. A power of two. */
+    Elf64_Word section_name_index_size;
+
+    /** The interpreter path, or `NULL` if the binary has none. */
+    const char* interpreter;
+
+    /** The static symbol table (`.symtab`), once located. */
+    Elf64_Symbol_Table symbol_table;
+
+    /** The dynamic symbol table (`.dynsym`), once located. */
+    Elf64_Symbol_Table dynamic_symbol_table;
+
+    /** The dynamic linking table (`.dynamic`), once located. */
+    Elf64_Dynamic_Table dynamic_table;
+
+    /** The GNU symbol hash table, once located. No header if it has none. */
+    Elf64_Gnu_Hash_Table gnu_hash;
+
+    /** The symbol version tables, once indexed. */
+    Elf64_Version_Table version_table;
+
+    /**
+     * Each section's compressed contents, once indexed, or `NULL` if the
+     * image has no compressed sections.
+     */
+    Elf64_Compressed_Section* compressed_sections;
+
+    /** The memory compressed sections inflate into. */
+    prim_u8* inflate_arena;
+
+    /**
+     * A copy of the binary made to align it, released with the image, or
+     * `NULL` if the mapping holds the binary in place.
+     */
+    prim_u8* aligned_copy;
+} Elf64_Image;
+
+/**
+ * Open an ELF64 binary as a lazily parsed image.
+ *
+ * Only the file header is read and checked. Everything else is deferred until
+ * it is first needed.
+ *
+ * @param image The image to initialise.
+ * @param path Path to the binary to open.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the file is not an ELF64
+ * binary, otherwise an error code.
+ */
+extern PrimStatus elf64_image_open(Elf64_Image* image, const char* path);
+
+/**
+ * Open an ELF64 binary the caller has already mapped as a lazily parsed
+ * image.
+ *
+ * The image borrows the mapping: closing the image leaves it mapped, so it
+ * can back several images at once.
+ *
+ * @param image The image to initialise.
+ * @param mapping The mapped binary. Must outlive the image.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the file is not an ELF64
+ * binary.
+ */
+extern PrimStatus elf64_image_open_mapping(
+    Elf64_Image* image, const PrimMapping* mapping);
+
+/**
+ * Release an image and everything built for it.
+ *
+ * @param image The image to close.
+ */
+extern void elf64_image_close(Elf64_Image* image);
+
+/**
+ * Get a section header from an image.
+ *
+ * @param image The image to read.
+ * @param index The index of the section in the section header table.
+ * @param result Location to return the section header.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such section
+ * or the section header table is malformed.
+ */
+extern PrimStatus elf64_image_get_section_header(Elf64_Image* image,
+    Elf64_Word index, const ELF64_Section_Header** result);
+
+/**
+ * Get a segment header from an image.
+ *
+ * @param image The image to read.
+ * @param index The index of the segment in the segment header table.
+ * @param result Location to return the segment header.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such segment
+ * or the segment header table is malformed.
+ */
+extern PrimStatus elf64_image_get_segment_header(Elf64_Image* image,
+    Elf64_Word index, const Elf64_Segment_Header** result);
+
+/**
+ * Get the contents of a section from an image.
+ *
+ * @note Sections which occupy no space in the binary, such as `.bss`, have no
+ * contents. They return `NULL` data.
+ *
+ * @param image The image to read.
+ * @param index The index of the section in the section header table.
+ * @param result Location to return the section contents.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such section
+ * or the section lies outside the binary.
+ */
+extern PrimStatus elf64_image_get_section_data(
+    Elf64_Image* image, Elf64_Word index, const void** result);
+
+/**
+ * Get the uncompressed contents of a section from an image.
+ *
+ * Sections flagged `ELF64_SECTION_FLAG_COMPRESSED` are inflated the first
+ * time they are asked for. Other sections are returned in place, like
+ * `elf64_image_get_section_data`.
+ *
+ * @param image The image to read.
+ * @param index The index of the section in the section header table.
+ * @param result Location to return the section contents.
+ * @param size Location to return the length of the contents, in bytes.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such section,
+ * the section lies outside the binary, or its compressed contents are
+ * malformed or in an unsupported format, otherwise an error code.
+ */
+extern PrimStatus elf64_image_get_section_contents(Elf64_Image* image,
+    Elf64_Word index, const void** result, Elf64_Xword* size);
+
+/**
+ * Inflate every compressed section of an image not yet inflated, spread
+ * across threads.
+ *
+ * @param image The image to inflate.
+ * @return STATUS_OKAY if every compressed section inflated, STATUS_INVALID if
+ * any is malformed or in an unsupported format, otherwise an error code.
+ */
+extern PrimStatus elf64_image_inflate_sections(Elf64_Image* image);
+
+/**
+ * Get the name of a section from an image.
+ *
+ * @param image The image to read.
+ * @param index The index of the section in the section header table.
+ * @param result Location to return the section name.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such section
+ * or the section has no valid name.
+ */
+extern PrimStatus elf64_image_get_section_name(
+    Elf64_Image* image, Elf64_Word index, const char** result);
+
+/**
+ * Find a section in an image by name.
+ *
+ * The first call builds an index of section names, so later calls cost a
+ * single hash probe.
+ *
+ * @param image The image to search.
+ * @param name The section name to find, for example `.text`.
+ * @param result Location to return the index of the section.
+ * @return STATUS_OKAY if the section is found, STATUS_INVALID if it is not,
+ * otherwise an error code.
+ */
+extern PrimStatus elf64_image_find_section(
+    Elf64_Image* image, const char* name, Elf64_Word* result);
+
+/**
+ * Get the path of the interpreter requested by an image.
+ *
+ * @param image The image to read.
+ * @param result Location to return the interpreter path, or `NULL` if the
+ * image does not request an interpreter.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the interpreter segment
+ * is malformed.
+ */
+extern PrimStatus elf64_image_get_interpreter(
+    Elf64_Image* image, const char** result);
+
+/**
+ * Get an image's GNU build ID, from its `ELF64_PT_NOTE` segments.
+ *
+ * @param image The image to read.
+ * @param result Location to return the build ID, or `NULL` if the image has
+ * none.
+ * @param result_size Location to return the build ID's length, or zero if
+ * the image has none.
+ * @return STATUS_OKAY on success, STATUS_INVALID if a note segment is
+ * malformed.
+ */
+extern PrimStatus elf64_image_get_build_id(Elf64_Image* image,
+    const Elf64_Byte** result, Elf64_Word* result_size);
+
+/**
+ * Checks if an image is a position independent executable.
+ *
+ * An image is treated as a PIE if it is a dynamic object which requests an
+ * interpreter. Shared libraries do not request an interpreter.
+ *
+ * @param image The image to test.
+ * @return `STATUS_OKAY` if the image is a PIE, `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus elf64_image_is_pie(Elf64_Image* image);
+
+/**
+ * Get a symbol table from an image.
+ *
+ * An image has at most one static symbol table and one dynamic symbol table.
+ * A table the image does not have is returned with no symbols.
+ *
+ * @param image The image to read.
+ * @param type `ELF64_SECTION_TYPE_SYMBOL_TABLE` for the static symbol table,
+ * or `ELF64_SECTION_TYPE_DYNSYM` for the dynamic symbol table.
+ * @param result Location to return the symbol table.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the type is not a symbol
+ * table type or the table is malformed.
+ */
+extern PrimStatus elf64_image_get_symbol_table(Elf64_Image* image,
+    ELF64_Section_Type type, const Elf64_Symbol_Table** result);
+
+/**
+ * Get the name of a symbol from its symbol table.
+ *
+ * @param table The symbol table the symbol belongs to.
+ * @param symbol The symbol to name.
+ * @param result Location to return the symbol name.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the symbol has no valid
+ * name.
+ */
+extern PrimStatus elf64_symbol_table_get_name(const Elf64_Symbol_Table* table,
+    const Elf64_Symbol* symbol, const char** result);
+
+/**
+ * Get the symbol version tables from an image.
+ *
+ * The version definitions and requirements are indexed by version index when
+ * the tables are first requested, so a symbol's version is found without
+ * walking either list. An image without versions is returned with no
+ * symbol entries.
+ *
+ * @param image The image to read.
+ * @param result Location to return the version tables.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the tables are malformed,
+ * otherwise an error code.
+ */
+extern PrimStatus elf64_image_get_version_table(
+    Elf64_Image* image, const Elf64_Version_Table** result);
+
+/**
+ * Find a symbol an image defines for other images, by name and version.
+ *
+ * The image's GNU hash table is used if it has one. Otherwise the dynamic
+ * symbol table is scanned. Undefined and local symbols are never found.
+ *
+ * @param image The image to search.
+ * @param name The symbol name to find.
+ * @param hash The name's `elf64_gnu_hash`.
+ * @param version The image's index of the version to find, or
+ * `ELF64_VER_NDX_GLOBAL` to find the default version. Ignored if the image
+ * has no versions.
+ * @param result Location to return the index of the symbol in the dynamic
+ * symbol table.
+ * @return STATUS_OKAY if the symbol is found, STATUS_INVALID if it is not,
+ * otherwise an error code.
+ */
+extern PrimStatus elf64_image_find_dynamic_symbol(Elf64_Image* image,
+    const char* name, Elf64_Word hash, Elf64_Half version, Elf64_Word* result);
+
+/**
+ * Get the dynamic linking table from an image.
+ *
+ * A statically linked image has no dynamic table. It is returned with no
+ * entries.
+ *
+ * @param image The image to read.
+ * @param result Location to return the dynamic table.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the table is malformed.
+ */
+extern PrimStatus elf64_image_get_dynamic_table(
+    Elf64_Image* image, const Elf64_Dynamic_Table** result);
+
+/**
+ * Find the first entry with a given tag in a dynamic table.
+ *
+ * @param table The dynamic table to search.
+ * @param tag The tag to find, for example `ELF64_DT_SONAME`.
+ * @param result Location to return the entry.
+ * @return STATUS_OKAY if the entry is found, STATUS_INVALID if it is not.
+ */
+extern PrimStatus elf64_dynamic_table_find(const Elf64_Dynamic_Table* table,
+    Elf64_Dynamic_Tag tag, const Elf64_Dynamic** result);
+
+/**
+ * Get the string a dynamic table entry refers to, such as a needed library.
+ *
+ * @param table The dynamic table the entry belongs to.
+ * @param entry The entry whose value is a string table offset.
+ * @param result Location to return the string.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the entry has no valid
+ * string.
+ */
+extern PrimStatus elf64_dynamic_table_get_string(
+    const Elf64_Dynamic_Table* table, const Elf64_Dynamic* entry,
+    const char** result);
+
+/**
+ * Hint that a section's contents will be read soon.
+ *
+ * @param image The image the section belongs to.
+ * @param index The index of the section in the section header table.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such section.
+ */
+extern PrimStatus elf64_image_prefetch_section(
+    Elf64_Image* image, Elf64_Word index);
+
+/**
+ * Hint that a segment's contents will be read soon.
+ *
+ * @param image The image the segment belongs to.
+ * @param index The index of the segment in the segment header table.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such segment.
+ */
+extern PrimStatus elf64_image_prefetch_segment(
+    Elf64_Image* image, Elf64_Word index);
+
+/**
+ * Hash a section's contents, as stored in the binary.
+ *
+ * @note Sections which occupy no space in the binary hash as empty.
+ *
+ * @param image The image to read.
+ * @param index The index of the section in the section header table.
+ * @param result Location to return the hash.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such section
+ * or the section lies outside the binary.
+ */
+extern PrimStatus elf64_image_hash_section(
+    Elf64_Image* image, Elf64_Word index, PrimHash128* result);
+
+/**
+ * Hash every section of an image, spread across threads.
+ *
+ * @param image The image to read.
+ * @param results Location to return each section's hash, in section header
+ * table order. Sections which can not be hashed are left zero.
+ * @return STATUS_OKAY if every section was hashed, STATUS_INVALID if the
+ * section header table or any section is malformed, otherwise an error code.
+ */
+extern PrimStatus elf64_image_hash_sections(
+    Elf64_Image* image, PrimHash128* results);
+
+/**
+ * Hash a segment's contents, as stored in the binary.
+ *
+ * @param image The image to read.
+ * @param index The index of the segment in the segment header table.
+ * @param result Location to return the hash.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such segment
+ * or the segment lies outside the binary.
+ */
+extern PrimStatus elf64_image_hash_segment(
+    Elf64_Image* image, Elf64_Word index, PrimHash128* result);
+
+#endif
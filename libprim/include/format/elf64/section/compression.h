@@ -0,0 +1,43 @@
+/**
+ * @file include/format/elf64/section/compression.h
+ *
+ * `compression.h` defines the header at the start of sections flagged
+ * `ELF64_SECTION_FLAG_COMPRESSED`, usually debug information.
+ *
+ * A compressed section's contents are the header followed by the compressed
+ * stream. The section header's size is the compressed size; the
+ * uncompressed size and alignment are in the compression header.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef FORMAT_ELF64_SECTION_COMPRESSION_H
+#define FORMAT_ELF64_SECTION_COMPRESSION_H
+
+#include "format/elf64/types.h"
+
+/** The section is a zlib stream. */
+#define ELF64_COMPRESS_ZLIB 1
+
+/** The section is a Zstandard stream. Not supported by Prim. */
+#define ELF64_COMPRESS_ZSTD 2
+
+/** The header at the start of a compressed section. */
+typedef struct
+{
+    /** The compression format, an `ELF64_COMPRESS_*` value. */
+    Elf64_Word type;
+
+    /** Reserved. */
+    Elf64_Word reserved;
+
+    /** Length of the uncompressed contents, in bytes. */
+    Elf64_Xword size;
+
+    /** Alignment of the uncompressed contents. */
+    Elf64_Xword alignment;
+} Elf64_Compression_Header;
+
+#endif
@@ -0,0 +1,198 @@
+/**
+ * @file include/format/elf64/section/dynamic.h
+ *
+ * `dynamic.h` defines the dynamic linking table entry format used by ELF64,
+ * stored in `ELF64_SECTION_TYPE_DYNAMIC` sections and `ELF64_PT_DYNAMIC`
+ * segments.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef FORMAT_ELF64_SECTION_DYNAMIC_H
+#define FORMAT_ELF64_SECTION_DYNAMIC_H
+
+#include "accessor.h"
+#include "format/elf64/types.h"
+#include "status.h"
+
+typedef struct
+{
+    /** The type of the entry. One of the `ELF64_DT_*` values. */
+    Elf64_Sxword tag;
+
+    /** An integer or address. Semantics are tag specific. */
+    Elf64_Xword value;
+} Elf64_Dynamic;
+
+/**
+ * Dynamic table entry tags. We avoid an enum because some specified values
+ * are too large for standard C enums (max width: int).
+ */
+typedef Elf64_Sxword Elf64_Dynamic_Tag;
+
+/** Marks the end of the dynamic table. */
+#define ELF64_DT_NULL 0
+
+/** String table offset of the name of a needed library. */
+#define ELF64_DT_NEEDED 1
+
+/** Size of the PLT relocations, in bytes. */
+#define ELF64_DT_PLTRELSZ 2
+
+/** Address of the PLT's global offset table. */
+#define ELF64_DT_PLTGOT 3
+
+/** Address of the SysV symbol hash table. */
+#define ELF64_DT_HASH 4
+
+/** Address of the dynamic string table. */
+#define ELF64_DT_STRTAB 5
+
+/** Address of the dynamic symbol table. */
+#define ELF64_DT_SYMTAB 6
+
+/** Address of the relocations with explicit addends. */
+#define ELF64_DT_RELA 7
+
+/** Size of the relocations with explicit addends, in bytes. */
+#define ELF64_DT_RELASZ 8
+
+/** Size of a relocation with an explicit addend, in bytes. */
+#define ELF64_DT_RELAENT 9
+
+/** Size of the dynamic string table, in bytes. */
+#define ELF64_DT_STRSZ 10
+
+/** Size of a dynamic symbol, in bytes. */
+#define ELF64_DT_SYMENT 11
+
+/** Address of the initialisation function. */
+#define ELF64_DT_INIT 12
+
+/** Address of the termination function. */
+#define ELF64_DT_FINI 13
+
+/** String table offset of this library's name. */
+#define ELF64_DT_SONAME 14
+
+/** String table offset of the library search path. Deprecated. */
+#define ELF64_DT_RPATH 15
+
+/** Address of the relocations without explicit addends. */
+#define ELF64_DT_REL 17
+
+/** Type of the PLT relocations: `ELF64_DT_REL` or `ELF64_DT_RELA`. */
+#define ELF64_DT_PLTREL 20
+
+/** Relocations may modify read-only segments. */
+#define ELF64_DT_TEXTREL 22
+
+/** Address of the PLT relocations. */
+#define ELF64_DT_JMPREL 23
+
+/** Resolve every symbol at load time. */
+#define ELF64_DT_BIND_NOW 24
+
+/** Address of the initialisation function table. */
+#define ELF64_DT_INIT_ARRAY 25
+
+/** Address of the termination function table. */
+#define ELF64_DT_FINI_ARRAY 26
+
+/** Size of the initialisation function table, in bytes. */
+#define ELF64_DT_INIT_ARRAYSZ 27
+
+/** Size of the termination function table, in bytes. */
+#define ELF64_DT_FINI_ARRAYSZ 28
+
+/** String table offset of the library search path. */
+#define ELF64_DT_RUNPATH 29
+
+/** Bitfield of `ELF64_DF_*` flags. */
+#define ELF64_DT_FLAGS 30
+
+/** Size of the relative relocation bitmaps, in bytes. */
+#define ELF64_DT_RELRSZ 35
+
+/** Address of the relative relocation bitmaps. */
+#define ELF64_DT_RELR 36
+
+/** Size of a relative relocation bitmap entry, in bytes. */
+#define ELF64_DT_RELRENT 37
+
+/** Address of the GNU symbol hash table. */
+#define ELF64_DT_GNU_HASH 0x6ffffef5
+
+/** Address of the symbol version table. */
+#define ELF64_DT_VERSYM 0x6ffffff0
+
+/** Number of relative relocations. */
+#define ELF64_DT_RELACOUNT 0x6ffffff9
+
+/** Bitfield of `ELF64_DF_1_*` flags. */
+#define ELF64_DT_FLAGS_1 0x6ffffffb
+
+/** Address of the version definitions. */
+#define ELF64_DT_VERDEF 0x6ffffffc
+
+/** Number of version definitions. */
+#define ELF64_DT_VERDEFNUM 0x6ffffffd
+
+/** Address of the version requirements. */
+#define ELF64_DT_VERNEED 0x6ffffffe
+
+/** Number of version requirements. */
+#define ELF64_DT_VERNEEDNUM 0x6fffffff
+
+/** `ELF64_DT_FLAGS`: resolve every symbol at load time. */
+#define ELF64_DF_BIND_NOW 0x8
+
+/** `ELF64_DT_FLAGS_1`: resolve every symbol at load time. */
+#define ELF64_DF_1_NOW 0x1
+
+/** `ELF64_DT_FLAGS_1`: the object is a position independent executable. */
+#define ELF64_DF_1_PIE 0x08000000
+
+/**
+ * Get the tag of a dynamic table entry.
+ *
+ * @param entry The entry to read.
+ * @return The entry's tag.
+ */
+PRIM_ACCESSOR Elf64_Dynamic_Tag elf64_get_dynamic_tag(
+    const Elf64_Dynamic* entry);
+
+/**
+ * Get the value of a dynamic table entry.
+ *
+ * @param entry The entry to read.
+ * @return The entry's integer or address value.
+ */
+PRIM_ACCESSOR Elf64_Xword elf64_get_dynamic_value(const Elf64_Dynamic* entry);
+
+/**
+ * Get a string with a human readable dynamic tag name.
+ *
+ * @param tag The tag to string-ify.
+ * @return A human readable tag name.
+ */
+extern const char* elf64_get_dynamic_tag_string(Elf64_Dynamic_Tag tag);
+
+#ifdef PRIM_ACCESSORS_INLINE
+
+static inline Elf64_Dynamic_Tag elf64_get_dynamic_tag(
+    const Elf64_Dynamic* entry)
+{
+    return entry->tag;
+}
+
+static inline Elf64_Xword elf64_get_dynamic_value(const Elf64_Dynamic* entry)
+{
+    return entry->value;
+}
+
+#endif
+
+#endif
@@ -11,6 +11,7 @@
 #ifndef FORMAT_ELF64_SECTION_FLAGS_H
 #define FORMAT_ELF64_SECTION_FLAGS_H
 
+#include "accessor.h"
 #include "format/elf64/section/header.h"
 #include "format/elf64/types.h"
 
@@ -30,6 +31,12 @@ typedef Elf64_Xword ELF64_Section_Flag;
 /** Section executable during execution. */
 #define ELF64_SECTION_FLAG_EXEC 0x4
 
+/**
+ * Section contents are compressed, behind an `Elf64_Compression_Header`.
+ * See `section/compression.h`.
+ */
+#define ELF64_SECTION_FLAG_COMPRESSED 0x800
+
 /** Reserved for CPU specific flags. */
 #define ELF64_SECTION_FLAG_MASK_PROC 0xf0000000
 
@@ -42,7 +49,8 @@ typedef Elf64_Xword ELF64_Section_Flag;
  * @param header pointer to the ELF64 section header.
  * @return The bitfield containing the section flags.
  */
-extern Elf64_Xword elf64_get_section_flags(const ELF64_Section_Header* header);
+PRIM_ACCESSOR Elf64_Xword elf64_get_section_flags(
+    const ELF64_Section_Header* header);
 
 /**
  * Get a string with a human readable section flag name.
@@ -61,4 +69,14 @@ extern const char* elf64_get_section_flag_string(ELF64_Section_Flag flag);
  */
 extern PrimStatus elf64_is_section_flag_valid(ELF64_Section_Flag flag);
 
+#ifdef PRIM_ACCESSORS_INLINE
+
+static inline Elf64_Xword elf64_get_section_flags(
+    const ELF64_Section_Header* header)
+{
+    return header->flags;
+}
+
+#endif
+
 #endif
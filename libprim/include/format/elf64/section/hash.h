@@ -0,0 +1,85 @@
+/**
+ * @file include/format/elf64/section/hash.h
+ *
+ * `hash.h` defines the GNU symbol hash table format, stored in
+ * `ELF64_SECTION_TYPE_GNU_HASH` sections.
+ *
+ * The table maps a symbol name's hash to a run of dynamic symbols. A bloom
+ * filter in front of the buckets rejects most names a binary does not
+ * define without touching the symbol table.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef FORMAT_ELF64_SECTION_HASH_H
+#define FORMAT_ELF64_SECTION_HASH_H
+
+#include "format/elf64/types.h"
+#include "status.h"
+
+/** The fixed header at the start of a GNU hash table. */
+typedef struct
+{
+    /** Number of hash buckets. */
+    Elf64_Word bucket_count;
+
+    /** Index of the first symbol in the hash table. */
+    Elf64_Word symbol_offset;
+
+    /** Number of 64-bit words in the bloom filter. */
+    Elf64_Word bloom_size;
+
+    /** Shift for the bloom filter's second hash. */
+    Elf64_Word bloom_shift;
+} Elf64_Gnu_Hash_Header;
+
+/** A validated GNU hash table. */
+typedef struct
+{
+    /** The table's header. */
+    const Elf64_Gnu_Hash_Header* header;
+
+    /** The bloom filter words. */
+    const Elf64_Xword* bloom;
+
+    /** The first symbol index for each bucket, or zero if it is empty. */
+    const Elf64_Word* buckets;
+
+    /** Each hashed symbol's hash. The low bit marks the end of a bucket. */
+    const Elf64_Word* chains;
+} Elf64_Gnu_Hash_Table;
+
+/**
+ * Compute the GNU hash of a symbol name.
+ *
+ * @param name The name to hash.
+ * @return The name's hash.
+ */
+extern Elf64_Word elf64_gnu_hash(const char* name);
+
+/**
+ * Validate a GNU hash table.
+ *
+ * @param table Location to return the table.
+ * @param data The table's contents. Must be 8-byte aligned.
+ * @param size The size of the table, in bytes.
+ * @param symbol_count Number of symbols in the dynamic symbol table.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the table is malformed.
+ */
+extern PrimStatus elf64_gnu_hash_parse(Elf64_Gnu_Hash_Table* table,
+    const void* data, Elf64_Xword size, Elf64_Word symbol_count);
+
+/**
+ * Check the bloom filter for a hash.
+ *
+ * @param table The table to check.
+ * @param hash The hash of the name to look for.
+ * @return STATUS_INVALID if the table certainly has no symbol with the hash,
+ * STATUS_OKAY if it may have one.
+ */
+extern PrimStatus elf64_gnu_hash_may_contain(
+    const Elf64_Gnu_Hash_Table* table, Elf64_Word hash);
+
+#endif
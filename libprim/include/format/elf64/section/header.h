@@ -12,6 +12,7 @@
 #ifndef FORMAT_ELF64_SECTION_HEADER_H
 #define FORMAT_ELF64_SECTION_HEADER_H
 
+#include "accessor.h"
 #include "format/elf64/types.h"
 #include "status.h"
 
@@ -67,7 +68,8 @@ typedef struct
  * @param A pointer to the ELF64 section header.
  * @return The ELF64 object type.
  */
-extern Elf64_Word elf64_get_section_name(const ELF64_Section_Header* header);
+PRIM_ACCESSOR Elf64_Word elf64_get_section_name(
+    const ELF64_Section_Header* header);
 
 /**
  * Get the load address of an ELF64 section.
@@ -75,7 +77,7 @@ extern Elf64_Word elf64_get_section_name(const ELF64_Section_Header* header);
  * @param header The ELF64 section header to read.
  * @return The address to load the section into.
  */
-extern Elf64_Address elf64_get_section_address(
+PRIM_ACCESSOR Elf64_Address elf64_get_section_address(
     const ELF64_Section_Header* header);
 
 /**
@@ -84,7 +86,7 @@ extern Elf64_Address elf64_get_section_address(
  * @param header The ELF64 section header to read.
  * @return The offset for the data the heder refers to.
  */
-extern Elf64_Offset elf64_get_section_offset(
+PRIM_ACCESSOR Elf64_Offset elf64_get_section_offset(
     const ELF64_Section_Header* header);
 
 /**
@@ -93,7 +95,8 @@ extern Elf64_Offset elf64_get_section_offset(
  * @param header The ELF64 section header to read.
  * @return The length of the section's data, in bytes.
  */
-extern Elf64_Xword elf64_get_section_size(const ELF64_Section_Header* header);
+PRIM_ACCESSOR Elf64_Xword elf64_get_section_size(
+    const ELF64_Section_Header* header);
 
 /**
  * Get an ELF64 section's link table index.
@@ -101,7 +104,7 @@ extern Elf64_Xword elf64_get_section_size(const ELF64_Section_Header* header);
  * @param header the ELF64 section header to read.
  * @return The section's link table index.
  */
-extern Elf64_Word elf64_get_section_link_table_index(
+PRIM_ACCESSOR Elf64_Word elf64_get_section_link_table_index(
     const ELF64_Section_Header* header);
 
 /**
@@ -110,7 +113,7 @@ extern Elf64_Word elf64_get_section_link_table_index(
  * @param header The ELF64 section header to read.
  * @return The section's extra information. Semantics are CPU dependent.
  */
-extern Elf64_Word elf64_get_section_extra_info(
+PRIM_ACCESSOR Elf64_Word elf64_get_section_extra_info(
     const ELF64_Section_Header* header);
 
 /**
@@ -119,7 +122,7 @@ extern Elf64_Word elf64_get_section_extra_info(
  * @param header The ELF64 section header to read.
  * @return The section's mandatory data alignment.
  */
-extern Elf64_Xword elf64_get_section_alignment(
+PRIM_ACCESSOR Elf64_Xword elf64_get_section_alignment(
     const ELF64_Section_Header* header);
 
 /**
@@ -128,7 +131,59 @@ extern Elf64_Xword elf64_get_section_alignment(
  * @param header The ELF64 section header to read.
  * @return The section's fixed entry size.
  */
-extern Elf64_Xword elf64_get_section_entry_size(
+PRIM_ACCESSOR Elf64_Xword elf64_get_section_entry_size(
     const ELF64_Section_Header* header);
 
+#ifdef PRIM_ACCESSORS_INLINE
+
+static inline Elf64_Word elf64_get_section_name(
+    const ELF64_Section_Header* header)
+{
+    return header->name;
+}
+
+static inline Elf64_Address elf64_get_section_address(
+    const ELF64_Section_Header* header)
+{
+    return header->address;
+}
+
+static inline Elf64_Offset elf64_get_section_offset(
+    const ELF64_Section_Header* header)
+{
+    return header->offset;
+}
+
+static inline Elf64_Xword elf64_get_section_size(
+    const ELF64_Section_Header* header)
+{
+    return header->size;
+}
+
+static inline Elf64_Word elf64_get_section_link_table_index(
+    const ELF64_Section_Header* header)
+{
+    return header->link;
+}
+
+static inline Elf64_Word elf64_get_section_extra_info(
+    const ELF64_Section_Header* header)
+{
+    return header->info;
+}
+
+static inline Elf64_Xword elf64_get_section_alignment(
+    const ELF64_Section_Header* header)
+{
+    return header->address_align;
+}
+
+static inline Elf64_Xword elf64_get_section_entry_size(
+    const ELF64_Section_Header* header)
+{
+    return header->entry_size;
+}
+
+#endif
+
 #endif
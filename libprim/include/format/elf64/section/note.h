@@ -0,0 +1,82 @@
+/**
+ * @file include/format/elf64/section/note.h
+ *
+ * `note.h` defines the note format used by ELF64, stored in
+ * `ELF64_SECTION_TYPE_NOTE` sections and `ELF64_PT_NOTE` segments.
+ *
+ * A note area is a sequence of notes. Each note is a header, followed by the
+ * owner's name and then the note's descriptor, each padded to a multiple of
+ * four bytes.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef FORMAT_ELF64_SECTION_NOTE_H
+#define FORMAT_ELF64_SECTION_NOTE_H
+
+#include "format/elf64/types.h"
+#include "status.h"
+
+/** Owner name of notes defined by the GNU toolchain. */
+#define ELF64_NOTE_GNU "GNU"
+
+/** GNU note type holding a unique build identifier. */
+#define ELF64_NT_GNU_BUILD_ID 3
+
+/** Owner name of notes written into core files by Linux. */
+#define ELF64_NOTE_CORE "CORE"
+
+/** Core note type holding a thread's status and registers. */
+#define ELF64_NT_PRSTATUS 1
+
+/** Core note type listing the files mapped into the process. */
+#define ELF64_NT_FILE 0x46494c45
+
+/** The header at the start of each note. */
+typedef struct
+{
+    /** Length of the owner's name, including its terminator. */
+    Elf64_Word name_size;
+
+    /** Length of the descriptor, in bytes. */
+    Elf64_Word descriptor_size;
+
+    /** The note's type. Meaning depends on the owner. */
+    Elf64_Word type;
+} Elf64_Note;
+
+/**
+ * Step to the next note in a note area.
+ *
+ * @param data The note area. Four byte aligned.
+ * @param size Length of the note area, in bytes.
+ * @param offset Offset of the note to read. Advanced past it on success.
+ * @param note Location to return the note's header. Its owner's name follows
+ * the header.
+ * @param descriptor Location to return the note's descriptor.
+ * @return STATUS_OKAY on success, STATUS_INVALID at the end of the area or if
+ * the note is malformed.
+ */
+extern PrimStatus elf64_note_next(const Elf64_Byte* data, Elf64_Xword size,
+    Elf64_Xword* offset, const Elf64_Note** note,
+    const Elf64_Byte** descriptor);
+
+/**
+ * Find a note in a note area.
+ *
+ * @param data The note area. Four byte aligned.
+ * @param size Length of the note area, in bytes.
+ * @param name The owner's name.
+ * @param type The note's type.
+ * @param result Location to return the note's descriptor.
+ * @param result_size Location to return the descriptor's length.
+ * @return STATUS_OKAY if the note is found, STATUS_INVALID if it is not or
+ * the area is malformed.
+ */
+extern PrimStatus elf64_note_find(const Elf64_Byte* data, Elf64_Xword size,
+    const char* name, Elf64_Word type, const Elf64_Byte** result,
+    Elf64_Word* result_size);
+
+#endif
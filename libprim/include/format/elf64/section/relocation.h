@@ -0,0 +1,124 @@
+/**
+ * @file include/format/elf64/section/relocation.h
+ *
+ * `relocation.h` defines the ELF64 relocation entry format, stored in
+ * `ELF64_SECTION_TYPE_RELOC_A` sections, and the AMD64 relocation types.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef FORMAT_ELF64_SECTION_RELOCATION_H
+#define FORMAT_ELF64_SECTION_RELOCATION_H
+
+#include "accessor.h"
+#include "format/elf64/types.h"
+#include "status.h"
+
+/** A relocation with an explicit addend. */
+typedef struct
+{
+    /** The link time address of the location to relocate. */
+    Elf64_Address offset;
+
+    /** The relocation's symbol index and type. */
+    Elf64_Xword info;
+
+    /** A constant used to compute the relocated value. */
+    Elf64_Sxword addend;
+} Elf64_Relocation;
+
+/**
+ * AMD64 relocation types.
+ *
+ * Only the types found in executables and shared objects are listed. The
+ * remainder are resolved by the static linker.
+ */
+typedef enum Elf64_Relocation_Type
+{
+    /** No relocation. */
+    ELF64_R_X86_64_NONE = 0,
+
+    /** Symbol value plus addend. */
+    ELF64_R_X86_64_64 = 1,
+
+    /** Copy the symbol's data from a shared object into the executable. */
+    ELF64_R_X86_64_COPY = 5,
+
+    /** Symbol value, into a global offset table entry. */
+    ELF64_R_X86_64_GLOB_DAT = 6,
+
+    /** Symbol value, into a procedure linkage table entry. */
+    ELF64_R_X86_64_JUMP_SLOT = 7,
+
+    /** Load bias plus addend. */
+    ELF64_R_X86_64_RELATIVE = 8,
+
+    /** Module ID of the symbol's thread local storage block. */
+    ELF64_R_X86_64_DTPMOD64 = 16,
+
+    /** Offset of the symbol in its thread local storage block. */
+    ELF64_R_X86_64_DTPOFF64 = 17,
+
+    /** Offset of the symbol from the thread pointer. */
+    ELF64_R_X86_64_TPOFF64 = 18,
+
+    /** Result of calling the resolver at load bias plus addend. */
+    ELF64_R_X86_64_IRELATIVE = 37,
+} Elf64_Relocation_Type;
+
+/**
+ * Get the symbol table index of a relocation's symbol.
+ *
+ * @param relocation The relocation to read.
+ * @return The index of the symbol in the dynamic symbol table.
+ */
+PRIM_ACCESSOR Elf64_Word elf64_get_relocation_symbol(
+    const Elf64_Relocation* relocation);
+
+/**
+ * Get the type of a relocation.
+ *
+ * @note elf64_get_relocation_type does not check if the value is valid. See
+ * `elf64_is_relocation_type_valid`.
+ *
+ * @param relocation The relocation to read.
+ * @return The relocation's type.
+ */
+PRIM_ACCESSOR Elf64_Relocation_Type elf64_get_relocation_type(
+    const Elf64_Relocation* relocation);
+
+/**
+ * Get a string with a human readable relocation type name.
+ *
+ * @param type The relocation type to string-ify.
+ * @return A human readable relocation type name.
+ */
+extern const char* elf64_get_relocation_type_string(Elf64_Relocation_Type type);
+
+/**
+ * Checks if a relocation type is one Prim understands.
+ *
+ * @param type A relocation type to test.
+ * @return `STATUS_OKAY` if the type is valid, `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus elf64_is_relocation_type_valid(Elf64_Relocation_Type type);
+
+#ifdef PRIM_ACCESSORS_INLINE
+
+static inline Elf64_Word elf64_get_relocation_symbol(
+    const Elf64_Relocation* relocation)
+{
+    return (Elf64_Word) (relocation->info >> 32U);
+}
+
+static inline Elf64_Relocation_Type elf64_get_relocation_type(
+    const Elf64_Relocation* relocation)
+{
+    return (Elf64_Relocation_Type) (relocation->info & 0xffffffffU);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ * @file include/format/elf64/section/symbol.h
+ *
+ * `symbol.h` defines the symbol table entry format used by ELF64, and
+ * provides definitions for accessing and reading symbols.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef FORMAT_ELF64_SECTION_SYMBOL_H
+#define FORMAT_ELF64_SECTION_SYMBOL_H
+
+#include "accessor.h"
+#include "format/elf64/types.h"
+#include "status.h"
+
+typedef struct
+{
+    /** Index into the symbol string table, which provides the symbol name. */
+    Elf64_Word name;
+
+    /** Symbol type and binding attributes. */
+    Elf64_Byte info;
+
+    /** Symbol visibility. */
+    Elf64_Byte other;
+
+    /** Index of the section the symbol is defined in. */
+    Elf64_Section section;
+
+    /** Value of the symbol: usually an address. */
+    Elf64_Address value;
+
+    /** Size of the object the symbol refers to, or 0. */
+    Elf64_Xword size;
+} Elf64_Symbol;
+
+/** Symbol type encoding for ELF64 binaries. */
+typedef enum Elf64_Symbol_Type
+{
+    /** Unspecified type. */
+    ELF64_STT_NOTYPE = 0,
+
+    /** Data object: a variable, array... */
+    ELF64_STT_OBJECT = 1,
+
+    /** Function or other executable code. */
+    ELF64_STT_FUNC = 2,
+
+    /** Section, for relocation. */
+    ELF64_STT_SECTION = 3,
+
+    /** Source file name. */
+    ELF64_STT_FILE = 4,
+
+    /** Uninitialised common block. */
+    ELF64_STT_COMMON = 5,
+
+    /** Thread local storage object. */
+    ELF64_STT_TLS = 6,
+
+    /** GNU indirect function, resolved at load time. */
+    ELF64_STT_GNU_IFUNC = 10,
+} Elf64_Symbol_Type;
+
+/** Symbol binding encoding for ELF64 binaries. */
+typedef enum Elf64_Symbol_Binding
+{
+    /** Not visible outside the defining object. */
+    ELF64_STB_LOCAL = 0,
+
+    /** Visible to all objects. */
+    ELF64_STB_GLOBAL = 1,
+
+    /** Visible to all objects, with lower precedence than global symbols. */
+    ELF64_STB_WEAK = 2,
+
+    /** GNU unique symbol: one definition per process. */
+    ELF64_STB_GNU_UNIQUE = 10,
+} Elf64_Symbol_Binding;
+
+/** Section index of undefined symbols. */
+#define ELF64_SHN_UNDEF 0
+
+/** Section index of symbols with absolute values. */
+#define ELF64_SHN_ABS 0xfff1
+
+/** Section index of common symbols. */
+#define ELF64_SHN_COMMON 0xfff2
+
+/**
+ * Extract the ELF64 symbol name index.
+ *
+ * @note `elf64_get_symbol_name` returns an index into the symbol string
+ * table, not the string name.
+ *
+ * @param symbol The symbol to read.
+ * @return The index of the symbol's name in the symbol string table.
+ */
+PRIM_ACCESSOR Elf64_Word elf64_get_symbol_name(const Elf64_Symbol* symbol);
+
+/**
+ * Get the value of an ELF64 symbol.
+ *
+ * @param symbol The symbol to read.
+ * @return The symbol's value. For defined symbols in executables and shared
+ * objects, this is the link time virtual address.
+ */
+PRIM_ACCESSOR Elf64_Address elf64_get_symbol_value(const Elf64_Symbol* symbol);
+
+/**
+ * Get the size of the object an ELF64 symbol refers to.
+ *
+ * @param symbol The symbol to read.
+ * @return The size of the object in bytes, or 0 if unknown.
+ */
+PRIM_ACCESSOR Elf64_Xword elf64_get_symbol_size(const Elf64_Symbol* symbol);
+
+/**
+ * Get the index of the section an ELF64 symbol is defined in.
+ *
+ * @param symbol The symbol to read.
+ * @return The section index, or one of the `ELF64_SHN_*` special values.
+ */
+PRIM_ACCESSOR Elf64_Section elf64_get_symbol_section(
+    const Elf64_Symbol* symbol);
+
+/**
+ * Extract the type of an ELF64 symbol.
+ *
+ * @note elf64_get_symbol_type does not check if the value is valid. See
+ * `elf64_is_symbol_type_valid`.
+ *
+ * @param symbol The symbol to read.
+ * @return The symbol's type.
+ */
+PRIM_ACCESSOR Elf64_Symbol_Type elf64_get_symbol_type(
+    const Elf64_Symbol* symbol);
+
+/**
+ * Extract the binding of an ELF64 symbol.
+ *
+ * @param symbol The symbol to read.
+ * @return The symbol's binding.
+ */
+PRIM_ACCESSOR Elf64_Symbol_Binding elf64_get_symbol_binding(
+    const Elf64_Symbol* symbol);
+
+/**
+ * Get a string with a human readable symbol type name.
+ *
+ * @param type The symbol type to string-ify.
+ * @return A human readable symbol type name.
+ */
+extern const char* elf64_get_symbol_type_string(Elf64_Symbol_Type type);
+
+/**
+ * Checks if an ELF64 symbol type is a valid type code.
+ *
+ * @param type A symbol type to test.
+ * @return `STATUS_OKAY` if the type is valid, `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus elf64_is_symbol_type_valid(Elf64_Symbol_Type type);
+
+#ifdef PRIM_ACCESSORS_INLINE
+
+static inline Elf64_Word elf64_get_symbol_name(const Elf64_Symbol* symbol)
+{
+    return symbol->name;
+}
+
+static inline Elf64_Address elf64_get_symbol_value(const Elf64_Symbol* symbol)
+{
+    return symbol->value;
+}
+
+static inline Elf64_Xword elf64_get_symbol_size(const Elf64_Symbol* symbol)
+{
+    return symbol->size;
+}
+
+static inline Elf64_Section elf64_get_symbol_section(const Elf64_Symbol* symbol)
+{
+    return symbol->section;
+}
+
+static inline Elf64_Symbol_Type elf64_get_symbol_type(
+    const Elf64_Symbol* symbol)
+{
+    return (Elf64_Symbol_Type) (symbol->info & 0xfU);
+}
+
+static inline Elf64_Symbol_Binding elf64_get_symbol_binding(
+    const Elf64_Symbol* symbol)
+{
+    return (Elf64_Symbol_Binding) (symbol->info >> 4U);
+}
+
+#endif
+
+#endif
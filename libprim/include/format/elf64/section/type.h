@@ -11,6 +11,7 @@
 #ifndef FORMAT_ELF64_SECTION_TYPE_H
 #define FORMAT_ELF64_SECTION_TYPE_H
 
+#include "accessor.h"
 #include "format/elf64/section/header.h"
 
 /**
@@ -64,6 +65,9 @@ typedef Elf64_Word ELF64_Section_Type;
 /** Termination function table. */
 #define ELF64_SECTION_TYPE_FINI_ARRAY 0xf
 
+/** GNU style symbol hash table. */
+#define ELF64_SECTION_TYPE_GNU_HASH 0x6ffffff6
+
 /** GNU style symbol version provisions. */
 #define ELF64_SECTION_TYPE_GNU_VER_DEF 0x6ffffffd
 
@@ -94,7 +98,7 @@ typedef Elf64_Word ELF64_Section_Type;
  * @param A pointer to the ELF64 section header.
  * @return The ELF64 object type.
  */
-extern ELF64_Section_Type elf64_get_section_type(
+PRIM_ACCESSOR ELF64_Section_Type elf64_get_section_type(
     const ELF64_Section_Header* header);
 
 /**
@@ -114,4 +118,14 @@ extern const char* elf64_get_section_type_string(ELF64_Section_Type type);
  */
 extern PrimStatus elf64_is_section_type_valid(ELF64_Section_Type type);
 
+#ifdef PRIM_ACCESSORS_INLINE
+
+static inline ELF64_Section_Type elf64_get_section_type(
+    const ELF64_Section_Header* header)
+{
+    return (ELF64_Section_Type) header->type;
+}
+
+#endif
+
 #endif
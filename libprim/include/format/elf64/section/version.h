@@ -0,0 +1,135 @@
+/**
+ * @file include/format/elf64/section/version.h
+ *
+ * `version.h` defines the GNU symbol versioning formats.
+ *
+ * `ELF64_SECTION_TYPE_GNU_VER_DEF` sections list the versions an image
+ * defines, and `ELF64_SECTION_TYPE_GNU_VER_REQ` sections list the versions
+ * it requires from each needed library. Both give each version a small index.
+ * `ELF64_SECTION_TYPE_GNU_VER_SYM` sections hold one index per dynamic
+ * symbol, naming the version the symbol defines or requires.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef FORMAT_ELF64_SECTION_VERSION_H
+#define FORMAT_ELF64_SECTION_VERSION_H
+
+#include "format/elf64/types.h"
+#include "status.h"
+
+/** Version index of local symbols. */
+#define ELF64_VER_NDX_LOCAL 0
+
+/** Version index of unversioned global symbols. */
+#define ELF64_VER_NDX_GLOBAL 1
+
+/** Mask of the version index in a symbol's version entry. */
+#define ELF64_VERSYM_INDEX 0x7fff
+
+/** Marks a symbol's version entry as hidden: not the default version. */
+#define ELF64_VERSYM_HIDDEN 0x8000
+
+/** Marks the version definition naming the image itself. */
+#define ELF64_VER_FLG_BASE 0x1
+
+/** Marks a weak version definition or requirement. */
+#define ELF64_VER_FLG_WEAK 0x2
+
+/** A version definition, chained to the next by `next`. */
+typedef struct
+{
+    /** Structure revision. Always one. */
+    Elf64_Half version;
+
+    /** Bitfield of `ELF64_VER_FLG_*` flags. */
+    Elf64_Half flags;
+
+    /** The version's index. */
+    Elf64_Half index;
+
+    /** Number of `Elf64_Version_Definition_Name` entries. */
+    Elf64_Half count;
+
+    /** ELF hash of the version's name. */
+    Elf64_Word hash;
+
+    /** Offset from this entry to its first name. */
+    Elf64_Word aux;
+
+    /** Offset from this entry to the next, or zero if it is the last. */
+    Elf64_Word next;
+} Elf64_Version_Definition;
+
+/** A version definition's name. The first is the version itself. */
+typedef struct
+{
+    /** The name's string table offset. */
+    Elf64_Word name;
+
+    /** Offset from this entry to the next, or zero if it is the last. */
+    Elf64_Word next;
+} Elf64_Version_Definition_Name;
+
+/** The versions required from a needed library, chained by `next`. */
+typedef struct
+{
+    /** Structure revision. Always one. */
+    Elf64_Half version;
+
+    /** Number of `Elf64_Version_Need_Entry` entries. */
+    Elf64_Half count;
+
+    /** The needed library's string table offset. */
+    Elf64_Word file;
+
+    /** Offset from this entry to its first required version. */
+    Elf64_Word aux;
+
+    /** Offset from this entry to the next, or zero if it is the last. */
+    Elf64_Word next;
+} Elf64_Version_Need;
+
+/** A version required from a needed library. */
+typedef struct
+{
+    /** ELF hash of the version's name. */
+    Elf64_Word hash;
+
+    /** Bitfield of `ELF64_VER_FLG_*` flags. */
+    Elf64_Half flags;
+
+    /** The index symbols use to require the version. */
+    Elf64_Half index;
+
+    /** The version name's string table offset. */
+    Elf64_Word name;
+
+    /** Offset from this entry to the next, or zero if it is the last. */
+    Elf64_Word next;
+} Elf64_Version_Need_Entry;
+
+/**
+ * Get the version index from a symbol's version entry.
+ *
+ * @param entry The symbol's entry in the `ELF64_SECTION_TYPE_GNU_VER_SYM`
+ * section.
+ * @return The version index.
+ */
+extern Elf64_Half elf64_get_version_index(Elf64_Half entry);
+
+/**
+ * Checks if a symbol's version entry is hidden.
+ *
+ * Hidden definitions are only found by references to their exact version.
+ * Unversioned references find the default version.
+ *
+ * @param entry The symbol's entry in the `ELF64_SECTION_TYPE_GNU_VER_SYM`
+ * section.
+ * @return `STATUS_OKAY` if the version is hidden, `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus elf64_is_version_hidden(Elf64_Half entry);
+
+#endif
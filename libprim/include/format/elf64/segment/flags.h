@@ -11,6 +11,7 @@
 #ifndef FORMAT_ELF64_SEGMENT_FLAGS_H
 #define FORMAT_ELF64_SEGMENT_FLAGS_H
 
+#include "accessor.h"
 #include "format/elf64/segment/header.h"
 #include "format/elf64/types.h"
 #include "status.h"
@@ -54,7 +55,7 @@ typedef Elf64_Xword Elf64_Segment_Flag;
  * @param header Pointer to the ELF64 segment header.
  * @return The bitfield containing the segment flags.
  */
-extern Elf64_Segment_Flag elf64_get_segment_flags(
+PRIM_ACCESSOR Elf64_Segment_Flag elf64_get_segment_flags(
     const Elf64_Segment_Header* header);
 
 /**
@@ -73,4 +74,14 @@ extern const char* elf64_get_segment_flag_string(Elf64_Segment_Flag flag);
  */
 extern PrimStatus elf64_is_segment_flag_valid(Elf64_Segment_Flag flag);
 
+#ifdef PRIM_ACCESSORS_INLINE
+
+static inline Elf64_Segment_Flag elf64_get_segment_flags(
+    const Elf64_Segment_Header* header)
+{
+    return header->p_flags;
+}
+
+#endif
+
 #endif
@@ -12,6 +12,7 @@
 #ifndef FORMAT_ELF64_SEGMENT_HEADER_H
 #define FORMAT_ELF64_SEGMENT_HEADER_H
 
+#include "accessor.h"
 #include "format/elf64/types.h"
 
 typedef struct
@@ -48,7 +49,7 @@ typedef struct
  * @param header The segment header.
  * @return The offset of the segment data in the ELF file.
  */
-extern Elf64_Offset elf64_get_segment_offset(
+PRIM_ACCESSOR Elf64_Offset elf64_get_segment_offset(
     const Elf64_Segment_Header* header);
 
 /**
@@ -57,7 +58,7 @@ extern Elf64_Offset elf64_get_segment_offset(
  * @param header The segment header.
  * @return The virtual address of the segment when loaded into memory.
  */
-extern Elf64_Address elf64_get_segment_vaddr(
+PRIM_ACCESSOR Elf64_Address elf64_get_segment_vaddr(
     const Elf64_Segment_Header* header);
 
 /**
@@ -66,7 +67,7 @@ extern Elf64_Address elf64_get_segment_vaddr(
  * @param header The segment header.
  * @return The physical address of the segment when loaded into memory.
  */
-extern Elf64_Address elf64_get_segment_paddr(
+PRIM_ACCESSOR Elf64_Address elf64_get_segment_paddr(
     const Elf64_Segment_Header* header);
 
 /**
@@ -75,7 +76,7 @@ extern Elf64_Address elf64_get_segment_paddr(
  * @param header The segment header.
  * @return The size of the segment when reading from the file.
  */
-extern Elf64_Address elf64_get_segment_fsize(
+PRIM_ACCESSOR Elf64_Address elf64_get_segment_fsize(
     const Elf64_Segment_Header* header);
 
 /**
@@ -84,7 +85,7 @@ extern Elf64_Address elf64_get_segment_fsize(
  * @param header The segment header.
  * @return The size of the segment when loaded into memory.
  */
-extern Elf64_Address elf64_get_segment_msize(
+PRIM_ACCESSOR Elf64_Address elf64_get_segment_msize(
     const Elf64_Segment_Header* header);
 
 /**
@@ -93,7 +94,47 @@ extern Elf64_Address elf64_get_segment_msize(
  * @param header The segment header.
  * @return The alignment required when loaded into memory.
  */
-extern Elf64_Address elf64_get_segment_align(
+PRIM_ACCESSOR Elf64_Address elf64_get_segment_align(
     const Elf64_Segment_Header* header);
 
+#ifdef PRIM_ACCESSORS_INLINE
+
+static inline Elf64_Offset elf64_get_segment_offset(
+    const Elf64_Segment_Header* header)
+{
+    return header->p_offset;
+}
+
+static inline Elf64_Address elf64_get_segment_vaddr(
+    const Elf64_Segment_Header* header)
+{
+    return header->p_vaddr;
+}
+
+static inline Elf64_Address elf64_get_segment_paddr(
+    const Elf64_Segment_Header* header)
+{
+    return header->p_paddr;
+}
+
+static inline Elf64_Address elf64_get_segment_fsize(
+    const Elf64_Segment_Header* header)
+{
+    return header->p_filesz;
+}
+
+static inline Elf64_Address elf64_get_segment_msize(
+    const Elf64_Segment_Header* header)
+{
+    return header->p_memsz;
+}
+
+static inline Elf64_Address elf64_get_segment_align(
+    const Elf64_Segment_Header* header)
+{
+    return header->p_align;
+}
+
+#endif
+
 #endif
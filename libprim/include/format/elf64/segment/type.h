@@ -12,6 +12,7 @@
 #ifndef FORMAT_ELF64_SEGMENT_TYPE_H
 #define FORMAT_ELF64_SEGMENT_TYPE_H
 
+#include "accessor.h"
 #include "format/elf64/segment/header.h"
 #include "format/elf64/types.h"
 #include "status.h"
@@ -40,9 +41,15 @@ typedef enum Elf64_Type
     /** Program header segment. */
     ELF64_PT_PHDR = 6,
 
+    /** Thread local storage initialisation image. */
+    ELF64_PT_TLS = 7,
+
     /** First OS specific value. */
     ELF64_PT_LOOS = 0x60000000,
 
+    /** Read only after relocation segment. */
+    ELF64_PT_GNU_RELRO = 0x6474e552,
+
     /** Last OS specific value. */
     ELF64_PT_HIOS = 0x6fffffff,
 
@@ -62,7 +69,7 @@ typedef enum Elf64_Type
  * @param A pointer to the ELF64 segment header.
  * @return The ELF64 segment types.
  */
-extern Elf64_Segment_Type elf64_get_segment_type(
+PRIM_ACCESSOR Elf64_Segment_Type elf64_get_segment_type(
     const Elf64_Segment_Header* header);
 
 /**
@@ -81,4 +88,14 @@ extern const char* efl64_get_segment_type_string(Elf64_Segment_Type type);
  */
 extern PrimStatus efl64_is_segment_type_valid(Elf64_Segment_Type type);
 
+#ifdef PRIM_ACCESSORS_INLINE
+
+static inline Elf64_Segment_Type elf64_get_segment_type(
+    const Elf64_Segment_Header* header)
+{
+    return (Elf64_Segment_Type) header->p_type;
+}
+
+#endif
+
 #endif
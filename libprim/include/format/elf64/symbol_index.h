@@ -0,0 +1,218 @@
+/**
+ * @file include/format/elf64/symbol_index.h
+ *
+ * `symbol_index.h` builds and queries an on-disk index of the global symbols
+ * many binaries define and import, so the binaries using a symbol are found
+ * without opening any of them.
+ *
+ * An index holds a record per binary, then postings pairing a symbol name
+ * with a binary that defines or imports it. Postings are sorted by the GNU
+ * hash of their name, and a bucket table over the top bits of the hash
+ * gives the postings of each bucket, so a lookup is one bucket read and a
+ * short scan of the mapped file. Names are stored once, however many
+ * binaries use them.
+ *
+ * Binaries are indexed from their dynamic symbol table, or from their static
+ * symbol table if they have no dynamic one, and are parsed in parallel. An
+ * index can be rebuilt from an older one, which acts as a manifest of the
+ * binaries it holds: binaries whose identity (device, inode, size and
+ * modification time) is unchanged keep their postings after only a `stat`,
+ * binaries whose identity has changed but whose GNU build ID has not, such
+ * as those reinstalled from the same package, keep them after only their
+ * notes are read, and only the rest have their symbols parsed again.
+ *
+ * @note Indexes are native endian.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef FORMAT_ELF64_SYMBOL_INDEX_H
+#define FORMAT_ELF64_SYMBOL_INDEX_H
+
+#include "format/elf64/types.h"
+#include "platform/file.h"
+#include "platform/mapping.h"
+#include "platform/types.h"
+#include "status.h"
+
+/** First bytes of every symbol index. */
+#define ELF64_SYMBOL_INDEX_MAGIC "PRIMSYMS"
+
+/** Format version written by `elf64_symbol_index_save`. */
+#define ELF64_SYMBOL_INDEX_VERSION 2
+
+/** Longest build ID recorded in full. Longer IDs are recorded by prefix. */
+#define ELF64_SYMBOL_INDEX_BUILD_ID_MAX 32
+
+/** The binary defines the symbol. Otherwise, it imports it. */
+#define ELF64_SYMBOL_INDEX_DEFINED 0x1
+
+/** The symbol is bound weakly. */
+#define ELF64_SYMBOL_INDEX_WEAK 0x2
+
+/** The symbol is from the binary's dynamic symbol table. */
+#define ELF64_SYMBOL_INDEX_DYNAMIC 0x4
+
+/** The start of a symbol index. */
+typedef struct
+{
+    /** `ELF64_SYMBOL_INDEX_MAGIC`, without its terminator. */
+    char magic[8];
+
+    /** `ELF64_SYMBOL_INDEX_VERSION`. */
+    prim_u32 version;
+
+    /** Right shift taking a name hash to its bucket. At most 32. */
+    prim_u32 bucket_shift;
+
+    /** Number of `Elf64_Symbol_Index_File` records following the header. */
+    prim_u64 file_count;
+
+    /**
+     * Number of buckets. The bucket table following the files holds one more
+     * entry than this, so each bucket's postings end where the next's start.
+     */
+    prim_u64 bucket_count;
+
+    /** Number of `Elf64_Symbol_Index_Posting` records following the buckets. */
+    prim_u64 posting_count;
+
+    /** Length of the string table following the postings, in bytes. */
+    prim_u64 string_size;
+} Elf64_Symbol_Index_Header;
+
+/** A binary in a symbol index. */
+typedef struct
+{
+    /** The identity of the binary when it was indexed. */
+    PrimFileIdentity identity;
+
+    /** Offset of the binary's path in the string table. */
+    prim_u64 path;
+
+    /** Number of postings for the binary. Zero if it is not an ELF64 binary. */
+    prim_u64 symbol_count;
+
+    /** The binary's build ID when it was indexed. */
+    Elf64_Byte build_id[ELF64_SYMBOL_INDEX_BUILD_ID_MAX];
+
+    /** Length of `build_id`. Zero if the binary has no build ID. */
+    prim_u32 build_id_size;
+
+    /** Reserved. Zero. */
+    prim_u32 reserved;
+} Elf64_Symbol_Index_File;
+
+/** A symbol used by a binary. */
+typedef struct
+{
+    /** The `elf64_gnu_hash` of the symbol's name. */
+    Elf64_Word hash;
+
+    /** `ELF64_SYMBOL_INDEX_*` flags describing the use. */
+    prim_u32 flags;
+
+    /** Index of the binary's record. */
+    prim_u64 file;
+
+    /** Offset of the symbol's name in the string table. */
+    prim_u64 name;
+} Elf64_Symbol_Index_Posting;
+
+/** A symbol index opened for queries. */
+typedef struct Elf64_Symbol_Index
+{
+    /** The mapped file. */
+    PrimMapping mapping;
+
+    /** The file's header. */
+    const Elf64_Symbol_Index_Header* header;
+
+    /** The file's binary records. */
+    const Elf64_Symbol_Index_File* files;
+
+    /** Index of each bucket's first posting, and of the end of the last. */
+    const prim_u64* buckets;
+
+    /** The file's postings, sorted by name hash then name. */
+    const Elf64_Symbol_Index_Posting* postings;
+
+    /** The file's string table. */
+    const char* strings;
+} Elf64_Symbol_Index;
+
+/**
+ * Open a symbol index.
+ *
+ * @param index Location to return the opened index.
+ * @param path The index file.
+ * @return STATUS_OKAY on success, STATUS_INVALID if it is malformed,
+ * otherwise an error code. Nothing is left open on failure.
+ */
+extern PrimStatus elf64_symbol_index_open(
+    Elf64_Symbol_Index* index, const char* path);
+
+/**
+ * Find the postings for a symbol name.
+ *
+ * Postings for one name are adjacent, and ordered by binary.
+ *
+ * @param index The index.
+ * @param name The symbol name to find.
+ * @param first Location to return the index of the name's first posting.
+ * @param count Location to return the number of postings for the name. Zero
+ * if no binary uses it.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the postings searched
+ * are malformed.
+ */
+extern PrimStatus elf64_symbol_index_find(const Elf64_Symbol_Index* index,
+    const char* name, prim_usize* first, prim_usize* count);
+
+/**
+ * Get the path of a binary in an index.
+ *
+ * @param index The index.
+ * @param file Index of the binary's record, from a posting `find` returned.
+ * @return The binary's path.
+ */
+extern const char* elf64_symbol_index_get_path(
+    const Elf64_Symbol_Index* index, prim_u64 file);
+
+/**
+ * Close a symbol index.
+ *
+ * @param index The index to close.
+ */
+extern void elf64_symbol_index_close(Elf64_Symbol_Index* index);
+
+/**
+ * Index the symbols of a list of binaries, and save them to a symbol index.
+ *
+ * With a previous index, every binary it holds is indexed too: those whose
+ * identity or build ID is unchanged keep their postings without their
+ * symbols being parsed, those which have changed are parsed again, and those
+ * which no longer exist are dropped. Paths are indexed once, however often
+ * they are given. Binaries are checked and parsed in parallel.
+ *
+ * Files which cannot be read are skipped, and files which are not ELF64
+ * binaries are recorded with no symbols, so later updates pass over them.
+ *
+ * The file is written beside `path` and then renamed over it, so the
+ * previous index may be the one being replaced, and processes with an older
+ * index mapped keep a consistent copy.
+ *
+ * @param path The index file to write.
+ * @param files Paths of the binaries to index.
+ * @param file_count Number of paths in `files`.
+ * @param previous An index to update, or `NULL`.
+ * @param scanned Location to return the number of binaries whose symbols
+ * were parsed, or `NULL`.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_symbol_index_save(const char* path,
+    const char* const* files, prim_usize file_count,
+    const Elf64_Symbol_Index* previous, prim_usize* scanned);
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @file include/format/zlib/inflate.h
+ *
+ * `inflate.h` decompresses DEFLATE streams (RFC 1951), and the zlib streams
+ * wrapping them (RFC 1950), such as compressed ELF64 debug sections.
+ *
+ * Decompression is one shot: the whole stream is in memory, and is inflated
+ * into a buffer the caller sized from the stream's container, so no window
+ * or state is kept between calls. Huffman codes are decoded through a lookup
+ * table indexed by the next few bits of input, falling back to a canonical
+ * code search only for the rare long codes. Matches are copied a word at a
+ * time wherever they do not overlap themselves.
+ *
+ * @note The bit reader loads input a word at a time, and assumes a little
+ * endian host.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef FORMAT_ZLIB_INFLATE_H
+#define FORMAT_ZLIB_INFLATE_H
+
+#include "platform/types.h"
+#include "status.h"
+
+/**
+ * Inflate a raw DEFLATE stream.
+ *
+ * @param source The compressed stream.
+ * @param source_size Length of the compressed stream, in bytes.
+ * @param destination Location to write the uncompressed data.
+ * @param destination_size Length of `destination`, in bytes.
+ * @param result_size Location to return the length of the uncompressed data.
+ * @param consumed Location to return the number of bytes of `source` the
+ * stream used, or `NULL`.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the stream is malformed or
+ * does not fit in `destination`.
+ */
+extern PrimStatus zlib_inflate(const prim_u8* source, prim_usize source_size,
+    prim_u8* destination, prim_usize destination_size,
+    prim_usize* result_size, prim_usize* consumed);
+
+/**
+ * Decompress a zlib stream, and check its checksum.
+ *
+ * @param source The zlib stream.
+ * @param source_size Length of the zlib stream, in bytes.
+ * @param destination Location to write the uncompressed data.
+ * @param destination_size Length of the uncompressed data, in bytes. The
+ * stream must produce exactly this much.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the stream is malformed,
+ * uses a preset dictionary, produces a different length, or fails its
+ * checksum.
+ */
+extern PrimStatus zlib_decompress(const prim_u8* source, prim_usize source_size,
+    prim_u8* destination, prim_usize destination_size);
+
+/**
+ * Compute the Adler-32 checksum of some data, as used by zlib streams.
+ *
+ * @param data The data to check.
+ * @param size Length of the data, in bytes.
+ * @return The checksum.
+ */
+extern prim_u32 zlib_adler32(const prim_u8* data, prim_usize size);
+
+#endif
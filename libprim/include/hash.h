@@ -0,0 +1,116 @@
+/**
+ * @file hash.h
+ *
+ * Fast, non-cryptographic 64 and 128 bit content hashes, for recognising
+ * identical sections and segments across binaries.
+ *
+ * Input is consumed in 64 byte stripes spread across eight independent
+ * 64-bit lanes. Each lane only adds and multiplies 32-bit halves, so
+ * compilers vectorise the stripe loop on hosts with SIMD units, and the hash
+ * runs close to memory bandwidth. Lanes are scrambled every kilobyte, and
+ * merged and avalanched when the hash is finished.
+ *
+ * Hashes can be computed in one call, or streamed a piece at a time, such as
+ * a window at a time through a `PrimWindowedView`. Both give the same result
+ * for the same bytes.
+ *
+ * @note Hashes are not resistant to deliberately crafted collisions, and
+ * must not be used where an attacker chooses the input.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef HASH_H
+#define HASH_H
+
+#include "platform/mapping.h"
+#include "platform/types.h"
+#include "status.h"
+
+/** Number of lanes the hash accumulates in. */
+#define PRIM_HASH_LANES 8
+
+/** Length of the stripes the hash consumes, in bytes. */
+#define PRIM_HASH_STRIPE_SIZE 64
+
+/** A 128-bit hash. */
+typedef struct
+{
+    /** The low 64 bits. Also the 64-bit hash of the same input. */
+    prim_u64 low;
+
+    /** The high 64 bits. */
+    prim_u64 high;
+} PrimHash128;
+
+/** A hash being streamed. */
+typedef struct
+{
+    /** The accumulator lanes. */
+    prim_u64 lanes[PRIM_HASH_LANES];
+
+    /** Input not yet making up a whole stripe. */
+    prim_u8 buffer[PRIM_HASH_STRIPE_SIZE];
+
+    /** Number of bytes in `buffer`. */
+    prim_usize buffered;
+
+    /** Number of stripes consumed since the lanes were last scrambled. */
+    prim_usize stripe;
+
+    /** Total length of the input, in bytes. */
+    prim_u64 length;
+} PrimHashState;
+
+/**
+ * Start streaming a hash.
+ *
+ * @param state The hash to initialise.
+ */
+extern void prim_hash_init(PrimHashState* state);
+
+/**
+ * Add input to a streamed hash.
+ *
+ * @param state The hash to update.
+ * @param data The input. May be `NULL` if `size` is zero.
+ * @param size Length of the input, in bytes.
+ */
+extern void prim_hash_update(
+    PrimHashState* state, const void* data, prim_usize size);
+
+/**
+ * Finish a streamed hash. The state is left unchanged, so more input may
+ * be added and the hash finished again.
+ *
+ * @param state The hash to finish.
+ * @param result Location to return the 128-bit hash.
+ */
+extern void prim_hash_final(const PrimHashState* state, PrimHash128* result);
+
+/**
+ * Hash some input in one call.
+ *
+ * @param data The input. May be `NULL` if `size` is zero.
+ * @param size Length of the input, in bytes.
+ * @param result Location to return the 128-bit hash.
+ */
+extern void prim_hash(const void* data, prim_usize size, PrimHash128* result);
+
+/**
+ * Hash a range of a file through a windowed view, a window at a time, so the
+ * range never needs to be stitched or mapped whole.
+ *
+ * @param view The view to read through.
+ * @param offset Offset of the range in the file.
+ * @param size Length of the range, in bytes.
+ * @param result Location to return the 128-bit hash.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the range is outside the
+ * file, otherwise an error code.
+ */
+extern PrimStatus prim_hash_view(PrimWindowedView* view, prim_usize offset,
+    prim_usize size, PrimHash128* result);
+
+#endif
@@ -0,0 +1,52 @@
+/**
+ * @file include/loader/exec.h
+ *
+ * `exec.h` runs a loaded static executable in place of the current program,
+ * without asking the kernel to `execve` it.
+ *
+ * The executable's initial stack is built as the kernel would build it: the
+ * argument count, the argument and environment pointer arrays, and an
+ * auxiliary vector describing the image, with the strings they point to
+ * stored above them. Control then jumps to the image's entry point, and never
+ * returns to Prim.
+ *
+ * Only static executables, including static position independent
+ * executables, can be run. Images which name a program interpreter need a
+ * dynamic linker Prim does not provide, and are rejected.
+ *
+ * @note The process keeps everything Prim owned when the image starts: its
+ * open files, mappings, heap, and signal dispositions.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef LOADER_EXEC_H
+#define LOADER_EXEC_H
+
+#include "loader/loader.h"
+#include "status.h"
+
+/** Size of the stack given to an executed image, in bytes. */
+#define ELF64_EXEC_STACK_SIZE (8 * 1024 * 1024)
+
+/**
+ * Run a loaded static executable in place of the current program.
+ *
+ * Flush any buffered output before calling: the image replaces Prim without
+ * running its exit handlers.
+ *
+ * @param loaded The loaded executable.
+ * @param path The path the executable was loaded from, given to it as
+ * `AT_EXECFN`.
+ * @param argc Number of arguments.
+ * @param argv The executable's arguments, starting with its name.
+ * @param envp The executable's environment, terminated by `NULL`.
+ * @return Only on failure. STATUS_INVALID if the image needs a program
+ * interpreter or the host can not run images, otherwise an error code.
+ */
+extern PrimStatus elf64_exec(Elf64_Loaded_Image* loaded, const char* path,
+    int argc, char* const argv[], char* const envp[]);
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * @file include/loader/image_registry.h
+ *
+ * `image_registry.h` shares each binary's file mapping between every image
+ * loaded from it.
+ *
+ * Loading the same library many times, for example once per tenant in one
+ * process, would otherwise open and map the whole binary again for every
+ * instance. The registry keeps one mapping per binary, keyed by the file's
+ * device, inode and GNU build ID, and lends it to each load. Only the
+ * segments each instance maps privately, which its relocations write to, are
+ * duplicated.
+ *
+ * A binary rewritten in place keeps its device and inode, so the build ID is
+ * checked against the shared mapping on every lookup. A binary whose build
+ * ID has changed is mapped afresh, and later loads share the new mapping.
+ *
+ * @note The registry is process wide and thread safe.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef LOADER_IMAGE_REGISTRY_H
+#define LOADER_IMAGE_REGISTRY_H
+
+#include "platform/mapping.h"
+#include "status.h"
+
+/**
+ * Get the shared mapping of a binary, mapping it if no image uses it yet.
+ *
+ * @param path Path to the binary.
+ * @param result Location to return the mapping. Release it with
+ * `elf64_image_registry_release`, not `prim_unmap_file`.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_image_registry_acquire(
+    const char* path, PrimMapping* result);
+
+/**
+ * Release a mapping returned by `elf64_image_registry_acquire`. The binary is
+ * unmapped once every image loaded from it is released.
+ *
+ * @param mapping The mapping to release.
+ */
+extern void elf64_image_registry_release(const PrimMapping* mapping);
+
+#endif
@@ -0,0 +1,185 @@
+/**
+ * @file include/loader/link_map.h
+ *
+ * `link_map.h` loads an executable together with every shared library it
+ * needs, directly or indirectly.
+ *
+ * Dependencies are discovered a level at a time, breadth first, which is the
+ * order the system's dynamic linker searches them for symbols. Every library
+ * discovered in a level is independent of the others, so each level is
+ * mapped in parallel once its libraries have been resolved.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef LOADER_LINK_MAP_H
+#define LOADER_LINK_MAP_H
+
+#include "format/elf64/section/symbol.h"
+#include "format/elf64/types.h"
+#include "loader/loader.h"
+#include "loader/resolver.h"
+#include "loader/symbol_cache.h"
+#include "loader/tls.h"
+#include "loader/version_registry.h"
+#include "platform/plt.h"
+#include "platform/types.h"
+#include "status.h"
+
+/** An image in a link map. */
+typedef struct
+{
+    /** The loaded image. */
+    Elf64_Loaded_Image* loaded;
+
+    /** The path the image was loaded from. */
+    char* path;
+
+    /** The name the image was needed by, or its path for the executable. */
+    const char* name;
+
+    /** The image's `ELF64_DT_SONAME`, or `NULL` if it has none. */
+    const char* soname;
+
+    /** Index of the entry which first needed the image. */
+    prim_usize requester;
+
+    /** The result of loading the image. */
+    PrimStatus status;
+
+    /** The image's lazy binding context, or `NULL` if it is bound eagerly. */
+    PrimPltContext* binding;
+
+    /**
+     * The version ID of each of the image's version indexes, or `NULL` if the
+     * image has no versions.
+     */
+    prim_u32* versions;
+
+    /** Number of entries in `versions`. */
+    Elf64_Half version_count;
+
+    /** The image's TLS module ID, or zero if it has no TLS. */
+    prim_usize tls_module;
+
+    /** Offset of the image's TLS block below the thread pointer. */
+    prim_usize tls_offset;
+} Elf64_Link_Map_Entry;
+
+/** An executable and its shared libraries, in breadth first order. */
+typedef struct
+{
+    /** The loaded images. The executable is first. */
+    Elf64_Link_Map_Entry* entries;
+
+    /** Number of entries in `entries`. */
+    prim_usize count;
+
+    /** Number of entries `entries` has room for. */
+    prim_usize capacity;
+
+    /** The definitions found by `elf64_link_map_find_symbol`. */
+    Elf64_Symbol_Cache symbols;
+
+    /** The IDs of every symbol version name in the link map. */
+    Elf64_Version_Registry version_names;
+
+    /** The static TLS layout of every image, and its pool of blocks. */
+    Elf64_Tls tls;
+} Elf64_Link_Map;
+
+/** A symbol definition found in a link map. */
+typedef struct
+{
+    /** Index of the entry defining the symbol. */
+    prim_usize entry;
+
+    /** The symbol, in the defining image's dynamic symbol table. */
+    const Elf64_Symbol* symbol;
+} Elf64_Link_Map_Symbol;
+
+/**
+ * Load an executable and every shared library it needs.
+ *
+ * The images' static TLS is laid out once they are loaded, so blocks for new
+ * threads can be allocated from the link map's `tls` pool.
+ *
+ * @param map The link map to initialise.
+ * @param path Path to the executable to load.
+ * @param cache Library cache to resolve needed libraries with, or `NULL` to
+ * search for every library.
+ * @param options Options controlling the load, or `NULL` for the defaults.
+ * `ELF64_LOAD_SERIAL` loads one library at a time. `ELF64_LOAD_RELOCATE`
+ * relocates every image, binding PLT entries on first call unless
+ * `ELF64_LOAD_BIND_NOW` is given. `ELF64_LOAD_SNAPSHOT` restores the
+ * relocated images from `snapshot_path` if its fingerprint holds, and
+ * otherwise loads and relocates them, then saves a new snapshot.
+ * @return STATUS_OKAY on success, STATUS_BAD_FILE if a needed library can not
+ * be found, otherwise an error code. Nothing is left loaded on failure.
+ */
+extern PrimStatus elf64_link_map_load(Elf64_Link_Map* map, const char* path,
+    Elf64_Library_Cache* cache, const Elf64_Load_Options* options);
+
+/**
+ * Find the first definition of a symbol in a link map, in search order.
+ *
+ * Definitions are remembered in the link map's symbol cache, so repeated
+ * lookups of a symbol probe one hash table rather than every image.
+ *
+ * A versioned lookup skips images which define versions, but not the one
+ * required. Every version is identified by its ID, so no version names are
+ * compared.
+ *
+ * @param map The link map to search.
+ * @param name The symbol name to find.
+ * @param version The version ID to find, from
+ * `elf64_link_map_get_symbol_version`, or `ELF64_VERSION_ID_NONE` for the
+ * default version.
+ * @param first Index of the first entry to search. One skips the executable.
+ * @param result Location to return the definition.
+ * @return STATUS_OKAY if the symbol is found, STATUS_INVALID otherwise.
+ */
+extern PrimStatus elf64_link_map_find_symbol(Elf64_Link_Map* map,
+    const char* name, prim_u32 version, prim_usize first,
+    Elf64_Link_Map_Symbol* result);
+
+/**
+ * Get the version ID of a dynamic symbol in one of a link map's images.
+ *
+ * @param map The link map.
+ * @param entry Index of the image in the link map.
+ * @param index Index of the symbol in the image's dynamic symbol table.
+ * @return The ID of the version the symbol defines or requires, or
+ * `ELF64_VERSION_ID_NONE` if it is unversioned.
+ */
+extern prim_u32 elf64_link_map_get_symbol_version(
+    const Elf64_Link_Map* map, prim_usize entry, Elf64_Word index);
+
+/**
+ * Call an `int (void)` function in a link map's images.
+ *
+ * If any image has TLS, the function runs on a thread pointer allocated
+ * from the link map's TLS pool, so its TLS accesses reach the blocks laid
+ * out for the images rather than the host's own TLS. The block is returned
+ * to the pool afterwards.
+ *
+ * @param map The link map, relocated.
+ * @param function The function to call.
+ * @param result Location to return the function's result.
+ * @return STATUS_OKAY if the function was called, STATUS_INVALID if an image
+ * has TLS but the host can not switch thread pointers, otherwise an error
+ * code.
+ */
+extern PrimStatus elf64_link_map_call(
+    Elf64_Link_Map* map, int (*function)(void), int* result);
+
+/**
+ * Unload every image in a link map.
+ *
+ * @param map The link map to unload.
+ */
+extern void elf64_link_map_unload(Elf64_Link_Map* map);
+
+#endif
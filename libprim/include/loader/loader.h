@@ -0,0 +1,207 @@
+/**
+ * @file include/loader/loader.h
+ *
+ * `loader.h` maps ELF64 executables and shared objects into the current
+ * process's address space.
+ *
+ * The loader reserves an address range covering every loadable segment, maps
+ * each `ELF64_PT_LOAD` segment from the binary into it, zero fills the parts
+ * of segments which are not stored in the file, then applies each segment's
+ * access rights.
+ *
+ * Read-only segments which need no zero filling are mapped with their final
+ * access rights straight away, so they are never private, writable memory.
+ *
+ * Executables are loaded at their link time addresses. Position independent
+ * executables and shared objects are loaded wherever the platform finds
+ * space, and the difference from their link time addresses is recorded as
+ * the load bias.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef LOADER_LOADER_H
+#define LOADER_LOADER_H
+
+#include "format/elf64/image.h"
+#include "format/elf64/segment/flags.h"
+#include "format/elf64/types.h"
+#include "platform/mapping.h"
+#include "platform/types.h"
+#include "status.h"
+
+/** Describe the image's functions in the process's perf map. */
+#define ELF64_LOAD_PERF_MAP 0x1
+
+/** Describe the image's functions, and their code, in a jitdump. */
+#define ELF64_LOAD_JITDUMP 0x2
+
+/** Load an image's dependencies one at a time, rather than in parallel. */
+#define ELF64_LOAD_SERIAL 0x4
+
+/** Apply relocations once every image in a link map is loaded. */
+#define ELF64_LOAD_RELOCATE 0x8
+
+/** Bind every PLT entry while relocating, rather than on first call. */
+#define ELF64_LOAD_BIND_NOW 0x10
+
+/**
+ * Restore a relocated link map from its snapshot file, or save one after
+ * relocating it. Implies `ELF64_LOAD_RELOCATE` and `ELF64_LOAD_BIND_NOW`.
+ */
+#define ELF64_LOAD_SNAPSHOT 0x20
+
+/**
+ * Share the binary's file mapping with every other image loaded from the
+ * same binary with this flag, through the image registry.
+ */
+#define ELF64_LOAD_SHARE_FILES 0x40
+
+/**
+ * Back executable segments with huge pages where they cover whole, aligned
+ * huge pages. Position independent images are loaded at a huge page aligned
+ * bias, and those parts of their code are copied to anonymous memory the
+ * host may back with huge pages.
+ */
+#define ELF64_LOAD_HUGE_TEXT 0x80
+
+/** Segments up to this size are populated by `ELF64_READAHEAD_BY_SIZE`. */
+#define ELF64_READAHEAD_DEFAULT_THRESHOLD 0x40000
+
+/** How the pages of each loadable segment are read ahead once mapped. */
+typedef enum Elf64_Readahead_Policy
+{
+    /** Leave every segment to be faulted in on demand. */
+    ELF64_READAHEAD_NONE,
+
+    /** Give every segment the same `readahead_advice`. */
+    ELF64_READAHEAD_FIXED,
+
+    /**
+     * Choose from each segment's flags: writable segments are populated, as
+     * relocation touches them anyway, executable segments are read ahead,
+     * and read-only data is left to demand faults.
+     */
+    ELF64_READAHEAD_BY_FLAGS,
+
+    /**
+     * Choose from each segment's size: segments up to `readahead_threshold`
+     * bytes are populated, and larger ones only read ahead, so they cost page
+     * cache rather than resident memory.
+     */
+    ELF64_READAHEAD_BY_SIZE,
+
+    /**
+     * Replay the pages `page_profile` recorded for the binary: read them
+     * ahead in file order, then populate those backing segments. Binaries
+     * missing from the profile are left to demand faults.
+     */
+    ELF64_READAHEAD_PROFILE,
+} Elf64_Readahead_Policy;
+
+/** Options controlling how an image is loaded. */
+typedef struct
+{
+    /** Bitfield of `ELF64_LOAD_*` flags. */
+    prim_u32 flags;
+
+    /** Directory to write the jitdump in, or `NULL` for `/tmp`. */
+    const char* jitdump_directory;
+
+    /** The snapshot file used by `ELF64_LOAD_SNAPSHOT`. */
+    const char* snapshot_path;
+
+    /** How segments are read ahead once mapped. */
+    Elf64_Readahead_Policy readahead;
+
+    /**
+     * The advice given to every segment by `ELF64_READAHEAD_FIXED`. Only
+     * `PRIM_ADVICE_NORMAL`, `WILLNEED`, `SEQUENTIAL`, `RANDOM` and `POPULATE`
+     * are accepted: loads given any other advice fail with STATUS_INVALID.
+     */
+    PrimMapAdvice readahead_advice;
+
+    /**
+     * Largest segment populated by `ELF64_READAHEAD_BY_SIZE`, in bytes, or
+     * zero for `ELF64_READAHEAD_DEFAULT_THRESHOLD`.
+     */
+    prim_usize readahead_threshold;
+
+    /** The page profile replayed by `ELF64_READAHEAD_PROFILE`. */
+    const struct Elf64_Page_Profile* page_profile;
+} Elf64_Load_Options;
+
+/** An ELF64 binary loaded into memory. */
+typedef struct
+{
+    /** The binary the image was loaded from. */
+    Elf64_Image image;
+
+    /** Start of the address range reserved for the image. */
+    prim_u8* base;
+
+    /** Length of the address range reserved for the image. */
+    prim_usize size;
+
+    /** Load address minus link time address, for every address in the image. */
+    prim_usize bias;
+
+    /** Number of huge pages backing the image's code. */
+    prim_usize huge_pages;
+} Elf64_Loaded_Image;
+
+/**
+ * Load an ELF64 executable or shared object into memory.
+ *
+ * @param loaded Location to return the loaded image.
+ * @param path Path to the binary to load.
+ * @param options Options controlling the load, or `NULL` for the defaults.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the binary can not be
+ * loaded on this machine, otherwise an error code.
+ */
+extern PrimStatus elf64_load_image(Elf64_Loaded_Image* loaded, const char* path,
+    const Elf64_Load_Options* options);
+
+/**
+ * Load an ELF64 executable or shared object at a chosen address.
+ *
+ * @param loaded Location to return the loaded image.
+ * @param path Path to the binary to load.
+ * @param base Address the image's reserved range must start at, or `NULL`
+ * to load it anywhere. Executables can only be loaded at their link time
+ * addresses.
+ * @param options Options controlling the load, or `NULL` for the defaults.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the binary can not be
+ * loaded on this machine or at `base`, otherwise an error code.
+ */
+extern PrimStatus elf64_load_image_at(Elf64_Loaded_Image* loaded,
+    const char* path, void* base, const Elf64_Load_Options* options);
+
+/**
+ * Unmap a loaded image, and close its binary.
+ *
+ * @param loaded The loaded image to unload.
+ */
+extern void elf64_unload_image(Elf64_Loaded_Image* loaded);
+
+/**
+ * Convert a link time address in an image to its loaded address.
+ *
+ * @param loaded The loaded image.
+ * @param address A link time virtual address from the binary.
+ * @return The address in memory.
+ */
+extern void* elf64_get_loaded_address(
+    const Elf64_Loaded_Image* loaded, Elf64_Address address);
+
+/**
+ * Convert ELF64 segment flags to Prim access rights.
+ *
+ * @param flags The segment's flags.
+ * @return The equivalent `PRIM_PROTECT_*` bitfield.
+ */
+extern prim_u32 elf64_get_segment_protection(Elf64_Segment_Flag flags);
+
+#endif
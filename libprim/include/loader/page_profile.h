@@ -0,0 +1,139 @@
+/**
+ * @file include/loader/page_profile.h
+ *
+ * `page_profile.h` records which pages of each binary in a link map were
+ * touched while it started, so later loads can read exactly those pages
+ * ahead before they are needed.
+ *
+ * A profile lists, for each binary, the file pages touched either through
+ * its loaded segments or through Prim's own view of the file while parsing
+ * and relocating it. Pages are recorded as file offsets, sorted and merged
+ * into ranges, so a replay reads them ahead in a single pass in file order.
+ *
+ * A binary's pages are only replayed while its identity (device, inode, size
+ * and modification time) matches the one recorded.
+ *
+ * @note Profiles are native endian, and only meaningful on machines with the
+ * page size that wrote them.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef LOADER_PAGE_PROFILE_H
+#define LOADER_PAGE_PROFILE_H
+
+#include "loader/link_map.h"
+#include "platform/file.h"
+#include "platform/mapping.h"
+#include "platform/types.h"
+#include "status.h"
+
+/** First bytes of every page profile. */
+#define ELF64_PAGE_PROFILE_MAGIC "PRIMPAGE"
+
+/** Format version written by `elf64_page_profile_save`. */
+#define ELF64_PAGE_PROFILE_VERSION 1
+
+/** The start of a page profile. */
+typedef struct
+{
+    /** `ELF64_PAGE_PROFILE_MAGIC`, without its terminator. */
+    char magic[8];
+
+    /** `ELF64_PAGE_PROFILE_VERSION`. */
+    prim_u32 version;
+
+    /** The page size the profile was recorded with, in bytes. */
+    prim_u32 page_size;
+
+    /** Number of `Elf64_Page_Profile_Image` records following the header. */
+    prim_u64 image_count;
+
+    /** Number of `Elf64_Page_Profile_Range` records following the images. */
+    prim_u64 range_count;
+} Elf64_Page_Profile_Header;
+
+/** A binary in a page profile. */
+typedef struct
+{
+    /** The identity of the binary when the profile was recorded. */
+    PrimFileIdentity identity;
+
+    /** Index of the binary's first range. */
+    prim_u64 first_range;
+
+    /** Number of ranges recorded for the binary. */
+    prim_u64 range_count;
+} Elf64_Page_Profile_Image;
+
+/** Touched pages of a binary, in file order. */
+typedef struct
+{
+    /** Offset of the first page in the file. Page aligned. */
+    prim_u64 offset;
+
+    /** Length of the pages, in bytes. */
+    prim_u64 size;
+} Elf64_Page_Profile_Range;
+
+/** A page profile opened for replaying. */
+typedef struct Elf64_Page_Profile
+{
+    /** The mapped file. */
+    PrimMapping mapping;
+
+    /** The file's header. */
+    const Elf64_Page_Profile_Header* header;
+
+    /** The file's image records. */
+    const Elf64_Page_Profile_Image* images;
+
+    /** The file's range records. */
+    const Elf64_Page_Profile_Range* ranges;
+} Elf64_Page_Profile;
+
+/**
+ * Open a page profile.
+ *
+ * @param profile Location to return the opened profile.
+ * @param path The profile file.
+ * @return STATUS_OKAY on success, STATUS_INVALID if it is malformed or was
+ * recorded with another page size, otherwise an error code. Nothing is left
+ * open on failure.
+ */
+extern PrimStatus elf64_page_profile_open(
+    Elf64_Page_Profile* profile, const char* path);
+
+/**
+ * Find the pages recorded for a binary.
+ *
+ * @param profile The profile.
+ * @param path The binary.
+ * @param result Location to return the binary's record.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the binary was not
+ * recorded or has changed since, otherwise an error code.
+ */
+extern PrimStatus elf64_page_profile_find(const Elf64_Page_Profile* profile,
+    const char* path, const Elf64_Page_Profile_Image** result);
+
+/**
+ * Close a page profile.
+ *
+ * @param profile The profile to close.
+ */
+extern void elf64_page_profile_close(Elf64_Page_Profile* profile);
+
+/**
+ * Record the pages of every binary in a link map touched so far, and save
+ * them to a page profile.
+ *
+ * @param map The link map, once it has started.
+ * @param path The profile file to write.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_page_profile_save(
+    const Elf64_Link_Map* map, const char* path);
+
+#endif
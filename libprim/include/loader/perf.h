@@ -0,0 +1,35 @@
+/**
+ * @file include/loader/perf.h
+ *
+ * `perf.h` describes the functions in loaded images to the host's profiler,
+ * so samples in code mapped by Prim are attributed to the right symbols.
+ *
+ * @see `include/platform/perf.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef LOADER_PERF_H
+#define LOADER_PERF_H
+
+#include "loader/loader.h"
+#include "status.h"
+
+/**
+ * Describe every function in a loaded image to the host's profiler.
+ *
+ * Functions are read from the image's static symbol table, or its dynamic
+ * symbol table if it has been stripped. Only defined functions with a known
+ * size are described.
+ *
+ * @param loaded The loaded image to describe.
+ * @param options The options the image was loaded with. `ELF64_LOAD_PERF_MAP`
+ * and `ELF64_LOAD_JITDUMP` select the outputs to write.
+ * @return STATUS_OKAY on success, otherwise the first error.
+ */
+extern PrimStatus elf64_perf_register_image(
+    Elf64_Loaded_Image* loaded, const Elf64_Load_Options* options);
+
+#endif
@@ -0,0 +1,71 @@
+/**
+ * @file include/loader/relocate.h
+ *
+ * `relocate.h` applies the dynamic relocations of the images in a link map,
+ * so their code and data refer to each other's loaded addresses.
+ *
+ * PLT relocations are bound lazily by default: each PLT entry's GOT slot is
+ * pointed at Prim's trampoline, and the symbol is looked up and patched on
+ * the entry's first call. Functions which are never called are never looked
+ * up. Images linked with `-z now`, and link maps loaded with
+ * `ELF64_LOAD_BIND_NOW`, are bound eagerly instead.
+ *
+ * IFUNC resolvers are called as their relocations are applied, except in the
+ * system dynamic linker and C library, and in libraries which need the
+ * dynamic linker. Their resolvers read state only the system dynamic linker
+ * sets up, so relocations needing them fail with STATUS_INVALID. The C
+ * library has `R_X86_64_IRELATIVE` relocations of its own, so link maps
+ * which include it can be loaded, but not relocated.
+ * `elf64_link_map_check_resolvers` finds such link maps before any of their
+ * relocations are applied.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef LOADER_RELOCATE_H
+#define LOADER_RELOCATE_H
+
+#include "loader/link_map.h"
+#include "loader/loader.h"
+#include "platform/types.h"
+#include "status.h"
+
+/**
+ * Relocate every image in a link map.
+ *
+ * Images are relocated in reverse search order, so libraries are ready
+ * before the images which depend on them. Each image's `PT_GNU_RELRO`
+ * segment is made read only once it is relocated.
+ *
+ * @param map The link map to relocate.
+ * @param flags The `ELF64_LOAD_*` flags the link map was loaded with.
+ * @return STATUS_OKAY on success, STATUS_INVALID if a relocation is
+ * malformed, unsupported, refers to an undefined symbol, or needs an IFUNC
+ * resolver which can not be called, otherwise an error code.
+ */
+extern PrimStatus elf64_link_map_relocate(Elf64_Link_Map* map, prim_u32 flags);
+
+/**
+ * Check that every IFUNC resolver in a link map can be called.
+ *
+ * Only images which define IFUNC symbols, or have `R_X86_64_IRELATIVE`
+ * relocations, have resolvers to check.
+ *
+ * @param map The loaded link map.
+ * @return STATUS_OKAY if every resolver can be called, STATUS_INVALID if an
+ * image's resolvers need the system dynamic linker's state, otherwise an
+ * error code.
+ */
+extern PrimStatus elf64_link_map_check_resolvers(Elf64_Link_Map* map);
+
+/**
+ * Make an image's `PT_GNU_RELRO` segments read only.
+ *
+ * @param loaded The relocated image.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_protect_relro(Elf64_Loaded_Image* loaded);
+
+#endif
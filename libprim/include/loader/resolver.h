@@ -0,0 +1,155 @@
+/**
+ * @file include/loader/resolver.h
+ *
+ * `resolver.h` finds the shared libraries named by `ELF64_DT_NEEDED`
+ * entries.
+ *
+ * Libraries are searched for the way the system's dynamic linker searches
+ * for them: the requesting image's `ELF64_DT_RPATH` (only if it has no
+ * `ELF64_DT_RUNPATH`), `LD_LIBRARY_PATH`, the requesting image's
+ * `ELF64_DT_RUNPATH`, and then the system library directories. Each search
+ * probes a file per directory. The requesting image's own paths differ
+ * between images, so are always searched, but `LD_LIBRARY_PATH` and the
+ * system directories are the same for every image, so the libraries found
+ * in them are remembered in a library cache keyed by soname. Like
+ * `ld.so.cache`, a cache can be saved to a file and loaded by later
+ * processes, which then resolve libraries without probing. Libraries which
+ * are not found are never cached, so those installed later are found.
+ *
+ * @note Library caches are not thread safe.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef LOADER_RESOLVER_H
+#define LOADER_RESOLVER_H
+
+#include "format/elf64/image.h"
+#include "platform/types.h"
+#include "status.h"
+
+/** The longest library path the resolver builds, including the terminator. */
+#define ELF64_LIBRARY_PATH_LENGTH 4096
+
+/** A soname and the path it resolved to. */
+typedef struct
+{
+    /** The soname, or `NULL` for an empty slot. */
+    char* soname;
+
+    /** The library's path. */
+    char* path;
+} Elf64_Library_Cache_Entry;
+
+/** An open addressed hash table of resolved sonames. */
+typedef struct
+{
+    /** The table's slots. */
+    Elf64_Library_Cache_Entry* entries;
+
+    /** Number of slots in `entries`. Zero, or a power of two. */
+    prim_usize size;
+
+    /** Number of occupied slots. */
+    prim_usize count;
+} Elf64_Library_Cache;
+
+/**
+ * Initialise an empty library cache.
+ *
+ * @param cache The cache to initialise.
+ */
+extern void elf64_library_cache_init(Elf64_Library_Cache* cache);
+
+/**
+ * Release a library cache and every entry in it.
+ *
+ * @param cache The cache to destroy.
+ */
+extern void elf64_library_cache_destroy(Elf64_Library_Cache* cache);
+
+/**
+ * Look up a soname in a library cache.
+ *
+ * @param cache The cache to search.
+ * @param soname The soname to look up.
+ * @param result Location to return the cached path.
+ * @return STATUS_OKAY if the soname is cached, STATUS_INVALID otherwise.
+ */
+extern PrimStatus elf64_library_cache_lookup(
+    const Elf64_Library_Cache* cache, const char* soname, const char** result);
+
+/**
+ * Remember the path a soname resolved to, replacing any earlier result.
+ *
+ * @param cache The cache to update.
+ * @param soname The soname.
+ * @param path The library's path.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_library_cache_insert(
+    Elf64_Library_Cache* cache, const char* soname, const char* path);
+
+/**
+ * Add the entries saved in a file to a library cache.
+ *
+ * A file saved under a different `LD_LIBRARY_PATH` is ignored, because its
+ * results may not hold under the current one.
+ *
+ * @param cache The cache to add to.
+ * @param path The file written by `elf64_library_cache_save`.
+ * @return STATUS_OKAY on success, including when the file is ignored,
+ * STATUS_INVALID if the file is malformed, otherwise an error code.
+ */
+extern PrimStatus elf64_library_cache_load(
+    Elf64_Library_Cache* cache, const char* path);
+
+/**
+ * Save the entries in a library cache to a file.
+ *
+ * @param cache The cache to save.
+ * @param path The file to write.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_library_cache_save(
+    const Elf64_Library_Cache* cache, const char* path);
+
+/**
+ * Search the filesystem for a needed library, ignoring any cache.
+ *
+ * @param requester The image which needs the library.
+ * @param requester_path The path `requester` was loaded from, used to
+ * expand `$ORIGIN`.
+ * @param soname The needed library, from an `ELF64_DT_NEEDED` entry.
+ * @param buffer Location to build the library's path, at least
+ * `ELF64_LIBRARY_PATH_LENGTH` bytes long.
+ * @return STATUS_OKAY if the library is found, STATUS_BAD_FILE if it is not,
+ * otherwise an error code.
+ */
+extern PrimStatus elf64_search_library(Elf64_Image* requester,
+    const char* requester_path, const char* soname, char* buffer);
+
+/**
+ * Find a needed library, consulting and updating a cache.
+ *
+ * Only the part of the search shared by every requesting image is cached:
+ * `LD_LIBRARY_PATH` and the system library directories. The requester's
+ * `ELF64_DT_RPATH` and `ELF64_DT_RUNPATH` are always searched first.
+ *
+ * @param cache The cache to consult, or `NULL` to always search.
+ * @param requester The image which needs the library.
+ * @param requester_path The path `requester` was loaded from, used to
+ * expand `$ORIGIN`.
+ * @param soname The needed library, from an `ELF64_DT_NEEDED` entry.
+ * @param buffer Location to build the library's path, at least
+ * `ELF64_LIBRARY_PATH_LENGTH` bytes long.
+ * @return STATUS_OKAY if the library is found, STATUS_BAD_FILE if it is not,
+ * otherwise an error code.
+ */
+extern PrimStatus elf64_resolve_library(Elf64_Library_Cache* cache,
+    Elf64_Image* requester, const char* requester_path, const char* soname,
+    char* buffer);
+
+#endif
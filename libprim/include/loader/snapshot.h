@@ -0,0 +1,188 @@
+/**
+ * @file include/loader/snapshot.h
+ *
+ * `snapshot.h` saves the relocated state of a link map to a file, so a later
+ * load can map it back in rather than relocating again.
+ *
+ * Relocation only writes to an image's writable segments. A snapshot records
+ * the address each image was loaded at, and the contents of its writable
+ * pages once every relocation, GOT entry and resolved symbol address has
+ * been applied. A restore loads each image at its recorded address as usual,
+ * then maps the saved pages over its writable segments straight from the
+ * snapshot file. No relocation is read or applied, and pages are only read
+ * from the snapshot when they are first touched.
+ *
+ * A snapshot is only restored while its fingerprint still holds: the same
+ * executable, the same identity (device, inode, size and modification time)
+ * for every image, the same `LD_LIBRARY_PATH`, load flags, and processor
+ * capabilities, which select IFUNC implementations. Snapshots are always
+ * bound eagerly, because lazy binding contexts live in Prim's heap rather
+ * than in the images. Link maps whose IFUNC resolvers need the system
+ * dynamic linker, such as any including the system C library, can not be
+ * relocated, so are refused before relocation starts and never snapshotted.
+ *
+ * @note Snapshots are native endian, and only meaningful on the machine that
+ * wrote them.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef LOADER_SNAPSHOT_H
+#define LOADER_SNAPSHOT_H
+
+#include "loader/link_map.h"
+#include "platform/file.h"
+#include "platform/mapping.h"
+#include "platform/types.h"
+#include "status.h"
+
+/** First bytes of every snapshot file. */
+#define ELF64_SNAPSHOT_MAGIC "PRIMSNAP"
+
+/** Format version written by `elf64_snapshot_save`. */
+#define ELF64_SNAPSHOT_VERSION 1
+
+/** The start of a snapshot file. */
+typedef struct
+{
+    /** `ELF64_SNAPSHOT_MAGIC`, without its terminator. */
+    char magic[8];
+
+    /** `ELF64_SNAPSHOT_VERSION`. */
+    prim_u32 version;
+
+    /** The `ELF64_LOAD_*` flags the link map was relocated with. */
+    prim_u32 flags;
+
+    /** The processor's `AT_HWCAP` and `AT_HWCAP2` capabilities. */
+    prim_u64 hardware[2];
+
+    /** Number of `Elf64_Snapshot_Image` records following the header. */
+    prim_u64 image_count;
+
+    /** Number of `Elf64_Snapshot_Range` records following the images. */
+    prim_u64 range_count;
+
+    /**
+     * Size of the string table following the ranges. The table starts with
+     * the `LD_LIBRARY_PATH` the snapshot was saved under.
+     */
+    prim_u64 strings_size;
+} Elf64_Snapshot_Header;
+
+/** An image in a snapshot, in link map order. */
+typedef struct
+{
+    /** The identity of the image's file when the snapshot was saved. */
+    PrimFileIdentity identity;
+
+    /** The start of the image's reserved address range. */
+    prim_u64 base;
+
+    /** Index of the image which first needed this one. */
+    prim_u64 requester;
+
+    /** Index of the requester's `ELF64_DT_NEEDED` entry naming this image. */
+    prim_u64 needed;
+
+    /** Offset of the image's path in the string table. */
+    prim_u64 path;
+} Elf64_Snapshot_Image;
+
+/** Pages of an image saved in a snapshot. */
+typedef struct
+{
+    /** Index of the image the pages belong to. */
+    prim_u64 image;
+
+    /** Address of the first page. */
+    prim_u64 address;
+
+    /** Length of the pages, in bytes. */
+    prim_u64 size;
+
+    /** Offset of the pages' contents in the file. Page aligned. */
+    prim_u64 offset;
+
+    /** The pages' `PRIM_PROTECT_*` access rights. */
+    prim_u64 protection;
+} Elf64_Snapshot_Range;
+
+/** A snapshot file opened for restoring. */
+typedef struct
+{
+    /** The mapped file. */
+    PrimMapping mapping;
+
+    /** The file's header. */
+    const Elf64_Snapshot_Header* header;
+
+    /** The file's image records. */
+    const Elf64_Snapshot_Image* images;
+
+    /** The file's range records. */
+    const Elf64_Snapshot_Range* ranges;
+
+    /** The file's string table. */
+    const char* strings;
+} Elf64_Snapshot;
+
+/**
+ * Open a snapshot, and check its fingerprint still holds.
+ *
+ * @param snapshot Location to return the opened snapshot.
+ * @param path The snapshot file.
+ * @param executable The executable being loaded.
+ * @param flags The `ELF64_LOAD_*` flags the link map is being loaded with.
+ * @return STATUS_OKAY if the snapshot can be restored, STATUS_INVALID if it
+ * is malformed or out of date, otherwise an error code. Nothing is left open
+ * on failure.
+ */
+extern PrimStatus elf64_snapshot_open(Elf64_Snapshot* snapshot,
+    const char* path, const char* executable, prim_u32 flags);
+
+/**
+ * Get the path of an image in an open snapshot.
+ *
+ * @param snapshot The snapshot.
+ * @param index Index of the image.
+ * @return The image's path.
+ */
+extern const char* elf64_snapshot_get_path(
+    const Elf64_Snapshot* snapshot, prim_usize index);
+
+/**
+ * Map a snapshot's saved pages over the images of a link map, in place of
+ * relocating them, then make each image's `PT_GNU_RELRO` segments read only.
+ *
+ * @param snapshot The snapshot.
+ * @param map The link map, with every image loaded at its snapshot's base.
+ * @return STATUS_OKAY on success, STATUS_INVALID if a range lies outside its
+ * image, otherwise an error code.
+ */
+extern PrimStatus elf64_snapshot_apply(
+    const Elf64_Snapshot* snapshot, Elf64_Link_Map* map);
+
+/**
+ * Close a snapshot. Pages already mapped by `elf64_snapshot_apply` stay
+ * mapped.
+ *
+ * @param snapshot The snapshot to close.
+ */
+extern void elf64_snapshot_close(Elf64_Snapshot* snapshot);
+
+/**
+ * Save a freshly relocated link map to a snapshot file.
+ *
+ * @param map The link map, relocated but not yet run.
+ * @param path The snapshot file to write.
+ * @param flags The `ELF64_LOAD_*` flags the link map was loaded with.
+ * @return STATUS_OKAY on success, STATUS_INVALID if an image can not be
+ * described by a snapshot, otherwise an error code.
+ */
+extern PrimStatus elf64_snapshot_save(
+    const Elf64_Link_Map* map, const char* path, prim_u32 flags);
+
+#endif
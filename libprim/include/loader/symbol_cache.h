@@ -0,0 +1,114 @@
+/**
+ * @file include/loader/symbol_cache.h
+ *
+ * `symbol_cache.h` remembers which image in a link map defines each symbol
+ * that has been looked up.
+ *
+ * Every library which calls `malloc` looks it up against the whole search
+ * list. A symbol cache turns the second and later lookups into one probe of
+ * a hash table, keyed by the symbol's GNU hash, name and version ID, instead
+ * of a probe of every image's hash table.
+ *
+ * @note Only definitions are cached. Lookups which find nothing are rare, and
+ * are repeated in full.
+ *
+ * @note Symbol caches are thread safe, so lazy binding may look symbols up
+ * from any thread. A lookup copies the definition out, as another thread's
+ * insert may move the table.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef LOADER_SYMBOL_CACHE_H
+#define LOADER_SYMBOL_CACHE_H
+
+#include "format/elf64/section/symbol.h"
+#include "format/elf64/types.h"
+#include "platform/thread.h"
+#include "platform/types.h"
+#include "status.h"
+
+/** A symbol lookup and the definition it found. */
+typedef struct
+{
+    /** The symbol name from the defining image, or `NULL` if empty. */
+    const char* name;
+
+    /** The GNU hash of `name`. */
+    Elf64_Word hash;
+
+    /** The version ID the lookup required, or `ELF64_VERSION_ID_NONE`. */
+    prim_u32 version;
+
+    /** Index of the first link map entry the lookup searched. */
+    prim_usize first;
+
+    /** Index of the link map entry defining the symbol. */
+    prim_usize entry;
+
+    /** The definition, in the defining image's dynamic symbol table. */
+    const Elf64_Symbol* symbol;
+} Elf64_Symbol_Cache_Entry;
+
+/** An open addressed hash table of symbol definitions. */
+typedef struct
+{
+    /** The table's slots. */
+    Elf64_Symbol_Cache_Entry* entries;
+
+    /** Number of slots in `entries`. Zero, or a power of two. */
+    prim_usize size;
+
+    /** Number of occupied slots. */
+    prim_usize count;
+
+    /** Guards the table against concurrent lookups and inserts. */
+    PrimLock lock;
+} Elf64_Symbol_Cache;
+
+/**
+ * Initialise an empty symbol cache.
+ *
+ * @param cache The cache to initialise.
+ */
+extern void elf64_symbol_cache_init(Elf64_Symbol_Cache* cache);
+
+/**
+ * Release a symbol cache.
+ *
+ * @param cache The cache to destroy.
+ */
+extern void elf64_symbol_cache_destroy(Elf64_Symbol_Cache* cache);
+
+/**
+ * Look up a symbol in a symbol cache.
+ *
+ * @param cache The cache to search.
+ * @param name The symbol name to look up.
+ * @param hash The GNU hash of `name`.
+ * @param version The version ID the lookup requires, or
+ * `ELF64_VERSION_ID_NONE`.
+ * @param first Index of the first link map entry the lookup searches.
+ * @param result Location to copy the cached definition to.
+ * @return STATUS_OKAY if the symbol is cached, STATUS_INVALID otherwise.
+ */
+extern PrimStatus elf64_symbol_cache_lookup(Elf64_Symbol_Cache* cache,
+    const char* name, Elf64_Word hash, prim_u32 version, prim_usize first,
+    Elf64_Symbol_Cache_Entry* result);
+
+/**
+ * Remember the definition a symbol lookup found.
+ *
+ * @note The entry's name is not copied. It must outlive the cache, which it
+ * does if it is the defining image's name for the symbol.
+ *
+ * @param cache The cache to update.
+ * @param entry The lookup and its definition.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_symbol_cache_insert(
+    Elf64_Symbol_Cache* cache, const Elf64_Symbol_Cache_Entry* entry);
+
+#endif
@@ -0,0 +1,140 @@
+/**
+ * @file include/loader/tls.h
+ *
+ * `tls.h` lays out the static thread local storage (TLS) of a link map, and
+ * allocates per-thread TLS blocks from a pool.
+ *
+ * Every image with a `ELF64_PT_TLS` segment is given a module ID and an
+ * offset below the thread pointer, following the AMD64 ABI's variant II
+ * layout: the executable's block is nearest the thread pointer, and each
+ * library's block is further below it. The thread control block (TCB) starts
+ * at the thread pointer.
+ *
+ * The initial contents of the whole static TLS area are assembled once into
+ * a template. Blocks are carved from pooled chunks, so a new thread's block
+ * costs a free list pop, one `memcpy` of the template's initialised bytes,
+ * and one `memset` of the zero filled remainder. `elf64_link_map_call`
+ * allocates a block for each call into loaded code, and installs it as the
+ * thread pointer.
+ *
+ * @note TLS pools are not thread safe. Callers creating threads concurrently
+ * must serialise allocation.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef LOADER_TLS_H
+#define LOADER_TLS_H
+
+#include "platform/types.h"
+#include "status.h"
+
+/** Size of the thread control block Prim reserves at the thread pointer. */
+#define ELF64_TLS_TCB_SIZE 64
+
+/** Number of blocks carved from each pool chunk. */
+#define ELF64_TLS_POOL_BLOCKS 32
+
+/** The static TLS layout of a link map, and its pool of blocks. */
+typedef struct
+{
+    /** Initial contents of the static TLS area, or `NULL` if it is empty. */
+    prim_u8* initial;
+
+    /** Size of the static TLS area below the thread pointer, in bytes. */
+    prim_usize size;
+
+    /** Bytes at the start of `initial` which are not all zero. */
+    prim_usize initialised;
+
+    /** Alignment of the thread pointer. A power of two. */
+    prim_usize align;
+
+    /** Size of each block: the static TLS area plus the TCB, aligned. */
+    prim_usize block_size;
+
+    /** Number of images with TLS. Module IDs run from one to this. */
+    prim_usize module_count;
+
+    /** Thread pointers of free blocks, linked through their TCBs. */
+    void* free;
+
+    /** Chunks allocated for the pool, linked through their first word. */
+    void* chunks;
+} Elf64_Tls;
+
+/**
+ * Initialise an empty TLS layout, with no modules.
+ *
+ * @param tls The layout to initialise.
+ */
+extern void elf64_tls_init(Elf64_Tls* tls);
+
+/**
+ * Add an image's TLS segment to a layout.
+ *
+ * Modules must be added in link map order, before the template is built.
+ *
+ * @param tls The layout to add to.
+ * @param size The segment's size in memory.
+ * @param align The segment's alignment. Zero or one for none.
+ * @param address The segment's link time address.
+ * @param offset Location to return the module's block offset below the
+ * thread pointer.
+ * @return The module's ID. Never zero.
+ */
+extern prim_usize elf64_tls_add_module(Elf64_Tls* tls, prim_usize size,
+    prim_usize align, prim_usize address, prim_usize* offset);
+
+/**
+ * Allocate a layout's template, once every module has been added.
+ *
+ * The template starts zero filled. Copy each module's initialisation image
+ * in with `elf64_tls_set_initial`.
+ *
+ * @param tls The layout.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_tls_build_template(Elf64_Tls* tls);
+
+/**
+ * Copy a module's initialisation image into a layout's template.
+ *
+ * @param tls The layout.
+ * @param offset The module's block offset below the thread pointer.
+ * @param data The module's initialised TLS data.
+ * @param size Size of `data`, in bytes.
+ */
+extern void elf64_tls_set_initial(
+    Elf64_Tls* tls, prim_usize offset, const void* data, prim_usize size);
+
+/**
+ * Allocate and initialise a thread's static TLS block.
+ *
+ * The TCB's first word holds the thread pointer itself, as the ABI requires.
+ * The rest of the TCB is zeroed.
+ *
+ * @param tls The layout to allocate for.
+ * @param result Location to return the block's thread pointer.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_tls_allocate(Elf64_Tls* tls, void** result);
+
+/**
+ * Return a thread's static TLS block to its pool.
+ *
+ * @param tls The layout the block was allocated for.
+ * @param thread_pointer The block's thread pointer.
+ */
+extern void elf64_tls_release(Elf64_Tls* tls, void* thread_pointer);
+
+/**
+ * Release a layout's template and every block in its pool.
+ *
+ * @param tls The layout to destroy.
+ */
+extern void elf64_tls_destroy(Elf64_Tls* tls);
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @file include/loader/version_registry.h
+ *
+ * `version_registry.h` gives every symbol version name in a link map a small
+ * integer ID.
+ *
+ * Each image numbers its versions independently, so `GLIBC_2.34` may be
+ * index 3 in one image and index 7 in another. Interning the names once, when
+ * a link map is loaded, lets versioned symbol lookups compare IDs instead of
+ * strings.
+ *
+ * @note Version registries are not thread safe.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef LOADER_VERSION_REGISTRY_H
+#define LOADER_VERSION_REGISTRY_H
+
+#include "platform/types.h"
+#include "status.h"
+
+/** The ID of no version: an unversioned symbol or reference. */
+#define ELF64_VERSION_ID_NONE 0
+
+/** A version name and its ID. */
+typedef struct
+{
+    /** The version name, or `NULL` for an empty slot. */
+    const char* name;
+
+    /** The name's ID. */
+    prim_u32 id;
+} Elf64_Version_Registry_Entry;
+
+/** An open addressed hash table of version names. */
+typedef struct
+{
+    /** The table's slots. */
+    Elf64_Version_Registry_Entry* entries;
+
+    /** Number of slots in `entries`. Zero, or a power of two. */
+    prim_usize size;
+
+    /** Number of occupied slots, which is also the largest ID given. */
+    prim_usize count;
+} Elf64_Version_Registry;
+
+/**
+ * Initialise an empty version registry.
+ *
+ * @param registry The registry to initialise.
+ */
+extern void elf64_version_registry_init(Elf64_Version_Registry* registry);
+
+/**
+ * Release a version registry.
+ *
+ * @param registry The registry to destroy.
+ */
+extern void elf64_version_registry_destroy(Elf64_Version_Registry* registry);
+
+/**
+ * Get the ID of a version name, giving it the next ID if it has none.
+ *
+ * @note The name is not copied. It must outlive the registry, which it does
+ * if it belongs to an image in the same link map.
+ *
+ * @param registry The registry to update.
+ * @param name The version name.
+ * @param result Location to return the name's ID. Never
+ * `ELF64_VERSION_ID_NONE`.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_version_registry_intern(
+    Elf64_Version_Registry* registry, const char* name, prim_u32* result);
+
+#endif
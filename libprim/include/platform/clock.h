@@ -0,0 +1,26 @@
+/**
+ * @file include/platform/clock.h
+ *
+ * Provides access to the host's monotonic clock.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef PLATFORM_CLOCK_H
+#define PLATFORM_CLOCK_H
+
+#include "platform/types.h"
+
+/**
+ * Read the host's monotonic clock.
+ *
+ * The clock's epoch is unspecified, so readings are only meaningful relative
+ * to each other.
+ *
+ * @return The current time, in nanoseconds.
+ */
+extern prim_u64 prim_clock_now(void);
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * @file include/platform/exec.h
+ *
+ * `exec.h` transfers control of the current process to a loaded program,
+ * the way the kernel starts a program after `execve`.
+ *
+ * The program's initial stack, holding its arguments, environment and
+ * auxiliary vector, is built by the caller. `prim_exec_jump` switches to it,
+ * clears the registers the ABI requires, and jumps to the entry point. It
+ * never returns.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef PLATFORM_EXEC_H
+#define PLATFORM_EXEC_H
+
+#include "platform/types.h"
+#include "status.h"
+
+/** End of the auxiliary vector. */
+#define PRIM_AT_NULL 0
+
+/** Address of the program headers. */
+#define PRIM_AT_PHDR 3
+
+/** Size of a program header. */
+#define PRIM_AT_PHENT 4
+
+/** Number of program headers. */
+#define PRIM_AT_PHNUM 5
+
+/** Page size. */
+#define PRIM_AT_PAGESZ 6
+
+/** Load address of the interpreter. Zero for static programs. */
+#define PRIM_AT_BASE 7
+
+/** Flags. Always zero. */
+#define PRIM_AT_FLAGS 8
+
+/** The program's entry point. */
+#define PRIM_AT_ENTRY 9
+
+/** Real user ID. */
+#define PRIM_AT_UID 11
+
+/** Effective user ID. */
+#define PRIM_AT_EUID 12
+
+/** Real group ID. */
+#define PRIM_AT_GID 13
+
+/** Effective group ID. */
+#define PRIM_AT_EGID 14
+
+/** Address of a string naming the platform. */
+#define PRIM_AT_PLATFORM 15
+
+/** Processor capability bits. */
+#define PRIM_AT_HWCAP 16
+
+/** Frequency of `times`. */
+#define PRIM_AT_CLKTCK 17
+
+/** Non-zero if the program is running with elevated privileges. */
+#define PRIM_AT_SECURE 23
+
+/** Address of 16 random bytes. */
+#define PRIM_AT_RANDOM 25
+
+/** More processor capability bits. */
+#define PRIM_AT_HWCAP2 26
+
+/** Address of the program's path. */
+#define PRIM_AT_EXECFN 31
+
+/** Address of the vDSO's ELF header. */
+#define PRIM_AT_SYSINFO_EHDR 33
+
+/** Minimum signal stack size. */
+#define PRIM_AT_MINSIGSTKSZ 51
+
+/**
+ * Checks if the host can start programs with `prim_exec_jump`.
+ *
+ * @return `STATUS_OKAY` if it can, `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus prim_exec_is_supported(void);
+
+/**
+ * Read an entry of the current process's auxiliary vector.
+ *
+ * @param type The entry's `PRIM_AT_*` type.
+ * @return The entry's value, or zero if the process has no such entry.
+ */
+extern prim_usize prim_exec_get_auxiliary(prim_usize type);
+
+/**
+ * Fill a buffer with random bytes from the host.
+ *
+ * @param buffer The buffer to fill.
+ * @param size Length of the buffer, in bytes.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+extern PrimStatus prim_exec_get_random(void* buffer, prim_usize size);
+
+/**
+ * Get the current process's environment.
+ *
+ * @return The environment, as a `NULL` terminated array of `name=value`
+ * strings.
+ */
+extern char** prim_exec_get_environment(void);
+
+/**
+ * Switch to a program's initial stack and jump to its entry point.
+ *
+ * @param entry The program's entry point.
+ * @param stack The initial stack pointer, addressing the argument count.
+ * Must be 16-byte aligned.
+ */
+extern void prim_exec_jump(void* entry, void* stack);
+
+#endif
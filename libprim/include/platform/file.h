@@ -23,6 +23,7 @@
 #ifndef PLATFORM_FILE_H
 #define PLATFORM_FILE_H
 
+#include "platform/types.h"
 #include "status.h"
 #include <stdio.h>
 
@@ -35,6 +36,38 @@
  */
 typedef FILE* prim_file_handle;
 
+/**
+ * Identifies a version of a file: two identities are equal only if they were
+ * read from the same, unmodified, file.
+ */
+typedef struct
+{
+    /** The device holding the file. */
+    prim_u64 device;
+
+    /** The file's number on its device. */
+    prim_u64 inode;
+
+    /** The file's size, in bytes. */
+    prim_u64 size;
+
+    /** Time the file was last modified, in nanoseconds since the epoch. */
+    prim_u64 modified;
+} PrimFileIdentity;
+
+/** A list of file paths, each owned by the list. */
+typedef struct
+{
+    /** The paths. */
+    char** paths;
+
+    /** Number of paths in `paths`. */
+    prim_usize count;
+
+    /** Number of paths `paths` has room for. */
+    prim_usize capacity;
+} PrimFileList;
+
 /**
  * Open the file specified by `path`.
  *
@@ -68,4 +101,97 @@ extern PrimStatus prim_fread(
  */
 extern PrimStatus prim_fseek(prim_file_handle file_handle, size_t offset);
 
+/**
+ * Create the file specified by `path` for writing, replacing any existing
+ * file.
+ *
+ * @param path Path to a file to create.
+ * @param file_handle Location to return a handle to the
+ * file.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_fcreate(const char* path, prim_file_handle* file_handle);
+
+/**
+ * Write data from memory to a file.
+ *
+ * @param source Data to write.
+ * @param size Size of a data record.
+ * @param count Number of records (of size `size`) to write.
+ * @param file_handle File to write to.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_fwrite(const void* source, size_t size, size_t count,
+    prim_file_handle file_handle);
+
+/**
+ * Close a file opened by `prim_fopen` or `prim_fcreate`.
+ *
+ * @param file_handle The file to close.
+ * @return STATUS_OKAY on success, otherwise an error code. Buffered writes
+ * which fail to reach the file are reported here.
+ */
+extern PrimStatus prim_fclose(prim_file_handle file_handle);
+
+/**
+ * Rename a file, replacing any file already at `to`.
+ *
+ * @param from The file's current path.
+ * @param to The file's new path.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_frename(const char* from, const char* to);
+
+/**
+ * Delete a file.
+ *
+ * @param path The file to delete.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_fremove(const char* path);
+
+/**
+ * Check if a readable file exists at `path`, without opening it.
+ *
+ * @param path Path to check.
+ * @return STATUS_OKAY if the file exists and is readable, STATUS_BAD_FILE
+ * otherwise.
+ */
+extern PrimStatus prim_file_exists(const char* path);
+
+/**
+ * Read the identity of the file at `path`.
+ *
+ * @param path Path to the file.
+ * @param identity Location to return the file's identity.
+ * @return STATUS_OKAY on success, STATUS_BAD_FILE if the file does not exist.
+ */
+extern PrimStatus prim_file_identity(
+    const char* path, PrimFileIdentity* identity);
+
+/**
+ * List the regular files under a set of directories.
+ *
+ * Directories are walked a level at a time, with each level's directories
+ * read in parallel. Symbolic links beneath the roots are not followed, and
+ * directories which cannot be read are skipped. A root which is not a
+ * directory is listed as it is. Files are listed in no particular order.
+ *
+ * @param roots Paths of the directories to walk.
+ * @param root_count Number of paths in `roots`.
+ * @param files Location to return the files found. Each path begins with the
+ * root it was found under.
+ * @return STATUS_OKAY on success, otherwise an error code. Nothing is left
+ * allocated on failure.
+ */
+extern PrimStatus prim_list_files(
+    const char* const* roots, prim_usize root_count, PrimFileList* files);
+
+/**
+ * Release a file list.
+ *
+ * @param files The list to release.
+ */
+extern void prim_free_file_list(PrimFileList* files);
+
 #endif
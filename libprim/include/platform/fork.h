@@ -0,0 +1,75 @@
+/**
+ * @file include/platform/fork.h
+ *
+ * `fork.h` forks the current process, and exchanges fixed size messages with
+ * other processes over pipes.
+ *
+ * A forked child shares nothing with its parent but the pages it has not yet
+ * written, so an image loaded and relocated once can be started many times
+ * for the cost of copying the pages each run dirties.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef PLATFORM_FORK_H
+#define PLATFORM_FORK_H
+
+#include "platform/types.h"
+#include "status.h"
+
+/** Identifies a process to the host. */
+typedef prim_s64 prim_process_id;
+
+/**
+ * Fork the current process.
+ *
+ * Flush buffered output first, or the child will write it again.
+ *
+ * @param child Location to return the child's ID in the parent, and zero in
+ * the child.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_fork(prim_process_id* child);
+
+/**
+ * Wait for a child process to exit.
+ *
+ * @param child The child to wait for.
+ * @param result Location to return the child's wait status, as the host
+ * encodes it.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_wait(prim_process_id child, prim_s32* result);
+
+/**
+ * Read exactly `size` bytes from a pipe.
+ *
+ * @param descriptor The pipe to read from.
+ * @param buffer Location to store the bytes read.
+ * @param size Number of bytes to read.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the pipe was closed
+ * before any bytes were read, otherwise an error code.
+ */
+extern PrimStatus prim_pipe_read(int descriptor, void* buffer, prim_usize size);
+
+/**
+ * Write exactly `size` bytes to a pipe.
+ *
+ * @param descriptor The pipe to write to.
+ * @param buffer The bytes to write.
+ * @param size Number of bytes to write.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_pipe_write(
+    int descriptor, const void* buffer, prim_usize size);
+
+/**
+ * Close a pipe.
+ *
+ * @param descriptor The pipe to close.
+ */
+extern void prim_pipe_close(int descriptor);
+
+#endif
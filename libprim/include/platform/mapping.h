@@ -0,0 +1,388 @@
+/**
+ * @file include/platform/mapping.h
+ *
+ * `mapping.h` provides abstraction of the platform's memory mapped file
+ * services.
+ *
+ * Mapping a binary lets Prim touch only the pages it actually reads, rather
+ * than copying the whole file into memory up front. Platforms without memory
+ * mapped files can implement this interface by reading the file into an
+ * allocated buffer.
+ *
+ * This version of `mapping.h` is configured for a POSIX userspace.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef PLATFORM_MAPPING_H
+#define PLATFORM_MAPPING_H
+
+#include "platform/types.h"
+#include "status.h"
+
+/** A read-only view of a file's contents in memory. */
+typedef struct
+{
+    /** Start of the file contents in memory. */
+    const prim_u8* data;
+
+    /** Length of the file contents, in bytes. */
+    prim_usize size;
+
+    /** Host file descriptor backing the mapping, or -1. */
+    int file;
+} PrimMapping;
+
+/** A file opened to be mapped a window at a time, rather than whole. */
+typedef struct
+{
+    /** Host file descriptor. */
+    int file;
+
+    /** Length of the file, in bytes. */
+    prim_usize size;
+} PrimWindowedFile;
+
+/** A window of a file mapped into memory by a windowed view. */
+typedef struct
+{
+    /** The mapped window, or no data if the slot is empty. */
+    PrimMapping mapping;
+
+    /** Offset of the window in the file. */
+    prim_usize offset;
+
+    /** When the window was last used, by the view's clock. */
+    prim_u64 used;
+} PrimWindow;
+
+/**
+ * A view of a whole file, backed by a bounded number of fixed size windows.
+ *
+ * Windows are aligned to the window size, mapped when a read first needs
+ * them, and replaced least recently used first, so a view never has more
+ * than `window_count * window_size` bytes of the file mapped however large
+ * the file is. Ranges which span windows are stitched together in a buffer
+ * owned by the view.
+ *
+ * @note A view is not thread safe: every access updates its window cache.
+ */
+typedef struct
+{
+    /** The file. */
+    PrimWindowedFile file;
+
+    /** The window cache. */
+    PrimWindow* windows;
+
+    /** Number of entries in `windows`. */
+    prim_usize window_count;
+
+    /** Length of each window, in bytes. A multiple of the page size. */
+    prim_usize window_size;
+
+    /** Counts accesses, to find the least recently used window. */
+    prim_u64 clock;
+
+    /** Buffer holding the last range stitched from several windows. */
+    prim_u8* stitched;
+
+    /** Length of `stitched`, in bytes. */
+    prim_usize stitched_size;
+} PrimWindowedView;
+
+/** Mapped memory may be read. */
+#define PRIM_PROTECT_READ 0x1
+
+/** Mapped memory may be written. */
+#define PRIM_PROTECT_WRITE 0x2
+
+/** Mapped memory may be executed. */
+#define PRIM_PROTECT_EXECUTE 0x4
+
+/** Access pattern hints for mapped file contents. */
+typedef enum PrimMapAdvice
+{
+    /** No special treatment. */
+    PRIM_ADVICE_NORMAL,
+
+    /** The range will be accessed soon; start reading it in now. */
+    PRIM_ADVICE_WILLNEED,
+
+    /** The range will be accessed in order, from low to high offsets. */
+    PRIM_ADVICE_SEQUENTIAL,
+
+    /** The range will be accessed in no particular order. */
+    PRIM_ADVICE_RANDOM,
+
+    /** The range will not be accessed again soon. */
+    PRIM_ADVICE_DONTNEED,
+
+    /** The range will be accessed soon; read it in and map it now. */
+    PRIM_ADVICE_POPULATE,
+} PrimMapAdvice;
+
+/**
+ * Map the file specified by `path` into memory, read-only.
+ *
+ * @note Mapping an empty file produces a mapping with `NULL` data and a size
+ * of zero.
+ *
+ * @param path Path to the file to map.
+ * @param mapping Location to return the mapping.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_file(const char* path, PrimMapping* mapping);
+
+/**
+ * Release a mapping created by `prim_map_file`.
+ *
+ * @param mapping The mapping to release.
+ */
+extern void prim_unmap_file(PrimMapping* mapping);
+
+/**
+ * Open the file specified by `path` to be mapped a window at a time.
+ *
+ * @param path Path to the file to open.
+ * @param file Location to return the opened file.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_open_windowed(
+    const char* path, PrimWindowedFile* file);
+
+/**
+ * Close a file opened by `prim_map_open_windowed`. Windows mapped from it
+ * stay mapped.
+ *
+ * @param file The file to close.
+ */
+extern void prim_map_close_windowed(PrimWindowedFile* file);
+
+/**
+ * Map a window of a file into memory, read-only.
+ *
+ * @param file The file to map from.
+ * @param offset Offset of the window in the file. A multiple of the page
+ * size.
+ * @param size Length of the window, in bytes. Must not extend past the end
+ * of the file.
+ * @param window Location to return the window. Its data starts at `offset`
+ * in the file, and it does not own the file's descriptor.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the window is outside the
+ * file, otherwise an error code.
+ */
+extern PrimStatus prim_map_window(const PrimWindowedFile* file,
+    prim_usize offset, prim_usize size, PrimMapping* window);
+
+/**
+ * Release a window mapped by `prim_map_window`.
+ *
+ * @param window The window to release.
+ */
+extern void prim_unmap_window(PrimMapping* window);
+
+/**
+ * Open a file as a windowed view.
+ *
+ * @param path Path to the file to open.
+ * @param window_size Length of each window, in bytes. Rounded up to the page
+ * size.
+ * @param window_count Number of windows to keep mapped. At least one.
+ * @param view Location to return the view.
+ * @return STATUS_OKAY on success, STATUS_INVALID if `window_count` is zero,
+ * otherwise an error code.
+ */
+extern PrimStatus prim_map_open_view(const char* path, prim_usize window_size,
+    prim_usize window_count, PrimWindowedView* view);
+
+/**
+ * Close a windowed view, and unmap its windows.
+ *
+ * @param view The view to close.
+ */
+extern void prim_map_close_view(PrimWindowedView* view);
+
+/**
+ * Get a range of a file through a windowed view.
+ *
+ * The range is served straight from a mapped window when it fits in one, and
+ * is otherwise copied into the view's stitching buffer.
+ *
+ * @param view The view to read through.
+ * @param offset Offset of the range in the file.
+ * @param size Length of the range, in bytes.
+ * @param result Location to return the range. Valid until the next access
+ * through the view.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the range is outside the
+ * file, otherwise an error code.
+ */
+extern PrimStatus prim_map_view_get(PrimWindowedView* view, prim_usize offset,
+    prim_usize size, const prim_u8** result);
+
+/**
+ * Copy a range of a file through a windowed view.
+ *
+ * @param view The view to read through.
+ * @param offset Offset of the range in the file.
+ * @param buffer Location to copy the range to.
+ * @param size Length of the range, in bytes.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the range is outside the
+ * file, otherwise an error code.
+ */
+extern PrimStatus prim_map_view_read(PrimWindowedView* view, prim_usize offset,
+    void* buffer, prim_usize size);
+
+/**
+ * Advise the platform how a range of a mapping will be accessed.
+ *
+ * The range is widened to page boundaries as required by the platform. Advice
+ * is only a hint: platforms which cannot act on it report success.
+ *
+ * @param mapping The mapping the range belongs to.
+ * @param offset Offset to the start of the range, in bytes.
+ * @param length Length of the range, in bytes.
+ * @param advice The expected access pattern.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the range is outside the
+ * mapping.
+ */
+extern PrimStatus prim_map_advise(const PrimMapping* mapping, prim_usize offset,
+    prim_usize length, PrimMapAdvice advice);
+
+/**
+ * Advise the platform how a range of mapped memory will be accessed.
+ *
+ * The range is widened to page boundaries as required by the platform. Advice
+ * is only a hint: platforms which cannot act on it report success.
+ *
+ * @param address Start of the memory.
+ * @param size Length of the memory, in bytes.
+ * @param advice The expected access pattern.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the advice is unknown.
+ */
+extern PrimStatus prim_map_advise_memory(
+    void* address, prim_usize size, PrimMapAdvice advice);
+
+/**
+ * Get the size of a page of memory on the host.
+ *
+ * @return The page size, in bytes.
+ */
+extern prim_usize prim_map_page_size(void);
+
+/**
+ * Reserve a range of address space, without backing memory.
+ *
+ * Reserved memory can not be accessed until part of it is replaced by
+ * `prim_map_file_range` or `prim_map_anonymous`.
+ *
+ * @param address Address the range must start at, or `NULL` to let the
+ * platform choose.
+ * @param size Length of the range, in bytes. A multiple of the page size.
+ * @param result Location to return the start of the range.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the requested address is
+ * unavailable, otherwise an error code.
+ */
+extern PrimStatus prim_map_reserve(
+    void* address, prim_usize size, void** result);
+
+/**
+ * Reserve a range of address space starting at a multiple of `alignment`,
+ * without backing memory.
+ *
+ * @param size Length of the range, in bytes. A multiple of the page size.
+ * @param alignment Alignment of the range's start. A power of two, and a
+ * multiple of the page size.
+ * @param result Location to return the start of the range.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_reserve_aligned(
+    prim_usize size, prim_usize alignment, void** result);
+
+/**
+ * Map part of a mapped file privately at a fixed address.
+ *
+ * Writes to the memory are private, and never reach the file.
+ *
+ * @param mapping The mapped file to map from.
+ * @param offset Offset of the range in the file. A multiple of the page size.
+ * @param address Address to map the range at. A multiple of the page size.
+ * @param size Length of the range, in bytes.
+ * @param protection Bitfield of `PRIM_PROTECT_*` access rights.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_file_range(const PrimMapping* mapping,
+    prim_usize offset, void* address, prim_usize size, prim_u32 protection);
+
+/**
+ * Map zero filled memory at a fixed address.
+ *
+ * @param address Address to map the memory at. A multiple of the page size.
+ * @param size Length of the memory, in bytes.
+ * @param protection Bitfield of `PRIM_PROTECT_*` access rights.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_anonymous(
+    void* address, prim_usize size, prim_u32 protection);
+
+/**
+ * Change the access rights of mapped memory.
+ *
+ * @param address Start of the memory. A multiple of the page size.
+ * @param size Length of the memory, in bytes.
+ * @param protection Bitfield of `PRIM_PROTECT_*` access rights.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_protect(
+    void* address, prim_usize size, prim_u32 protection);
+
+/**
+ * Get the size of the huge pages the host can back anonymous memory with.
+ *
+ * @return The huge page size, in bytes, or zero if the host has none.
+ */
+extern prim_usize prim_map_huge_page_size(void);
+
+/**
+ * Ask the host to back anonymous memory with huge pages when it is first
+ * touched. Only whole, aligned huge pages in the range can be backed.
+ *
+ * @param address Start of the memory. A multiple of the page size.
+ * @param size Length of the memory, in bytes.
+ * @return STATUS_OKAY if the host accepted the request, STATUS_INVALID if it
+ * does not support huge pages.
+ */
+extern PrimStatus prim_map_request_huge_pages(void* address, prim_usize size);
+
+/**
+ * Count the huge pages currently backing a range of memory.
+ *
+ * @param address Start of the memory. A multiple of the page size.
+ * @param size Length of the memory, in bytes.
+ * @return The number of huge pages, or zero if the host can not tell.
+ */
+extern prim_usize prim_map_count_huge_pages(void* address, prim_usize size);
+
+/**
+ * Find which pages of a range of mapped memory this process has touched.
+ *
+ * @param address Start of the memory. A multiple of the page size.
+ * @param size Length of the memory, in bytes.
+ * @param touched Location to return one byte per page, non-zero if the page
+ * has been touched.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_get_touched(
+    const void* address, prim_usize size, prim_u8* touched);
+
+/**
+ * Release reserved or mapped memory.
+ *
+ * @param address Start of the memory. A multiple of the page size.
+ * @param size Length of the memory, in bytes.
+ */
+extern void prim_map_release(void* address, prim_usize size);
+
+#endif
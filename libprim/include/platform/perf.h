@@ -0,0 +1,59 @@
+/**
+ * @file include/platform/perf.h
+ *
+ * `perf.h` describes code loaded by Prim to the host's profiler.
+ *
+ * The kernel only knows about code mapped by `execve` or `mmap` from a file it
+ * can symbolise. Code mapped by Prim's loader is attributed to the binary's
+ * file, but profilers do not know the load address Prim chose. Prim writes
+ * the addresses of loaded functions out in the formats understood by Linux
+ * `perf`:
+ *
+ * - A perf map, `/tmp/perf-<pid>.map`, with a line per function.
+ * - A jitdump, `<directory>/jit-<pid>.dump`, with a copy of each function's
+ *   code. Record with `perf record -k mono`, then run `perf inject --jit`.
+ *
+ * Files are opened on first use and shared by every image loaded by the
+ * process. A forked child starts its own files.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef PLATFORM_PERF_H
+#define PLATFORM_PERF_H
+
+#include "platform/types.h"
+#include "status.h"
+
+/**
+ * Add a function to the process's perf map.
+ *
+ * @param address Address of the function in memory.
+ * @param size Length of the function, in bytes.
+ * @param name Name of the function.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_perf_map_add(
+    prim_usize address, prim_usize size, const char* name);
+
+/**
+ * Add a function to the process's jitdump.
+ *
+ * @param directory Directory to create the jitdump in, if it is not already
+ * open. `NULL` selects `/tmp`.
+ * @param code Address of the function in memory.
+ * @param size Length of the function, in bytes.
+ * @param name Name of the function.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_jitdump_add(const char* directory, const void* code,
+    prim_usize size, const char* name);
+
+/**
+ * Flush any buffered perf map and jitdump records to their files.
+ */
+extern void prim_perf_flush(void);
+
+#endif
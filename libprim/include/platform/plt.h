@@ -0,0 +1,56 @@
+/**
+ * @file include/platform/plt.h
+ *
+ * `plt.h` provides the trampoline lazily bound procedure linkage table (PLT)
+ * entries jump to on their first call.
+ *
+ * A lazily bound PLT entry pushes its relocation index and jumps to the
+ * PLT's first entry, which pushes the second global offset table (GOT) word
+ * and jumps through the third. Prim stores a `PrimPltContext` in the second
+ * word and `prim_plt_trampoline` in the third. The trampoline saves the
+ * caller's argument registers, including the whole vector state, asks the
+ * context to bind the relocation, and tail calls the bound function with the
+ * original arguments.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef PLATFORM_PLT_H
+#define PLATFORM_PLT_H
+
+#include "platform/types.h"
+#include "status.h"
+
+/** Binds lazy PLT entries for one image. */
+typedef struct PrimPltContext
+{
+    /**
+     * Resolve a PLT relocation and patch its GOT entry. Must stay the first
+     * member: the trampoline calls through it.
+     *
+     * @param context The context stored in the image's GOT.
+     * @param index The index of the relocation in the PLT relocations.
+     * @return The function's address. The process is stopped if this is
+     * `NULL`.
+     */
+    void* (*bind)(struct PrimPltContext* context, prim_usize index);
+} PrimPltContext;
+
+/**
+ * Checks if the host supports lazy binding with `prim_plt_trampoline`.
+ *
+ * Must return `STATUS_OKAY` before the trampoline is first used.
+ *
+ * @return `STATUS_OKAY` if lazy binding is supported, `STATUS_INVALID`
+ * otherwise.
+ */
+extern PrimStatus prim_plt_is_supported(void);
+
+/**
+ * The lazy binding trampoline. Never called directly.
+ */
+extern void prim_plt_trampoline(void);
+
+#endif
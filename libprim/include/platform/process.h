@@ -0,0 +1,22 @@
+/**
+ * @file include/platform/process.h
+ *
+ * Provides access to the host's description of the current process.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef PLATFORM_PROCESS_H
+#define PLATFORM_PROCESS_H
+
+/**
+ * Read an environment variable of the current process.
+ *
+ * @param name The variable to read, for example `LD_LIBRARY_PATH`.
+ * @return The variable's value, or `NULL` if it is not set.
+ */
+extern const char* prim_get_environment(const char* name);
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * @file include/platform/sdt.h
+ *
+ * A minimal, header-only implementation of the SystemTap statically defined
+ * tracing (SDT) probe ABI, used by `perf`, `bpftrace` and SystemTap.
+ *
+ * Each probe assembles to a single `nop` in the code, plus a
+ * `.note.stapsdt` ELF note recording the probe's address, provider, name and
+ * the location of its arguments. Tracers find probes by reading the notes,
+ * and replace the `nop` with a breakpoint only while they are attached, so an
+ * unattached probe costs one `nop`.
+ *
+ * Probe arguments are passed as 64-bit unsigned integers. Pointers are cast
+ * to integers, so tracers can read strings with `str(arg0)` or similar.
+ *
+ * This file follows the layout of `sys/sdt.h` from SystemTap, so Prim can
+ * provide probes without depending on SystemTap's headers. It only supports
+ * x86-64 GCC and Clang: elsewhere probes compile to nothing.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef PLATFORM_SDT_H
+#define PLATFORM_SDT_H
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+/** Probes are supported on this platform. */
+#define PRIM_SDT_SUPPORTED 1
+
+/**
+ * Assembly for a probe site and its `.note.stapsdt` note.
+ *
+ * The note holds the probe address, the address of `_.stapsdt.base` (which
+ * tracers use to correct for prelinking), and a zero semaphore address,
+ * followed by the provider, name and argument strings.
+ */
+#define PRIM_SDT_ASM(provider, name, args)                                     \
+    "990: nop\n"                                                               \
+    ".pushsection .note.stapsdt,\"?\",\"note\"\n"                              \
+    ".balign 4\n"                                                              \
+    ".4byte 992f-991f, 994f-993f, 3\n"                                         \
+    "991: .asciz \"stapsdt\"\n"                                                \
+    "992: .balign 4\n"                                                         \
+    "993: .8byte 990b\n"                                                       \
+    ".8byte _.stapsdt.base\n"                                                  \
+    ".8byte 0\n"                                                               \
+    ".asciz \"" #provider "\"\n"                                               \
+    ".asciz \"" #name "\"\n"                                                   \
+    ".asciz \"" args "\"\n"                                                    \
+    "994: .balign 4\n"                                                         \
+    ".popsection\n"                                                            \
+    ".ifndef _.stapsdt.base\n"                                                 \
+    ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"    \
+    ".weak _.stapsdt.base\n"                                                   \
+    ".hidden _.stapsdt.base\n"                                                 \
+    "_.stapsdt.base: .space 1\n"                                               \
+    ".size _.stapsdt.base, 1\n"                                                \
+    ".popsection\n"                                                            \
+    ".endif\n"
+
+/** Cast a probe argument to the 64-bit integer tracers will read. */
+#define PRIM_SDT_ARG(arg) ((unsigned long long) (arg))
+
+/** Define a probe with no arguments. */
+#define PRIM_SDT_PROBE0(provider, name)                                        \
+    __asm__ __volatile__(PRIM_SDT_ASM(provider, name, ""))
+
+/** Define a probe with one argument. */
+#define PRIM_SDT_PROBE1(provider, name, v1)                                    \
+    __asm__ __volatile__(PRIM_SDT_ASM(provider, name, "8@%[a1]")             \
+                         :                                                     \
+                         : [a1] "nor"(PRIM_SDT_ARG(v1)))
+
+/** Define a probe with two arguments. */
+#define PRIM_SDT_PROBE2(provider, name, v1, v2)                                \
+    __asm__ __volatile__(                                                      \
+        PRIM_SDT_ASM(provider, name, "8@%[a1] 8@%[a2]")                        \
+        :                                                                      \
+        : [a1] "nor"(PRIM_SDT_ARG(v1)), [a2] "nor"(PRIM_SDT_ARG(v2)))
+
+/** Define a probe with three arguments. */
+#define PRIM_SDT_PROBE3(provider, name, v1, v2, v3)                            \
+    __asm__ __volatile__(                                                      \
+        PRIM_SDT_ASM(provider, name, "8@%[a1] 8@%[a2] 8@%[a3]")                \
+        :                                                                      \
+        : [a1] "nor"(PRIM_SDT_ARG(v1)), [a2] "nor"(PRIM_SDT_ARG(v2)),          \
+        [a3] "nor"(PRIM_SDT_ARG(v3)))
+
+/** Define a probe with four arguments. */
+#define PRIM_SDT_PROBE4(provider, name, v1, v2, v3, v4)                        \
+    __asm__ __volatile__(                                                      \
+        PRIM_SDT_ASM(provider, name, "8@%[a1] 8@%[a2] 8@%[a3] 8@%[a4]")        \
+        :                                                                      \
+        : [a1] "nor"(PRIM_SDT_ARG(v1)), [a2] "nor"(PRIM_SDT_ARG(v2)),          \
+        [a3] "nor"(PRIM_SDT_ARG(v3)), [a4] "nor"(PRIM_SDT_ARG(v4)))
+
+#else
+
+/** Probes compile to nothing on unsupported platforms. */
+#define PRIM_SDT_PROBE0(provider, name)
+
+/** Probes compile to nothing on unsupported platforms. */
+#define PRIM_SDT_PROBE1(provider, name, v1) ((void) (v1))
+
+/** Probes compile to nothing on unsupported platforms. */
+#define PRIM_SDT_PROBE2(provider, name, v1, v2) ((void) (v1), (void) (v2))
+
+/** Probes compile to nothing on unsupported platforms. */
+#define PRIM_SDT_PROBE3(provider, name, v1, v2, v3)                            \
+    ((void) (v1), (void) (v2), (void) (v3))
+
+/** Probes compile to nothing on unsupported platforms. */
+#define PRIM_SDT_PROBE4(provider, name, v1, v2, v3, v4)                        \
+    ((void) (v1), (void) (v2), (void) (v3), (void) (v4))
+
+#endif
+
+#endif
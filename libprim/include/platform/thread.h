@@ -0,0 +1,76 @@
+/**
+ * @file include/platform/thread.h
+ *
+ * Provides access to the host's threads, for running independent work in
+ * parallel.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef PLATFORM_THREAD_H
+#define PLATFORM_THREAD_H
+
+#include "platform/types.h"
+#include "status.h"
+
+/**
+ * A unit of parallel work.
+ *
+ * @param context The context passed to `prim_parallel_for`.
+ * @param index The index of the work item to run.
+ */
+typedef void (*PrimTask)(void* context, prim_usize index);
+
+/**
+ * A lock guarding short critical sections. Waiting threads yield rather than
+ * sleep, so a lock must never be held across slow work.
+ */
+typedef struct
+{
+    /** Non-zero while a thread holds the lock. */
+    prim_u32 held;
+} PrimLock;
+
+/** Initialiser for an unheld `PrimLock`. */
+#define PRIM_LOCK_INIT { 0 }
+
+/**
+ * Get the number of threads the host can run at once.
+ *
+ * @return The number of online processors, and at least one.
+ */
+extern prim_usize prim_thread_count(void);
+
+/**
+ * Run a task once for every index in `[0, count)`, spread across threads.
+ *
+ * The calling thread takes part in the work, and the function returns once
+ * every index has run. Indexes are handed out in increasing order, but may
+ * complete in any order.
+ *
+ * @param count The number of work items.
+ * @param task The task to run for each item.
+ * @param context Passed unchanged to every call of `task`.
+ * @return STATUS_OKAY once every item has run. Items run on the calling
+ * thread alone if no more threads can be started.
+ */
+extern PrimStatus prim_parallel_for(
+    prim_usize count, PrimTask task, void* context);
+
+/**
+ * Take a lock, waiting until it is free.
+ *
+ * @param lock The lock to take.
+ */
+extern void prim_lock_acquire(PrimLock* lock);
+
+/**
+ * Release a lock held by the calling thread.
+ *
+ * @param lock The lock to release.
+ */
+extern void prim_lock_release(PrimLock* lock);
+
+#endif
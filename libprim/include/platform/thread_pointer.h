@@ -0,0 +1,65 @@
+/**
+ * @file include/platform/thread_pointer.h
+ *
+ * `thread_pointer.h` runs loaded code on a thread pointer of Prim's choosing,
+ * so the code's thread local storage accesses reach a block laid out for
+ * its link map rather than the host's own TLS.
+ *
+ * While loaded code runs, the thread control block (TCB) at the thread
+ * pointer holds the host's thread pointer at
+ * `PRIM_THREAD_POINTER_HOST_OFFSET`, and the address of
+ * `prim_thread_pointer_tag` at `PRIM_THREAD_POINTER_TAG_OFFSET`, which marks
+ * the TCB as Prim's. The lazy binding trampoline uses them to return to the
+ * host's thread pointer while it binds, because Prim's own code relies on
+ * the host's TLS.
+ *
+ * @note Signal handlers installed by the host run on the switched thread
+ * pointer if a signal arrives while loaded code is running.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef PLATFORM_THREAD_POINTER_H
+#define PLATFORM_THREAD_POINTER_H
+
+#include "platform/types.h"
+#include "status.h"
+
+/** Offset of the host's thread pointer in a switched thread's TCB. */
+#define PRIM_THREAD_POINTER_HOST_OFFSET 16
+
+/** Offset of `prim_thread_pointer_tag`'s address in a switched TCB. */
+#define PRIM_THREAD_POINTER_TAG_OFFSET 24
+
+/** Smallest TCB `prim_thread_pointer_call` can use, in bytes. */
+#define PRIM_THREAD_POINTER_TCB_SIZE 32
+
+/** Marks the TCBs of thread pointers switched to by Prim. Never read. */
+extern const prim_u8 prim_thread_pointer_tag;
+
+/**
+ * Checks if the host supports switching the thread pointer.
+ *
+ * @return `STATUS_OKAY` if the thread pointer can be switched,
+ * `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus prim_thread_pointer_is_supported(void);
+
+/**
+ * Call an `int (void)` function with the thread pointer switched, then
+ * switch back to the host's thread pointer.
+ *
+ * @param thread_pointer The thread pointer to call the function on. Its TCB
+ * must be at least `PRIM_THREAD_POINTER_TCB_SIZE` bytes, with its first word
+ * pointing to itself.
+ * @param function The function to call.
+ * @param result Location to return the function's result.
+ * @return STATUS_OKAY if the function was called, STATUS_INVALID if the host
+ * does not support switching the thread pointer, otherwise an error code.
+ */
+extern PrimStatus prim_thread_pointer_call(
+    void* thread_pointer, int (*function)(void), int* result);
+
+#endif
@@ -0,0 +1,190 @@
+/**
+ * @file stats.h
+ *
+ * Counters and per-phase timers describing where Prim spends its time.
+ *
+ * Statistics are only collected when Prim is built with the `PRIM_STATS`
+ * Cmake option, which defines `PRIM_ENABLE_STATS`. Otherwise the recording
+ * macros expand to nothing, and the query functions report zeros.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include "platform/types.h"
+#include "status.h"
+
+/** Events counted by Prim. */
+typedef enum PrimStatsCounter
+{
+    /** Files opened or mapped. */
+    PRIM_STATS_OPENS,
+
+    /** Paths checked for existence, such as library search candidates. */
+    PRIM_STATS_PROBES,
+
+    /** Read calls made on files. */
+    PRIM_STATS_READS,
+
+    /** Seek calls made on files. */
+    PRIM_STATS_SEEKS,
+
+    /** Memory mappings created. */
+    PRIM_STATS_MAPS,
+
+    /** Bytes returned by read calls. */
+    PRIM_STATS_BYTES_READ,
+
+    /** Memory allocations made. */
+    PRIM_STATS_ALLOCATIONS,
+
+    /** Bytes of memory allocated. */
+    PRIM_STATS_BYTES_ALLOCATED,
+
+    /** Relocations applied. */
+    PRIM_STATS_RELOCATIONS,
+
+    /** Symbols looked up across a link map. */
+    PRIM_STATS_SYMBOL_LOOKUPS,
+
+    /** Symbol lookups answered by a link map's symbol cache. */
+    PRIM_STATS_SYMBOL_CACHE_HITS,
+
+    /** PLT entries bound on their first call. */
+    PRIM_STATS_LAZY_BINDS,
+
+    /** Number of counters. Not a counter. */
+    PRIM_STATS_COUNTER_COUNT,
+} PrimStatsCounter;
+
+/** Phases of parsing and loading timed by Prim. */
+typedef enum PrimStatsPhase
+{
+    /** Opening a binary and checking its file header. */
+    PRIM_PHASE_HEADER,
+
+    /** Reading section and segment header tables. */
+    PRIM_PHASE_TABLES,
+
+    /** Reading string tables and building name indexes. */
+    PRIM_PHASE_STRINGS,
+
+    /** Reading symbol tables. */
+    PRIM_PHASE_SYMBOLS,
+
+    /** Searching for needed libraries. */
+    PRIM_PHASE_RESOLVE,
+
+    /** Mapping segments into memory. */
+    PRIM_PHASE_LOAD,
+
+    /** Applying relocations. */
+    PRIM_PHASE_RELOCATE,
+
+    /** Number of phases. Not a phase. */
+    PRIM_PHASE_COUNT,
+} PrimStatsPhase;
+
+/** A snapshot of Prim's statistics. */
+typedef struct
+{
+    /** Totals for each `PrimStatsCounter`. */
+    prim_u64 counters[PRIM_STATS_COUNTER_COUNT];
+
+    /** Wall clock time spent in each `PrimStatsPhase`, in nanoseconds. */
+    prim_u64 phase_time[PRIM_PHASE_COUNT];
+
+    /** Number of times each `PrimStatsPhase` was entered. */
+    prim_u64 phase_entries[PRIM_PHASE_COUNT];
+} PrimStats;
+
+#ifdef PRIM_ENABLE_STATS
+
+#include "platform/clock.h"
+
+/** Add `amount` to a `PrimStatsCounter`. */
+#define PRIM_STATS_ADD(counter, amount)                                        \
+    prim_stats_add_count((counter), (prim_u64) (amount))
+
+/** Start a phase timer named `timer` in the current scope. */
+#define PRIM_STATS_PHASE_BEGIN(timer) const prim_u64 timer = prim_clock_now()
+
+/** Stop the phase timer `timer`, and charge its time to `phase`. */
+#define PRIM_STATS_PHASE_END(timer, phase)                                     \
+    prim_stats_add_phase_time((phase), prim_clock_now() - (timer))
+
+#else
+
+/** Statistics are disabled: counting costs nothing. */
+#define PRIM_STATS_ADD(counter, amount)
+
+/** Statistics are disabled: timing costs nothing. */
+#define PRIM_STATS_PHASE_BEGIN(timer)
+
+/** Statistics are disabled: timing costs nothing. */
+#define PRIM_STATS_PHASE_END(timer, phase)
+
+#endif
+
+/**
+ * Add to one of Prim's counters.
+ *
+ * @note Use `PRIM_STATS_ADD`, which compiles away when statistics are
+ * disabled, rather than calling this function directly.
+ *
+ * @param counter The counter to add to.
+ * @param amount The amount to add.
+ */
+extern void prim_stats_add_count(PrimStatsCounter counter, prim_u64 amount);
+
+/**
+ * Charge time to one of Prim's phases.
+ *
+ * @note Use `PRIM_STATS_PHASE_BEGIN` and `PRIM_STATS_PHASE_END`, which compile
+ * away when statistics are disabled, rather than calling this function
+ * directly.
+ *
+ * @param phase The phase to charge.
+ * @param time The time spent in the phase, in nanoseconds.
+ */
+extern void prim_stats_add_phase_time(PrimStatsPhase phase, prim_u64 time);
+
+/**
+ * Checks if Prim was built to collect statistics.
+ *
+ * @return `STATUS_OKAY` if statistics are collected, `STATUS_INVALID`
+ * otherwise.
+ */
+extern PrimStatus prim_stats_is_enabled(void);
+
+/**
+ * Take a snapshot of Prim's statistics.
+ *
+ * @param stats Location to return the snapshot.
+ */
+extern void prim_stats_get(PrimStats* stats);
+
+/** Reset all of Prim's statistics to zero. */
+extern void prim_stats_reset(void);
+
+/**
+ * Get a string with a human readable counter name.
+ *
+ * @param counter The counter to string-ify.
+ * @return A human readable counter name.
+ */
+extern const char* prim_stats_get_counter_string(PrimStatsCounter counter);
+
+/**
+ * Get a string with a human readable phase name.
+ *
+ * @param phase The phase to string-ify.
+ * @return A human readable phase name.
+ */
+extern const char* prim_stats_get_phase_string(PrimStatsPhase phase);
+
+#endif
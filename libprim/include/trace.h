@@ -0,0 +1,99 @@
+/**
+ * @file trace.h
+ *
+ * Static tracepoints in Prim's parsing and loading paths.
+ *
+ * When Prim is built with the `PRIM_USDT` Cmake option (the default), each
+ * tracepoint is a USDT probe under the `prim` provider. Probes can be listed
+ * and attached without rebuilding Prim, for example:
+ *
+ * ```sh
+ * $ bpftrace -l 'usdt:/path/to/prim:prim:*'
+ * $ perf probe -x /path/to/prim sdt_prim:image_open
+ * ```
+ *
+ * Probe arguments, in order:
+ *
+ * - `image_open`: path, file size.
+ * - `section_table_load`: entry count, table size in bytes.
+ * - `segment_table_load`: entry count, table size in bytes.
+ * - `strtab_build`: strings indexed, index slots.
+ * - `segment_map`: virtual address, memory size, segment flags.
+ * - `reloc_start`: relocation count.
+ * - `reloc_end`: relocation count, relocations applied.
+ * - `symbol_lookup`: symbol name, name hash, 1 if found or 0.
+ *
+ * When `PRIM_USDT` is off, tracepoints expand to nothing.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#ifdef PRIM_ENABLE_USDT
+
+#include "platform/sdt.h"
+
+/** An image has been opened. */
+#define PRIM_TRACE_IMAGE_OPEN(path, size)                                      \
+    PRIM_SDT_PROBE2(prim, image_open, path, size)
+
+/** A section header table has been loaded. */
+#define PRIM_TRACE_SECTION_TABLE_LOAD(count, size)                             \
+    PRIM_SDT_PROBE2(prim, section_table_load, count, size)
+
+/** A segment header table has been loaded. */
+#define PRIM_TRACE_SEGMENT_TABLE_LOAD(count, size)                             \
+    PRIM_SDT_PROBE2(prim, segment_table_load, count, size)
+
+/** A string table index has been built. */
+#define PRIM_TRACE_STRTAB_BUILD(strings, slots)                                \
+    PRIM_SDT_PROBE2(prim, strtab_build, strings, slots)
+
+/** A segment has been mapped into memory. */
+#define PRIM_TRACE_SEGMENT_MAP(address, size, flags)                           \
+    PRIM_SDT_PROBE3(prim, segment_map, address, size, flags)
+
+/** A batch of relocations is about to be applied. */
+#define PRIM_TRACE_RELOC_START(count) PRIM_SDT_PROBE1(prim, reloc_start, count)
+
+/** A batch of relocations has been applied. */
+#define PRIM_TRACE_RELOC_END(count, applied)                                   \
+    PRIM_SDT_PROBE2(prim, reloc_end, count, applied)
+
+/** A symbol has been looked up. */
+#define PRIM_TRACE_SYMBOL_LOOKUP(name, hash, found)                            \
+    PRIM_SDT_PROBE3(prim, symbol_lookup, name, hash, found)
+
+#else
+
+/** Tracing is disabled. */
+#define PRIM_TRACE_IMAGE_OPEN(path, size)
+
+/** Tracing is disabled. */
+#define PRIM_TRACE_SECTION_TABLE_LOAD(count, size)
+
+/** Tracing is disabled. */
+#define PRIM_TRACE_SEGMENT_TABLE_LOAD(count, size)
+
+/** Tracing is disabled. */
+#define PRIM_TRACE_STRTAB_BUILD(strings, slots)
+
+/** Tracing is disabled. */
+#define PRIM_TRACE_SEGMENT_MAP(address, size, flags)
+
+/** Tracing is disabled. */
+#define PRIM_TRACE_RELOC_START(count)
+
+/** Tracing is disabled. */
+#define PRIM_TRACE_RELOC_END(count, applied)
+
+/** Tracing is disabled. */
+#define PRIM_TRACE_SYMBOL_LOOKUP(name, hash, found)
+
+#endif
+
+#endif
@@ -0,0 +1,589 @@
+/**
+ * @file src/format/ar/archive.c
+ *
+ * Implements reading `ar` archives.
+ *
+ * @see `include/format/ar/archive.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "format/ar/archive.h"
+#include "format/elf64/image.h"
+#include "format/elf64/section/hash.h"
+#include "platform/mapping.h"
+#include "platform/memory.h"
+#include "platform/thread.h"
+#include "platform/types.h"
+#include "status.h"
+#include <string.h>
+
+/** Members of an archive being indexed. */
+typedef struct
+{
+    /** The members. */
+    Ar_Member* members;
+
+    /** Number of members in `members`. */
+    prim_usize count;
+
+    /** Number of members `members` has room for. */
+    prim_usize capacity;
+} Ar_Members;
+
+/** The special members found while indexing an archive. */
+typedef struct
+{
+    /** The symbol index, or `NULL` if the archive has none. */
+    const prim_u8* symbols;
+
+    /** Length of the symbol index, in bytes. */
+    prim_usize symbols_size;
+
+    /** Size of each symbol index word: 4, or 8 for `/SYM64/`. */
+    prim_usize word_size;
+
+    /** The long name table, or `NULL` if the archive has none. */
+    const char* long_names;
+
+    /** Length of the long name table, in bytes. */
+    prim_usize long_names_size;
+} Ar_Special_Members;
+
+/** A task being run for every member of an archive. */
+typedef struct
+{
+    /** The archive. */
+    const Ar_Archive* archive;
+
+    /** The task. */
+    Ar_Member_Task task;
+
+    /** The task's context. */
+    void* context;
+} Ar_Parse;
+
+/**
+ * Parse a space padded decimal header field.
+ *
+ * @param field The field.
+ * @param length Length of the field.
+ * @param result Location to return the value.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the field holds no
+ * number or anything other than a number.
+ */
+static PrimStatus ar_parse_decimal(
+    const char* field, const prim_usize length, prim_usize* result)
+{
+    prim_usize value = 0;
+    prim_usize i = 0;
+    for (i = 0; i < length && field[i] >= '0' && field[i] <= '9'; i++)
+    {
+        value = value * 10 + (prim_usize) (field[i] - '0');
+    }
+    if (i == 0)
+    {
+        return STATUS_INVALID;
+    }
+    for (; i < length; i++)
+    {
+        if (field[i] != ' ')
+        {
+            return STATUS_INVALID;
+        }
+    }
+    *result = value;
+    return STATUS_OKAY;
+}
+
+/**
+ * Read a big endian word from a symbol index.
+ *
+ * @param data The word.
+ * @param size Size of the word: 4 or 8.
+ * @return The word's value.
+ */
+static prim_u64 ar_read_word(const prim_u8* data, const prim_usize size)
+{
+    prim_u64 value = 0;
+    prim_usize i = 0;
+    for (i = 0; i < size; i++)
+    {
+        value = (value << 8U) | data[i];
+    }
+    return value;
+}
+
+/**
+ * Work out a regular member's name from its header.
+ *
+ * @param member The member, with its data set. BSD style names are moved out
+ * of the data.
+ * @param header The member's header.
+ * @param special The long name table found so far.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the name is
+ * malformed.
+ */
+static PrimStatus ar_read_member_name(Ar_Member* member,
+    const Ar_Member_Header* header, const Ar_Special_Members* special)
+{
+    PrimStatus status = STATUS_ERROR;
+    prim_usize value = 0;
+    prim_usize length = 0;
+    if (header->name[0] == '/')
+    {
+        /* GNU long names end with "/\n" in the long name table. */
+        status = ar_parse_decimal(header->name + 1, 15, &value);
+        if (status != STATUS_OKAY || value >= special->long_names_size)
+        {
+            return STATUS_INVALID;
+        }
+        member->name = special->long_names + value;
+        while (value + length < special->long_names_size
+            && member->name[length] != '\n')
+        {
+            length++;
+        }
+        if (length != 0 && member->name[length - 1] == '/')
+        {
+            length--;
+        }
+    }
+    else if (memcmp(header->name, "#1/", 3) == 0)
+    {
+        /* BSD long names are stored at the start of the member's data. */
+        status = ar_parse_decimal(header->name + 3, 13, &value);
+        if (status != STATUS_OKAY || value > member->size)
+        {
+            return STATUS_INVALID;
+        }
+        member->name = (const char*) member->data;
+        member->data += value;
+        member->size -= value;
+        while (length < value && member->name[length] != '\0')
+        {
+            length++;
+        }
+    }
+    else
+    {
+        member->name = header->name;
+        while (length < sizeof(header->name) && header->name[length] != '/'
+            && header->name[length] != ' ')
+        {
+            length++;
+        }
+    }
+    member->name_length = length;
+    return STATUS_OKAY;
+}
+
+/**
+ * Add a regular member to an archive being indexed.
+ *
+ * @param members The members to add to.
+ * @param member The member.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus ar_add_member(Ar_Members* members, const Ar_Member* member)
+{
+    PrimStatus status = STATUS_ERROR;
+    Ar_Member* grown = NULL;
+    if (members->count == members->capacity)
+    {
+        members->capacity
+            = members->capacity == 0 ? 64 : members->capacity * 2;
+        status = prim_malloc(
+            (void**) &grown, members->capacity * sizeof(Ar_Member));
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        if (members->members != NULL)
+        {
+            memcpy(grown, members->members, members->count * sizeof(Ar_Member));
+            prim_free(members->members);
+        }
+        members->members = grown;
+    }
+    members->members[members->count] = *member;
+    members->count++;
+    return STATUS_OKAY;
+}
+
+/**
+ * Walk an archive's member headers, collecting its regular members and its
+ * special members.
+ *
+ * @param archive The archive being opened.
+ * @param special Location to return the special members.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if a header is
+ * malformed, otherwise an error code.
+ */
+static PrimStatus ar_index_members(
+    Ar_Archive* archive, Ar_Special_Members* special)
+{
+    PrimStatus status = STATUS_OKAY;
+    Ar_Members members = { NULL, 0, 0 };
+    const Ar_Member_Header* header = NULL;
+    Ar_Member member;
+    prim_usize size = archive->mapping.size;
+    prim_usize offset = AR_MAGIC_SIZE;
+    prim_usize length = 0;
+    while (status == STATUS_OKAY && offset + sizeof(Ar_Member_Header) <= size)
+    {
+        header = (const Ar_Member_Header*) (archive->mapping.data + offset);
+        if (memcmp(header->terminator, "`\n", 2) != 0
+            || ar_parse_decimal(header->size, sizeof(header->size), &length)
+                != STATUS_OKAY
+            || length > size - offset - sizeof(Ar_Member_Header))
+        {
+            status = STATUS_INVALID;
+            break;
+        }
+        memset(&member, 0, sizeof(Ar_Member));
+        member.data = archive->mapping.data + offset + sizeof(Ar_Member_Header);
+        member.size = length;
+        member.offset = offset;
+        if (memcmp(header->name, "/ ", 2) == 0)
+        {
+            special->symbols = member.data;
+            special->symbols_size = length;
+            special->word_size = 4;
+        }
+        else if (memcmp(header->name, "/SYM64/ ", 8) == 0)
+        {
+            special->symbols = member.data;
+            special->symbols_size = length;
+            special->word_size = 8;
+        }
+        else if (memcmp(header->name, "// ", 3) == 0)
+        {
+            special->long_names = (const char*) member.data;
+            special->long_names_size = length;
+        }
+        else
+        {
+            status = ar_read_member_name(&member, header, special);
+            if (status == STATUS_OKAY)
+            {
+                status = ar_add_member(&members, &member);
+            }
+        }
+        /* Members are padded to an even offset. */
+        offset += sizeof(Ar_Member_Header) + length + (length & 1U);
+    }
+    archive->members = members.members;
+    archive->member_count = members.count;
+    return status;
+}
+
+/**
+ * Find a member by the offset of its header.
+ *
+ * @param archive The archive.
+ * @param offset The offset of the member's header.
+ * @param result Location to return the index of the member.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if no member starts at
+ * `offset`.
+ */
+static PrimStatus ar_find_member_at(
+    const Ar_Archive* archive, const prim_u64 offset, prim_usize* result)
+{
+    prim_usize low = 0;
+    prim_usize high = archive->member_count;
+    prim_usize middle = 0;
+    while (low < high)
+    {
+        middle = low + (high - low) / 2;
+        if (archive->members[middle].offset < offset)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    if (low == archive->member_count || archive->members[low].offset != offset)
+    {
+        return STATUS_INVALID;
+    }
+    *result = low;
+    return STATUS_OKAY;
+}
+
+/**
+ * Read the archive's symbol index, and hash its symbol names.
+ *
+ * The index holds a symbol count, a member header offset for each symbol,
+ * then each symbol's terminated name, with every number big endian.
+ *
+ * @param archive The archive being opened, with its members indexed.
+ * @param special The archive's special members.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the symbol index is
+ * malformed, otherwise an error code.
+ */
+static PrimStatus ar_index_symbols(
+    Ar_Archive* archive, const Ar_Special_Members* special)
+{
+    PrimStatus status = STATUS_ERROR;
+    const prim_u8* offsets = NULL;
+    const char* names = NULL;
+    const char* end = NULL;
+    prim_usize word = special->word_size;
+    prim_u64 count = 0;
+    prim_usize size = 1;
+    prim_usize slot = 0;
+    prim_usize i = 0;
+    if (special->symbols == NULL)
+    {
+        return STATUS_OKAY;
+    }
+    if (special->symbols_size < word)
+    {
+        return STATUS_INVALID;
+    }
+    count = ar_read_word(special->symbols, word);
+    if (count > (special->symbols_size - word) / word)
+    {
+        return STATUS_INVALID;
+    }
+    offsets = special->symbols + word;
+    names = (const char*) (offsets + count * word);
+    end = (const char*) (special->symbols + special->symbols_size);
+    if (count == 0)
+    {
+        return STATUS_OKAY;
+    }
+    status = prim_malloc(
+        (void**) &archive->symbol_members, count * sizeof(prim_usize));
+    if (status == STATUS_OKAY)
+    {
+        status = prim_malloc(
+            (void**) &archive->symbol_names, count * sizeof(const char*));
+    }
+    /* Keep the table at most half full, so probe sequences stay short. */
+    while (size < 2 * count)
+    {
+        size <<= 1U;
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = prim_malloc(
+            (void**) &archive->symbol_slots, size * sizeof(prim_usize));
+    }
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(archive->symbol_slots, 0, size * sizeof(prim_usize));
+    archive->symbol_slot_count = size;
+    archive->symbol_count = count;
+    for (i = 0; i < count; i++)
+    {
+        archive->symbol_names[i] = names;
+        names = memchr(names, '\0', (prim_usize) (end - names));
+        if (names == NULL
+            || ar_find_member_at(archive,
+                   ar_read_word(offsets + i * word, word),
+                   &archive->symbol_members[i])
+                != STATUS_OKAY)
+        {
+            return STATUS_INVALID;
+        }
+        names++;
+        slot = elf64_gnu_hash(archive->symbol_names[i]) & (size - 1);
+        while (archive->symbol_slots[slot] != 0)
+        {
+            slot = (slot + 1) & (size - 1);
+        }
+        archive->symbol_slots[slot] = i + 1;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Open an archive, and index its members and symbols.
+ *
+ * @param archive The archive to initialise.
+ * @param path Path to the archive.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the file is not an
+ * archive or is malformed, otherwise an error code. Nothing is left open on
+ * failure.
+ */
+extern PrimStatus ar_archive_open(Ar_Archive* archive, const char* path)
+{
+    PrimStatus status = STATUS_ERROR;
+    Ar_Special_Members special;
+    memset(archive, 0, sizeof(Ar_Archive));
+    memset(&special, 0, sizeof(Ar_Special_Members));
+    status = prim_map_file(path, &archive->mapping);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    if (archive->mapping.size < AR_MAGIC_SIZE
+        || memcmp(archive->mapping.data, AR_MAGIC, AR_MAGIC_SIZE) != 0)
+    {
+        ar_archive_close(archive);
+        return STATUS_INVALID;
+    }
+    /* The member headers are read in order, once. */
+    prim_map_advise(&archive->mapping, 0, archive->mapping.size,
+        PRIM_ADVICE_SEQUENTIAL);
+    status = ar_index_members(archive, &special);
+    if (status == STATUS_OKAY)
+    {
+        status = ar_index_symbols(archive, &special);
+    }
+    prim_map_advise(
+        &archive->mapping, 0, archive->mapping.size, PRIM_ADVICE_NORMAL);
+    if (status != STATUS_OKAY)
+    {
+        ar_archive_close(archive);
+    }
+    return status;
+}
+
+/**
+ * Close an archive. Images opened on its members must be closed first.
+ *
+ * @param archive The archive to close.
+ */
+extern void ar_archive_close(Ar_Archive* archive)
+{
+    if (archive->members != NULL)
+    {
+        prim_free(archive->members);
+    }
+    if (archive->symbol_members != NULL)
+    {
+        prim_free(archive->symbol_members);
+    }
+    if (archive->symbol_names != NULL)
+    {
+        prim_free((void*) archive->symbol_names);
+    }
+    if (archive->symbol_slots != NULL)
+    {
+        prim_free(archive->symbol_slots);
+    }
+    prim_unmap_file(&archive->mapping);
+    memset(archive, 0, sizeof(Ar_Archive));
+}
+
+/**
+ * Find the member which defines a symbol, through the symbol index.
+ *
+ * @param archive The archive to search.
+ * @param name The symbol to find.
+ * @param result Location to return the index of the member in `members`.
+ * @return STATUS_OKAY if the symbol is found, STATUS_INVALID if the archive
+ * has no symbol index or the symbol is not in it.
+ */
+extern PrimStatus ar_archive_find_symbol(
+    const Ar_Archive* archive, const char* name, prim_usize* result)
+{
+    prim_usize mask = archive->symbol_slot_count - 1;
+    prim_usize slot = 0;
+    prim_usize symbol = 0;
+    if (archive->symbol_slot_count == 0)
+    {
+        return STATUS_INVALID;
+    }
+    slot = elf64_gnu_hash(name) & mask;
+    while (archive->symbol_slots[slot] != 0)
+    {
+        symbol = archive->symbol_slots[slot] - 1;
+        if (strcmp(archive->symbol_names[symbol], name) == 0)
+        {
+            *result = archive->symbol_members[symbol];
+            return STATUS_OKAY;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return STATUS_INVALID;
+}
+
+/**
+ * Open an archive member as a lazily parsed ELF64 image.
+ *
+ * The image borrows the archive's mapping, so it must be closed before the
+ * archive. Members are only 2-byte aligned in the archive, so a member which
+ * is not 8-byte aligned is copied, and the image reads the copy instead.
+ *
+ * @param member The member to open.
+ * @param image The image to initialise.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the member is not an
+ * ELF64 object, otherwise an error code.
+ */
+extern PrimStatus ar_member_open_image(
+    const Ar_Member* member, Elf64_Image* image)
+{
+    PrimStatus status = STATUS_ERROR;
+    PrimMapping view;
+    prim_u8* copy = NULL;
+    view.data = member->data;
+    view.size = member->size;
+    /* The view is not page aligned in the file, so it can not be mapped. */
+    view.file = -1;
+    if ((prim_usize) member->data % 8 != 0)
+    {
+        if (member->size < sizeof(Elf64_Header))
+        {
+            return STATUS_INVALID;
+        }
+        status = prim_malloc((void**) &copy, member->size);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        memcpy(copy, member->data, member->size);
+        view.data = copy;
+    }
+    status = elf64_image_open_mapping(image, &view);
+    if (status != STATUS_OKAY)
+    {
+        if (copy != NULL)
+        {
+            prim_free(copy);
+        }
+        return status;
+    }
+    image->aligned_copy = copy;
+    return STATUS_OKAY;
+}
+
+/**
+ * Run the task for one member of an archive.
+ *
+ * @param context The `Ar_Parse` being run.
+ * @param index Index of the member.
+ */
+static void ar_parse_member_task(void* context, const prim_usize index)
+{
+    const Ar_Parse* parse = (const Ar_Parse*) context;
+    parse->task(parse->context, parse->archive, index);
+}
+
+/**
+ * Run a task for every member of an archive, spread across threads.
+ *
+ * @param archive The archive.
+ * @param task The task to run for each member.
+ * @param context Passed unchanged to every call of `task`.
+ * @return STATUS_OKAY once every member has been parsed.
+ */
+extern PrimStatus ar_archive_parse_members(
+    const Ar_Archive* archive, Ar_Member_Task task, void* context)
+{
+    Ar_Parse parse;
+    parse.archive = archive;
+    parse.task = task;
+    parse.context = context;
+    return prim_parallel_for(
+        archive->member_count, ar_parse_member_task, &parse);
+}
@@ -0,0 +1,556 @@
+/**
+ * @file src/format/elf64/core.c
+ *
+ * Implements reading ELF64 core files a window at a time.
+ *
+ * The `NT_PRSTATUS` layout decoded here is Linux's `struct elf_prstatus` for
+ * AMD64, and the `NT_FILE` layout is Linux's mapped file note.
+ *
+ * @see `include/format/elf64/core.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "format/elf64/core.h"
+#include "format/elf64/header/header.h"
+#include "format/elf64/header/ident.h"
+#include "format/elf64/header/type.h"
+#include "format/elf64/section/note.h"
+#include "format/elf64/segment/header.h"
+#include "format/elf64/segment/type.h"
+#include "platform/mapping.h"
+#include "platform/memory.h"
+#include "platform/types.h"
+#include "status.h"
+#include <string.h>
+
+/** Offset of the signal number in an `NT_PRSTATUS` descriptor. */
+#define ELF64_CORE_PRSTATUS_SIGNAL 12
+
+/** Offset of the thread ID in an `NT_PRSTATUS` descriptor. */
+#define ELF64_CORE_PRSTATUS_PID 32
+
+/** Offset of the saved registers in an `NT_PRSTATUS` descriptor. */
+#define ELF64_CORE_PRSTATUS_REGISTERS 112
+
+/**
+ * Map a range of a core which need not start on a page boundary, outside the
+ * core's window cache.
+ *
+ * @param core The core.
+ * @param offset Offset of the range in the core.
+ * @param size Length of the range, in bytes.
+ * @param window Location to return the mapped window.
+ * @param result Location to return the start of the range in the window.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the range is outside
+ * the core, otherwise an error code.
+ */
+static PrimStatus elf64_core_map_range(const Elf64_Core* core,
+    const prim_usize offset, const prim_usize size, PrimMapping* window,
+    const prim_u8** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    prim_usize start = offset & ~(prim_map_page_size() - 1);
+    if (offset > core->view.file.size || size > core->view.file.size - offset)
+    {
+        return STATUS_INVALID;
+    }
+    status = prim_map_window(
+        &core->view.file, start, offset - start + size, window);
+    if (status == STATUS_OKAY)
+    {
+        *result = window->data + (offset - start);
+    }
+    return status;
+}
+
+/**
+ * Read and check a core's file header.
+ *
+ * @param core The core being opened.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the file is not an
+ * ELF64 core, otherwise an error code.
+ */
+static PrimStatus elf64_core_read_header(Elf64_Core* core)
+{
+    PrimStatus status = STATUS_ERROR;
+    status = prim_map_view_read(
+        &core->view, 0, &core->header, sizeof(Elf64_Header));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    if (elf64_is_magic_okay(core->header.ident) != STATUS_OKAY
+        || elf64_get_class(core->header.ident) != ELF64_CLASS_64BIT
+        || elf64_parse_object_type(core->header.type) != ELF64_TYPE_CORE
+        || core->header.ph_entry_size != sizeof(Elf64_Segment_Header))
+    {
+        return STATUS_INVALID;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Sort a core's segments by start address.
+ *
+ * Cores list their segments in address order already, so an insertion sort
+ * usually makes a single pass.
+ *
+ * @param core The core being opened.
+ */
+static void elf64_core_sort_segments(Elf64_Core* core)
+{
+    Elf64_Core_Segment segment;
+    prim_usize i = 0;
+    prim_usize j = 0;
+    for (i = 1; i < core->segment_count; i++)
+    {
+        segment = core->segments[i];
+        for (j = i; j > 0 && core->segments[j - 1].start > segment.start; j--)
+        {
+            core->segments[j] = core->segments[j - 1];
+        }
+        core->segments[j] = segment;
+    }
+}
+
+/**
+ * Build the interval tree over a range of a core's sorted segments.
+ *
+ * @param core The core being opened.
+ * @param low Index of the first segment in the range.
+ * @param high Index after the last segment in the range.
+ * @return The highest end address in the range, or zero if it is empty.
+ */
+static Elf64_Address elf64_core_build_tree(
+    Elf64_Core* core, const prim_usize low, const prim_usize high)
+{
+    prim_usize middle = low + (high - low) / 2;
+    Elf64_Address max_end = 0;
+    Elf64_Address child = 0;
+    if (low >= high)
+    {
+        return 0;
+    }
+    max_end = core->segments[middle].end;
+    child = elf64_core_build_tree(core, low, middle);
+    max_end = child > max_end ? child : max_end;
+    child = elf64_core_build_tree(core, middle + 1, high);
+    max_end = child > max_end ? child : max_end;
+    core->segment_max_ends[middle] = max_end;
+    return max_end;
+}
+
+/**
+ * Read a core's program headers, and index its `PT_LOAD` segments.
+ *
+ * @param core The core being opened.
+ * @param note_offset Location to return the offset of the first note
+ * segment, if there is one.
+ * @param note_size Location to return the length of the first note segment,
+ * or zero if there is none.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if a segment lies
+ * outside the core, otherwise an error code.
+ */
+static PrimStatus elf64_core_read_segments(
+    Elf64_Core* core, prim_usize* note_offset, prim_usize* note_size)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Segment_Header* headers = NULL;
+    const Elf64_Segment_Header* segment = NULL;
+    Elf64_Core_Segment* indexed = NULL;
+    Elf64_Half count = core->header.ph_entry_count;
+    Elf64_Half index = 0;
+    if (count == 0)
+    {
+        return STATUS_INVALID;
+    }
+    status = prim_malloc(
+        (void**) &core->segments, count * sizeof(Elf64_Core_Segment));
+    if (status == STATUS_OKAY)
+    {
+        status = prim_malloc(
+            (void**) &core->segment_max_ends, count * sizeof(Elf64_Address));
+    }
+    /* Nothing else reads through the view until the headers are indexed. */
+    if (status == STATUS_OKAY)
+    {
+        status = prim_map_view_get(&core->view, core->header.ph_offset,
+            (prim_usize) count * sizeof(Elf64_Segment_Header),
+            (const prim_u8**) &headers);
+    }
+    for (index = 0; index < count && status == STATUS_OKAY; index++)
+    {
+        segment = &headers[index];
+        if (segment->p_offset > core->view.file.size
+            || segment->p_filesz > core->view.file.size - segment->p_offset)
+        {
+            status = STATUS_INVALID;
+        }
+        else if (elf64_get_segment_type(segment) == ELF64_PT_NOTE
+            && *note_size == 0)
+        {
+            *note_offset = segment->p_offset;
+            *note_size = segment->p_filesz;
+        }
+        else if (elf64_get_segment_type(segment) != ELF64_PT_LOAD)
+        {
+            continue;
+        }
+        else if (segment->p_filesz > segment->p_memsz)
+        {
+            status = STATUS_INVALID;
+        }
+        else if (segment->p_memsz != 0)
+        {
+            indexed = &core->segments[core->segment_count++];
+            indexed->start = segment->p_vaddr;
+            indexed->end = segment->p_vaddr + segment->p_memsz;
+            indexed->offset = segment->p_offset;
+            indexed->file_size = segment->p_filesz;
+            indexed->flags = segment->p_flags;
+        }
+    }
+    if (status == STATUS_OKAY)
+    {
+        elf64_core_sort_segments(core);
+        elf64_core_build_tree(core, 0, core->segment_count);
+    }
+    return status;
+}
+
+/**
+ * Decode a thread's `NT_PRSTATUS` note.
+ *
+ * @param thread Location to return the thread.
+ * @param descriptor The note's descriptor.
+ * @param size Length of the descriptor.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the note is too
+ * short.
+ */
+static PrimStatus elf64_core_decode_thread(Elf64_Core_Thread* thread,
+    const Elf64_Byte* descriptor, const Elf64_Word size)
+{
+    prim_u16 signal = 0;
+    if (size < ELF64_CORE_PRSTATUS_REGISTERS
+            + ELF64_CORE_REGISTER_COUNT * sizeof(prim_u64))
+    {
+        return STATUS_INVALID;
+    }
+    memcpy(&signal, descriptor + ELF64_CORE_PRSTATUS_SIGNAL, sizeof(signal));
+    memcpy(&thread->pid, descriptor + ELF64_CORE_PRSTATUS_PID,
+        sizeof(thread->pid));
+    thread->signal = signal;
+    memcpy(thread->registers, descriptor + ELF64_CORE_PRSTATUS_REGISTERS,
+        sizeof(thread->registers));
+    return STATUS_OKAY;
+}
+
+/**
+ * Read one word of an `NT_FILE` note. Notes are only 4-byte aligned, so the
+ * word is copied out rather than read in place.
+ *
+ * @param descriptor The note's descriptor.
+ * @param index Index of the word.
+ * @return The word.
+ */
+static prim_u64 elf64_core_file_word(
+    const Elf64_Byte* descriptor, const prim_usize index)
+{
+    prim_u64 word = 0;
+    memcpy(&word, descriptor + index * sizeof(prim_u64), sizeof(word));
+    return word;
+}
+
+/**
+ * Decode the `NT_FILE` note, listing the files mapped into the process.
+ *
+ * The note holds a mapping count and page size, a start, end and page
+ * offset for each mapping, then each mapping's terminated path.
+ *
+ * @param core The core being opened.
+ * @param descriptor The note's descriptor.
+ * @param size Length of the descriptor.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the note is
+ * malformed, otherwise an error code.
+ */
+static PrimStatus elf64_core_decode_files(Elf64_Core* core,
+    const Elf64_Byte* descriptor, const Elf64_Word size)
+{
+    PrimStatus status = STATUS_ERROR;
+    const char* path = NULL;
+    const char* end = (const char*) descriptor + size;
+    prim_u64 count = 0;
+    prim_usize i = 0;
+    if (size < 2 * sizeof(prim_u64) || core->files != NULL)
+    {
+        return STATUS_INVALID;
+    }
+    count = elf64_core_file_word(descriptor, 0);
+    if (count > (size - 2 * sizeof(prim_u64)) / (3 * sizeof(prim_u64)))
+    {
+        return STATUS_INVALID;
+    }
+    path = (const char*) descriptor + (2 + 3 * count) * sizeof(prim_u64);
+    if (count == 0)
+    {
+        return STATUS_OKAY;
+    }
+    status = prim_malloc((void**) &core->files, count * sizeof(Elf64_Core_File));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    core->file_count = count;
+    for (i = 0; i < count; i++)
+    {
+        core->files[i].start = elf64_core_file_word(descriptor, 2 + 3 * i);
+        core->files[i].end = elf64_core_file_word(descriptor, 3 + 3 * i);
+        core->files[i].offset = elf64_core_file_word(descriptor, 4 + 3 * i)
+            * elf64_core_file_word(descriptor, 1);
+        core->files[i].path = path;
+        path = memchr(path, '\0', (prim_usize) (end - path));
+        if (path == NULL)
+        {
+            return STATUS_INVALID;
+        }
+        path++;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Map a core's note segment, and decode its thread and file notes.
+ *
+ * @param core The core being opened.
+ * @param offset Offset of the note segment.
+ * @param size Length of the note segment, or zero if the core has none.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if a note is malformed,
+ * otherwise an error code.
+ */
+static PrimStatus elf64_core_read_notes(
+    Elf64_Core* core, const prim_usize offset, const prim_usize size)
+{
+    PrimStatus status = STATUS_OKAY;
+    const prim_u8* data = NULL;
+    const Elf64_Note* note = NULL;
+    const Elf64_Byte* descriptor = NULL;
+    Elf64_Xword cursor = 0;
+    prim_usize threads = 0;
+    if (size == 0)
+    {
+        return STATUS_OKAY;
+    }
+    status = elf64_core_map_range(core, offset, size, &core->notes, &data);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    /* Count the threads first, so they are allocated once. */
+    while (elf64_note_next(data, size, &cursor, &note, &descriptor)
+        == STATUS_OKAY)
+    {
+        threads += note->type == ELF64_NT_PRSTATUS;
+    }
+    if (threads != 0)
+    {
+        status = prim_malloc(
+            (void**) &core->threads, threads * sizeof(Elf64_Core_Thread));
+    }
+    cursor = 0;
+    while (status == STATUS_OKAY
+        && elf64_note_next(data, size, &cursor, &note, &descriptor)
+            == STATUS_OKAY)
+    {
+        if (note->name_size != sizeof(ELF64_NOTE_CORE)
+            || memcmp(note + 1, ELF64_NOTE_CORE, sizeof(ELF64_NOTE_CORE)) != 0)
+        {
+            continue;
+        }
+        if (note->type == ELF64_NT_PRSTATUS)
+        {
+            status = elf64_core_decode_thread(&core->threads[core->thread_count],
+                descriptor, note->descriptor_size);
+            core->thread_count++;
+        }
+        else if (note->type == ELF64_NT_FILE)
+        {
+            status
+                = elf64_core_decode_files(core, descriptor, note->descriptor_size);
+        }
+    }
+    return status;
+}
+
+/**
+ * Open an ELF64 core file.
+ *
+ * @param core The core to initialise.
+ * @param path Path to the core file.
+ * @param window_size Length of each window, in bytes, or zero for
+ * `ELF64_CORE_DEFAULT_WINDOW_SIZE`. Rounded up to the page size.
+ * @param window_count Number of windows to keep mapped, or zero for
+ * `ELF64_CORE_DEFAULT_WINDOW_COUNT`.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the file is not an ELF64
+ * core or is malformed, otherwise an error code. Nothing is left open on
+ * failure.
+ */
+extern PrimStatus elf64_core_open(Elf64_Core* core, const char* path,
+    prim_usize window_size, prim_usize window_count)
+{
+    PrimStatus status = STATUS_ERROR;
+    prim_usize note_offset = 0;
+    prim_usize note_size = 0;
+    memset(core, 0, sizeof(Elf64_Core));
+    window_size = window_size != 0 ? window_size : ELF64_CORE_DEFAULT_WINDOW_SIZE;
+    window_count
+        = window_count != 0 ? window_count : ELF64_CORE_DEFAULT_WINDOW_COUNT;
+    status = prim_map_open_view(path, window_size, window_count, &core->view);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    status = elf64_core_read_header(core);
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_core_read_segments(core, &note_offset, &note_size);
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_core_read_notes(core, note_offset, note_size);
+    }
+    if (status != STATUS_OKAY)
+    {
+        elf64_core_close(core);
+    }
+    return status;
+}
+
+/**
+ * Close a core, and unmap its windows and notes.
+ *
+ * @param core The core to close.
+ */
+extern void elf64_core_close(Elf64_Core* core)
+{
+    if (core->segments != NULL)
+    {
+        prim_free(core->segments);
+    }
+    if (core->segment_max_ends != NULL)
+    {
+        prim_free(core->segment_max_ends);
+    }
+    if (core->threads != NULL)
+    {
+        prim_free(core->threads);
+    }
+    if (core->files != NULL)
+    {
+        prim_free(core->files);
+    }
+    prim_unmap_window(&core->notes);
+    prim_map_close_view(&core->view);
+    memset(core, 0, sizeof(Elf64_Core));
+}
+
+/**
+ * Find the segment holding an address in a range of the interval tree.
+ *
+ * @param core The core to search.
+ * @param low Index of the first segment in the range.
+ * @param high Index after the last segment in the range.
+ * @param address The virtual address to find.
+ * @return The index of a segment holding `address`, or `high` if none does.
+ */
+static prim_usize elf64_core_search_tree(const Elf64_Core* core,
+    const prim_usize low, const prim_usize high, const Elf64_Address address)
+{
+    prim_usize middle = low + (high - low) / 2;
+    prim_usize found = 0;
+    if (low >= high || core->segment_max_ends[middle] <= address)
+    {
+        return high;
+    }
+    /* Every segment right of the middle starts above the address. */
+    if (address < core->segments[middle].start)
+    {
+        found = elf64_core_search_tree(core, low, middle, address);
+        return found == middle ? high : found;
+    }
+    if (address < core->segments[middle].end)
+    {
+        return middle;
+    }
+    found = elf64_core_search_tree(core, low, middle, address);
+    if (found != middle)
+    {
+        return found;
+    }
+    return elf64_core_search_tree(core, middle + 1, high, address);
+}
+
+/**
+ * Find the saved memory range holding an address.
+ *
+ * @param core The core to search.
+ * @param address The virtual address to find.
+ * @param result Location to return the range.
+ * @return STATUS_OKAY if the address was in the process, STATUS_INVALID if it
+ * was not.
+ */
+extern PrimStatus elf64_core_find_segment(const Elf64_Core* core,
+    const Elf64_Address address, const Elf64_Core_Segment** result)
+{
+    prim_usize found = elf64_core_search_tree(
+        core, 0, core->segment_count, address);
+    if (found == core->segment_count)
+    {
+        return STATUS_INVALID;
+    }
+    *result = &core->segments[found];
+    return STATUS_OKAY;
+}
+
+/**
+ * Read process memory saved in a core.
+ *
+ * @param core The core to read.
+ * @param address The virtual address to read from.
+ * @param buffer Location to copy the memory to.
+ * @param size Number of bytes to read.
+ * @return STATUS_OKAY on success, STATUS_INVALID if any of the memory was not
+ * saved, otherwise an error code.
+ */
+extern PrimStatus elf64_core_read(Elf64_Core* core, Elf64_Address address,
+    void* buffer, prim_usize size)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Core_Segment* segment = NULL;
+    prim_u8* destination = (prim_u8*) buffer;
+    prim_usize saved = 0;
+    prim_usize length = 0;
+    while (size > 0)
+    {
+        status = elf64_core_find_segment(core, address, &segment);
+        if (status != STATUS_OKAY
+            || address - segment->start >= segment->file_size)
+        {
+            return STATUS_INVALID;
+        }
+        saved = segment->file_size - (address - segment->start);
+        length = saved < size ? saved : size;
+        status = prim_map_view_read(&core->view,
+            segment->offset + (address - segment->start), destination, length);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        destination += length;
+        address += length;
+        size -= length;
+    }
+    return STATUS_OKAY;
+}
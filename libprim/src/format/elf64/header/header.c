@@ -13,6 +13,8 @@
  * @date May 2020.
  */
 
+#define PRIM_ACCESSOR_DEFINITIONS
+
 #include "format/elf64/header/header.h"
 #include "status.h"
 
@@ -0,0 +1,1795 @@
+/**
+ * @file src/format/elf64/image.c
+ *
+ * Implements lazily parsed ELF64 images.
+ *
+ * @see `include/format/elf64/image.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "format/elf64/image.h"
+#include "format/elf64/header/header.h"
+#include "format/elf64/header/ident.h"
+#include "format/elf64/header/type.h"
+#include "format/elf64/section/compression.h"
+#include "format/elf64/section/dynamic.h"
+#include "format/elf64/section/flags.h"
+#include "format/elf64/section/hash.h"
+#include "format/elf64/section/note.h"
+#include "format/elf64/section/string_table.h"
+#include "format/elf64/section/type.h"
+#include "format/elf64/section/version.h"
+#include "format/elf64/segment/type.h"
+#include "platform/mapping.h"
+#include "platform/memory.h"
+#include "platform/thread.h"
+#include "stats.h"
+#include "status.h"
+#include "format/zlib/inflate.h"
+#include "trace.h"
+#include <string.h>
+
+/** Undefined section index, used when a binary has no section names. */
+#define ELF64_SECTION_INDEX_UNDEFINED 0
+
+/** Alignment of each section inflated into an image's arena. */
+#define ELF64_IMAGE_INFLATE_ALIGNMENT 16
+
+/** The most DEFLATE can expand its input by. */
+#define ELF64_IMAGE_INFLATE_MAX_RATIO 1032
+
+/**
+ * Checks if a range of the binary lies inside the mapping.
+ *
+ * @param image The image to check against.
+ * @param offset Offset to the start of the range.
+ * @param size Length of the range, in bytes.
+ * @return `STATUS_OKAY` if the range is inside the binary, `STATUS_INVALID`
+ * otherwise.
+ */
+static PrimStatus elf64_image_check_range(
+    const Elf64_Image* image, Elf64_Offset offset, Elf64_Xword size)
+{
+    if (offset > image->mapping.size || size > image->mapping.size - offset)
+    {
+        return STATUS_INVALID;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Checks a header table's location, and returns a pointer to it.
+ *
+ * Tables are used in place, so they must be suitably aligned for their
+ * entries as well as inside the binary.
+ *
+ * @param image The image containing the table.
+ * @param offset Offset to the table.
+ * @param entry_size Entry size reported by the binary.
+ * @param expected_size Entry size understood by Prim.
+ * @param count Number of entries in the table.
+ * @param result Location to return the table.
+ * @return `STATUS_OKAY` if the table is usable, `STATUS_INVALID` otherwise.
+ */
+static PrimStatus elf64_image_locate_table(const Elf64_Image* image,
+    Elf64_Offset offset, Elf64_Half entry_size, prim_usize expected_size,
+    Elf64_Half count, const void** result)
+{
+    *result = NULL;
+    if (count == 0)
+    {
+        return STATUS_OKAY;
+    }
+    if (entry_size != expected_size || offset % sizeof(Elf64_Xword) != 0)
+    {
+        return STATUS_INVALID;
+    }
+    if (elf64_image_check_range(image, offset, (Elf64_Xword) count * entry_size)
+        != STATUS_OKAY)
+    {
+        return STATUS_INVALID;
+    }
+    *result = image->mapping.data + offset;
+    return STATUS_OKAY;
+}
+
+/**
+ * Validate and remember the section header table.
+ *
+ * @param image The image to materialise the table for.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the table is
+ * malformed.
+ */
+static PrimStatus elf64_image_materialise_section_headers(Elf64_Image* image)
+{
+    PrimStatus status = STATUS_ERROR;
+    const void* table = NULL;
+    if (image->materialised & ELF64_IMAGE_SECTION_HEADERS)
+    {
+        return STATUS_OKAY;
+    }
+    PRIM_STATS_PHASE_BEGIN(timer);
+    status = elf64_image_locate_table(image, image->header->sh_offset,
+        image->header->sh_entry_size, sizeof(ELF64_Section_Header),
+        image->header->sh_entry_count, &table);
+    PRIM_STATS_PHASE_END(timer, PRIM_PHASE_TABLES);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    image->section_headers = (const ELF64_Section_Header*) table;
+    image->materialised |= ELF64_IMAGE_SECTION_HEADERS;
+    PRIM_TRACE_SECTION_TABLE_LOAD(image->header->sh_entry_count,
+        image->header->sh_entry_count * sizeof(ELF64_Section_Header));
+    return STATUS_OKAY;
+}
+
+/**
+ * Validate and remember the segment header table.
+ *
+ * @param image The image to materialise the table for.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the table is
+ * malformed.
+ */
+static PrimStatus elf64_image_materialise_segment_headers(Elf64_Image* image)
+{
+    PrimStatus status = STATUS_ERROR;
+    const void* table = NULL;
+    if (image->materialised & ELF64_IMAGE_SEGMENT_HEADERS)
+    {
+        return STATUS_OKAY;
+    }
+    PRIM_STATS_PHASE_BEGIN(timer);
+    status = elf64_image_locate_table(image, image->header->ph_offset,
+        image->header->ph_entry_size, sizeof(Elf64_Segment_Header),
+        image->header->ph_entry_count, &table);
+    PRIM_STATS_PHASE_END(timer, PRIM_PHASE_TABLES);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    image->segment_headers = (const Elf64_Segment_Header*) table;
+    image->materialised |= ELF64_IMAGE_SEGMENT_HEADERS;
+    PRIM_TRACE_SEGMENT_TABLE_LOAD(image->header->ph_entry_count,
+        image->header->ph_entry_count * sizeof(Elf64_Segment_Header));
+    return STATUS_OKAY;
+}
+
+/**
+ * Locate and remember the section name string table.
+ *
+ * @param image The image to materialise the string table for.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the string table is
+ * malformed.
+ */
+static PrimStatus elf64_image_materialise_section_names(Elf64_Image* image)
+{
+    PrimStatus status = STATUS_ERROR;
+    const ELF64_Section_Header* names = NULL;
+    const void* data = NULL;
+    if (image->materialised & ELF64_IMAGE_SECTION_NAMES)
+    {
+        return STATUS_OKAY;
+    }
+    if (image->header->header_name_strs_index != ELF64_SECTION_INDEX_UNDEFINED)
+    {
+        status = elf64_image_get_section_header(
+            image, image->header->header_name_strs_index, &names);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        status = elf64_image_get_section_data(
+            image, image->header->header_name_strs_index, &data);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        image->section_names_header = names;
+        image->section_names = (const char*) data;
+    }
+    image->materialised |= ELF64_IMAGE_SECTION_NAMES;
+    return STATUS_OKAY;
+}
+
+/**
+ * Hash a section name for the section name index.
+ *
+ * @param name The name to hash.
+ * @return The 32-bit FNV-1a hash of the name.
+ */
+static Elf64_Word elf64_image_hash_name(const char* name)
+{
+    Elf64_Word hash = 2166136261U;
+    while (*name != '\0')
+    {
+        hash ^= (unsigned char) *name;
+        hash *= 16777619U;
+        name++;
+    }
+    return hash;
+}
+
+/**
+ * Build and remember the section name index.
+ *
+ * Sections without a valid name are left out of the index.
+ *
+ * @param image The image to index.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_image_materialise_section_name_index(
+    Elf64_Image* image)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Word size = 1;
+    Elf64_Word section = 0;
+    Elf64_Word slot = 0;
+    Elf64_Word indexed = 0;
+    const char* name = NULL;
+    if (image->materialised & ELF64_IMAGE_SECTION_NAME_INDEX)
+    {
+        return STATUS_OKAY;
+    }
+    PRIM_STATS_PHASE_BEGIN(timer);
+    /* Keep the table at most half full, so probe sequences stay short. */
+    while (size < 2U * image->header->sh_entry_count)
+    {
+        size <<= 1U;
+    }
+    status = prim_malloc(
+        (void**) &image->section_name_index, size * sizeof(Elf64_Word));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(image->section_name_index, 0, size * sizeof(Elf64_Word));
+    image->section_name_index_size = size;
+    for (section = 0; section < image->header->sh_entry_count; section++)
+    {
+        if (elf64_image_get_section_name(image, section, &name) != STATUS_OKAY)
+        {
+            continue;
+        }
+        slot = elf64_image_hash_name(name) & (size - 1);
+        while (image->section_name_index[slot] != 0)
+        {
+            slot = (slot + 1) & (size - 1);
+        }
+        image->section_name_index[slot] = section + 1;
+        indexed++;
+    }
+    image->materialised |= ELF64_IMAGE_SECTION_NAME_INDEX;
+    PRIM_TRACE_STRTAB_BUILD(indexed, size);
+    PRIM_STATS_PHASE_END(timer, PRIM_PHASE_STRINGS);
+    return STATUS_OKAY;
+}
+
+/**
+ * Find the first section of a given type.
+ *
+ * @param image The image to search.
+ * @param type The section type to find.
+ * @param result Location to return the section index, or the section count if
+ * the image has no such section.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the section header
+ * table is malformed.
+ */
+static PrimStatus elf64_image_find_section_type(
+    Elf64_Image* image, ELF64_Section_Type type, Elf64_Word* result)
+{
+    PrimStatus status = STATUS_OKAY;
+    const ELF64_Section_Header* header = NULL;
+    Elf64_Word section = 0;
+    for (section = 0; section < image->header->sh_entry_count; section++)
+    {
+        status = elf64_image_get_section_header(image, section, &header);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        if (header->type == type)
+        {
+            break;
+        }
+    }
+    *result = section;
+    return STATUS_OKAY;
+}
+
+/**
+ * Locate and remember a symbol table and its string table.
+ *
+ * @param image The image to materialise the symbol table for.
+ * @param type The section type of the symbol table.
+ * @param table Location to remember the symbol table.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the symbol table is
+ * malformed.
+ */
+static PrimStatus elf64_image_materialise_symbol_table(
+    Elf64_Image* image, ELF64_Section_Type type, Elf64_Symbol_Table* table)
+{
+    PrimStatus status = STATUS_OKAY;
+    const ELF64_Section_Header* header = NULL;
+    const void* symbols = NULL;
+    const void* strings = NULL;
+    Elf64_Word section = 0;
+    status = elf64_image_find_section_type(image, type, &section);
+    if (status != STATUS_OKAY || section == image->header->sh_entry_count)
+    {
+        return status;
+    }
+    elf64_image_get_section_header(image, section, &header);
+    status = elf64_image_get_section_data(image, section, &symbols);
+    if (status != STATUS_OKAY || symbols == NULL
+        || header->entry_size != sizeof(Elf64_Symbol)
+        || header->offset % sizeof(Elf64_Xword) != 0)
+    {
+        return STATUS_INVALID;
+    }
+    status = elf64_image_get_section_data(image, header->link, &strings);
+    if (status != STATUS_OKAY || strings == NULL)
+    {
+        return STATUS_INVALID;
+    }
+    elf64_image_get_section_header(image, header->link, &table->strings_header);
+    table->strings = (const char*) strings;
+    table->symbols = (const Elf64_Symbol*) symbols;
+    table->count = (Elf64_Word) (header->size / sizeof(Elf64_Symbol));
+    return STATUS_OKAY;
+}
+
+/**
+ * Locate and remember the dynamic linking table and its string table.
+ *
+ * @param image The image to materialise the dynamic table for.
+ * @param table Location to remember the dynamic table.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the dynamic table is
+ * malformed.
+ */
+static PrimStatus elf64_image_materialise_dynamic_table(
+    Elf64_Image* image, Elf64_Dynamic_Table* table)
+{
+    PrimStatus status = STATUS_OKAY;
+    const ELF64_Section_Header* header = NULL;
+    const Elf64_Dynamic* entries = NULL;
+    const void* data = NULL;
+    const void* strings = NULL;
+    Elf64_Word section = 0;
+    Elf64_Word count = 0;
+    status = elf64_image_find_section_type(
+        image, ELF64_SECTION_TYPE_DYNAMIC, &section);
+    if (status != STATUS_OKAY || section == image->header->sh_entry_count)
+    {
+        return status;
+    }
+    elf64_image_get_section_header(image, section, &header);
+    status = elf64_image_get_section_data(image, section, &data);
+    if (status != STATUS_OKAY || data == NULL
+        || header->entry_size != sizeof(Elf64_Dynamic)
+        || header->offset % sizeof(Elf64_Xword) != 0)
+    {
+        return STATUS_INVALID;
+    }
+    status = elf64_image_get_section_data(image, header->link, &strings);
+    if (status != STATUS_OKAY || strings == NULL)
+    {
+        return STATUS_INVALID;
+    }
+    entries = (const Elf64_Dynamic*) data;
+    while (count < header->size / sizeof(Elf64_Dynamic)
+        && elf64_get_dynamic_tag(&entries[count]) != ELF64_DT_NULL)
+    {
+        count++;
+    }
+    elf64_image_get_section_header(image, header->link, &table->strings_header);
+    table->strings = (const char*) strings;
+    table->entries = entries;
+    table->count = count;
+    return STATUS_OKAY;
+}
+
+/**
+ * Locate and remember the GNU symbol hash table.
+ *
+ * @param image The image to materialise the hash table for.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the hash table is
+ * malformed.
+ */
+static PrimStatus elf64_image_materialise_gnu_hash(Elf64_Image* image)
+{
+    PrimStatus status = STATUS_OKAY;
+    const ELF64_Section_Header* header = NULL;
+    const Elf64_Symbol_Table* symbols = NULL;
+    const void* data = NULL;
+    Elf64_Word section = 0;
+    if (image->materialised & ELF64_IMAGE_GNU_HASH)
+    {
+        return STATUS_OKAY;
+    }
+    status = elf64_image_get_symbol_table(
+        image, ELF64_SECTION_TYPE_DYNSYM, &symbols);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    status = elf64_image_find_section_type(
+        image, ELF64_SECTION_TYPE_GNU_HASH, &section);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    if (section != image->header->sh_entry_count)
+    {
+        elf64_image_get_section_header(image, section, &header);
+        status = elf64_image_get_section_data(image, section, &data);
+        if (status != STATUS_OKAY || data == NULL
+            || header->offset % sizeof(Elf64_Xword) != 0
+            || elf64_gnu_hash_parse(
+                   &image->gnu_hash, data, header->size, symbols->count)
+                != STATUS_OKAY)
+        {
+            return STATUS_INVALID;
+        }
+    }
+    image->materialised |= ELF64_IMAGE_GNU_HASH;
+    return STATUS_OKAY;
+}
+
+/**
+ * Locate a symbol version section and the string table holding its names.
+ *
+ * @param image The image to search.
+ * @param type The version section type to find.
+ * @param header Location to return the section header.
+ * @param data Location to return the section contents, or `NULL` if the image
+ * has no such section.
+ * @param strings_header Location to return the string table header.
+ * @param strings Location to return the string table data, or `NULL` if the
+ * string table is not needed.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the section is
+ * malformed.
+ */
+static PrimStatus elf64_image_locate_version_section(Elf64_Image* image,
+    ELF64_Section_Type type, const ELF64_Section_Header** header,
+    const void** data, const ELF64_Section_Header** strings_header,
+    const char** strings)
+{
+    PrimStatus status = STATUS_OKAY;
+    Elf64_Word section = 0;
+    *data = NULL;
+    status = elf64_image_find_section_type(image, type, &section);
+    if (status != STATUS_OKAY || section == image->header->sh_entry_count)
+    {
+        return status;
+    }
+    elf64_image_get_section_header(image, section, header);
+    status = elf64_image_get_section_data(image, section, data);
+    if (status != STATUS_OKAY || *data == NULL
+        || (*header)->offset % sizeof(Elf64_Half) != 0)
+    {
+        return STATUS_INVALID;
+    }
+    if (strings == NULL)
+    {
+        return STATUS_OKAY;
+    }
+    status = elf64_image_get_section_data(
+        image, (*header)->link, (const void**) strings);
+    if (status != STATUS_OKAY || *strings == NULL)
+    {
+        return STATUS_INVALID;
+    }
+    elf64_image_get_section_header(image, (*header)->link, strings_header);
+    return STATUS_OKAY;
+}
+
+/**
+ * Checks an entry of a version section lies inside it, and returns it.
+ *
+ * @param header The version section's header.
+ * @param data The version section's contents.
+ * @param offset Offset to the entry from the start of the section.
+ * @param size Size of the entry, in bytes.
+ * @param result Location to return the entry.
+ * @return `STATUS_OKAY` if the entry is usable, `STATUS_INVALID` otherwise.
+ */
+static PrimStatus elf64_image_locate_version_entry(
+    const ELF64_Section_Header* header, const void* data, Elf64_Xword offset,
+    prim_usize size, const void** result)
+{
+    if ((header->offset + offset) % sizeof(Elf64_Word) != 0
+        || offset > header->size || size > header->size - offset)
+    {
+        return STATUS_INVALID;
+    }
+    *result = (const prim_u8*) data + offset;
+    return STATUS_OKAY;
+}
+
+/**
+ * Record a version's name in a version table.
+ *
+ * Until the table's versions are allocated, only the table's count is raised
+ * to cover the index.
+ *
+ * @param table The version table to update.
+ * @param index The version's index.
+ * @param strings_header The string table header.
+ * @param strings The string table data.
+ * @param name The version name's string table offset.
+ * @param defined Non-zero if the image defines the version.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the name is malformed.
+ */
+static PrimStatus elf64_image_record_version(Elf64_Version_Table* table,
+    Elf64_Half index, const ELF64_Section_Header* strings_header,
+    const char* strings, Elf64_Word name, int defined)
+{
+    index = elf64_get_version_index(index);
+    if (table->versions == NULL)
+    {
+        if (index >= table->count)
+        {
+            table->count = (Elf64_Half) (index + 1);
+        }
+        return STATUS_OKAY;
+    }
+    table->versions[index].defined = defined;
+    table->defines_versions |= defined;
+    return elf64_get_string_table_entry(
+        &table->versions[index].name, strings_header, strings, name);
+}
+
+/**
+ * Walk an image's version definitions, recording each in a version table.
+ *
+ * @param image The image to read.
+ * @param table The version table to update.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the definitions are
+ * malformed.
+ */
+static PrimStatus elf64_image_read_version_definitions(
+    Elf64_Image* image, Elf64_Version_Table* table)
+{
+    PrimStatus status = STATUS_OKAY;
+    const ELF64_Section_Header* header = NULL;
+    const ELF64_Section_Header* strings_header = NULL;
+    const char* strings = NULL;
+    const void* data = NULL;
+    const Elf64_Version_Definition* definition = NULL;
+    const Elf64_Version_Definition_Name* name = NULL;
+    Elf64_Xword offset = 0;
+    Elf64_Word i = 0;
+    status = elf64_image_locate_version_section(image,
+        ELF64_SECTION_TYPE_GNU_VER_DEF, &header, &data, &strings_header,
+        &strings);
+    if (status != STATUS_OKAY || data == NULL)
+    {
+        return status;
+    }
+    for (i = 0; i < header->info; i++)
+    {
+        if (elf64_image_locate_version_entry(header, data, offset,
+                sizeof(Elf64_Version_Definition), (const void**) &definition)
+                != STATUS_OKAY
+            || definition->count == 0
+            || elf64_image_locate_version_entry(header, data,
+                   offset + definition->aux,
+                   sizeof(Elf64_Version_Definition_Name),
+                   (const void**) &name)
+                != STATUS_OKAY)
+        {
+            return STATUS_INVALID;
+        }
+        /* The base definition names the image itself, not a version. */
+        if (!(definition->flags & ELF64_VER_FLG_BASE)
+            && elf64_image_record_version(table, definition->index,
+                   strings_header, strings, name->name, 1)
+                != STATUS_OKAY)
+        {
+            return STATUS_INVALID;
+        }
+        if (definition->next == 0)
+        {
+            break;
+        }
+        offset += definition->next;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Walk an image's version requirements, recording each in a version table.
+ *
+ * @param image The image to read.
+ * @param table The version table to update.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the requirements are
+ * malformed.
+ */
+static PrimStatus elf64_image_read_version_needs(
+    Elf64_Image* image, Elf64_Version_Table* table)
+{
+    PrimStatus status = STATUS_OKAY;
+    const ELF64_Section_Header* header = NULL;
+    const ELF64_Section_Header* strings_header = NULL;
+    const char* strings = NULL;
+    const void* data = NULL;
+    const Elf64_Version_Need* need = NULL;
+    const Elf64_Version_Need_Entry* entry = NULL;
+    Elf64_Xword offset = 0;
+    Elf64_Xword entry_offset = 0;
+    Elf64_Word i = 0;
+    Elf64_Half j = 0;
+    status = elf64_image_locate_version_section(image,
+        ELF64_SECTION_TYPE_GNU_VER_REQ, &header, &data, &strings_header,
+        &strings);
+    if (status != STATUS_OKAY || data == NULL)
+    {
+        return status;
+    }
+    for (i = 0; i < header->info; i++)
+    {
+        if (elf64_image_locate_version_entry(header, data, offset,
+                sizeof(Elf64_Version_Need), (const void**) &need)
+            != STATUS_OKAY)
+        {
+            return STATUS_INVALID;
+        }
+        entry_offset = offset + need->aux;
+        for (j = 0; j < need->count; j++)
+        {
+            if (elf64_image_locate_version_entry(header, data, entry_offset,
+                    sizeof(Elf64_Version_Need_Entry), (const void**) &entry)
+                    != STATUS_OKAY
+                || elf64_image_record_version(table, entry->index,
+                       strings_header, strings, entry->name, 0)
+                    != STATUS_OKAY)
+            {
+                return STATUS_INVALID;
+            }
+            if (entry->next == 0)
+            {
+                break;
+            }
+            entry_offset += entry->next;
+        }
+        if (need->next == 0)
+        {
+            break;
+        }
+        offset += need->next;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Locate the symbol version entries, and index the version names.
+ *
+ * The definitions and requirements are walked twice: once to size the index,
+ * and once to fill it.
+ *
+ * @param image The image to materialise the version tables for.
+ * @param table Location to remember the version tables.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the tables are
+ * malformed, otherwise an error code.
+ */
+static PrimStatus elf64_image_materialise_versions(
+    Elf64_Image* image, Elf64_Version_Table* table)
+{
+    PrimStatus status = STATUS_OKAY;
+    const ELF64_Section_Header* header = NULL;
+    const void* data = NULL;
+    status = elf64_image_locate_version_section(image,
+        ELF64_SECTION_TYPE_GNU_VER_SYM, &header, &data, NULL, NULL);
+    if (status != STATUS_OKAY || data == NULL)
+    {
+        return status;
+    }
+    table->count = ELF64_VER_NDX_GLOBAL + 1;
+    if (elf64_image_read_version_definitions(image, table) != STATUS_OKAY
+        || elf64_image_read_version_needs(image, table) != STATUS_OKAY)
+    {
+        return STATUS_INVALID;
+    }
+    status = prim_malloc(
+        (void**) &table->versions, table->count * sizeof(Elf64_Version));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(table->versions, 0, table->count * sizeof(Elf64_Version));
+    status = elf64_image_read_version_definitions(image, table);
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_image_read_version_needs(image, table);
+    }
+    table->symbols = (const Elf64_Half*) data;
+    table->symbol_count = (Elf64_Word) (header->size / sizeof(Elf64_Half));
+    return status;
+}
+
+/**
+ * Checks if a dynamic symbol is one an image defines for other images.
+ *
+ * @param table The dynamic symbol table.
+ * @param versions The image's symbol versions.
+ * @param index The index of the symbol.
+ * @param name The name to match.
+ * @param version The version index to match, or `ELF64_VER_NDX_GLOBAL` to
+ * match the default version.
+ * @return `STATUS_OKAY` if the symbol is a defined, non-local symbol with the
+ * name and version, `STATUS_INVALID` otherwise.
+ */
+static PrimStatus elf64_image_is_exported_symbol(
+    const Elf64_Symbol_Table* table, const Elf64_Version_Table* versions,
+    Elf64_Word index, const char* name, Elf64_Half version)
+{
+    const Elf64_Symbol* symbol = &table->symbols[index];
+    const char* candidate = NULL;
+    Elf64_Half entry = 0;
+    if (elf64_get_symbol_section(symbol) == ELF64_SHN_UNDEF
+        || elf64_get_symbol_binding(symbol) == ELF64_STB_LOCAL
+        || elf64_symbol_table_get_name(table, symbol, &candidate)
+            != STATUS_OKAY
+        || strcmp(candidate, name) != 0)
+    {
+        return STATUS_INVALID;
+    }
+    if (versions->symbols == NULL || index >= versions->symbol_count)
+    {
+        return STATUS_OKAY;
+    }
+    entry = versions->symbols[index];
+    if (version <= ELF64_VER_NDX_GLOBAL)
+    {
+        return elf64_is_version_hidden(entry) == STATUS_OKAY ? STATUS_INVALID
+                                                             : STATUS_OKAY;
+    }
+    return elf64_get_version_index(entry) == version ? STATUS_OKAY
+                                                     : STATUS_INVALID;
+}
+
+/**
+ * Checks if a section is stored compressed.
+ *
+ * @param header The section's header.
+ * @return Non-zero if the section has compressed contents in the binary.
+ */
+static int elf64_image_is_compressed(const ELF64_Section_Header* header)
+{
+    return (elf64_get_section_flags(header) & ELF64_SECTION_FLAG_COMPRESSED)
+        && header->type != ELF64_SECTION_TYPE_NOBITS;
+}
+
+/**
+ * Index the image's compressed sections, and allocate the arena they all
+ * inflate into.
+ *
+ * Nothing is inflated yet. A section whose compression header is malformed,
+ * or whose format Prim cannot inflate, is marked failed rather than failing
+ * the whole index.
+ *
+ * @param image The image to materialise the index for.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the section header
+ * table is malformed, otherwise an error code.
+ */
+static PrimStatus elf64_image_materialise_compressed_sections(
+    Elf64_Image* image)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Compressed_Section* sections = NULL;
+    Elf64_Compressed_Section* section = NULL;
+    const ELF64_Section_Header* header = NULL;
+    Elf64_Compression_Header compression;
+    Elf64_Half count = 0;
+    Elf64_Half index = 0;
+    prim_usize compressed = 0;
+    prim_usize arena_size = 0;
+    if (image->materialised & ELF64_IMAGE_COMPRESSED_SECTIONS)
+    {
+        return STATUS_OKAY;
+    }
+    status = elf64_image_materialise_section_headers(image);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    count = image->header->sh_entry_count;
+    for (index = 0; index < count; index++)
+    {
+        compressed += elf64_image_is_compressed(&image->section_headers[index]);
+    }
+    if (compressed == 0)
+    {
+        image->materialised |= ELF64_IMAGE_COMPRESSED_SECTIONS;
+        return STATUS_OKAY;
+    }
+    status = prim_malloc(
+        (void**) &sections, count * sizeof(Elf64_Compressed_Section));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(sections, 0, count * sizeof(Elf64_Compressed_Section));
+    for (index = 0; index < count; index++)
+    {
+        header = &image->section_headers[index];
+        section = &sections[index];
+        if (!elf64_image_is_compressed(header))
+        {
+            continue;
+        }
+        section->inflated = 1;
+        section->status = STATUS_INVALID;
+        if (elf64_image_check_range(image, header->offset, header->size)
+                != STATUS_OKAY
+            || header->size < sizeof(Elf64_Compression_Header))
+        {
+            continue;
+        }
+        memcpy(&compression, image->mapping.data + header->offset,
+            sizeof(Elf64_Compression_Header));
+        section->source = image->mapping.data + header->offset
+            + sizeof(Elf64_Compression_Header);
+        section->source_size = header->size - sizeof(Elf64_Compression_Header);
+        section->format = compression.type;
+        section->size = compression.size;
+        if (section->format != ELF64_COMPRESS_ZLIB
+            || section->size / ELF64_IMAGE_INFLATE_MAX_RATIO
+                > section->source_size)
+        {
+            continue;
+        }
+        section->inflated = 0;
+        section->status = STATUS_OKAY;
+        arena_size += (section->size + ELF64_IMAGE_INFLATE_ALIGNMENT - 1)
+            & ~(prim_usize) (ELF64_IMAGE_INFLATE_ALIGNMENT - 1);
+    }
+    if (arena_size != 0)
+    {
+        status = prim_malloc((void**) &image->inflate_arena, arena_size);
+    }
+    if (status != STATUS_OKAY)
+    {
+        prim_free(sections);
+        return status;
+    }
+    arena_size = 0;
+    for (index = 0; index < count; index++)
+    {
+        section = &sections[index];
+        if (section->source != NULL && !section->inflated)
+        {
+            section->data = image->inflate_arena + arena_size;
+            arena_size += (section->size + ELF64_IMAGE_INFLATE_ALIGNMENT - 1)
+                & ~(prim_usize) (ELF64_IMAGE_INFLATE_ALIGNMENT - 1);
+        }
+    }
+    image->compressed_sections = sections;
+    image->materialised |= ELF64_IMAGE_COMPRESSED_SECTIONS;
+    return STATUS_OKAY;
+}
+
+/**
+ * Inflate a compressed section, unless it has been already.
+ *
+ * @param section The section to inflate.
+ * @return `STATUS_OKAY` if the section is inflated, `STATUS_INVALID` if it is
+ * malformed or in an unsupported format.
+ */
+static PrimStatus elf64_image_inflate_section(Elf64_Compressed_Section* section)
+{
+    if (!section->inflated)
+    {
+        section->status = zlib_decompress(
+            section->source, section->source_size, section->data, section->size);
+        section->inflated = 1;
+    }
+    return section->status;
+}
+
+/**
+ * Inflate one of an image's compressed sections, in parallel with others.
+ *
+ * @param context The image.
+ * @param index The index of the section in the section header table.
+ */
+static void elf64_image_inflate_task(void* context, const prim_usize index)
+{
+    Elf64_Image* image = (Elf64_Image*) context;
+    if (image->compressed_sections[index].source != NULL)
+    {
+        elf64_image_inflate_section(&image->compressed_sections[index]);
+    }
+}
+
+/**
+ * Check an image's mapping starts with a valid ELF64 file header.
+ *
+ * @param image The image to check.
+ * @return `STATUS_OKAY` if the header is usable, `STATUS_INVALID` otherwise.
+ */
+static PrimStatus elf64_image_check_header(Elf64_Image* image)
+{
+    image->header = (const Elf64_Header*) image->mapping.data;
+    if (image->mapping.size < sizeof(Elf64_Header)
+        || elf64_is_magic_okay(image->header->ident) != STATUS_OKAY
+        || elf64_get_class(image->header->ident) != ELF64_CLASS_64BIT)
+    {
+        return STATUS_INVALID;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Open an ELF64 binary as a lazily parsed image.
+ *
+ * Only the file header is read and checked. Everything else is deferred until
+ * it is first needed.
+ *
+ * @param image The image to initialise.
+ * @param path Path to the binary to open.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the file is not an ELF64
+ * binary, otherwise an error code.
+ */
+extern PrimStatus elf64_image_open(Elf64_Image* image, const char* path)
+{
+    PrimStatus status = STATUS_ERROR;
+    PRIM_STATS_PHASE_BEGIN(timer);
+    memset(image, 0, sizeof(Elf64_Image));
+    status = prim_map_file(path, &image->mapping);
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_image_check_header(image);
+        if (status != STATUS_OKAY)
+        {
+            elf64_image_close(image);
+        }
+    }
+    if (status == STATUS_OKAY)
+    {
+        PRIM_TRACE_IMAGE_OPEN(path, image->mapping.size);
+    }
+    PRIM_STATS_PHASE_END(timer, PRIM_PHASE_HEADER);
+    return status;
+}
+
+/**
+ * Open an ELF64 binary the caller has already mapped as a lazily parsed
+ * image.
+ *
+ * The image borrows the mapping: closing the image leaves it mapped, so it
+ * can back several images at once.
+ *
+ * @param image The image to initialise.
+ * @param mapping The mapped binary. Must outlive the image.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the file is not an ELF64
+ * binary.
+ */
+extern PrimStatus elf64_image_open_mapping(
+    Elf64_Image* image, const PrimMapping* mapping)
+{
+    memset(image, 0, sizeof(Elf64_Image));
+    image->mapping = *mapping;
+    image->borrowed = 1;
+    if (elf64_image_check_header(image) != STATUS_OKAY)
+    {
+        memset(image, 0, sizeof(Elf64_Image));
+        return STATUS_INVALID;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Release an image and everything built for it.
+ *
+ * @param image The image to close.
+ */
+extern void elf64_image_close(Elf64_Image* image)
+{
+    if (image->section_name_index != NULL)
+    {
+        prim_free(image->section_name_index);
+    }
+    if (image->version_table.versions != NULL)
+    {
+        prim_free(image->version_table.versions);
+    }
+    if (image->compressed_sections != NULL)
+    {
+        prim_free(image->compressed_sections);
+    }
+    if (image->inflate_arena != NULL)
+    {
+        prim_free(image->inflate_arena);
+    }
+    if (image->aligned_copy != NULL)
+    {
+        prim_free(image->aligned_copy);
+    }
+    if (!image->borrowed)
+    {
+        prim_unmap_file(&image->mapping);
+    }
+    memset(image, 0, sizeof(Elf64_Image));
+}
+
+/**
+ * Get a section header from an image.
+ *
+ * @param image The image to read.
+ * @param index The index of the section in the section header table.
+ * @param result Location to return the section header.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such section
+ * or the section header table is malformed.
+ */
+extern PrimStatus elf64_image_get_section_header(Elf64_Image* image,
+    const Elf64_Word index, const ELF64_Section_Header** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    status = elf64_image_materialise_section_headers(image);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    if (index >= image->header->sh_entry_count)
+    {
+        return STATUS_INVALID;
+    }
+    *result = &image->section_headers[index];
+    return STATUS_OKAY;
+}
+
+/**
+ * Get a segment header from an image.
+ *
+ * @param image The image to read.
+ * @param index The index of the segment in the segment header table.
+ * @param result Location to return the segment header.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such segment
+ * or the segment header table is malformed.
+ */
+extern PrimStatus elf64_image_get_segment_header(Elf64_Image* image,
+    const Elf64_Word index, const Elf64_Segment_Header** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    status = elf64_image_materialise_segment_headers(image);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    if (index >= image->header->ph_entry_count)
+    {
+        return STATUS_INVALID;
+    }
+    *result = &image->segment_headers[index];
+    return STATUS_OKAY;
+}
+
+/**
+ * Get the contents of a section from an image.
+ *
+ * @note Sections which occupy no space in the binary, such as `.bss`, have no
+ * contents. They return `NULL` data.
+ *
+ * @param image The image to read.
+ * @param index The index of the section in the section header table.
+ * @param result Location to return the section contents.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such section
+ * or the section lies outside the binary.
+ */
+extern PrimStatus elf64_image_get_section_data(
+    Elf64_Image* image, const Elf64_Word index, const void** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    const ELF64_Section_Header* header = NULL;
+    status = elf64_image_get_section_header(image, index, &header);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    *result = NULL;
+    if (header->type == ELF64_SECTION_TYPE_NOBITS)
+    {
+        return STATUS_OKAY;
+    }
+    status = elf64_image_check_range(image, header->offset, header->size);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    *result = image->mapping.data + header->offset;
+    return STATUS_OKAY;
+}
+
+/**
+ * Get the uncompressed contents of a section from an image.
+ *
+ * Sections flagged `ELF64_SECTION_FLAG_COMPRESSED` are inflated the first
+ * time they are asked for. Other sections are returned in place, like
+ * `elf64_image_get_section_data`.
+ *
+ * @param image The image to read.
+ * @param index The index of the section in the section header table.
+ * @param result Location to return the section contents.
+ * @param size Location to return the length of the contents, in bytes.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such section,
+ * the section lies outside the binary, or its compressed contents are
+ * malformed or in an unsupported format, otherwise an error code.
+ */
+extern PrimStatus elf64_image_get_section_contents(Elf64_Image* image,
+    const Elf64_Word index, const void** result, Elf64_Xword* size)
+{
+    PrimStatus status = STATUS_ERROR;
+    const ELF64_Section_Header* header = NULL;
+    Elf64_Compressed_Section* section = NULL;
+    status = elf64_image_get_section_header(image, index, &header);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    if (!elf64_image_is_compressed(header))
+    {
+        status = elf64_image_get_section_data(image, index, result);
+        *size = *result != NULL ? header->size : 0;
+        return status;
+    }
+    status = elf64_image_materialise_compressed_sections(image);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    section = &image->compressed_sections[index];
+    status = elf64_image_inflate_section(section);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    *result = section->data;
+    *size = section->size;
+    return STATUS_OKAY;
+}
+
+/**
+ * Inflate every compressed section of an image not yet inflated, spread
+ * across threads.
+ *
+ * @param image The image to inflate.
+ * @return STATUS_OKAY if every compressed section inflated, STATUS_INVALID if
+ * any is malformed or in an unsupported format, otherwise an error code.
+ */
+extern PrimStatus elf64_image_inflate_sections(Elf64_Image* image)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Half index = 0;
+    status = elf64_image_materialise_compressed_sections(image);
+    if (status != STATUS_OKAY || image->compressed_sections == NULL)
+    {
+        return status;
+    }
+    prim_parallel_for(image->header->sh_entry_count, elf64_image_inflate_task,
+        image);
+    for (index = 0; index < image->header->sh_entry_count; index++)
+    {
+        if (elf64_image_is_compressed(&image->section_headers[index])
+            && image->compressed_sections[index].status != STATUS_OKAY)
+        {
+            return STATUS_INVALID;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Get the name of a section from an image.
+ *
+ * @param image The image to read.
+ * @param index The index of the section in the section header table.
+ * @param result Location to return the section name.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such section
+ * or the section has no valid name.
+ */
+extern PrimStatus elf64_image_get_section_name(
+    Elf64_Image* image, const Elf64_Word index, const char** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    const ELF64_Section_Header* header = NULL;
+    status = elf64_image_materialise_section_names(image);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    if (image->section_names == NULL)
+    {
+        return STATUS_INVALID;
+    }
+    status = elf64_image_get_section_header(image, index, &header);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    return elf64_get_string_table_entry(result, image->section_names_header,
+        image->section_names, header->name);
+}
+
+/**
+ * Find a section in an image by name.
+ *
+ * The first call builds an index of section names, so later calls cost a
+ * single hash probe.
+ *
+ * @param image The image to search.
+ * @param name The section name to find, for example `.text`.
+ * @param result Location to return the index of the section.
+ * @return STATUS_OKAY if the section is found, STATUS_INVALID if it is not,
+ * otherwise an error code.
+ */
+extern PrimStatus elf64_image_find_section(
+    Elf64_Image* image, const char* name, Elf64_Word* result)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Word mask = 0;
+    Elf64_Word slot = 0;
+    const char* candidate = NULL;
+    status = elf64_image_materialise_section_name_index(image);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    mask = image->section_name_index_size - 1;
+    slot = elf64_image_hash_name(name) & mask;
+    while (image->section_name_index[slot] != 0)
+    {
+        elf64_image_get_section_name(
+            image, image->section_name_index[slot] - 1, &candidate);
+        if (strcmp(candidate, name) == 0)
+        {
+            *result = image->section_name_index[slot] - 1;
+            return STATUS_OKAY;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return STATUS_INVALID;
+}
+
+/**
+ * Get the path of the interpreter requested by an image.
+ *
+ * @param image The image to read.
+ * @param result Location to return the interpreter path, or `NULL` if the
+ * image does not request an interpreter.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the interpreter segment
+ * is malformed.
+ */
+extern PrimStatus elf64_image_get_interpreter(
+    Elf64_Image* image, const char** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Segment_Header* segment = NULL;
+    Elf64_Word index = 0;
+    if (image->materialised & ELF64_IMAGE_INTERPRETER)
+    {
+        *result = image->interpreter;
+        return STATUS_OKAY;
+    }
+    for (index = 0; index < image->header->ph_entry_count; index++)
+    {
+        status = elf64_image_get_segment_header(image, index, &segment);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        if (elf64_get_segment_type(segment) != ELF64_PT_INTERP)
+        {
+            continue;
+        }
+        if (segment->p_filesz == 0
+            || elf64_image_check_range(
+                   image, segment->p_offset, segment->p_filesz)
+                != STATUS_OKAY
+            || image->mapping.data[segment->p_offset + segment->p_filesz - 1]
+                != '\0')
+        {
+            return STATUS_INVALID;
+        }
+        image->interpreter
+            = (const char*) image->mapping.data + segment->p_offset;
+        break;
+    }
+    image->materialised |= ELF64_IMAGE_INTERPRETER;
+    *result = image->interpreter;
+    return STATUS_OKAY;
+}
+
+/**
+ * Get an image's GNU build ID, from its `ELF64_PT_NOTE` segments.
+ *
+ * @param image The image to read.
+ * @param result Location to return the build ID, or `NULL` if the image has
+ * none.
+ * @param result_size Location to return the build ID's length, or zero if
+ * the image has none.
+ * @return STATUS_OKAY on success, STATUS_INVALID if a note segment is
+ * malformed.
+ */
+extern PrimStatus elf64_image_get_build_id(Elf64_Image* image,
+    const Elf64_Byte** result, Elf64_Word* result_size)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Segment_Header* segment = NULL;
+    Elf64_Word index = 0;
+    *result = NULL;
+    *result_size = 0;
+    for (index = 0; index < image->header->ph_entry_count; index++)
+    {
+        status = elf64_image_get_segment_header(image, index, &segment);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        if (elf64_get_segment_type(segment) != ELF64_PT_NOTE)
+        {
+            continue;
+        }
+        if (segment->p_offset % sizeof(Elf64_Word) != 0
+            || elf64_image_check_range(
+                   image, segment->p_offset, segment->p_filesz)
+                != STATUS_OKAY)
+        {
+            return STATUS_INVALID;
+        }
+        if (elf64_note_find(image->mapping.data + segment->p_offset,
+                segment->p_filesz, ELF64_NOTE_GNU, ELF64_NT_GNU_BUILD_ID,
+                result, result_size)
+            == STATUS_OKAY)
+        {
+            return STATUS_OKAY;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Checks if an image is a position independent executable.
+ *
+ * An image is treated as a PIE if it is a dynamic object which requests an
+ * interpreter. Shared libraries do not request an interpreter.
+ *
+ * @param image The image to test.
+ * @return `STATUS_OKAY` if the image is a PIE, `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus elf64_image_is_pie(Elf64_Image* image)
+{
+    const char* interpreter = NULL;
+    if (elf64_parse_object_type(image->header->type) != ELF64_TYPE_DYNAMIC)
+    {
+        return STATUS_INVALID;
+    }
+    if (elf64_image_get_interpreter(image, &interpreter) != STATUS_OKAY
+        || interpreter == NULL)
+    {
+        return STATUS_INVALID;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Get a symbol table from an image.
+ *
+ * An image has at most one static symbol table and one dynamic symbol table.
+ * A table the image does not have is returned with no symbols.
+ *
+ * @param image The image to read.
+ * @param type `ELF64_SECTION_TYPE_SYMBOL_TABLE` for the static symbol table,
+ * or `ELF64_SECTION_TYPE_DYNSYM` for the dynamic symbol table.
+ * @param result Location to return the symbol table.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the type is not a symbol
+ * table type or the table is malformed.
+ */
+extern PrimStatus elf64_image_get_symbol_table(Elf64_Image* image,
+    const ELF64_Section_Type type, const Elf64_Symbol_Table** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Symbol_Table* table = NULL;
+    prim_u32 component = 0;
+    if (type == ELF64_SECTION_TYPE_SYMBOL_TABLE)
+    {
+        table = &image->symbol_table;
+        component = ELF64_IMAGE_SYMBOLS;
+    }
+    else if (type == ELF64_SECTION_TYPE_DYNSYM)
+    {
+        table = &image->dynamic_symbol_table;
+        component = ELF64_IMAGE_DYNAMIC_SYMBOLS;
+    }
+    else
+    {
+        return STATUS_INVALID;
+    }
+    if (!(image->materialised & component))
+    {
+        PRIM_STATS_PHASE_BEGIN(timer);
+        status = elf64_image_materialise_symbol_table(image, type, table);
+        PRIM_STATS_PHASE_END(timer, PRIM_PHASE_SYMBOLS);
+        if (status != STATUS_OKAY)
+        {
+            memset(table, 0, sizeof(Elf64_Symbol_Table));
+            return status;
+        }
+        image->materialised |= component;
+    }
+    *result = table;
+    return STATUS_OKAY;
+}
+
+/**
+ * Get the name of a symbol from its symbol table.
+ *
+ * @param table The symbol table the symbol belongs to.
+ * @param symbol The symbol to name.
+ * @param result Location to return the symbol name.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the symbol has no valid
+ * name.
+ */
+extern PrimStatus elf64_symbol_table_get_name(const Elf64_Symbol_Table* table,
+    const Elf64_Symbol* symbol, const char** result)
+{
+    return elf64_get_string_table_entry(result, table->strings_header,
+        table->strings, elf64_get_symbol_name(symbol));
+}
+
+/**
+ * Get the symbol version tables from an image.
+ *
+ * The version definitions and requirements are indexed by version index when
+ * the tables are first requested, so a symbol's version is found without
+ * walking either list. An image without versions is returned with no
+ * symbol entries.
+ *
+ * @param image The image to read.
+ * @param result Location to return the version tables.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the tables are malformed,
+ * otherwise an error code.
+ */
+extern PrimStatus elf64_image_get_version_table(
+    Elf64_Image* image, const Elf64_Version_Table** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Version_Table* table = &image->version_table;
+    if (!(image->materialised & ELF64_IMAGE_VERSIONS))
+    {
+        PRIM_STATS_PHASE_BEGIN(timer);
+        status = elf64_image_materialise_versions(image, table);
+        PRIM_STATS_PHASE_END(timer, PRIM_PHASE_SYMBOLS);
+        if (status != STATUS_OKAY)
+        {
+            if (table->versions != NULL)
+            {
+                prim_free(table->versions);
+            }
+            memset(table, 0, sizeof(Elf64_Version_Table));
+            return status;
+        }
+        image->materialised |= ELF64_IMAGE_VERSIONS;
+    }
+    *result = table;
+    return STATUS_OKAY;
+}
+
+/**
+ * Find a symbol an image defines for other images, by name and version.
+ *
+ * The image's GNU hash table is used if it has one. Otherwise the dynamic
+ * symbol table is scanned. Undefined and local symbols are never found.
+ *
+ * @param image The image to search.
+ * @param name The symbol name to find.
+ * @param hash The name's `elf64_gnu_hash`.
+ * @param version The image's index of the version to find, or
+ * `ELF64_VER_NDX_GLOBAL` to find the default version. Ignored if the image
+ * has no versions.
+ * @param result Location to return the index of the symbol in the dynamic
+ * symbol table.
+ * @return STATUS_OKAY if the symbol is found, STATUS_INVALID if it is not,
+ * otherwise an error code.
+ */
+extern PrimStatus elf64_image_find_dynamic_symbol(Elf64_Image* image,
+    const char* name, const Elf64_Word hash, const Elf64_Half version,
+    Elf64_Word* result)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Symbol_Table* table = NULL;
+    const Elf64_Version_Table* versions = NULL;
+    const Elf64_Gnu_Hash_Table* gnu_hash = &image->gnu_hash;
+    Elf64_Word index = 0;
+    Elf64_Word chain = 0;
+    status = elf64_image_materialise_gnu_hash(image);
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_image_get_version_table(image, &versions);
+    }
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    elf64_image_get_symbol_table(image, ELF64_SECTION_TYPE_DYNSYM, &table);
+    if (gnu_hash->header == NULL)
+    {
+        for (index = 1; index < table->count; index++)
+        {
+            if (elf64_image_is_exported_symbol(
+                    table, versions, index, name, version)
+                == STATUS_OKAY)
+            {
+                *result = index;
+                return STATUS_OKAY;
+            }
+        }
+        return STATUS_INVALID;
+    }
+    if (elf64_gnu_hash_may_contain(gnu_hash, hash) != STATUS_OKAY)
+    {
+        return STATUS_INVALID;
+    }
+    index = gnu_hash->buckets[hash % gnu_hash->header->bucket_count];
+    if (index < gnu_hash->header->symbol_offset)
+    {
+        return STATUS_INVALID;
+    }
+    for (; index < table->count; index++)
+    {
+        chain = gnu_hash->chains[index - gnu_hash->header->symbol_offset];
+        if ((chain | 1U) == (hash | 1U)
+            && elf64_image_is_exported_symbol(
+                    table, versions, index, name, version)
+                == STATUS_OKAY)
+        {
+            *result = index;
+            return STATUS_OKAY;
+        }
+        if (chain & 1U)
+        {
+            break;
+        }
+    }
+    return STATUS_INVALID;
+}
+
+/**
+ * Get the dynamic linking table from an image.
+ *
+ * A statically linked image has no dynamic table. It is returned with no
+ * entries.
+ *
+ * @param image The image to read.
+ * @param result Location to return the dynamic table.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the table is malformed.
+ */
+extern PrimStatus elf64_image_get_dynamic_table(
+    Elf64_Image* image, const Elf64_Dynamic_Table** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    if (!(image->materialised & ELF64_IMAGE_DYNAMIC))
+    {
+        PRIM_STATS_PHASE_BEGIN(timer);
+        status = elf64_image_materialise_dynamic_table(
+            image, &image->dynamic_table);
+        PRIM_STATS_PHASE_END(timer, PRIM_PHASE_TABLES);
+        if (status != STATUS_OKAY)
+        {
+            memset(&image->dynamic_table, 0, sizeof(Elf64_Dynamic_Table));
+            return status;
+        }
+        image->materialised |= ELF64_IMAGE_DYNAMIC;
+    }
+    *result = &image->dynamic_table;
+    return STATUS_OKAY;
+}
+
+/**
+ * Find the first entry with a given tag in a dynamic table.
+ *
+ * @param table The dynamic table to search.
+ * @param tag The tag to find, for example `ELF64_DT_SONAME`.
+ * @param result Location to return the entry.
+ * @return STATUS_OKAY if the entry is found, STATUS_INVALID if it is not.
+ */
+extern PrimStatus elf64_dynamic_table_find(const Elf64_Dynamic_Table* table,
+    const Elf64_Dynamic_Tag tag, const Elf64_Dynamic** result)
+{
+    Elf64_Word index = 0;
+    for (index = 0; index < table->count; index++)
+    {
+        if (elf64_get_dynamic_tag(&table->entries[index]) == tag)
+        {
+            *result = &table->entries[index];
+            return STATUS_OKAY;
+        }
+    }
+    return STATUS_INVALID;
+}
+
+/**
+ * Get the string a dynamic table entry refers to, such as a needed library.
+ *
+ * @param table The dynamic table the entry belongs to.
+ * @param entry The entry whose value is a string table offset.
+ * @param result Location to return the string.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the entry has no valid
+ * string.
+ */
+extern PrimStatus elf64_dynamic_table_get_string(
+    const Elf64_Dynamic_Table* table, const Elf64_Dynamic* entry,
+    const char** result)
+{
+    if (table->strings == NULL)
+    {
+        return STATUS_INVALID;
+    }
+    return elf64_get_string_table_entry(result, table->strings_header,
+        table->strings, elf64_get_dynamic_value(entry));
+}
+
+/**
+ * Hint that a section's contents will be read soon.
+ *
+ * @param image The image the section belongs to.
+ * @param index The index of the section in the section header table.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such section.
+ */
+extern PrimStatus elf64_image_prefetch_section(
+    Elf64_Image* image, const Elf64_Word index)
+{
+    PrimStatus status = STATUS_ERROR;
+    const ELF64_Section_Header* header = NULL;
+    status = elf64_image_get_section_header(image, index, &header);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    if (header->type == ELF64_SECTION_TYPE_NOBITS)
+    {
+        return STATUS_OKAY;
+    }
+    return prim_map_advise(
+        &image->mapping, header->offset, header->size, PRIM_ADVICE_WILLNEED);
+}
+
+/**
+ * Hint that a segment's contents will be read soon.
+ *
+ * @param image The image the segment belongs to.
+ * @param index The index of the segment in the segment header table.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such segment.
+ */
+extern PrimStatus elf64_image_prefetch_segment(
+    Elf64_Image* image, const Elf64_Word index)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Segment_Header* header = NULL;
+    status = elf64_image_get_segment_header(image, index, &header);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    return prim_map_advise(&image->mapping, header->p_offset, header->p_filesz,
+        PRIM_ADVICE_WILLNEED);
+}
+
+/**
+ * Hash a section's contents, as stored in the binary.
+ *
+ * @note Sections which occupy no space in the binary hash as empty.
+ *
+ * @param image The image to read.
+ * @param index The index of the section in the section header table.
+ * @param result Location to return the hash.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such section
+ * or the section lies outside the binary.
+ */
+extern PrimStatus elf64_image_hash_section(
+    Elf64_Image* image, const Elf64_Word index, PrimHash128* result)
+{
+    PrimStatus status = STATUS_ERROR;
+    const void* data = NULL;
+    status = elf64_image_get_section_data(image, index, &data);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    prim_hash(data, data != NULL ? image->section_headers[index].size : 0,
+        result);
+    return STATUS_OKAY;
+}
+
+/** A request to hash every section of an image. */
+struct Elf64_Hash_Sections
+{
+    /** The image to hash. */
+    Elf64_Image* image;
+
+    /** Each section's hash. */
+    PrimHash128* results;
+
+    /** Non-zero if any section could not be hashed. */
+    int failed;
+};
+
+/**
+ * Hash one section of an image, in parallel with others.
+ *
+ * @param context The `struct Elf64_Hash_Sections` request.
+ * @param index The index of the section in the section header table.
+ */
+static void elf64_image_hash_task(void* context, const prim_usize index)
+{
+    struct Elf64_Hash_Sections* request = (struct Elf64_Hash_Sections*) context;
+    if (elf64_image_hash_section(
+            request->image, (Elf64_Word) index, &request->results[index])
+        != STATUS_OKAY)
+    {
+        request->results[index].low = 0;
+        request->results[index].high = 0;
+        request->failed = 1;
+    }
+}
+
+/**
+ * Hash every section of an image, spread across threads.
+ *
+ * The section header table is validated first, so the threads only read.
+ *
+ * @param image The image to read.
+ * @param results Location to return each section's hash, in section header
+ * table order. Sections which can not be hashed are left zero.
+ * @return STATUS_OKAY if every section was hashed, STATUS_INVALID if the
+ * section header table or any section is malformed, otherwise an error code.
+ */
+extern PrimStatus elf64_image_hash_sections(
+    Elf64_Image* image, PrimHash128* results)
+{
+    PrimStatus status = STATUS_ERROR;
+    struct Elf64_Hash_Sections request;
+    status = elf64_image_materialise_section_headers(image);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    request.image = image;
+    request.results = results;
+    request.failed = 0;
+    prim_parallel_for(
+        image->header->sh_entry_count, elf64_image_hash_task, &request);
+    return request.failed ? STATUS_INVALID : STATUS_OKAY;
+}
+
+/**
+ * Hash a segment's contents, as stored in the binary.
+ *
+ * @param image The image to read.
+ * @param index The index of the segment in the segment header table.
+ * @param result Location to return the hash.
+ * @return STATUS_OKAY on success, STATUS_INVALID if there is no such segment
+ * or the segment lies outside the binary.
+ */
+extern PrimStatus elf64_image_hash_segment(
+    Elf64_Image* image, const Elf64_Word index, PrimHash128* result)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Segment_Header* header = NULL;
+    status = elf64_image_get_segment_header(image, index, &header);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    status = elf64_image_check_range(image, header->p_offset, header->p_filesz);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    prim_hash(image->mapping.data + header->p_offset, header->p_filesz, result);
+    return STATUS_OKAY;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file src/format/elf64/section/dynamic.c
+ *
+ * Functions for reading ELF64 dynamic linking table entries.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#define PRIM_ACCESSOR_DEFINITIONS
+
+#include "format/elf64/section/dynamic.h"
+
+/** Associates a dynamic tag with a human readable string. */
+struct TagString
+{
+    const Elf64_Dynamic_Tag tag;
+    const char* const name;
+};
+
+/** Maps dynamic tags to human readable names. */
+static const struct TagString tag_strings[] = {
+    { ELF64_DT_NULL, "ELF64_DT_NULL" },
+    { ELF64_DT_NEEDED, "ELF64_DT_NEEDED" },
+    { ELF64_DT_PLTRELSZ, "ELF64_DT_PLTRELSZ" },
+    { ELF64_DT_PLTGOT, "ELF64_DT_PLTGOT" },
+    { ELF64_DT_HASH, "ELF64_DT_HASH" },
+    { ELF64_DT_STRTAB, "ELF64_DT_STRTAB" },
+    { ELF64_DT_SYMTAB, "ELF64_DT_SYMTAB" },
+    { ELF64_DT_RELA, "ELF64_DT_RELA" },
+    { ELF64_DT_RELASZ, "ELF64_DT_RELASZ" },
+    { ELF64_DT_RELAENT, "ELF64_DT_RELAENT" },
+    { ELF64_DT_STRSZ, "ELF64_DT_STRSZ" },
+    { ELF64_DT_SYMENT, "ELF64_DT_SYMENT" },
+    { ELF64_DT_INIT, "ELF64_DT_INIT" },
+    { ELF64_DT_FINI, "ELF64_DT_FINI" },
+    { ELF64_DT_SONAME, "ELF64_DT_SONAME" },
+    { ELF64_DT_RPATH, "ELF64_DT_RPATH" },
+    { ELF64_DT_REL, "ELF64_DT_REL" },
+    { ELF64_DT_PLTREL, "ELF64_DT_PLTREL" },
+    { ELF64_DT_TEXTREL, "ELF64_DT_TEXTREL" },
+    { ELF64_DT_JMPREL, "ELF64_DT_JMPREL" },
+    { ELF64_DT_BIND_NOW, "ELF64_DT_BIND_NOW" },
+    { ELF64_DT_INIT_ARRAY, "ELF64_DT_INIT_ARRAY" },
+    { ELF64_DT_FINI_ARRAY, "ELF64_DT_FINI_ARRAY" },
+    { ELF64_DT_INIT_ARRAYSZ, "ELF64_DT_INIT_ARRAYSZ" },
+    { ELF64_DT_FINI_ARRAYSZ, "ELF64_DT_FINI_ARRAYSZ" },
+    { ELF64_DT_RUNPATH, "ELF64_DT_RUNPATH" },
+    { ELF64_DT_FLAGS, "ELF64_DT_FLAGS" },
+    { ELF64_DT_RELRSZ, "ELF64_DT_RELRSZ" },
+    { ELF64_DT_RELR, "ELF64_DT_RELR" },
+    { ELF64_DT_RELRENT, "ELF64_DT_RELRENT" },
+    { ELF64_DT_GNU_HASH, "ELF64_DT_GNU_HASH" },
+    { ELF64_DT_VERSYM, "ELF64_DT_VERSYM" },
+    { ELF64_DT_RELACOUNT, "ELF64_DT_RELACOUNT" },
+    { ELF64_DT_FLAGS_1, "ELF64_DT_FLAGS_1" },
+    { ELF64_DT_VERDEF, "ELF64_DT_VERDEF" },
+    { ELF64_DT_VERDEFNUM, "ELF64_DT_VERDEFNUM" },
+    { ELF64_DT_VERNEED, "ELF64_DT_VERNEED" },
+    { ELF64_DT_VERNEEDNUM, "ELF64_DT_VERNEEDNUM" },
+};
+
+/**
+ * Get the tag of a dynamic table entry.
+ *
+ * @param entry The entry to read.
+ * @return The entry's tag.
+ */
+extern Elf64_Dynamic_Tag elf64_get_dynamic_tag(const Elf64_Dynamic* const entry)
+{
+    return entry->tag;
+}
+
+/**
+ * Get the value of a dynamic table entry.
+ *
+ * @param entry The entry to read.
+ * @return The entry's integer or address value.
+ */
+extern Elf64_Xword elf64_get_dynamic_value(const Elf64_Dynamic* const entry)
+{
+    return entry->value;
+}
+
+/**
+ * Get a string with a human readable dynamic tag name.
+ *
+ * @param tag The tag to string-ify.
+ * @return A human readable tag name.
+ */
+extern const char* elf64_get_dynamic_tag_string(const Elf64_Dynamic_Tag tag)
+{
+    static const char* const unrecognised_tag = "<ELF64_DT_UNKNOWN>";
+    unsigned int i = 0;
+    for (i = 0; i < sizeof(tag_strings) / sizeof(struct TagString); i++)
+    {
+        if (tag_strings[i].tag == tag)
+        {
+            return tag_strings[i].name;
+        }
+    }
+    return unrecognised_tag;
+}
@@ -8,6 +8,8 @@
  * @date May 2020.
  */
 
+#define PRIM_ACCESSOR_DEFINITIONS
+
 #include "format/elf64/section/flags.h"
 
 /**
@@ -24,6 +26,7 @@ static const struct FlagString flag_strings[] = {
     { ELF64_SECTION_FLAG_WRITE, "ELF64_SECTION_FLAG_WRITE" },
     { ELF64_SECTION_FLAG_ALLOC, "ELF64_SECTION_FLAG_ALLOC" },
     { ELF64_SECTION_FLAG_EXEC, "ELF64_SECTION_FLAG_EXEC" },
+    { ELF64_SECTION_FLAG_COMPRESSED, "ELF64_SECTION_FLAG_COMPRESSED" },
     { ELF64_SECTION_FLAG_MASK_PROC, "ELF64_SECTION_FLAG_MASK_PROC" },
 };
 
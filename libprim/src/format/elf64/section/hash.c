@@ -0,0 +1,92 @@
+/**
+ * @file src/format/elf64/section/hash.c
+ *
+ * Functions for reading GNU symbol hash tables.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "format/elf64/section/hash.h"
+#include "status.h"
+
+/** Number of bits in a bloom filter word. */
+#define ELF64_GNU_HASH_BLOOM_BITS 64
+
+/**
+ * Compute the GNU hash of a symbol name.
+ *
+ * @param name The name to hash.
+ * @return The name's hash.
+ */
+extern Elf64_Word elf64_gnu_hash(const char* name)
+{
+    Elf64_Word hash = 5381;
+    while (*name != '\0')
+    {
+        hash = hash * 33 + (unsigned char) *name;
+        name++;
+    }
+    return hash;
+}
+
+/**
+ * Validate a GNU hash table.
+ *
+ * @param table Location to return the table.
+ * @param data The table's contents. Must be 8-byte aligned.
+ * @param size The size of the table, in bytes.
+ * @param symbol_count Number of symbols in the dynamic symbol table.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the table is malformed.
+ */
+extern PrimStatus elf64_gnu_hash_parse(Elf64_Gnu_Hash_Table* table,
+    const void* data, const Elf64_Xword size, const Elf64_Word symbol_count)
+{
+    const Elf64_Gnu_Hash_Header* header = (const Elf64_Gnu_Hash_Header*) data;
+    Elf64_Xword required = sizeof(Elf64_Gnu_Hash_Header);
+    if (size < required || header->bucket_count == 0
+        || header->bloom_size == 0
+        || (header->bloom_size & (header->bloom_size - 1)) != 0
+        || header->symbol_offset > symbol_count)
+    {
+        return STATUS_INVALID;
+    }
+    required += (Elf64_Xword) header->bloom_size * sizeof(Elf64_Xword)
+        + (Elf64_Xword) header->bucket_count * sizeof(Elf64_Word)
+        + (Elf64_Xword) (symbol_count - header->symbol_offset)
+            * sizeof(Elf64_Word);
+    if (size < required)
+    {
+        return STATUS_INVALID;
+    }
+    table->header = header;
+    table->bloom = (const Elf64_Xword*) (header + 1);
+    table->buckets = (const Elf64_Word*) (table->bloom + header->bloom_size);
+    table->chains = table->buckets + header->bucket_count;
+    return STATUS_OKAY;
+}
+
+/**
+ * Check the bloom filter for a hash.
+ *
+ * @param table The table to check.
+ * @param hash The hash of the name to look for.
+ * @return STATUS_INVALID if the table certainly has no symbol with the hash,
+ * STATUS_OKAY if it may have one.
+ */
+extern PrimStatus elf64_gnu_hash_may_contain(
+    const Elf64_Gnu_Hash_Table* table, const Elf64_Word hash)
+{
+    Elf64_Xword word = table->bloom[(hash / ELF64_GNU_HASH_BLOOM_BITS)
+        & (table->header->bloom_size - 1)];
+    Elf64_Xword mask = ((Elf64_Xword) 1 << (hash % ELF64_GNU_HASH_BLOOM_BITS))
+        | ((Elf64_Xword) 1
+            << ((hash >> table->header->bloom_shift)
+                % ELF64_GNU_HASH_BLOOM_BITS));
+    if ((word & mask) != mask)
+    {
+        return STATUS_INVALID;
+    }
+    return STATUS_OKAY;
+}
@@ -8,6 +8,8 @@
  * @date May 2020.
  */
 
+#define PRIM_ACCESSOR_DEFINITIONS
+
 #include "format/elf64/section/header.h"
 #include "status.h"
 
@@ -64,7 +66,7 @@ extern Elf64_Offset elf64_get_section_offset(const ELF64_Section_Header* header)
 extern Elf64_Xword elf64_get_section_size(const ELF64_Section_Header* header)
 {
     Elf64_Xword length = 0;
-    length = header->offset;
+    length = header->size;
     return length;
 }
 
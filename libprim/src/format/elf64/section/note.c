@@ -0,0 +1,93 @@
+/**
+ * @file src/format/elf64/section/note.c
+ *
+ * Functions for reading ELF64 notes.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "format/elf64/section/note.h"
+#include <string.h>
+
+/**
+ * Round a note field's length up to the next four byte boundary.
+ *
+ * @param size The field's length.
+ * @return The length including its padding.
+ */
+static Elf64_Xword elf64_note_pad(const Elf64_Xword size)
+{
+    return (size + 3) & ~(Elf64_Xword) 3;
+}
+
+/**
+ * Step to the next note in a note area.
+ *
+ * @param data The note area. Four byte aligned.
+ * @param size Length of the note area, in bytes.
+ * @param offset Offset of the note to read. Advanced past it on success.
+ * @param note Location to return the note's header. Its owner's name follows
+ * the header.
+ * @param descriptor Location to return the note's descriptor.
+ * @return STATUS_OKAY on success, STATUS_INVALID at the end of the area or if
+ * the note is malformed.
+ */
+extern PrimStatus elf64_note_next(const Elf64_Byte* data,
+    const Elf64_Xword size, Elf64_Xword* offset, const Elf64_Note** note,
+    const Elf64_Byte** descriptor)
+{
+    const Elf64_Note* header = NULL;
+    Elf64_Xword length = 0;
+    if (*offset > size || size - *offset < sizeof(Elf64_Note))
+    {
+        return STATUS_INVALID;
+    }
+    header = (const Elf64_Note*) (data + *offset);
+    length = sizeof(Elf64_Note) + elf64_note_pad(header->name_size)
+        + elf64_note_pad(header->descriptor_size);
+    if (length > size - *offset)
+    {
+        return STATUS_INVALID;
+    }
+    *note = header;
+    *descriptor
+        = (const Elf64_Byte*) (header + 1) + elf64_note_pad(header->name_size);
+    *offset += length;
+    return STATUS_OKAY;
+}
+
+/**
+ * Find a note in a note area.
+ *
+ * @param data The note area. Four byte aligned.
+ * @param size Length of the note area, in bytes.
+ * @param name The owner's name.
+ * @param type The note's type.
+ * @param result Location to return the note's descriptor.
+ * @param result_size Location to return the descriptor's length.
+ * @return STATUS_OKAY if the note is found, STATUS_INVALID if it is not or
+ * the area is malformed.
+ */
+extern PrimStatus elf64_note_find(const Elf64_Byte* data,
+    const Elf64_Xword size, const char* name, const Elf64_Word type,
+    const Elf64_Byte** result, Elf64_Word* result_size)
+{
+    const Elf64_Note* note = NULL;
+    const Elf64_Byte* descriptor = NULL;
+    Elf64_Xword name_size = strlen(name) + 1;
+    Elf64_Xword offset = 0;
+    while (elf64_note_next(data, size, &offset, &note, &descriptor)
+        == STATUS_OKAY)
+    {
+        if (note->type == type && note->name_size == name_size
+            && memcmp(note + 1, name, name_size) == 0)
+        {
+            *result = descriptor;
+            *result_size = note->descriptor_size;
+            return STATUS_OKAY;
+        }
+    }
+    return STATUS_INVALID;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file src/format/elf64/section/relocation.c
+ *
+ * Functions for reading ELF64 relocation entries.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#define PRIM_ACCESSOR_DEFINITIONS
+
+#include "format/elf64/section/relocation.h"
+#include "status.h"
+
+/** Associates a relocation type with a human readable string. */
+struct TypeString
+{
+    const Elf64_Relocation_Type type;
+    const char* const name;
+};
+
+/** Maps relocation types to human readable names. */
+static const struct TypeString type_strings[] = {
+    { ELF64_R_X86_64_NONE, "ELF64_R_X86_64_NONE" },
+    { ELF64_R_X86_64_64, "ELF64_R_X86_64_64" },
+    { ELF64_R_X86_64_COPY, "ELF64_R_X86_64_COPY" },
+    { ELF64_R_X86_64_GLOB_DAT, "ELF64_R_X86_64_GLOB_DAT" },
+    { ELF64_R_X86_64_JUMP_SLOT, "ELF64_R_X86_64_JUMP_SLOT" },
+    { ELF64_R_X86_64_RELATIVE, "ELF64_R_X86_64_RELATIVE" },
+    { ELF64_R_X86_64_DTPMOD64, "ELF64_R_X86_64_DTPMOD64" },
+    { ELF64_R_X86_64_DTPOFF64, "ELF64_R_X86_64_DTPOFF64" },
+    { ELF64_R_X86_64_TPOFF64, "ELF64_R_X86_64_TPOFF64" },
+    { ELF64_R_X86_64_IRELATIVE, "ELF64_R_X86_64_IRELATIVE" },
+};
+
+/**
+ * Get the symbol table index of a relocation's symbol.
+ *
+ * @param relocation The relocation to read.
+ * @return The index of the symbol in the dynamic symbol table.
+ */
+extern Elf64_Word elf64_get_relocation_symbol(
+    const Elf64_Relocation* const relocation)
+{
+    return (Elf64_Word) (relocation->info >> 32U);
+}
+
+/**
+ * Get the type of a relocation.
+ *
+ * @note elf64_get_relocation_type does not check if the value is valid. See
+ * `elf64_is_relocation_type_valid`.
+ *
+ * @param relocation The relocation to read.
+ * @return The relocation's type.
+ */
+extern Elf64_Relocation_Type elf64_get_relocation_type(
+    const Elf64_Relocation* const relocation)
+{
+    return (Elf64_Relocation_Type) (relocation->info & 0xffffffffU);
+}
+
+/**
+ * Get a string with a human readable relocation type name.
+ *
+ * @param type The relocation type to string-ify.
+ * @return A human readable relocation type name.
+ */
+extern const char* elf64_get_relocation_type_string(
+    const Elf64_Relocation_Type type)
+{
+    static const char* const unrecognised_type
+        = "<ELF64_RELOCATION_TYPE_INVALID>";
+    unsigned int i = 0;
+    for (i = 0; i < sizeof(type_strings) / sizeof(struct TypeString); i++)
+    {
+        if (type_strings[i].type == type)
+        {
+            return type_strings[i].name;
+        }
+    }
+    return unrecognised_type;
+}
+
+/**
+ * Checks if a relocation type is one Prim understands.
+ *
+ * @param type A relocation type to test.
+ * @return `STATUS_OKAY` if the type is valid, `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus elf64_is_relocation_type_valid(
+    const Elf64_Relocation_Type type)
+{
+    unsigned int i = 0;
+    for (i = 0; i < sizeof(type_strings) / sizeof(struct TypeString); i++)
+    {
+        if (type_strings[i].type == type)
+        {
+            return STATUS_OKAY;
+        }
+    }
+    return STATUS_INVALID;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file src/format/elf64/section/symbol.c
+ *
+ * Functions for reading ELF64 symbol table entries.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#define PRIM_ACCESSOR_DEFINITIONS
+
+#include "format/elf64/section/symbol.h"
+#include "status.h"
+
+/** Associates an ELF64 symbol type with a human readable string. */
+struct TypeString
+{
+    const Elf64_Symbol_Type type;
+    const char* const name;
+};
+
+/** Maps ELF64 symbol types to human readable names. */
+static const struct TypeString type_strings[] = {
+    { ELF64_STT_NOTYPE, "ELF64_STT_NOTYPE" },
+    { ELF64_STT_OBJECT, "ELF64_STT_OBJECT" },
+    { ELF64_STT_FUNC, "ELF64_STT_FUNC" },
+    { ELF64_STT_SECTION, "ELF64_STT_SECTION" },
+    { ELF64_STT_FILE, "ELF64_STT_FILE" },
+    { ELF64_STT_COMMON, "ELF64_STT_COMMON" },
+    { ELF64_STT_TLS, "ELF64_STT_TLS" },
+    { ELF64_STT_GNU_IFUNC, "ELF64_STT_GNU_IFUNC" },
+};
+
+/**
+ * Extract the ELF64 symbol name index.
+ *
+ * @note `elf64_get_symbol_name` returns an index into the symbol string
+ * table, not the string name.
+ *
+ * @param symbol The symbol to read.
+ * @return The index of the symbol's name in the symbol string table.
+ */
+extern Elf64_Word elf64_get_symbol_name(const Elf64_Symbol* const symbol)
+{
+    return symbol->name;
+}
+
+/**
+ * Get the value of an ELF64 symbol.
+ *
+ * @param symbol The symbol to read.
+ * @return The symbol's value. For defined symbols in executables and shared
+ * objects, this is the link time virtual address.
+ */
+extern Elf64_Address elf64_get_symbol_value(const Elf64_Symbol* const symbol)
+{
+    return symbol->value;
+}
+
+/**
+ * Get the size of the object an ELF64 symbol refers to.
+ *
+ * @param symbol The symbol to read.
+ * @return The size of the object in bytes, or 0 if unknown.
+ */
+extern Elf64_Xword elf64_get_symbol_size(const Elf64_Symbol* const symbol)
+{
+    return symbol->size;
+}
+
+/**
+ * Get the index of the section an ELF64 symbol is defined in.
+ *
+ * @param symbol The symbol to read.
+ * @return The section index, or one of the `ELF64_SHN_*` special values.
+ */
+extern Elf64_Section elf64_get_symbol_section(const Elf64_Symbol* const symbol)
+{
+    return symbol->section;
+}
+
+/**
+ * Extract the type of an ELF64 symbol.
+ *
+ * @note elf64_get_symbol_type does not check if the value is valid. See
+ * `elf64_is_symbol_type_valid`.
+ *
+ * @param symbol The symbol to read.
+ * @return The symbol's type.
+ */
+extern Elf64_Symbol_Type elf64_get_symbol_type(const Elf64_Symbol* const symbol)
+{
+    return (Elf64_Symbol_Type) (symbol->info & 0xfU);
+}
+
+/**
+ * Extract the binding of an ELF64 symbol.
+ *
+ * @param symbol The symbol to read.
+ * @return The symbol's binding.
+ */
+extern Elf64_Symbol_Binding elf64_get_symbol_binding(
+    const Elf64_Symbol* const symbol)
+{
+    return (Elf64_Symbol_Binding) (symbol->info >> 4U);
+}
+
+/**
+ * Get a string with a human readable symbol type name.
+ *
+ * @param type The symbol type to string-ify.
+ * @return A human readable symbol type name.
+ */
+extern const char* elf64_get_symbol_type_string(const Elf64_Symbol_Type type)
+{
+    static const char* const unrecognised_type = "<ELF64_STT_INVALID>";
+    unsigned int i = 0;
+    for (i = 0; i < sizeof(type_strings) / sizeof(struct TypeString); i++)
+    {
+        if (type_strings[i].type == type)
+        {
+            return type_strings[i].name;
+        }
+    }
+    return unrecognised_type;
+}
+
+/**
+ * Checks if an ELF64 symbol type is a valid type code.
+ *
+ * @param type A symbol type to test.
+ * @return `STATUS_OKAY` if the type is valid, `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus elf64_is_symbol_type_valid(const Elf64_Symbol_Type type)
+{
+    unsigned int i = 0;
+    for (i = 0; i < sizeof(type_strings) / sizeof(struct TypeString); i++)
+    {
+        if (type_strings[i].type == type)
+        {
+            return STATUS_OKAY;
+        }
+    }
+    return STATUS_INVALID;
+}
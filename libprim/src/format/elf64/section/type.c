@@ -8,6 +8,8 @@
  * @date May 2020.
  */
 
+#define PRIM_ACCESSOR_DEFINITIONS
+
 #include "format/elf64/section/type.h"
 #include "format/elf64/section/header.h"
 
@@ -37,6 +39,7 @@ static const struct TypeString type_strings[] = {
     { ELF64_SECTION_TYPE_INIT_ARRAY, "ELF64_SECTION_TYPE_INIT_ARRAY" },
     { ELF64_SECTION_TYPE_PREINIT_ARRAY, "ELF64_SECTION_TYPE_PREINIT_ARRAY" },
     { ELF64_SECTION_TYPE_FINI_ARRAY, "ELF64_SECTION_TYPE_FINI_ARRAY" },
+    { ELF64_SECTION_TYPE_GNU_HASH, "ELF64_SECTION_TYPE_GNU_HASH" },
     { ELF64_SECTION_TYPE_GNU_VER_DEF, "ELF64_SECTION_TYPE_GNU_VER_DEF" },
     { ELF64_SECTION_TYPE_GNU_VER_REQ, "ELF64_SECTION_TYPE_GNU_VER_REQ" },
     { ELF64_SECTION_TYPE_GNU_VER_SYM, "ELF64_SECTION_TYPE_GNU_VER_SYM" },
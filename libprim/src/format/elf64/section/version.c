@@ -0,0 +1,39 @@
+/**
+ * @file src/format/elf64/section/version.c
+ *
+ * Functions for reading GNU symbol version entries.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "format/elf64/section/version.h"
+#include "status.h"
+
+/**
+ * Get the version index from a symbol's version entry.
+ *
+ * @param entry The symbol's entry in the `ELF64_SECTION_TYPE_GNU_VER_SYM`
+ * section.
+ * @return The version index.
+ */
+extern Elf64_Half elf64_get_version_index(const Elf64_Half entry)
+{
+    return (Elf64_Half) (entry & ELF64_VERSYM_INDEX);
+}
+
+/**
+ * Checks if a symbol's version entry is hidden.
+ *
+ * Hidden definitions are only found by references to their exact version.
+ * Unversioned references find the default version.
+ *
+ * @param entry The symbol's entry in the `ELF64_SECTION_TYPE_GNU_VER_SYM`
+ * section.
+ * @return `STATUS_OKAY` if the version is hidden, `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus elf64_is_version_hidden(const Elf64_Half entry)
+{
+    return (entry & ELF64_VERSYM_HIDDEN) ? STATUS_OKAY : STATUS_INVALID;
+}
@@ -8,6 +8,8 @@
  * @date May 2020.
  */
 
+#define PRIM_ACCESSOR_DEFINITIONS
+
 #include "format/elf64/segment/flags.h"
 #include "format/elf64/segment/header.h"
 #include "status.h"
@@ -8,6 +8,8 @@
  * @date June 2020.
  */
 
+#define PRIM_ACCESSOR_DEFINITIONS
+
 #include "format/elf64/segment/header.h"
 #include "format/elf64/types.h"
 
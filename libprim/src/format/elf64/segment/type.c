@@ -9,6 +9,8 @@
  * @date June 2020.
  */
 
+#define PRIM_ACCESSOR_DEFINITIONS
+
 #include "format/elf64/segment/type.h"
 #include "format/elf64/segment/header.h"
 #include "status.h"
@@ -29,7 +31,9 @@ static const struct Type_String type_strings[] = {
     { ELF64_PT_NOTE, "ELF64_PT_NOTE" },
     { ELF64_PT_SHLIB, "ELF64_PT_SHLIB" },
     { ELF64_PT_PHDR, "ELF64_PT_PHDR" },
+    { ELF64_PT_TLS, "ELF64_PT_TLS" },
     { ELF64_PT_LOOS, "ELF64_PT_LOOS" },
+    { ELF64_PT_GNU_RELRO, "ELF64_PT_GNU_RELRO" },
     { ELF64_PT_HIOS, "ELF64_PT_HIOS" },
     { ELF64_PT_LOPROC, "ELF64_PT_LOPROC" },
     { ELF64_PT_HIPROC, "ELF64_PT_HIPROC" },
@@ -64,6 +68,13 @@ extern const char* efl64_get_segment_type_string(const Elf64_Segment_Type type)
     static const char* const proc_range = "ELF64_PT_PROC";
     static const char* const os_range = "ELF64_PT_OS";
     unsigned int i = 0;
+    for (i = 0; i < sizeof(type_strings) / sizeof(struct Type_String); i++)
+    {
+        if (type_strings[i].type == type)
+        {
+            return type_strings[i].name;
+        }
+    }
     if (type >= ELF64_PT_LOPROC && type <= ELF64_PT_HIPROC)
     {
         return proc_range;
@@ -72,13 +83,6 @@ extern const char* efl64_get_segment_type_string(const Elf64_Segment_Type type)
     {
         return os_range;
     }
-    for (i = 0; i < sizeof(type_strings) / sizeof(struct Type_String); i++)
-    {
-        if (type_strings[i].type == type)
-        {
-            return type_strings[i].name;
-        }
-    }
     return unrecognised_type;
 }
 
@@ -0,0 +1,1161 @@
+/**
+ * @file src/format/elf64/symbol_index.c
+ *
+ * Implements building and querying symbol indexes.
+ *
+ * A symbol index holds a header, a record per binary, the bucket table, the
+ * postings, and then the string table holding every path and symbol name.
+ *
+ * @see `include/format/elf64/symbol_index.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "format/elf64/symbol_index.h"
+#include "format/elf64/image.h"
+#include "format/elf64/section/hash.h"
+#include "format/elf64/section/symbol.h"
+#include "format/elf64/section/type.h"
+#include "platform/file.h"
+#include "platform/mapping.h"
+#include "platform/memory.h"
+#include "platform/thread.h"
+#include "platform/types.h"
+#include "status.h"
+#include <string.h>
+
+/** Marks a binary which was not in the previous index. */
+#define ELF64_SYMBOL_INDEX_NONE ((prim_u64) -1)
+
+/** A symbol collected from a binary being indexed. */
+typedef struct
+{
+    /** The `elf64_gnu_hash` of the symbol's name. */
+    Elf64_Word hash;
+
+    /** `ELF64_SYMBOL_INDEX_*` flags describing the use. */
+    prim_u32 flags;
+
+    /** The symbol's name. */
+    const char* name;
+} Elf64_Symbol_Index_Entry;
+
+/** A binary being indexed. */
+typedef struct
+{
+    /** The binary's path. */
+    const char* path;
+
+    /** The binary's identity, read before it was indexed. */
+    PrimFileIdentity identity;
+
+    /** The binary's build ID, truncated to `ELF64_SYMBOL_INDEX_BUILD_ID_MAX`. */
+    Elf64_Byte build_id[ELF64_SYMBOL_INDEX_BUILD_ID_MAX];
+
+    /** Length of `build_id`. Zero if the binary has no build ID. */
+    prim_u32 build_id_size;
+
+    /** Index of the binary's record in the previous index, if it has one. */
+    prim_u64 previous;
+
+    /** Non-zero if the binary keeps its postings from the previous index. */
+    int reused;
+
+    /** The symbols the binary uses. */
+    Elf64_Symbol_Index_Entry* entries;
+
+    /** Number of symbols in `entries`. */
+    prim_usize count;
+
+    /** Copies of the names of a parsed binary's symbols, or `NULL`. */
+    char* names;
+
+    /**
+     * The result of checking and parsing the binary: STATUS_BAD_FILE if it no
+     * longer exists.
+     */
+    PrimStatus status;
+} Elf64_Symbol_Index_Source;
+
+/** A symbol index being built. */
+typedef struct
+{
+    /** The binaries being indexed. */
+    Elf64_Symbol_Index_Source* sources;
+
+    /** Number of binaries in `sources`. */
+    prim_usize count;
+
+    /**
+     * Open addressed hash table of the binaries, keyed by path. Slots hold a
+     * binary's index plus one, so zero marks an empty slot.
+     */
+    prim_usize* slots;
+
+    /** Number of slots, less one. Slot counts are powers of two. */
+    prim_usize mask;
+
+    /** The index being updated, or `NULL`. */
+    const Elf64_Symbol_Index* previous;
+} Elf64_Symbol_Index_Build;
+
+/** The string table of a symbol index being built. */
+typedef struct
+{
+    /** The strings, each with its terminator. */
+    char* data;
+
+    /** Number of bytes used in `data`. */
+    prim_usize size;
+
+    /** Number of bytes `data` has room for. */
+    prim_usize capacity;
+
+    /**
+     * Open addressed hash table of the symbol names added, keyed by name.
+     * Slots hold a name's offset plus one, so zero marks an empty slot.
+     */
+    prim_u64* slots;
+
+    /** Number of slots, less one. Slot counts are powers of two. */
+    prim_usize mask;
+
+    /** Number of names in `slots`. */
+    prim_usize name_count;
+} Elf64_Symbol_Index_Strings;
+
+/**
+ * Open a symbol index.
+ *
+ * @param index Location to return the opened index.
+ * @param path The index file.
+ * @return STATUS_OKAY on success, STATUS_INVALID if it is malformed,
+ * otherwise an error code. Nothing is left open on failure.
+ */
+extern PrimStatus elf64_symbol_index_open(
+    Elf64_Symbol_Index* index, const char* path)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Symbol_Index_Header* header = NULL;
+    prim_usize size = 0;
+    prim_usize i = 0;
+    memset(index, 0, sizeof(Elf64_Symbol_Index));
+    status = prim_map_file(path, &index->mapping);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    header = (const Elf64_Symbol_Index_Header*) index->mapping.data;
+    size = index->mapping.size;
+    if (size < sizeof(Elf64_Symbol_Index_Header)
+        || memcmp(
+               header->magic, ELF64_SYMBOL_INDEX_MAGIC, sizeof(header->magic))
+            != 0
+        || header->version != ELF64_SYMBOL_INDEX_VERSION
+        || header->bucket_shift > 32
+        || header->bucket_count != (prim_u64) 1 << (32 - header->bucket_shift))
+    {
+        elf64_symbol_index_close(index);
+        return STATUS_INVALID;
+    }
+    /* Bound each count by the file size before multiplying. */
+    if (header->file_count > size / sizeof(Elf64_Symbol_Index_File)
+        || header->bucket_count >= size / sizeof(prim_u64)
+        || header->posting_count > size / sizeof(Elf64_Symbol_Index_Posting)
+        || header->string_size > size
+        || sizeof(Elf64_Symbol_Index_Header)
+                + header->file_count * sizeof(Elf64_Symbol_Index_File)
+                + (header->bucket_count + 1) * sizeof(prim_u64)
+                + header->posting_count * sizeof(Elf64_Symbol_Index_Posting)
+                + header->string_size
+            > size)
+    {
+        elf64_symbol_index_close(index);
+        return STATUS_INVALID;
+    }
+    index->header = header;
+    index->files = (const Elf64_Symbol_Index_File*) (header + 1);
+    index->buckets = (const prim_u64*) (index->files + header->file_count);
+    index->postings = (const Elf64_Symbol_Index_Posting*) (index->buckets
+        + header->bucket_count + 1);
+    index->strings
+        = (const char*) (index->postings + header->posting_count);
+    /* Every string ends before the table does, so paths and names need only
+     * their offsets checked. */
+    if (header->string_size == 0
+            ? header->file_count != 0
+            : index->strings[header->string_size - 1] != '\0')
+    {
+        elf64_symbol_index_close(index);
+        return STATUS_INVALID;
+    }
+    for (i = 0; i < header->file_count; i++)
+    {
+        if (index->files[i].path >= header->string_size)
+        {
+            elf64_symbol_index_close(index);
+            return STATUS_INVALID;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Find the postings for a symbol name.
+ *
+ * Postings for one name are adjacent, and ordered by binary.
+ *
+ * @param index The index.
+ * @param name The symbol name to find.
+ * @param first Location to return the index of the name's first posting.
+ * @param count Location to return the number of postings for the name. Zero
+ * if no binary uses it.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the postings searched
+ * are malformed.
+ */
+extern PrimStatus elf64_symbol_index_find(const Elf64_Symbol_Index* index,
+    const char* name, prim_usize* first, prim_usize* count)
+{
+    const Elf64_Symbol_Index_Header* header = index->header;
+    const Elf64_Symbol_Index_Posting* posting = NULL;
+    Elf64_Word hash = elf64_gnu_hash(name);
+    prim_u64 bucket = (prim_u64) hash >> header->bucket_shift;
+    prim_u64 low = index->buckets[bucket];
+    prim_u64 high = index->buckets[bucket + 1];
+    prim_u64 i = 0;
+    *first = 0;
+    *count = 0;
+    if (low > high || high > header->posting_count)
+    {
+        return STATUS_INVALID;
+    }
+    for (i = low; i < high; i++)
+    {
+        posting = &index->postings[i];
+        if (posting->hash < hash)
+        {
+            continue;
+        }
+        if (posting->hash > hash)
+        {
+            break;
+        }
+        if (posting->name >= header->string_size
+            || posting->file >= header->file_count)
+        {
+            return STATUS_INVALID;
+        }
+        if (*count != 0)
+        {
+            /* Names are stored once, so the name's postings share an offset. */
+            if (posting->name != index->postings[*first].name)
+            {
+                break;
+            }
+            (*count)++;
+        }
+        else if (strcmp(index->strings + posting->name, name) == 0)
+        {
+            *first = i;
+            *count = 1;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Get the path of a binary in an index.
+ *
+ * @param index The index.
+ * @param file Index of the binary's record, from a posting `find` returned.
+ * @return The binary's path.
+ */
+extern const char* elf64_symbol_index_get_path(
+    const Elf64_Symbol_Index* index, prim_u64 file)
+{
+    return index->strings + index->files[file].path;
+}
+
+/**
+ * Close a symbol index.
+ *
+ * @param index The index to close.
+ */
+extern void elf64_symbol_index_close(Elf64_Symbol_Index* index)
+{
+    prim_unmap_file(&index->mapping);
+    memset(index, 0, sizeof(Elf64_Symbol_Index));
+}
+
+/**
+ * Add a binary to an index being built, unless it is already there.
+ *
+ * @param build The index being built.
+ * @param path The binary's path.
+ * @param record Index of the binary's record in the previous index, or
+ * `ELF64_SYMBOL_INDEX_NONE`.
+ */
+static void elf64_symbol_index_add_source(
+    Elf64_Symbol_Index_Build* build, const char* path, prim_u64 record)
+{
+    Elf64_Symbol_Index_Source* source = &build->sources[build->count];
+    prim_usize slot = elf64_gnu_hash(path) & build->mask;
+    while (build->slots[slot] != 0)
+    {
+        if (strcmp(build->sources[build->slots[slot] - 1].path, path) == 0)
+        {
+            return;
+        }
+        slot = (slot + 1) & build->mask;
+    }
+    memset(source, 0, sizeof(Elf64_Symbol_Index_Source));
+    source->path = path;
+    source->previous = record;
+    source->status = STATUS_OKAY;
+    build->slots[slot] = ++build->count;
+}
+
+/**
+ * Give the binaries kept from a previous index their old postings.
+ *
+ * @param build The index being built.
+ * @param previous The previous index.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the previous postings
+ * are malformed, otherwise an error code.
+ */
+static PrimStatus elf64_symbol_index_reuse(
+    Elf64_Symbol_Index_Build* build, const Elf64_Symbol_Index* previous)
+{
+    PrimStatus status = STATUS_OKAY;
+    const Elf64_Symbol_Index_Header* header = previous->header;
+    const Elf64_Symbol_Index_Posting* posting = NULL;
+    Elf64_Symbol_Index_Source* source = NULL;
+    prim_usize* sources = NULL;
+    prim_usize i = 0;
+    status = prim_malloc(
+        (void**) &sources, (header->file_count + 1) * sizeof(prim_usize));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(sources, 0, (header->file_count + 1) * sizeof(prim_usize));
+    for (i = 0; i < build->count && status == STATUS_OKAY; i++)
+    {
+        source = &build->sources[i];
+        if (!source->reused)
+        {
+            continue;
+        }
+        sources[source->previous] = i + 1;
+        if (previous->files[source->previous].symbol_count
+            > header->posting_count)
+        {
+            status = STATUS_INVALID;
+        }
+        else if (previous->files[source->previous].symbol_count != 0)
+        {
+            status = prim_malloc((void**) &source->entries,
+                previous->files[source->previous].symbol_count
+                    * sizeof(Elf64_Symbol_Index_Entry));
+        }
+    }
+    for (i = 0; i < header->posting_count && status == STATUS_OKAY; i++)
+    {
+        posting = &previous->postings[i];
+        if (posting->file >= header->file_count
+            || posting->name >= header->string_size)
+        {
+            status = STATUS_INVALID;
+            break;
+        }
+        if (sources[posting->file] == 0)
+        {
+            continue;
+        }
+        source = &build->sources[sources[posting->file] - 1];
+        if (source->count == previous->files[posting->file].symbol_count)
+        {
+            status = STATUS_INVALID;
+            break;
+        }
+        source->entries[source->count].hash = posting->hash;
+        source->entries[source->count].flags = posting->flags;
+        source->entries[source->count].name
+            = previous->strings + posting->name;
+        source->count++;
+    }
+    for (i = 0; i < build->count && status == STATUS_OKAY; i++)
+    {
+        source = &build->sources[i];
+        if (source->reused
+            && source->count
+                != previous->files[source->previous].symbol_count)
+        {
+            status = STATUS_INVALID;
+        }
+    }
+    prim_free(sources);
+    return status;
+}
+
+/**
+ * Checks if a symbol is one a binary defines for others or imports.
+ *
+ * @param table The symbol table holding the symbol.
+ * @param symbol The symbol to check.
+ * @param name Location to return the symbol's name.
+ * @return Non-zero if the symbol is global or weak, names a function or
+ * object, and has a name.
+ */
+static int elf64_symbol_index_is_indexed(const Elf64_Symbol_Table* table,
+    const Elf64_Symbol* symbol, const char** name)
+{
+    Elf64_Symbol_Type type = elf64_get_symbol_type(symbol);
+    return elf64_get_symbol_binding(symbol) != ELF64_STB_LOCAL
+        && type != ELF64_STT_SECTION && type != ELF64_STT_FILE
+        && elf64_symbol_table_get_name(table, symbol, name) == STATUS_OKAY
+        && **name != '\0';
+}
+
+/**
+ * Collect the symbols a binary defines and imports from one of its symbol
+ * tables.
+ *
+ * @param source The binary being indexed.
+ * @param table The symbol table.
+ * @param flags Flags to give every symbol collected.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+static PrimStatus elf64_symbol_index_collect(Elf64_Symbol_Index_Source* source,
+    const Elf64_Symbol_Table* table, prim_u32 flags)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Symbol_Index_Entry* entry = NULL;
+    const Elf64_Symbol* symbol = NULL;
+    const char* name = NULL;
+    prim_usize count = 0;
+    prim_usize size = 0;
+    prim_usize length = 0;
+    Elf64_Word i = 0;
+    for (i = 0; i < table->count; i++)
+    {
+        if (elf64_symbol_index_is_indexed(table, &table->symbols[i], &name))
+        {
+            count++;
+            size += strlen(name) + 1;
+        }
+    }
+    if (count == 0)
+    {
+        return STATUS_OKAY;
+    }
+    status = prim_malloc(
+        (void**) &source->entries, count * sizeof(Elf64_Symbol_Index_Entry));
+    if (status == STATUS_OKAY)
+    {
+        status = prim_malloc((void**) &source->names, size);
+    }
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    size = 0;
+    for (i = 0; i < table->count; i++)
+    {
+        symbol = &table->symbols[i];
+        if (!elf64_symbol_index_is_indexed(table, symbol, &name))
+        {
+            continue;
+        }
+        length = strlen(name) + 1;
+        memcpy(source->names + size, name, length);
+        entry = &source->entries[source->count++];
+        entry->hash = elf64_gnu_hash(name);
+        entry->flags = flags;
+        entry->name = source->names + size;
+        if (elf64_get_symbol_section(symbol) != ELF64_SHN_UNDEF)
+        {
+            entry->flags |= ELF64_SYMBOL_INDEX_DEFINED;
+        }
+        if (elf64_get_symbol_binding(symbol) == ELF64_STB_WEAK)
+        {
+            entry->flags |= ELF64_SYMBOL_INDEX_WEAK;
+        }
+        size += length;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Checks if a binary being indexed can keep its postings from the previous
+ * index, copying its build ID from there if it can.
+ *
+ * @param build The index being built.
+ * @param source The binary, with its identity and, if `opened`, its build ID
+ * read.
+ * @param opened Non-zero if the binary's build ID has been read.
+ * @return Non-zero if the binary has the identity it was indexed with, or
+ * has been opened and has the build ID it was indexed with. A previous
+ * record whose build ID size is out of range never matches.
+ */
+static int elf64_symbol_index_is_unchanged(
+    const Elf64_Symbol_Index_Build* build,
+    Elf64_Symbol_Index_Source* source, int opened)
+{
+    const Elf64_Symbol_Index_File* record = NULL;
+    if (source->previous == ELF64_SYMBOL_INDEX_NONE)
+    {
+        return 0;
+    }
+    record = &build->previous->files[source->previous];
+    if (!opened)
+    {
+        if (memcmp(&record->identity, &source->identity,
+                sizeof(PrimFileIdentity))
+            != 0)
+        {
+            return 0;
+        }
+        /* A corrupt build ID size is treated as a change, and reparsed. */
+        if (record->build_id_size > ELF64_SYMBOL_INDEX_BUILD_ID_MAX)
+        {
+            return 0;
+        }
+        memcpy(source->build_id, record->build_id,
+            sizeof(source->build_id));
+        source->build_id_size = record->build_id_size;
+        return 1;
+    }
+    return source->build_id_size != 0
+        && source->build_id_size == record->build_id_size
+        && record->build_id_size <= ELF64_SYMBOL_INDEX_BUILD_ID_MAX
+        && memcmp(source->build_id, record->build_id, source->build_id_size)
+        == 0;
+}
+
+/**
+ * Check and parse a binary being indexed.
+ *
+ * The binary is first only `stat`ed: if it is unchanged since the previous
+ * index, it keeps its postings. Otherwise its build ID is read, and only if
+ * that has changed too are its symbols parsed. A file which is not an ELF64
+ * binary, or whose symbol tables are malformed, is indexed with no symbols.
+ *
+ * @param context The index being built.
+ * @param index Index of the binary to check.
+ */
+static void elf64_symbol_index_scan(void* context, prim_usize index)
+{
+    Elf64_Symbol_Index_Build* build = (Elf64_Symbol_Index_Build*) context;
+    Elf64_Symbol_Index_Source* source = &build->sources[index];
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Image image;
+    const Elf64_Symbol_Table* table = NULL;
+    const Elf64_Byte* build_id = NULL;
+    Elf64_Word build_id_size = 0;
+    prim_u32 flags = ELF64_SYMBOL_INDEX_DYNAMIC;
+    if (prim_file_identity(source->path, &source->identity) != STATUS_OKAY)
+    {
+        source->status = STATUS_BAD_FILE;
+        return;
+    }
+    if (elf64_symbol_index_is_unchanged(build, source, 0))
+    {
+        source->reused = 1;
+        return;
+    }
+    status = elf64_image_open(&image, source->path);
+    if (status != STATUS_OKAY)
+    {
+        source->status = status == STATUS_ERROR ? status : STATUS_OKAY;
+        return;
+    }
+    if (elf64_image_get_build_id(&image, &build_id, &build_id_size)
+            == STATUS_OKAY
+        && build_id != NULL)
+    {
+        if (build_id_size > ELF64_SYMBOL_INDEX_BUILD_ID_MAX)
+        {
+            build_id_size = ELF64_SYMBOL_INDEX_BUILD_ID_MAX;
+        }
+        memcpy(source->build_id, build_id, build_id_size);
+        source->build_id_size = build_id_size;
+    }
+    if (elf64_symbol_index_is_unchanged(build, source, 1))
+    {
+        source->reused = 1;
+        elf64_image_close(&image);
+        return;
+    }
+    status = elf64_image_get_symbol_table(
+        &image, ELF64_SECTION_TYPE_DYNSYM, &table);
+    if (status == STATUS_OKAY && table->count == 0)
+    {
+        flags = 0;
+        status = elf64_image_get_symbol_table(
+            &image, ELF64_SECTION_TYPE_SYMBOL_TABLE, &table);
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_symbol_index_collect(source, table, flags);
+    }
+    source->status = status == STATUS_ERROR ? status : STATUS_OKAY;
+    elf64_image_close(&image);
+}
+
+/**
+ * Append a string to the string table of an index being built.
+ *
+ * @param strings The string table.
+ * @param string The string to add.
+ * @param offset Location to return the string's offset.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+static PrimStatus elf64_symbol_index_append(
+    Elf64_Symbol_Index_Strings* strings, const char* string, prim_u64* offset)
+{
+    PrimStatus status = STATUS_ERROR;
+    prim_usize length = strlen(string) + 1;
+    prim_usize capacity = strings->capacity == 0 ? 4096 : strings->capacity;
+    char* data = NULL;
+    while (capacity - strings->size < length)
+    {
+        capacity *= 2;
+    }
+    if (capacity != strings->capacity)
+    {
+        status = prim_malloc((void**) &data, capacity);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        if (strings->data != NULL)
+        {
+            memcpy(data, strings->data, strings->size);
+            prim_free(strings->data);
+        }
+        strings->data = data;
+        strings->capacity = capacity;
+    }
+    memcpy(strings->data + strings->size, string, length);
+    *offset = strings->size;
+    strings->size += length;
+    return STATUS_OKAY;
+}
+
+/**
+ * Add a symbol name to the string table of an index being built, unless it
+ * is already there.
+ *
+ * @param strings The string table.
+ * @param name The name to add.
+ * @param hash The name's `elf64_gnu_hash`.
+ * @param offset Location to return the name's offset.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+static PrimStatus elf64_symbol_index_intern(Elf64_Symbol_Index_Strings* strings,
+    const char* name, Elf64_Word hash, prim_u64* offset)
+{
+    PrimStatus status = STATUS_ERROR;
+    prim_u64* slots = NULL;
+    prim_usize count = 0;
+    prim_usize slot = 0;
+    prim_usize i = 0;
+    /* Keep the table at most half full, rehashing into one twice the size. */
+    if (2 * (strings->name_count + 1) > strings->mask + 1)
+    {
+        count = strings->slots == NULL ? 1024 : 2 * (strings->mask + 1);
+        status = prim_malloc((void**) &slots, count * sizeof(prim_u64));
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        memset(slots, 0, count * sizeof(prim_u64));
+        for (i = 0; strings->slots != NULL && i <= strings->mask; i++)
+        {
+            if (strings->slots[i] == 0)
+            {
+                continue;
+            }
+            slot = elf64_gnu_hash(strings->data + strings->slots[i] - 1)
+                & (count - 1);
+            while (slots[slot] != 0)
+            {
+                slot = (slot + 1) & (count - 1);
+            }
+            slots[slot] = strings->slots[i];
+        }
+        if (strings->slots != NULL)
+        {
+            prim_free(strings->slots);
+        }
+        strings->slots = slots;
+        strings->mask = count - 1;
+    }
+    slot = hash & strings->mask;
+    while (strings->slots[slot] != 0)
+    {
+        if (strcmp(strings->data + strings->slots[slot] - 1, name) == 0)
+        {
+            *offset = strings->slots[slot] - 1;
+            return STATUS_OKAY;
+        }
+        slot = (slot + 1) & strings->mask;
+    }
+    status = elf64_symbol_index_append(strings, name, offset);
+    if (status == STATUS_OKAY)
+    {
+        strings->slots[slot] = *offset + 1;
+        strings->name_count++;
+    }
+    return status;
+}
+
+/**
+ * Checks if a posting sorts before another: by name hash, then by name.
+ *
+ * @param posting The posting to check.
+ * @param other The posting to compare it with.
+ * @return Non-zero if `posting` sorts first.
+ */
+static int elf64_symbol_index_before(const Elf64_Symbol_Index_Posting* posting,
+    const Elf64_Symbol_Index_Posting* other)
+{
+    return posting->hash < other->hash
+        || (posting->hash == other->hash && posting->name < other->name);
+}
+
+/**
+ * Sort postings by name hash, then by name.
+ *
+ * The sort is a stable merge sort, so postings added in binary order stay in
+ * binary order within each name.
+ *
+ * @param postings The postings to sort.
+ * @param count Number of postings.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+static PrimStatus elf64_symbol_index_sort(
+    Elf64_Symbol_Index_Posting* postings, prim_usize count)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Symbol_Index_Posting* scratch = NULL;
+    Elf64_Symbol_Index_Posting* from = postings;
+    Elf64_Symbol_Index_Posting* to = NULL;
+    Elf64_Symbol_Index_Posting* swap = NULL;
+    prim_usize width = 0;
+    prim_usize low = 0;
+    prim_usize middle = 0;
+    prim_usize high = 0;
+    prim_usize i = 0;
+    prim_usize j = 0;
+    prim_usize k = 0;
+    if (count < 2)
+    {
+        return STATUS_OKAY;
+    }
+    status = prim_malloc(
+        (void**) &scratch, count * sizeof(Elf64_Symbol_Index_Posting));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    to = scratch;
+    for (width = 1; width < count; width *= 2)
+    {
+        for (low = 0; low < count; low += 2 * width)
+        {
+            middle = count - low < width ? count : low + width;
+            high = count - middle < width ? count : middle + width;
+            i = low;
+            j = middle;
+            k = low;
+            while (i < middle && j < high)
+            {
+                to[k++] = elf64_symbol_index_before(&from[j], &from[i])
+                    ? from[j++]
+                    : from[i++];
+            }
+            while (i < middle)
+            {
+                to[k++] = from[i++];
+            }
+            while (j < high)
+            {
+                to[k++] = from[j++];
+            }
+        }
+        swap = from;
+        from = to;
+        to = swap;
+    }
+    if (from != postings)
+    {
+        memcpy(postings, from, count * sizeof(Elf64_Symbol_Index_Posting));
+    }
+    prim_free(scratch);
+    return STATUS_OKAY;
+}
+
+/**
+ * Lay out the records of an index being built: its binaries, postings,
+ * buckets and strings.
+ *
+ * A binary listing a name more than once, such as a dynamic symbol with
+ * several versions, gets a single posting with the flags of every use.
+ *
+ * @param build The index being built.
+ * @param header The index's header, to complete.
+ * @param files Location to return the binary records.
+ * @param postings Location to return the postings.
+ * @param buckets Location to return the bucket table.
+ * @param strings The string table to fill.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+static PrimStatus elf64_symbol_index_layout(
+    const Elf64_Symbol_Index_Build* build, Elf64_Symbol_Index_Header* header,
+    Elf64_Symbol_Index_File** files, Elf64_Symbol_Index_Posting** postings,
+    prim_u64** buckets, Elf64_Symbol_Index_Strings* strings)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Symbol_Index_Source* source = NULL;
+    Elf64_Symbol_Index_Posting* posting = NULL;
+    prim_usize count = 0;
+    prim_usize i = 0;
+    prim_usize j = 0;
+    prim_u32 bits = 0;
+    for (i = 0; i < build->count; i++)
+    {
+        count += build->sources[i].count;
+    }
+    status = prim_malloc((void**) files,
+        (build->count + 1) * sizeof(Elf64_Symbol_Index_File));
+    if (status == STATUS_OKAY)
+    {
+        status = prim_malloc((void**) postings,
+            (count + 1) * sizeof(Elf64_Symbol_Index_Posting));
+    }
+    for (i = 0; i < build->count && status == STATUS_OKAY; i++)
+    {
+        source = &build->sources[i];
+        memset(&(*files)[i], 0, sizeof(Elf64_Symbol_Index_File));
+        (*files)[i].identity = source->identity;
+        (*files)[i].symbol_count = source->count;
+        memcpy((*files)[i].build_id, source->build_id, source->build_id_size);
+        (*files)[i].build_id_size = source->build_id_size;
+        status = elf64_symbol_index_append(
+            strings, source->path, &(*files)[i].path);
+    }
+    count = 0;
+    for (i = 0; i < build->count && status == STATUS_OKAY; i++)
+    {
+        source = &build->sources[i];
+        for (j = 0; j < source->count && status == STATUS_OKAY; j++)
+        {
+            posting = &(*postings)[count++];
+            posting->hash = source->entries[j].hash;
+            posting->flags = source->entries[j].flags;
+            posting->file = i;
+            status = elf64_symbol_index_intern(strings,
+                source->entries[j].name, posting->hash, &posting->name);
+        }
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_symbol_index_sort(*postings, count);
+    }
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    /* Postings sort by binary within each name, so repeats are adjacent. */
+    for (i = 0, j = 0; i < count; i++)
+    {
+        posting = &(*postings)[i];
+        if (j != 0 && posting->name == (*postings)[j - 1].name
+            && posting->file == (*postings)[j - 1].file)
+        {
+            (*postings)[j - 1].flags |= posting->flags;
+            (*files)[posting->file].symbol_count--;
+            continue;
+        }
+        (*postings)[j++] = *posting;
+    }
+    count = j;
+    while (bits < 32 && ((prim_usize) 1 << bits) < strings->name_count)
+    {
+        bits++;
+    }
+    header->file_count = build->count;
+    header->bucket_shift = 32 - bits;
+    header->bucket_count = (prim_u64) 1 << bits;
+    header->posting_count = count;
+    header->string_size = strings->size;
+    status = prim_malloc(
+        (void**) buckets, (header->bucket_count + 1) * sizeof(prim_u64));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(*buckets, 0, (header->bucket_count + 1) * sizeof(prim_u64));
+    for (i = 0; i < count; i++)
+    {
+        (*buckets)[((prim_u64) (*postings)[i].hash >> header->bucket_shift)
+            + 1]++;
+    }
+    for (i = 0; i < header->bucket_count; i++)
+    {
+        (*buckets)[i + 1] += (*buckets)[i];
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Write a symbol index's records to a file.
+ *
+ * @param file The file to write.
+ * @param header The index's header.
+ * @param files The index's binary records.
+ * @param buckets The index's bucket table.
+ * @param postings The index's postings.
+ * @param strings The index's string table.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_symbol_index_write(prim_file_handle file,
+    const Elf64_Symbol_Index_Header* header,
+    const Elf64_Symbol_Index_File* files, const prim_u64* buckets,
+    const Elf64_Symbol_Index_Posting* postings,
+    const Elf64_Symbol_Index_Strings* strings)
+{
+    PrimStatus status = STATUS_ERROR;
+    status = prim_fwrite(header, sizeof(Elf64_Symbol_Index_Header), 1, file);
+    if (status == STATUS_OKAY && header->file_count != 0)
+    {
+        status = prim_fwrite(files, sizeof(Elf64_Symbol_Index_File),
+            header->file_count, file);
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = prim_fwrite(
+            buckets, sizeof(prim_u64), header->bucket_count + 1, file);
+    }
+    if (status == STATUS_OKAY && header->posting_count != 0)
+    {
+        status = prim_fwrite(postings, sizeof(Elf64_Symbol_Index_Posting),
+            header->posting_count, file);
+    }
+    if (status == STATUS_OKAY && header->string_size != 0)
+    {
+        status = prim_fwrite(strings->data, 1, header->string_size, file);
+    }
+    return status;
+}
+
+/**
+ * Write a symbol index beside its final path, then rename it into place.
+ *
+ * @param path The index file to write.
+ * @param header The index's header.
+ * @param files The index's binary records.
+ * @param buckets The index's bucket table.
+ * @param postings The index's postings.
+ * @param strings The index's string table.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_symbol_index_replace(const char* path,
+    const Elf64_Symbol_Index_Header* header,
+    const Elf64_Symbol_Index_File* files, const prim_u64* buckets,
+    const Elf64_Symbol_Index_Posting* postings,
+    const Elf64_Symbol_Index_Strings* strings)
+{
+    PrimStatus status = STATUS_ERROR;
+    PrimStatus close_status = STATUS_ERROR;
+    prim_file_handle file;
+    char* temporary = NULL;
+    status = prim_malloc((void**) &temporary, strlen(path) + 5);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    strcpy(temporary, path);
+    strcat(temporary, ".new");
+    status = prim_fcreate(temporary, &file);
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_symbol_index_write(
+            file, header, files, buckets, postings, strings);
+        close_status = prim_fclose(file);
+        if (status == STATUS_OKAY)
+        {
+            status = close_status;
+        }
+        if (status == STATUS_OKAY)
+        {
+            status = prim_frename(temporary, path);
+        }
+        if (status != STATUS_OKAY)
+        {
+            prim_fremove(temporary);
+        }
+    }
+    prim_free(temporary);
+    return status;
+}
+
+/**
+ * Index the symbols of a list of binaries, and save them to a symbol index.
+ *
+ * With a previous index, every binary it holds is indexed too: those whose
+ * identity or build ID is unchanged keep their postings without their
+ * symbols being parsed, those which have changed are parsed again, and those
+ * which no longer exist are dropped. Paths are indexed once, however often
+ * they are given. Binaries are checked and parsed in parallel.
+ *
+ * Files which cannot be read are skipped, and files which are not ELF64
+ * binaries are recorded with no symbols, so later updates pass over them.
+ *
+ * The file is written beside `path` and then renamed over it, so the
+ * previous index may be the one being replaced, and processes with an older
+ * index mapped keep a consistent copy.
+ *
+ * @param path The index file to write.
+ * @param files Paths of the binaries to index.
+ * @param file_count Number of paths in `files`.
+ * @param previous An index to update, or `NULL`.
+ * @param scanned Location to return the number of binaries whose symbols
+ * were parsed, or `NULL`.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_symbol_index_save(const char* path,
+    const char* const* files, prim_usize file_count,
+    const Elf64_Symbol_Index* previous, prim_usize* scanned)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Symbol_Index_Build build;
+    Elf64_Symbol_Index_Header header;
+    Elf64_Symbol_Index_Strings strings;
+    Elf64_Symbol_Index_File* records = NULL;
+    Elf64_Symbol_Index_Posting* postings = NULL;
+    prim_u64* buckets = NULL;
+    prim_usize total = file_count;
+    prim_usize size = 0;
+    prim_usize i = 0;
+    memset(&build, 0, sizeof(Elf64_Symbol_Index_Build));
+    memset(&strings, 0, sizeof(Elf64_Symbol_Index_Strings));
+    memset(&header, 0, sizeof(Elf64_Symbol_Index_Header));
+    memcpy(header.magic, ELF64_SYMBOL_INDEX_MAGIC, sizeof(header.magic));
+    header.version = ELF64_SYMBOL_INDEX_VERSION;
+    if (previous != NULL)
+    {
+        total += previous->header->file_count;
+    }
+    for (size = 1; size < 2 * total; size <<= 1)
+        ;
+    status = prim_malloc((void**) &build.sources,
+        (total + 1) * sizeof(Elf64_Symbol_Index_Source));
+    if (status == STATUS_OKAY)
+    {
+        status = prim_malloc((void**) &build.slots, size * sizeof(prim_usize));
+    }
+    if (status == STATUS_OKAY)
+    {
+        memset(build.slots, 0, size * sizeof(prim_usize));
+        build.mask = size - 1;
+        build.previous = previous;
+        for (i = 0; previous != NULL && i < previous->header->file_count; i++)
+        {
+            elf64_symbol_index_add_source(
+                &build, elf64_symbol_index_get_path(previous, i), i);
+        }
+        for (i = 0; i < file_count; i++)
+        {
+            elf64_symbol_index_add_source(
+                &build, files[i], ELF64_SYMBOL_INDEX_NONE);
+        }
+        status = prim_parallel_for(
+            build.count, elf64_symbol_index_scan, &build);
+    }
+    for (i = 0; i < build.count && status == STATUS_OKAY; i++)
+    {
+        if (build.sources[i].status == STATUS_ERROR)
+        {
+            status = STATUS_ERROR;
+        }
+    }
+    /* Drop the binaries which no longer exist. */
+    for (i = 0, size = 0; i < build.count && status == STATUS_OKAY; i++)
+    {
+        if (build.sources[i].status == STATUS_OKAY)
+        {
+            build.sources[size++] = build.sources[i];
+        }
+    }
+    if (status == STATUS_OKAY)
+    {
+        build.count = size;
+        if (previous != NULL)
+        {
+            status = elf64_symbol_index_reuse(&build, previous);
+        }
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_symbol_index_layout(
+            &build, &header, &records, &postings, &buckets, &strings);
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_symbol_index_replace(
+            path, &header, records, buckets, postings, &strings);
+    }
+    if (scanned != NULL)
+    {
+        *scanned = 0;
+        for (i = 0; i < build.count; i++)
+        {
+            *scanned += !build.sources[i].reused;
+        }
+    }
+    for (i = 0; i < build.count; i++)
+    {
+        if (build.sources[i].entries != NULL)
+        {
+            prim_free(build.sources[i].entries);
+        }
+        if (build.sources[i].names != NULL)
+        {
+            prim_free(build.sources[i].names);
+        }
+    }
+    if (buckets != NULL)
+    {
+        prim_free(buckets);
+    }
+    if (postings != NULL)
+    {
+        prim_free(postings);
+    }
+    if (records != NULL)
+    {
+        prim_free(records);
+    }
+    if (strings.data != NULL)
+    {
+        prim_free(strings.data);
+    }
+    if (strings.slots != NULL)
+    {
+        prim_free(strings.slots);
+    }
+    if (build.slots != NULL)
+    {
+        prim_free(build.slots);
+    }
+    if (build.sources != NULL)
+    {
+        prim_free(build.sources);
+    }
+    return status;
+}
@@ -0,0 +1,755 @@
+/**
+ * @file src/format/zlib/inflate.c
+ *
+ * Implements one shot DEFLATE and zlib decompression.
+ *
+ * @see `include/format/zlib/inflate.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "format/zlib/inflate.h"
+#include "platform/types.h"
+#include "status.h"
+#include <string.h>
+
+/** Longest Huffman code DEFLATE allows, in bits. */
+#define ZLIB_MAX_CODE_BITS 15
+
+/** Codes up to this many bits are decoded with a single table lookup. */
+#define ZLIB_FAST_BITS 10
+
+/** Selects the bits of input indexing the fast lookup table. */
+#define ZLIB_FAST_MASK ((1u << ZLIB_FAST_BITS) - 1)
+
+/** Bits of a fast lookup table entry holding the symbol. */
+#define ZLIB_FAST_SYMBOL_BITS 9
+
+/** Number of literal and length symbols, including the two unused ones. */
+#define ZLIB_LITERAL_CODES 288
+
+/** Number of distance symbols, including the two unused ones. */
+#define ZLIB_DISTANCE_CODES 32
+
+/** Number of symbols in the code length alphabet. */
+#define ZLIB_CODE_LENGTH_CODES 19
+
+/** The literal and length symbol ending a block. */
+#define ZLIB_END_OF_BLOCK 256
+
+/** The first literal and length symbol encoding a match length. */
+#define ZLIB_FIRST_LENGTH 257
+
+/** Number of match length symbols in use. */
+#define ZLIB_LENGTH_SYMBOLS 29
+
+/** Number of distance symbols in use. */
+#define ZLIB_DISTANCE_SYMBOLS 30
+
+/** The zlib compression method for DEFLATE. */
+#define ZLIB_METHOD_DEFLATE 8
+
+/** The zlib header flag for a preset dictionary. */
+#define ZLIB_FLAG_DICTIONARY 0x20
+
+/** The Adler-32 modulus. */
+#define ZLIB_ADLER_BASE 65521
+
+/** Bytes Adler-32 can sum before its totals must be reduced. */
+#define ZLIB_ADLER_RUN 5552
+
+/** DEFLATE block types. */
+enum Zlib_Block_Type
+{
+    ZLIB_BLOCK_STORED = 0,
+    ZLIB_BLOCK_FIXED = 1,
+    ZLIB_BLOCK_DYNAMIC = 2,
+};
+
+/** A Huffman code, prepared for decoding. */
+typedef struct
+{
+    /**
+     * Decodes the next `ZLIB_FAST_BITS` bits of input. Each entry holds a
+     * code's length above `ZLIB_FAST_SYMBOL_BITS`, and its symbol below, or
+     * zero if the code is longer than `ZLIB_FAST_BITS`.
+     */
+    prim_u16 fast[1u << ZLIB_FAST_BITS];
+
+    /**
+     * One past the last code of each length, left aligned to 16 bits, for
+     * the canonical search of long codes.
+     */
+    prim_u32 max_code[ZLIB_MAX_CODE_BITS + 2];
+
+    /** The first code of each length. */
+    prim_u16 first_code[ZLIB_MAX_CODE_BITS + 1];
+
+    /** Index in `symbols` of the first code of each length. */
+    prim_u16 first_symbol[ZLIB_MAX_CODE_BITS + 1];
+
+    /** Each code's length, in canonical order. */
+    prim_u8 lengths[ZLIB_LITERAL_CODES];
+
+    /** Each code's symbol, in canonical order. */
+    prim_u16 symbols[ZLIB_LITERAL_CODES];
+} Zlib_Huffman;
+
+/** A stream being inflated. */
+typedef struct
+{
+    /** The next byte of input to load. */
+    const prim_u8* next;
+
+    /** The end of the input. */
+    const prim_u8* end;
+
+    /** Loaded input, least significant bit first. */
+    prim_u64 bits;
+
+    /** Number of valid bits in `bits`. */
+    unsigned int count;
+
+    /** The start of the output. */
+    prim_u8* start;
+
+    /** The next byte of output to write. */
+    prim_u8* out;
+
+    /** The end of the output buffer. */
+    prim_u8* limit;
+} Zlib_Stream;
+
+/** The base length of each match length symbol. */
+static const prim_u16 length_bases[ZLIB_LENGTH_SYMBOLS] = { 3, 4, 5, 6, 7, 8,
+    9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115,
+    131, 163, 195, 227, 258 };
+
+/** Extra bits following each match length symbol. */
+static const prim_u8 length_extra[ZLIB_LENGTH_SYMBOLS] = { 0, 0, 0, 0, 0, 0,
+    0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+/** The base distance of each distance symbol. */
+static const prim_u16 distance_bases[ZLIB_DISTANCE_SYMBOLS] = { 1, 2, 3, 4, 5,
+    7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025,
+    1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+
+/** Extra bits following each distance symbol. */
+static const prim_u8 distance_extra[ZLIB_DISTANCE_SYMBOLS] = { 0, 0, 0, 0, 1,
+    1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12,
+    13, 13 };
+
+/** The order code lengths for the code length alphabet are stored in. */
+static const prim_u8 code_length_order[ZLIB_CODE_LENGTH_CODES] = { 16, 17, 18,
+    0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+/**
+ * Reverse the low bits of a code, since Huffman codes are packed most
+ * significant bit first into a least significant bit first stream.
+ *
+ * @param code The code to reverse.
+ * @param length Number of bits in the code.
+ * @return The reversed code.
+ */
+static unsigned int zlib_reverse(unsigned int code, unsigned int length)
+{
+    unsigned int reversed = 0;
+    while (length-- > 0)
+    {
+        reversed = (reversed << 1) | (code & 1);
+        code >>= 1;
+    }
+    return reversed;
+}
+
+/**
+ * Build a Huffman code from its code lengths.
+ *
+ * Incomplete codes are allowed, as DEFLATE uses them for distance codes
+ * with a single symbol. Unused codes fail to decode.
+ *
+ * @param code The code to build.
+ * @param lengths Each symbol's code length, or zero if it is unused.
+ * @param count Number of symbols.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the lengths describe
+ * more codes than fit.
+ */
+static PrimStatus zlib_build_huffman(
+    Zlib_Huffman* code, const prim_u8* lengths, const unsigned int count)
+{
+    unsigned int counts[ZLIB_MAX_CODE_BITS + 1];
+    unsigned int next_code[ZLIB_MAX_CODE_BITS + 1];
+    unsigned int next = 0;
+    unsigned int symbol = 0;
+    unsigned int length = 0;
+    unsigned int index = 0;
+    unsigned int slot = 0;
+    memset(counts, 0, sizeof(counts));
+    memset(code->fast, 0, sizeof(code->fast));
+    memset(code->lengths, 0, sizeof(code->lengths));
+    for (symbol = 0; symbol < count; symbol++)
+    {
+        counts[lengths[symbol]]++;
+    }
+    counts[0] = 0;
+    index = 0;
+    for (length = 1; length <= ZLIB_MAX_CODE_BITS; length++)
+    {
+        next_code[length] = next;
+        code->first_code[length] = (prim_u16) next;
+        code->first_symbol[length] = (prim_u16) index;
+        next += counts[length];
+        if (next > (1u << length))
+        {
+            return STATUS_INVALID;
+        }
+        code->max_code[length] = next << (16 - length);
+        next <<= 1;
+        index += counts[length];
+    }
+    code->max_code[ZLIB_MAX_CODE_BITS + 1] = 0x10000;
+    for (symbol = 0; symbol < count; symbol++)
+    {
+        length = lengths[symbol];
+        if (length == 0)
+        {
+            continue;
+        }
+        index = next_code[length] - code->first_code[length]
+            + code->first_symbol[length];
+        code->lengths[index] = (prim_u8) length;
+        code->symbols[index] = (prim_u16) symbol;
+        if (length <= ZLIB_FAST_BITS)
+        {
+            for (slot = zlib_reverse(next_code[length], length);
+                 slot < (1u << ZLIB_FAST_BITS); slot += 1u << length)
+            {
+                code->fast[slot]
+                    = (prim_u16) (length << ZLIB_FAST_SYMBOL_BITS | symbol);
+            }
+        }
+        next_code[length]++;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Load as much input as fits in a stream's bit buffer.
+ *
+ * Away from the end of the input a whole word is loaded at once. Bits past
+ * `count` may then hold input which is loaded again, to the same place, by
+ * the next refill.
+ *
+ * @param stream The stream to refill.
+ */
+static void zlib_refill(Zlib_Stream* stream)
+{
+    prim_u64 word = 0;
+    if (stream->end - stream->next >= (long) sizeof(word))
+    {
+        memcpy(&word, stream->next, sizeof(word));
+        stream->bits |= word << stream->count;
+        stream->next += (63 - stream->count) >> 3;
+        stream->count |= 56;
+        return;
+    }
+    while (stream->count < 56 && stream->next < stream->end)
+    {
+        stream->bits |= (prim_u64) *stream->next++ << stream->count;
+        stream->count += 8;
+    }
+}
+
+/**
+ * Take bits from a stream.
+ *
+ * @param stream The stream to read.
+ * @param count Number of bits to take, at most 16.
+ * @param result Location to return the bits.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the input ran out.
+ */
+static PrimStatus zlib_take_bits(
+    Zlib_Stream* stream, const unsigned int count, unsigned int* result)
+{
+    if (stream->count < count)
+    {
+        zlib_refill(stream);
+        if (stream->count < count)
+        {
+            return STATUS_INVALID;
+        }
+    }
+    *result = (unsigned int) (stream->bits & ((1u << count) - 1));
+    stream->bits >>= count;
+    stream->count -= count;
+    return STATUS_OKAY;
+}
+
+/**
+ * Decode a symbol whose code is longer than the fast lookup table, by a
+ * canonical code search.
+ *
+ * @param stream The stream to read.
+ * @param code The code to decode with.
+ * @return The symbol, or -1 if the input is not a valid code.
+ */
+static int zlib_decode_slow(Zlib_Stream* stream, const Zlib_Huffman* code)
+{
+    unsigned int key = zlib_reverse((unsigned int) (stream->bits & 0xffff), 16);
+    unsigned int length = ZLIB_FAST_BITS + 1;
+    unsigned int index = 0;
+    while (key >= code->max_code[length])
+    {
+        length++;
+    }
+    if (length > ZLIB_MAX_CODE_BITS || length > stream->count)
+    {
+        return -1;
+    }
+    index = (key >> (16 - length)) - code->first_code[length]
+        + code->first_symbol[length];
+    if (index >= ZLIB_LITERAL_CODES || code->lengths[index] != length)
+    {
+        return -1;
+    }
+    stream->bits >>= length;
+    stream->count -= length;
+    return code->symbols[index];
+}
+
+/**
+ * Decode a symbol.
+ *
+ * @param stream The stream to read.
+ * @param code The code to decode with.
+ * @return The symbol, or -1 if the input is not a valid code.
+ */
+static int zlib_decode(Zlib_Stream* stream, const Zlib_Huffman* code)
+{
+    prim_u16 entry = 0;
+    unsigned int length = 0;
+    if (stream->count < 16)
+    {
+        zlib_refill(stream);
+    }
+    entry = code->fast[stream->bits & ZLIB_FAST_MASK];
+    if (entry == 0)
+    {
+        return zlib_decode_slow(stream, code);
+    }
+    length = entry >> ZLIB_FAST_SYMBOL_BITS;
+    if (length > stream->count)
+    {
+        return -1;
+    }
+    stream->bits >>= length;
+    stream->count -= length;
+    return entry & ((1u << ZLIB_FAST_SYMBOL_BITS) - 1);
+}
+
+/**
+ * Copy a match from earlier in the output.
+ *
+ * Matches which do not overlap themselves within a word are copied a word
+ * at a time when the output has room for the last word to overrun; the
+ * overrun is overwritten by later output. Runs of a single byte are filled.
+ *
+ * @param out Where the match is copied to.
+ * @param distance How far back the match starts. At least one.
+ * @param length Length of the match.
+ * @param limit The end of the output buffer.
+ */
+static void zlib_copy_match(prim_u8* out, const prim_usize distance,
+    prim_usize length, const prim_u8* limit)
+{
+    const prim_u8* from = out - distance;
+    const prim_u8* end = out + length;
+    prim_u64 word = 0;
+    if (distance >= sizeof(word)
+        && (prim_usize) (limit - out) >= length + sizeof(word))
+    {
+        do
+        {
+            memcpy(&word, from, sizeof(word));
+            memcpy(out, &word, sizeof(word));
+            from += sizeof(word);
+            out += sizeof(word);
+        } while (out < end);
+        return;
+    }
+    if (distance == 1)
+    {
+        memset(out, *from, length);
+        return;
+    }
+    while (length-- > 0)
+    {
+        *out++ = *from++;
+    }
+}
+
+/**
+ * Inflate the compressed data of a block, up to its end of block symbol.
+ *
+ * @param stream The stream to inflate.
+ * @param literals The literal and length code.
+ * @param distances The distance code.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the data is
+ * malformed or overflows the output.
+ */
+static PrimStatus zlib_inflate_codes(Zlib_Stream* stream,
+    const Zlib_Huffman* literals, const Zlib_Huffman* distances)
+{
+    int symbol = 0;
+    unsigned int extra = 0;
+    prim_usize length = 0;
+    prim_usize distance = 0;
+    for (;;)
+    {
+        symbol = zlib_decode(stream, literals);
+        if (symbol < 0)
+        {
+            return STATUS_INVALID;
+        }
+        if (symbol < ZLIB_END_OF_BLOCK)
+        {
+            if (stream->out == stream->limit)
+            {
+                return STATUS_INVALID;
+            }
+            *stream->out++ = (prim_u8) symbol;
+            continue;
+        }
+        if (symbol == ZLIB_END_OF_BLOCK)
+        {
+            return STATUS_OKAY;
+        }
+        symbol -= ZLIB_FIRST_LENGTH;
+        if (symbol >= ZLIB_LENGTH_SYMBOLS
+            || zlib_take_bits(stream, length_extra[symbol], &extra)
+                != STATUS_OKAY)
+        {
+            return STATUS_INVALID;
+        }
+        length = length_bases[symbol] + extra;
+        symbol = zlib_decode(stream, distances);
+        if (symbol < 0 || symbol >= ZLIB_DISTANCE_SYMBOLS
+            || zlib_take_bits(stream, distance_extra[symbol], &extra)
+                != STATUS_OKAY)
+        {
+            return STATUS_INVALID;
+        }
+        distance = distance_bases[symbol] + extra;
+        if (distance > (prim_usize) (stream->out - stream->start)
+            || length > (prim_usize) (stream->limit - stream->out))
+        {
+            return STATUS_INVALID;
+        }
+        zlib_copy_match(stream->out, distance, length, stream->limit);
+        stream->out += length;
+    }
+}
+
+/**
+ * Copy a stored block to the output.
+ *
+ * @param stream The stream to inflate.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the block is
+ * malformed or overflows the output.
+ */
+static PrimStatus zlib_inflate_stored(Zlib_Stream* stream)
+{
+    prim_usize length = 0;
+    /* Stored blocks start on a byte boundary. Return unused whole bytes. */
+    stream->count -= stream->count % 8;
+    stream->next -= stream->count / 8;
+    stream->bits = 0;
+    stream->count = 0;
+    if (stream->end - stream->next < 4)
+    {
+        return STATUS_INVALID;
+    }
+    length = (prim_usize) stream->next[0] | (prim_usize) stream->next[1] << 8;
+    if ((stream->next[2] ^ stream->next[0]) != 0xff
+        || (stream->next[3] ^ stream->next[1]) != 0xff)
+    {
+        return STATUS_INVALID;
+    }
+    stream->next += 4;
+    if ((prim_usize) (stream->end - stream->next) < length
+        || (prim_usize) (stream->limit - stream->out) < length)
+    {
+        return STATUS_INVALID;
+    }
+    memcpy(stream->out, stream->next, length);
+    stream->out += length;
+    stream->next += length;
+    return STATUS_OKAY;
+}
+
+/**
+ * Build the fixed literal and length, and distance, codes.
+ *
+ * @param literals The literal and length code to build.
+ * @param distances The distance code to build.
+ */
+static void zlib_build_fixed(Zlib_Huffman* literals, Zlib_Huffman* distances)
+{
+    prim_u8 lengths[ZLIB_LITERAL_CODES];
+    memset(lengths, 8, 144);
+    memset(lengths + 144, 9, 256 - 144);
+    memset(lengths + 256, 7, 280 - 256);
+    memset(lengths + 280, 8, ZLIB_LITERAL_CODES - 280);
+    zlib_build_huffman(literals, lengths, ZLIB_LITERAL_CODES);
+    memset(lengths, 5, ZLIB_DISTANCE_CODES);
+    zlib_build_huffman(distances, lengths, ZLIB_DISTANCE_CODES);
+}
+
+/**
+ * Read a dynamic block's codes.
+ *
+ * @param stream The stream to inflate.
+ * @param literals The literal and length code to build.
+ * @param distances The distance code to build.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the codes are
+ * malformed.
+ */
+static PrimStatus zlib_read_dynamic(
+    Zlib_Stream* stream, Zlib_Huffman* literals, Zlib_Huffman* distances)
+{
+    prim_u8 lengths[ZLIB_LITERAL_CODES + ZLIB_DISTANCE_CODES];
+    Zlib_Huffman code_lengths;
+    unsigned int literal_count = 0;
+    unsigned int distance_count = 0;
+    unsigned int length_count = 0;
+    unsigned int repeat = 0;
+    unsigned int index = 0;
+    prim_u8 value = 0;
+    int symbol = 0;
+    if (zlib_take_bits(stream, 5, &literal_count) != STATUS_OKAY
+        || zlib_take_bits(stream, 5, &distance_count) != STATUS_OKAY
+        || zlib_take_bits(stream, 4, &length_count) != STATUS_OKAY)
+    {
+        return STATUS_INVALID;
+    }
+    literal_count += ZLIB_FIRST_LENGTH;
+    distance_count += 1;
+    length_count += 4;
+    if (literal_count > ZLIB_FIRST_LENGTH + ZLIB_LENGTH_SYMBOLS
+        || distance_count > ZLIB_DISTANCE_SYMBOLS)
+    {
+        return STATUS_INVALID;
+    }
+    memset(lengths, 0, ZLIB_CODE_LENGTH_CODES);
+    for (index = 0; index < length_count; index++)
+    {
+        if (zlib_take_bits(stream, 3, &repeat) != STATUS_OKAY)
+        {
+            return STATUS_INVALID;
+        }
+        lengths[code_length_order[index]] = (prim_u8) repeat;
+    }
+    if (zlib_build_huffman(&code_lengths, lengths, ZLIB_CODE_LENGTH_CODES)
+        != STATUS_OKAY)
+    {
+        return STATUS_INVALID;
+    }
+    index = 0;
+    while (index < literal_count + distance_count)
+    {
+        symbol = zlib_decode(stream, &code_lengths);
+        if (symbol < 0)
+        {
+            return STATUS_INVALID;
+        }
+        if (symbol < 16)
+        {
+            lengths[index++] = (prim_u8) symbol;
+            continue;
+        }
+        if (symbol == 16)
+        {
+            if (index == 0 || zlib_take_bits(stream, 2, &repeat) != STATUS_OKAY)
+            {
+                return STATUS_INVALID;
+            }
+            value = lengths[index - 1];
+            repeat += 3;
+        }
+        else if (symbol == 17)
+        {
+            if (zlib_take_bits(stream, 3, &repeat) != STATUS_OKAY)
+            {
+                return STATUS_INVALID;
+            }
+            value = 0;
+            repeat += 3;
+        }
+        else
+        {
+            if (zlib_take_bits(stream, 7, &repeat) != STATUS_OKAY)
+            {
+                return STATUS_INVALID;
+            }
+            value = 0;
+            repeat += 11;
+        }
+        if (repeat > literal_count + distance_count - index)
+        {
+            return STATUS_INVALID;
+        }
+        memset(lengths + index, value, repeat);
+        index += repeat;
+    }
+    if (lengths[ZLIB_END_OF_BLOCK] == 0
+        || zlib_build_huffman(literals, lengths, literal_count) != STATUS_OKAY
+        || zlib_build_huffman(
+               distances, lengths + literal_count, distance_count)
+            != STATUS_OKAY)
+    {
+        return STATUS_INVALID;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Inflate a raw DEFLATE stream.
+ *
+ * @param source The compressed stream.
+ * @param source_size Length of the compressed stream, in bytes.
+ * @param destination Location to write the uncompressed data.
+ * @param destination_size Length of `destination`, in bytes.
+ * @param result_size Location to return the length of the uncompressed data.
+ * @param consumed Location to return the number of bytes of `source` the
+ * stream used, or `NULL`.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the stream is malformed or
+ * does not fit in `destination`.
+ */
+extern PrimStatus zlib_inflate(const prim_u8* source,
+    const prim_usize source_size, prim_u8* destination,
+    const prim_usize destination_size, prim_usize* result_size,
+    prim_usize* consumed)
+{
+    PrimStatus status = STATUS_OKAY;
+    Zlib_Stream stream;
+    Zlib_Huffman literals;
+    Zlib_Huffman distances;
+    unsigned int final = 0;
+    unsigned int type = 0;
+    stream.next = source;
+    stream.end = source + source_size;
+    stream.bits = 0;
+    stream.count = 0;
+    stream.start = destination;
+    stream.out = destination;
+    stream.limit = destination + destination_size;
+    while (status == STATUS_OKAY && !final)
+    {
+        if (zlib_take_bits(&stream, 1, &final) != STATUS_OKAY
+            || zlib_take_bits(&stream, 2, &type) != STATUS_OKAY)
+        {
+            return STATUS_INVALID;
+        }
+        switch (type)
+        {
+        case ZLIB_BLOCK_STORED:
+            status = zlib_inflate_stored(&stream);
+            break;
+        case ZLIB_BLOCK_FIXED:
+            zlib_build_fixed(&literals, &distances);
+            status = zlib_inflate_codes(&stream, &literals, &distances);
+            break;
+        case ZLIB_BLOCK_DYNAMIC:
+            status = zlib_read_dynamic(&stream, &literals, &distances);
+            if (status == STATUS_OKAY)
+            {
+                status = zlib_inflate_codes(&stream, &literals, &distances);
+            }
+            break;
+        default:
+            status = STATUS_INVALID;
+            break;
+        }
+    }
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    *result_size = (prim_usize) (stream.out - stream.start);
+    if (consumed != NULL)
+    {
+        *consumed = (prim_usize) (stream.next - source) - stream.count / 8;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Decompress a zlib stream, and check its checksum.
+ *
+ * @param source The zlib stream.
+ * @param source_size Length of the zlib stream, in bytes.
+ * @param destination Location to write the uncompressed data.
+ * @param destination_size Length of the uncompressed data, in bytes. The
+ * stream must produce exactly this much.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the stream is malformed,
+ * uses a preset dictionary, produces a different length, or fails its
+ * checksum.
+ */
+extern PrimStatus zlib_decompress(const prim_u8* source,
+    const prim_usize source_size, prim_u8* destination,
+    const prim_usize destination_size)
+{
+    PrimStatus status = STATUS_ERROR;
+    const prim_u8* trailer = NULL;
+    prim_usize produced = 0;
+    prim_usize consumed = 0;
+    prim_u32 checksum = 0;
+    if (source_size < 6 || (source[0] & 0xf) != ZLIB_METHOD_DEFLATE
+        || (source[0] >> 4) > 7 || (source[0] << 8 | source[1]) % 31 != 0
+        || (source[1] & ZLIB_FLAG_DICTIONARY) != 0)
+    {
+        return STATUS_INVALID;
+    }
+    status = zlib_inflate(source + 2, source_size - 2, destination,
+        destination_size, &produced, &consumed);
+    if (status != STATUS_OKAY || produced != destination_size
+        || source_size - 2 - consumed < 4)
+    {
+        return STATUS_INVALID;
+    }
+    trailer = source + 2 + consumed;
+    checksum = (prim_u32) trailer[0] << 24 | (prim_u32) trailer[1] << 16
+        | (prim_u32) trailer[2] << 8 | trailer[3];
+    return checksum == zlib_adler32(destination, destination_size)
+        ? STATUS_OKAY
+        : STATUS_INVALID;
+}
+
+/**
+ * Compute the Adler-32 checksum of some data, as used by zlib streams.
+ *
+ * @param data The data to check.
+ * @param size Length of the data, in bytes.
+ * @return The checksum.
+ */
+extern prim_u32 zlib_adler32(const prim_u8* data, prim_usize size)
+{
+    prim_u32 low = 1;
+    prim_u32 high = 0;
+    prim_usize run = 0;
+    while (size > 0)
+    {
+        run = size < ZLIB_ADLER_RUN ? size : ZLIB_ADLER_RUN;
+        size -= run;
+        while (run-- > 0)
+        {
+            low += *data++;
+            high += low;
+        }
+        low %= ZLIB_ADLER_BASE;
+        high %= ZLIB_ADLER_BASE;
+    }
+    return high << 16 | low;
+}
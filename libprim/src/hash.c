@@ -0,0 +1,283 @@
+/**
+ * @file src/hash.c
+ *
+ * Implements Prim's content hashes.
+ *
+ * @see `include/hash.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "hash.h"
+#include "platform/mapping.h"
+#include "platform/types.h"
+#include "status.h"
+#include <string.h>
+
+/** Number of stripes between scrambles of the lanes. */
+#define PRIM_HASH_BLOCK_STRIPES 16
+
+/** Offset in `hash_keys` of the keys used to scramble the lanes. */
+#define PRIM_HASH_SCRAMBLE_KEYS 24
+
+/** Offset in `hash_keys` of the keys used to merge the low 64 bits. */
+#define PRIM_HASH_LOW_KEYS 16
+
+/** Offset in `hash_keys` of the keys used to merge the high 64 bits. */
+#define PRIM_HASH_HIGH_KEYS 8
+
+/** Odd multiplier for scrambling lanes. */
+#define PRIM_HASH_PRIME_32 0x9e3779b1u
+
+/** Odd multiplier for merging lanes. */
+#define PRIM_HASH_PRIME_64 0x9e3779b97f4a7c15u
+
+/**
+ * Keys mixed into the input and lanes. Each stripe of a block uses the eight
+ * keys starting at its position in the block.
+ */
+static const prim_u64 hash_keys[32] = {
+    0x2cb0f69f4abea221, 0x9417034723148989, 0xdd555950609dfe03,
+    0xdbafb150deb12800, 0x7e789b2e6c442cb6, 0xf41e5636c7e4f8c4,
+    0x0959d150f8fba7e4, 0xa97316f13cdb9eea, 0x74cd8258f9520068,
+    0x55c74a62e116868b, 0xd2f4c799a2023cbd, 0xdf98cb79a37b51b9,
+    0x396f5885524f3905, 0xaf1d56386ca3b276, 0xa9ffbe6b5104e85a,
+    0x6bd0c51b9fd533b3, 0x980ce91c50ab4b56, 0x28ac395780fe62c5,
+    0x768912e3a6bcedc7, 0x50b3e8c9332c7c88, 0xce3bbfe520bd47da,
+    0xcba6c8e8e0bb7c4f, 0xbf194db8434a346d, 0x7d8f2a7b60416d7f,
+    0x0849d1f6e0e10a5e, 0x7654b590d064e22f, 0x16d1da9507df3af2,
+    0xf63aef1089ea30e4, 0x9ade6673cc6c522b, 0x4c75bc274e37087c,
+    0xd35e12b49f51f27b, 0x22ddf2ffcee481ea,
+};
+
+/**
+ * Accumulate a stripe into the lanes.
+ *
+ * Each lane gains the product of the halves of its keyed input word, and its
+ * neighbour gains the input word itself, so no input bits are lost to the
+ * multiply.
+ *
+ * @param lanes The lanes to accumulate into.
+ * @param stripe The stripe to accumulate.
+ * @param keys The stripe's keys.
+ */
+static void prim_hash_accumulate(
+    prim_u64* lanes, const prim_u8* stripe, const prim_u64* keys)
+{
+    prim_u64 words[PRIM_HASH_LANES];
+    prim_u64 keyed = 0;
+    unsigned int i = 0;
+    memcpy(words, stripe, sizeof(words));
+    for (i = 0; i < PRIM_HASH_LANES; i++)
+    {
+        keyed = words[i] ^ keys[i];
+        lanes[i ^ 1] += words[i];
+        lanes[i] += (keyed & 0xffffffffu) * (keyed >> 32);
+    }
+}
+
+/**
+ * Scramble the lanes at the end of a block, so their high bits feed back
+ * into the low bits the multiplies read.
+ *
+ * @param lanes The lanes to scramble.
+ */
+static void prim_hash_scramble(prim_u64* lanes)
+{
+    unsigned int i = 0;
+    for (i = 0; i < PRIM_HASH_LANES; i++)
+    {
+        lanes[i] ^= lanes[i] >> 47;
+        lanes[i] ^= hash_keys[PRIM_HASH_SCRAMBLE_KEYS + i];
+        lanes[i] *= PRIM_HASH_PRIME_32;
+    }
+}
+
+/**
+ * Consume a whole stripe of input.
+ *
+ * @param state The hash to update.
+ * @param stripe The stripe to consume.
+ */
+static void prim_hash_consume(PrimHashState* state, const prim_u8* stripe)
+{
+    prim_hash_accumulate(state->lanes, stripe, hash_keys + state->stripe);
+    if (++state->stripe == PRIM_HASH_BLOCK_STRIPES)
+    {
+        prim_hash_scramble(state->lanes);
+        state->stripe = 0;
+    }
+}
+
+/**
+ * Mix a 64-bit value so every input bit affects every output bit.
+ *
+ * @param value The value to mix.
+ * @return The mixed value.
+ */
+static prim_u64 prim_hash_avalanche(prim_u64 value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdu;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53u;
+    value ^= value >> 33;
+    return value;
+}
+
+/**
+ * Merge the lanes into 64 bits of the hash.
+ *
+ * @param lanes The lanes to merge.
+ * @param seed The starting value.
+ * @param keys The keys to mix into each lane.
+ * @return 64 bits of the hash.
+ */
+static prim_u64 prim_hash_merge(
+    const prim_u64* lanes, prim_u64 seed, const prim_u64* keys)
+{
+    unsigned int i = 0;
+    for (i = 0; i < PRIM_HASH_LANES; i++)
+    {
+        seed = (seed ^ prim_hash_avalanche(lanes[i] ^ keys[i]))
+            * PRIM_HASH_PRIME_64;
+    }
+    return prim_hash_avalanche(seed);
+}
+
+/**
+ * Start streaming a hash.
+ *
+ * @param state The hash to initialise.
+ */
+extern void prim_hash_init(PrimHashState* state)
+{
+    memset(state, 0, sizeof(PrimHashState));
+}
+
+/**
+ * Add input to a streamed hash.
+ *
+ * @param state The hash to update.
+ * @param data The input. May be `NULL` if `size` is zero.
+ * @param size Length of the input, in bytes.
+ */
+extern void prim_hash_update(
+    PrimHashState* state, const void* data, prim_usize size)
+{
+    const prim_u8* bytes = (const prim_u8*) data;
+    prim_usize taken = 0;
+    /* Empty input may have no buffer, which `memcpy` must not be passed. */
+    if (size == 0)
+    {
+        return;
+    }
+    state->length += size;
+    if (state->buffered != 0)
+    {
+        taken = PRIM_HASH_STRIPE_SIZE - state->buffered;
+        taken = taken < size ? taken : size;
+        memcpy(state->buffer + state->buffered, bytes, taken);
+        state->buffered += taken;
+        bytes += taken;
+        size -= taken;
+        if (state->buffered < PRIM_HASH_STRIPE_SIZE)
+        {
+            return;
+        }
+        prim_hash_consume(state, state->buffer);
+        state->buffered = 0;
+    }
+    while (size >= PRIM_HASH_STRIPE_SIZE)
+    {
+        prim_hash_consume(state, bytes);
+        bytes += PRIM_HASH_STRIPE_SIZE;
+        size -= PRIM_HASH_STRIPE_SIZE;
+    }
+    memcpy(state->buffer, bytes, size);
+    state->buffered = size;
+}
+
+/**
+ * Finish a streamed hash. The state is left unchanged, so more input may
+ * be added and the hash finished again.
+ *
+ * The last partial stripe is padded with zeros. The input's length is mixed
+ * into the result, so padding can not collide with real zeros.
+ *
+ * @param state The hash to finish.
+ * @param result Location to return the 128-bit hash.
+ */
+extern void prim_hash_final(const PrimHashState* state, PrimHash128* result)
+{
+    prim_u64 lanes[PRIM_HASH_LANES];
+    prim_u8 tail[PRIM_HASH_STRIPE_SIZE];
+    memcpy(lanes, state->lanes, sizeof(lanes));
+    if (state->buffered != 0)
+    {
+        memset(tail, 0, sizeof(tail));
+        memcpy(tail, state->buffer, state->buffered);
+        prim_hash_accumulate(lanes, tail, hash_keys + state->stripe);
+    }
+    result->low = prim_hash_merge(lanes, state->length * PRIM_HASH_PRIME_64,
+        hash_keys + PRIM_HASH_LOW_KEYS);
+    result->high = prim_hash_merge(lanes,
+        ~(state->length * PRIM_HASH_PRIME_32), hash_keys + PRIM_HASH_HIGH_KEYS);
+}
+
+/**
+ * Hash some input in one call.
+ *
+ * @param data The input. May be `NULL` if `size` is zero.
+ * @param size Length of the input, in bytes.
+ * @param result Location to return the 128-bit hash.
+ */
+extern void prim_hash(const void* data, prim_usize size, PrimHash128* result)
+{
+    PrimHashState state;
+    prim_hash_init(&state);
+    prim_hash_update(&state, data, size);
+    prim_hash_final(&state, result);
+}
+
+/**
+ * Hash a range of a file through a windowed view, a window at a time, so the
+ * range never needs to be stitched or mapped whole.
+ *
+ * @param view The view to read through.
+ * @param offset Offset of the range in the file.
+ * @param size Length of the range, in bytes.
+ * @param result Location to return the 128-bit hash.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the range is outside the
+ * file, otherwise an error code.
+ */
+extern PrimStatus prim_hash_view(PrimWindowedView* view, prim_usize offset,
+    prim_usize size, PrimHash128* result)
+{
+    PrimStatus status = STATUS_ERROR;
+    PrimHashState state;
+    const prim_u8* data = NULL;
+    prim_usize length = 0;
+    if (offset > view->file.size || size > view->file.size - offset)
+    {
+        return STATUS_INVALID;
+    }
+    prim_hash_init(&state);
+    while (size > 0)
+    {
+        length = view->window_size - offset % view->window_size;
+        length = length < size ? length : size;
+        status = prim_map_view_get(view, offset, length, &data);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        prim_hash_update(&state, data, length);
+        offset += length;
+        size -= length;
+    }
+    prim_hash_final(&state, result);
+    return STATUS_OKAY;
+}
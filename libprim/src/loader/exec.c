@@ -0,0 +1,305 @@
+/**
+ * @file src/loader/exec.c
+ *
+ * Implements running loaded static executables in the current process.
+ *
+ * @see `include/loader/exec.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "loader/exec.h"
+#include "format/elf64/image.h"
+#include "format/elf64/segment/header.h"
+#include "format/elf64/segment/type.h"
+#include "loader/loader.h"
+#include "platform/exec.h"
+#include "platform/mapping.h"
+#include "platform/types.h"
+#include "status.h"
+#include <string.h>
+
+/** Most auxiliary vector entries an executed image is given, with `AT_NULL`. */
+#define ELF64_EXEC_AUXILIARY_MAX 24
+
+/** Number of random bytes `AT_RANDOM` addresses. */
+#define ELF64_EXEC_RANDOM_SIZE 16
+
+/** An auxiliary vector under construction. */
+typedef struct
+{
+    /** Type and value pairs. */
+    prim_usize entries[ELF64_EXEC_AUXILIARY_MAX][2];
+
+    /** Number of entries used. */
+    prim_usize count;
+} Elf64_Exec_Auxiliary;
+
+/**
+ * Append an entry to an auxiliary vector.
+ *
+ * @param auxiliary The vector to append to.
+ * @param type The entry's `PRIM_AT_*` type.
+ * @param value The entry's value.
+ */
+static void elf64_exec_add_auxiliary(
+    Elf64_Exec_Auxiliary* auxiliary, const prim_usize type, prim_usize value)
+{
+    auxiliary->entries[auxiliary->count][0] = type;
+    auxiliary->entries[auxiliary->count][1] = value;
+    auxiliary->count++;
+}
+
+/**
+ * Pass an entry of Prim's own auxiliary vector on to an executed image.
+ *
+ * @param auxiliary The vector to append to.
+ * @param type The entry's `PRIM_AT_*` type.
+ * @param optional Non-zero to omit the entry if Prim's value is zero.
+ */
+static void elf64_exec_inherit_auxiliary(
+    Elf64_Exec_Auxiliary* auxiliary, const prim_usize type, const int optional)
+{
+    prim_usize value = prim_exec_get_auxiliary(type);
+    if (optional && value == 0)
+    {
+        return;
+    }
+    elf64_exec_add_auxiliary(auxiliary, type, value);
+}
+
+/**
+ * Find an image's program headers in memory, and check it needs no program
+ * interpreter.
+ *
+ * @param loaded The loaded image.
+ * @param result Location to return the program headers' loaded address.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the image names an
+ * interpreter or its program headers are not loaded, otherwise an error code.
+ */
+static PrimStatus elf64_exec_find_program_headers(
+    Elf64_Loaded_Image* loaded, prim_usize* result)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Segment_Header* segment = NULL;
+    Elf64_Offset offset = loaded->image.header->ph_offset;
+    Elf64_Address address = 0;
+    Elf64_Word index = 0;
+    for (index = 0; index < loaded->image.header->ph_entry_count; index++)
+    {
+        status
+            = elf64_image_get_segment_header(&loaded->image, index, &segment);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        switch (elf64_get_segment_type(segment))
+        {
+        case ELF64_PT_INTERP:
+            return STATUS_INVALID;
+        case ELF64_PT_PHDR:
+            address = segment->p_vaddr;
+            break;
+        case ELF64_PT_LOAD:
+            /* Without a PT_PHDR, the headers must be in a loaded segment. */
+            if (address == 0 && offset >= segment->p_offset
+                && offset - segment->p_offset < segment->p_filesz)
+            {
+                address = segment->p_vaddr + (offset - segment->p_offset);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    if (address == 0)
+    {
+        return STATUS_INVALID;
+    }
+    *result = (prim_usize) elf64_get_loaded_address(loaded, address);
+    return STATUS_OKAY;
+}
+
+/**
+ * Copy a string to an image's stack.
+ *
+ * @param cursor The next free byte of the string area. Advanced past the
+ * copy.
+ * @param string The string to copy.
+ * @return The copy's address.
+ */
+static prim_usize elf64_exec_push_string(prim_u8** cursor, const char* string)
+{
+    prim_usize size = strlen(string) + 1;
+    prim_u8* copy = *cursor;
+    memcpy(copy, string, size);
+    *cursor += size;
+    return (prim_usize) copy;
+}
+
+/**
+ * Build an image's initial stack.
+ *
+ * The strings are stored at the top of the stack. Below them, from the
+ * returned stack pointer up, are the argument count, the `NULL` terminated
+ * argument and environment arrays, and the auxiliary vector.
+ *
+ * @param stack The stack's lowest address.
+ * @param size The stack's size, in bytes.
+ * @param path The path given as `AT_EXECFN`.
+ * @param argc Number of arguments.
+ * @param argv The arguments.
+ * @param envp The environment, terminated by `NULL`.
+ * @param auxiliary The auxiliary vector, without the entries which address
+ * strings or `AT_NULL`.
+ * @param result Location to return the initial stack pointer.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+static PrimStatus elf64_exec_build_stack(prim_u8* stack, const prim_usize size,
+    const char* path, const int argc, char* const argv[], char* const envp[],
+    Elf64_Exec_Auxiliary* auxiliary, prim_usize** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    const char* platform
+        = (const char*) prim_exec_get_auxiliary(PRIM_AT_PLATFORM);
+    prim_usize string_size = strlen(path) + 1 + ELF64_EXEC_RANDOM_SIZE;
+    prim_usize envc = 0;
+    prim_usize words = 0;
+    prim_u8* cursor = NULL;
+    prim_usize* vector = NULL;
+    prim_usize i = 0;
+    if (platform != NULL)
+    {
+        string_size += strlen(platform) + 1;
+    }
+    for (i = 0; i < (prim_usize) argc; i++)
+    {
+        string_size += strlen(argv[i]) + 1;
+    }
+    for (envc = 0; envp[envc] != NULL; envc++)
+    {
+        string_size += strlen(envp[envc]) + 1;
+    }
+    /* Argument count, both arrays and their terminators, and the vector. */
+    words = 3 + argc + envc + 2 * (auxiliary->count + 4);
+    /* Leave room to align the stack pointer. */
+    if (string_size + (words + 2) * sizeof(prim_usize) > size)
+    {
+        return STATUS_INVALID;
+    }
+    cursor = stack + size - string_size;
+    vector = (prim_usize*) (((prim_usize) cursor - words * sizeof(prim_usize))
+        & ~(prim_usize) 15);
+    *result = vector;
+    status = prim_exec_get_random(cursor, ELF64_EXEC_RANDOM_SIZE);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    elf64_exec_add_auxiliary(auxiliary, PRIM_AT_RANDOM, (prim_usize) cursor);
+    cursor += ELF64_EXEC_RANDOM_SIZE;
+    *vector++ = (prim_usize) argc;
+    for (i = 0; i < (prim_usize) argc; i++)
+    {
+        *vector++ = elf64_exec_push_string(&cursor, argv[i]);
+    }
+    *vector++ = 0;
+    for (i = 0; i < envc; i++)
+    {
+        *vector++ = elf64_exec_push_string(&cursor, envp[i]);
+    }
+    *vector++ = 0;
+    if (platform != NULL)
+    {
+        elf64_exec_add_auxiliary(auxiliary, PRIM_AT_PLATFORM,
+            elf64_exec_push_string(&cursor, platform));
+    }
+    elf64_exec_add_auxiliary(
+        auxiliary, PRIM_AT_EXECFN, elf64_exec_push_string(&cursor, path));
+    elf64_exec_add_auxiliary(auxiliary, PRIM_AT_NULL, 0);
+    memcpy(vector, auxiliary->entries,
+        sizeof(auxiliary->entries[0]) * auxiliary->count);
+    return STATUS_OKAY;
+}
+
+/**
+ * Run a loaded static executable in place of the current program.
+ *
+ * Flush any buffered output before calling: the image replaces Prim without
+ * running its exit handlers.
+ *
+ * @param loaded The loaded executable.
+ * @param path The path the executable was loaded from, given to it as
+ * `AT_EXECFN`.
+ * @param argc Number of arguments.
+ * @param argv The executable's arguments, starting with its name.
+ * @param envp The executable's environment, terminated by `NULL`.
+ * @return Only on failure. STATUS_INVALID if the image needs a program
+ * interpreter or the host can not run images, otherwise an error code.
+ */
+extern PrimStatus elf64_exec(Elf64_Loaded_Image* loaded, const char* path,
+    const int argc, char* const argv[], char* const envp[])
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Exec_Auxiliary auxiliary;
+    const Elf64_Header* header = loaded->image.header;
+    prim_usize program_headers = 0;
+    void* stack = NULL;
+    prim_usize* stack_pointer = NULL;
+    status = prim_exec_is_supported();
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    status = elf64_exec_find_program_headers(loaded, &program_headers);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    auxiliary.count = 0;
+    elf64_exec_add_auxiliary(&auxiliary, PRIM_AT_PHDR, program_headers);
+    elf64_exec_add_auxiliary(
+        &auxiliary, PRIM_AT_PHENT, header->ph_entry_size);
+    elf64_exec_add_auxiliary(
+        &auxiliary, PRIM_AT_PHNUM, header->ph_entry_count);
+    elf64_exec_add_auxiliary(&auxiliary, PRIM_AT_PAGESZ, prim_map_page_size());
+    elf64_exec_add_auxiliary(&auxiliary, PRIM_AT_BASE, 0);
+    elf64_exec_add_auxiliary(&auxiliary, PRIM_AT_FLAGS, 0);
+    elf64_exec_add_auxiliary(&auxiliary, PRIM_AT_ENTRY,
+        (prim_usize) elf64_get_loaded_address(loaded, header->entry));
+    elf64_exec_inherit_auxiliary(&auxiliary, PRIM_AT_UID, 0);
+    elf64_exec_inherit_auxiliary(&auxiliary, PRIM_AT_EUID, 0);
+    elf64_exec_inherit_auxiliary(&auxiliary, PRIM_AT_GID, 0);
+    elf64_exec_inherit_auxiliary(&auxiliary, PRIM_AT_EGID, 0);
+    elf64_exec_inherit_auxiliary(&auxiliary, PRIM_AT_SECURE, 0);
+    elf64_exec_inherit_auxiliary(&auxiliary, PRIM_AT_HWCAP, 0);
+    elf64_exec_inherit_auxiliary(&auxiliary, PRIM_AT_HWCAP2, 1);
+    elf64_exec_inherit_auxiliary(&auxiliary, PRIM_AT_CLKTCK, 0);
+    /* Prim's vDSO stays mapped, so the image can use it too. */
+    elf64_exec_inherit_auxiliary(&auxiliary, PRIM_AT_SYSINFO_EHDR, 1);
+    elf64_exec_inherit_auxiliary(&auxiliary, PRIM_AT_MINSIGSTKSZ, 1);
+    status = prim_map_reserve(NULL, ELF64_EXEC_STACK_SIZE, &stack);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    status = prim_map_anonymous(stack, ELF64_EXEC_STACK_SIZE,
+        PRIM_PROTECT_READ | PRIM_PROTECT_WRITE);
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_exec_build_stack((prim_u8*) stack, ELF64_EXEC_STACK_SIZE,
+            path, argc, argv, envp, &auxiliary, &stack_pointer);
+    }
+    if (status != STATUS_OKAY)
+    {
+        prim_map_release(stack, ELF64_EXEC_STACK_SIZE);
+        return status;
+    }
+    prim_exec_jump(
+        elf64_get_loaded_address(loaded, header->entry), stack_pointer);
+    /* Only reached on hosts without userspace exec. */
+    prim_map_release(stack, ELF64_EXEC_STACK_SIZE);
+    return STATUS_INVALID;
+}
@@ -0,0 +1,239 @@
+/**
+ * @file src/loader/image_registry.c
+ *
+ * Implements sharing binaries' file mappings between loaded images.
+ *
+ * @see `include/loader/image_registry.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "loader/image_registry.h"
+#include "format/elf64/image.h"
+#include "format/elf64/types.h"
+#include "platform/file.h"
+#include "platform/mapping.h"
+#include "platform/memory.h"
+#include "platform/thread.h"
+#include "platform/types.h"
+#include "status.h"
+#include <string.h>
+
+/** Longest build ID compared in full. Longer IDs are compared by prefix. */
+#define ELF64_IMAGE_REGISTRY_BUILD_ID_MAX 64
+
+/** A binary mapped for one or more loaded images. */
+typedef struct Elf64_Shared_Binary
+{
+    /** The next binary in the registry. */
+    struct Elf64_Shared_Binary* next;
+
+    /** The binary's device. */
+    prim_u64 device;
+
+    /** The binary's inode. */
+    prim_u64 inode;
+
+    /** The binary's build ID when it was mapped. */
+    Elf64_Byte build_id[ELF64_IMAGE_REGISTRY_BUILD_ID_MAX];
+
+    /** Length of `build_id`. Zero if the binary has no build ID. */
+    Elf64_Word build_id_size;
+
+    /** Non-zero once a newer binary has replaced this one for lookups. */
+    int stale;
+
+    /** The shared mapping. */
+    PrimMapping mapping;
+
+    /** Number of images using the mapping. */
+    prim_usize references;
+} Elf64_Shared_Binary;
+
+/** Every binary currently shared. */
+static Elf64_Shared_Binary* elf64_image_registry = NULL;
+
+/** Guards `elf64_image_registry`, and every binary's references. */
+static PrimLock elf64_image_registry_lock = PRIM_LOCK_INIT;
+
+/**
+ * Read the build ID of a mapped binary.
+ *
+ * @param mapping The mapped binary.
+ * @param result Location to return the build ID, truncated to
+ * `ELF64_IMAGE_REGISTRY_BUILD_ID_MAX` bytes.
+ * @param result_size Location to return the build ID's length, or zero if
+ * the binary has none.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the binary is malformed.
+ */
+static PrimStatus elf64_image_registry_read_build_id(
+    const PrimMapping* mapping, Elf64_Byte* result, Elf64_Word* result_size)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Image image;
+    const Elf64_Byte* build_id = NULL;
+    Elf64_Word size = 0;
+    status = elf64_image_open_mapping(&image, mapping);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    status = elf64_image_get_build_id(&image, &build_id, &size);
+    if (status == STATUS_OKAY)
+    {
+        if (size > ELF64_IMAGE_REGISTRY_BUILD_ID_MAX)
+        {
+            size = ELF64_IMAGE_REGISTRY_BUILD_ID_MAX;
+        }
+        memcpy(result, build_id, size);
+        *result_size = size;
+    }
+    elf64_image_close(&image);
+    return status;
+}
+
+/**
+ * Find the current shared binary with a file's device and inode, and check
+ * its contents still carry the build ID it was mapped with.
+ *
+ * Binaries whose build ID has changed are marked stale, so the next mapping
+ * of the file replaces them. Must be called holding the registry's lock.
+ *
+ * @param identity The file's identity.
+ * @return The shared binary, or `NULL` if the file is not shared.
+ */
+static Elf64_Shared_Binary* elf64_image_registry_find(
+    const PrimFileIdentity* identity)
+{
+    Elf64_Shared_Binary* binary = NULL;
+    Elf64_Byte build_id[ELF64_IMAGE_REGISTRY_BUILD_ID_MAX];
+    Elf64_Word build_id_size = 0;
+    for (binary = elf64_image_registry; binary != NULL; binary = binary->next)
+    {
+        if (binary->stale || binary->device != identity->device
+            || binary->inode != identity->inode)
+        {
+            continue;
+        }
+        if (elf64_image_registry_read_build_id(
+                &binary->mapping, build_id, &build_id_size)
+                == STATUS_OKAY
+            && build_id_size == binary->build_id_size
+            && memcmp(build_id, binary->build_id, build_id_size) == 0)
+        {
+            return binary;
+        }
+        binary->stale = 1;
+    }
+    return NULL;
+}
+
+/**
+ * Get the shared mapping of a binary, mapping it if no image uses it yet.
+ *
+ * @param path Path to the binary.
+ * @param result Location to return the mapping. Release it with
+ * `elf64_image_registry_release`, not `prim_unmap_file`.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_image_registry_acquire(
+    const char* path, PrimMapping* result)
+{
+    PrimStatus status = STATUS_ERROR;
+    PrimFileIdentity identity;
+    Elf64_Shared_Binary* binary = NULL;
+    Elf64_Shared_Binary* existing = NULL;
+    status = prim_file_identity(path, &identity);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    prim_lock_acquire(&elf64_image_registry_lock);
+    existing = elf64_image_registry_find(&identity);
+    if (existing != NULL)
+    {
+        existing->references++;
+        *result = existing->mapping;
+    }
+    prim_lock_release(&elf64_image_registry_lock);
+    if (existing != NULL)
+    {
+        return STATUS_OKAY;
+    }
+    /* Map the binary without the lock, so other loads are not held up. */
+    status = prim_malloc((void**) &binary, sizeof(Elf64_Shared_Binary));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(binary, 0, sizeof(Elf64_Shared_Binary));
+    binary->device = identity.device;
+    binary->inode = identity.inode;
+    binary->references = 1;
+    status = prim_map_file(path, &binary->mapping);
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_image_registry_read_build_id(
+            &binary->mapping, binary->build_id, &binary->build_id_size);
+        if (status != STATUS_OKAY)
+        {
+            prim_unmap_file(&binary->mapping);
+        }
+    }
+    if (status != STATUS_OKAY)
+    {
+        prim_free(binary);
+        return status;
+    }
+    prim_lock_acquire(&elf64_image_registry_lock);
+    /* Another thread may have mapped the same binary meanwhile. */
+    existing = elf64_image_registry_find(&identity);
+    if (existing != NULL)
+    {
+        existing->references++;
+        *result = existing->mapping;
+    }
+    else
+    {
+        binary->next = elf64_image_registry;
+        elf64_image_registry = binary;
+        *result = binary->mapping;
+    }
+    prim_lock_release(&elf64_image_registry_lock);
+    if (existing != NULL)
+    {
+        prim_unmap_file(&binary->mapping);
+        prim_free(binary);
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Release a mapping returned by `elf64_image_registry_acquire`. The binary is
+ * unmapped once every image loaded from it is released.
+ *
+ * @param mapping The mapping to release.
+ */
+extern void elf64_image_registry_release(const PrimMapping* mapping)
+{
+    Elf64_Shared_Binary** link = &elf64_image_registry;
+    Elf64_Shared_Binary* binary = NULL;
+    prim_lock_acquire(&elf64_image_registry_lock);
+    while (*link != NULL && (*link)->mapping.data != mapping->data)
+    {
+        link = &(*link)->next;
+    }
+    if (*link != NULL && --(*link)->references == 0)
+    {
+        binary = *link;
+        *link = binary->next;
+    }
+    prim_lock_release(&elf64_image_registry_lock);
+    if (binary != NULL)
+    {
+        prim_unmap_file(&binary->mapping);
+        prim_free(binary);
+    }
+}
@@ -0,0 +1,863 @@
+/**
+ * @file src/loader/link_map.c
+ *
+ * Implements loading an executable together with the libraries it needs.
+ *
+ * @see `include/loader/link_map.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "loader/link_map.h"
+#include "format/elf64/image.h"
+#include "format/elf64/section/dynamic.h"
+#include "format/elf64/section/hash.h"
+#include "format/elf64/section/symbol.h"
+#include "format/elf64/section/type.h"
+#include "format/elf64/section/version.h"
+#include "format/elf64/segment/header.h"
+#include "format/elf64/segment/type.h"
+#include "loader/loader.h"
+#include "loader/perf.h"
+#include "loader/relocate.h"
+#include "loader/resolver.h"
+#include "loader/snapshot.h"
+#include "loader/symbol_cache.h"
+#include "loader/tls.h"
+#include "loader/version_registry.h"
+#include "platform/memory.h"
+#include "platform/thread.h"
+#include "platform/thread_pointer.h"
+#include "platform/types.h"
+#include "stats.h"
+#include "status.h"
+#include "trace.h"
+#include <string.h>
+
+/** Smallest number of entries a link map has room for. */
+#define ELF64_LINK_MAP_MINIMUM_CAPACITY 16
+
+/** A level of a link map being loaded in parallel. */
+typedef struct
+{
+    /** The link map being loaded. */
+    Elf64_Link_Map* map;
+
+    /** Index of the first entry in the level. */
+    prim_usize first;
+
+    /** Options to load each image with. */
+    const Elf64_Load_Options* options;
+} Elf64_Link_Map_Level;
+
+/**
+ * Append an entry for an image which has not been loaded yet.
+ *
+ * @param map The link map to append to.
+ * @param path The path to load the image from.
+ * @param name The name the image was needed by, or `NULL` to use its path.
+ * @param requester Index of the entry which needs the image.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_link_map_append(Elf64_Link_Map* map,
+    const char* path, const char* name, prim_usize requester)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Link_Map_Entry* entries = NULL;
+    Elf64_Link_Map_Entry* entry = NULL;
+    prim_usize capacity = map->capacity * 2;
+    if (map->count == map->capacity)
+    {
+        if (capacity < ELF64_LINK_MAP_MINIMUM_CAPACITY)
+        {
+            capacity = ELF64_LINK_MAP_MINIMUM_CAPACITY;
+        }
+        status = prim_malloc(
+            (void**) &entries, capacity * sizeof(Elf64_Link_Map_Entry));
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        if (map->entries != NULL)
+        {
+            memcpy(entries, map->entries,
+                map->count * sizeof(Elf64_Link_Map_Entry));
+            prim_free(map->entries);
+        }
+        map->entries = entries;
+        map->capacity = capacity;
+    }
+    entry = &map->entries[map->count];
+    memset(entry, 0, sizeof(Elf64_Link_Map_Entry));
+    status = prim_malloc((void**) &entry->loaded, sizeof(Elf64_Loaded_Image));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(entry->loaded, 0, sizeof(Elf64_Loaded_Image));
+    status = prim_malloc((void**) &entry->path, strlen(path) + 1);
+    if (status != STATUS_OKAY)
+    {
+        prim_free(entry->loaded);
+        return status;
+    }
+    strcpy(entry->path, path);
+    entry->name = name != NULL ? name : entry->path;
+    entry->requester = requester;
+    entry->status = STATUS_ERROR;
+    map->count++;
+    return STATUS_OKAY;
+}
+
+/**
+ * Find an entry which satisfies a needed name.
+ *
+ * @param map The link map to search.
+ * @param name The needed name, or `NULL` to match by path alone.
+ * @param path The resolved path, or `NULL` to match by name alone.
+ * @return `STATUS_OKAY` if an entry matches, `STATUS_INVALID` otherwise.
+ */
+static PrimStatus elf64_link_map_contains(
+    const Elf64_Link_Map* map, const char* name, const char* path)
+{
+    const Elf64_Link_Map_Entry* entry = NULL;
+    prim_usize i = 0;
+    for (i = 0; i < map->count; i++)
+    {
+        entry = &map->entries[i];
+        if (name != NULL
+            && (strcmp(entry->name, name) == 0
+                || (entry->soname != NULL && strcmp(entry->soname, name) == 0)))
+        {
+            return STATUS_OKAY;
+        }
+        if (path != NULL && strcmp(entry->path, path) == 0)
+        {
+            return STATUS_OKAY;
+        }
+    }
+    return STATUS_INVALID;
+}
+
+/**
+ * Load an entry's image, and remember its soname.
+ *
+ * @param entry The entry to load.
+ * @param base Address to load the image at, or `NULL` for anywhere.
+ * @param options Options to load the image with.
+ */
+static void elf64_link_map_load_entry(Elf64_Link_Map_Entry* entry,
+    void* base, const Elf64_Load_Options* options)
+{
+    const Elf64_Dynamic_Table* table = NULL;
+    const Elf64_Dynamic* soname = NULL;
+    entry->status
+        = elf64_load_image_at(entry->loaded, entry->path, base, options);
+    if (entry->status == STATUS_OKAY
+        && elf64_image_get_dynamic_table(&entry->loaded->image, &table)
+            == STATUS_OKAY
+        && elf64_dynamic_table_find(table, ELF64_DT_SONAME, &soname)
+            == STATUS_OKAY)
+    {
+        elf64_dynamic_table_get_string(table, soname, &entry->soname);
+    }
+}
+
+/**
+ * Load one image of a level. Runs on any thread.
+ *
+ * @param context The `Elf64_Link_Map_Level` being loaded.
+ * @param index The index of the image in the level.
+ */
+static void elf64_link_map_load_task(void* context, prim_usize index)
+{
+    Elf64_Link_Map_Level* level = (Elf64_Link_Map_Level*) context;
+    elf64_link_map_load_entry(
+        &level->map->entries[level->first + index], NULL, level->options);
+}
+
+/**
+ * Resolve the libraries needed by one image, appending any not yet in the
+ * link map.
+ *
+ * @param map The link map being loaded.
+ * @param requester Index of the image whose needed libraries to resolve.
+ * @param cache Library cache to resolve with, or `NULL`.
+ * @return `STATUS_OKAY` on success, `STATUS_BAD_FILE` if a library can not be
+ * found, otherwise an error code.
+ */
+static PrimStatus elf64_link_map_resolve_needed(
+    Elf64_Link_Map* map, prim_usize requester, Elf64_Library_Cache* cache)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Dynamic_Table* table = NULL;
+    const char* name = NULL;
+    char path[ELF64_LIBRARY_PATH_LENGTH];
+    Elf64_Word index = 0;
+    status = elf64_image_get_dynamic_table(
+        &map->entries[requester].loaded->image, &table);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    for (index = 0; index < table->count; index++)
+    {
+        if (elf64_get_dynamic_tag(&table->entries[index]) != ELF64_DT_NEEDED)
+        {
+            continue;
+        }
+        status = elf64_dynamic_table_get_string(
+            table, &table->entries[index], &name);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        if (elf64_link_map_contains(map, name, NULL) == STATUS_OKAY)
+        {
+            continue;
+        }
+        status = elf64_resolve_library(cache,
+            &map->entries[requester].loaded->image,
+            map->entries[requester].path, name, path);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        if (elf64_link_map_contains(map, NULL, path) == STATUS_OKAY)
+        {
+            continue;
+        }
+        status = elf64_link_map_append(map, path, name, requester);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Check every image in a level loaded, searching again for any library whose
+ * cached path no longer holds a loadable image.
+ *
+ * @param map The link map being loaded.
+ * @param first Index of the first entry in the level.
+ * @param cache Library cache the level was resolved with, or `NULL`.
+ * @param options Options to load each image with.
+ * @return `STATUS_OKAY` if every image is loaded, otherwise the first error.
+ */
+static PrimStatus elf64_link_map_check_level(Elf64_Link_Map* map,
+    prim_usize first, Elf64_Library_Cache* cache,
+    const Elf64_Load_Options* options)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Link_Map_Entry* entry = NULL;
+    Elf64_Link_Map_Entry* requester = NULL;
+    char path[ELF64_LIBRARY_PATH_LENGTH];
+    char* copy = NULL;
+    prim_usize i = 0;
+    for (i = first; i < map->count; i++)
+    {
+        entry = &map->entries[i];
+        if (entry->status != STATUS_OKAY && cache != NULL)
+        {
+            requester = &map->entries[entry->requester];
+            status = elf64_search_library(&requester->loaded->image,
+                requester->path, entry->name, path);
+            if (status == STATUS_OKAY && strcmp(path, entry->path) != 0
+                && prim_malloc((void**) &copy, strlen(path) + 1)
+                    == STATUS_OKAY)
+            {
+                prim_free(entry->path);
+                entry->path = strcpy(copy, path);
+                elf64_library_cache_insert(cache, entry->name, path);
+                elf64_link_map_load_entry(entry, NULL, options);
+            }
+        }
+        if (entry->status != STATUS_OKAY)
+        {
+            return entry->status;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Give each of an image's symbol versions its link map wide ID.
+ *
+ * @param map The link map.
+ * @param entry The entry to index the versions of.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the image's version
+ * tables are malformed, otherwise an error code.
+ */
+static PrimStatus elf64_link_map_index_versions(
+    Elf64_Link_Map* map, Elf64_Link_Map_Entry* entry)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Version_Table* table = NULL;
+    Elf64_Half i = 0;
+    status = elf64_image_get_version_table(&entry->loaded->image, &table);
+    if (status != STATUS_OKAY || table->count == 0)
+    {
+        return status;
+    }
+    status = prim_malloc(
+        (void**) &entry->versions, table->count * sizeof(prim_u32));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    entry->version_count = table->count;
+    for (i = 0; i < table->count && status == STATUS_OKAY; i++)
+    {
+        entry->versions[i] = ELF64_VERSION_ID_NONE;
+        if (table->versions[i].name != NULL)
+        {
+            status = elf64_version_registry_intern(&map->version_names,
+                table->versions[i].name, &entry->versions[i]);
+        }
+    }
+    return status;
+}
+
+/**
+ * Find an image's index for a version it defines.
+ *
+ * @param entry The entry to search.
+ * @param version The version ID to find.
+ * @param result Location to return the image's index for the version, or
+ * `ELF64_VER_NDX_GLOBAL` if the image defines no versions.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the image defines
+ * versions, but not this one.
+ */
+static PrimStatus elf64_link_map_find_version(
+    const Elf64_Link_Map_Entry* entry, prim_u32 version, Elf64_Half* result)
+{
+    const Elf64_Version_Table* table = &entry->loaded->image.version_table;
+    Elf64_Half i = 0;
+    *result = ELF64_VER_NDX_GLOBAL;
+    if (!table->defines_versions)
+    {
+        return STATUS_OKAY;
+    }
+    for (i = ELF64_VER_NDX_GLOBAL + 1; i < entry->version_count; i++)
+    {
+        if (entry->versions[i] == version && table->versions[i].defined)
+        {
+            *result = i;
+            return STATUS_OKAY;
+        }
+    }
+    return STATUS_INVALID;
+}
+
+/**
+ * Find an image's TLS segment.
+ *
+ * @param loaded The loaded image.
+ * @param result Location to return the segment header.
+ * @return `STATUS_OKAY` if the image has a TLS segment, `STATUS_INVALID`
+ * otherwise.
+ */
+static PrimStatus elf64_link_map_find_tls_segment(
+    Elf64_Loaded_Image* loaded, const Elf64_Segment_Header** result)
+{
+    Elf64_Word i = 0;
+    for (i = 0; i < loaded->image.header->ph_entry_count; i++)
+    {
+        if (elf64_image_get_segment_header(&loaded->image, i, result)
+                == STATUS_OKAY
+            && elf64_get_segment_type(*result) == ELF64_PT_TLS)
+        {
+            return STATUS_OKAY;
+        }
+    }
+    return STATUS_INVALID;
+}
+
+/**
+ * Lay out the static TLS of every image in a link map, and build its
+ * template.
+ *
+ * @param map The link map.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if a TLS segment is
+ * malformed, otherwise an error code.
+ */
+static PrimStatus elf64_link_map_layout_tls(Elf64_Link_Map* map)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Segment_Header* segment = NULL;
+    Elf64_Loaded_Image* loaded = NULL;
+    prim_usize start = 0;
+    prim_usize i = 0;
+    elf64_tls_init(&map->tls);
+    for (i = 0; i < map->count; i++)
+    {
+        loaded = map->entries[i].loaded;
+        if (elf64_link_map_find_tls_segment(loaded, &segment) != STATUS_OKAY)
+        {
+            continue;
+        }
+        start = (prim_usize) elf64_get_loaded_address(loaded, segment->p_vaddr);
+        if (segment->p_filesz > segment->p_memsz
+            || start < (prim_usize) loaded->base
+            || start - (prim_usize) loaded->base > loaded->size
+            || segment->p_filesz
+                > loaded->size - (start - (prim_usize) loaded->base))
+        {
+            return STATUS_INVALID;
+        }
+        map->entries[i].tls_module = elf64_tls_add_module(&map->tls,
+            segment->p_memsz, segment->p_align, segment->p_vaddr,
+            &map->entries[i].tls_offset);
+    }
+    status = elf64_tls_build_template(&map->tls);
+    for (i = 0; i < map->count && status == STATUS_OKAY; i++)
+    {
+        loaded = map->entries[i].loaded;
+        if (map->entries[i].tls_module != 0)
+        {
+            elf64_link_map_find_tls_segment(loaded, &segment);
+            elf64_tls_set_initial(&map->tls, map->entries[i].tls_offset,
+                elf64_get_loaded_address(loaded, segment->p_vaddr),
+                segment->p_filesz);
+        }
+    }
+    return status;
+}
+
+/**
+ * Index the symbol versions, and lay out the static TLS, of every image in a
+ * loaded link map.
+ *
+ * @param map The link map.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if an image's version
+ * tables or TLS segment are malformed, otherwise an error code.
+ */
+static PrimStatus elf64_link_map_prepare(Elf64_Link_Map* map)
+{
+    PrimStatus status = STATUS_OKAY;
+    prim_usize i = 0;
+    for (i = 0; i < map->count && status == STATUS_OKAY; i++)
+    {
+        status = elf64_link_map_index_versions(map, &map->entries[i]);
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_link_map_layout_tls(map);
+    }
+    return status;
+}
+
+/**
+ * Load the images of a snapshot at the addresses they were saved at.
+ *
+ * @param map The link map to append the images to.
+ * @param snapshot The snapshot.
+ * @param options Options to load each image with.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the snapshot does not
+ * describe the images, otherwise an error code.
+ */
+static PrimStatus elf64_link_map_load_snapshot(Elf64_Link_Map* map,
+    const Elf64_Snapshot* snapshot, const Elf64_Load_Options* options)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Snapshot_Image* image = NULL;
+    const Elf64_Dynamic_Table* table = NULL;
+    const char* name = NULL;
+    prim_usize i = 0;
+    for (i = 0; i < snapshot->header->image_count; i++)
+    {
+        image = &snapshot->images[i];
+        name = NULL;
+        if (i != 0)
+        {
+            /* The name an image was needed by is the requester's string. */
+            status = elf64_image_get_dynamic_table(
+                &map->entries[image->requester].loaded->image, &table);
+            if (status != STATUS_OKAY || image->needed >= table->count
+                || elf64_get_dynamic_tag(&table->entries[image->needed])
+                    != ELF64_DT_NEEDED
+                || elf64_dynamic_table_get_string(
+                       table, &table->entries[image->needed], &name)
+                    != STATUS_OKAY)
+            {
+                return STATUS_INVALID;
+            }
+        }
+        status = elf64_link_map_append(map,
+            elf64_snapshot_get_path(snapshot, i), name, image->requester);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        elf64_link_map_load_entry(&map->entries[i],
+            (void*) (prim_usize) image->base, options);
+        if (map->entries[i].status != STATUS_OKAY)
+        {
+            return map->entries[i].status;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Restore a relocated link map from its snapshot file.
+ *
+ * @param map The link map to initialise.
+ * @param path Path to the executable to load.
+ * @param options Options controlling the load, including the snapshot file.
+ * @return `STATUS_OKAY` if the link map was restored, `STATUS_INVALID` if
+ * the snapshot is out of date or its addresses are unavailable, otherwise an
+ * error code. Nothing is left loaded on failure.
+ */
+static PrimStatus elf64_link_map_restore(Elf64_Link_Map* map,
+    const char* path, const Elf64_Load_Options* options)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Snapshot snapshot;
+    status = elf64_snapshot_open(
+        &snapshot, options->snapshot_path, path, options->flags);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    status = elf64_link_map_load_snapshot(map, &snapshot, options);
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_link_map_prepare(map);
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_snapshot_apply(&snapshot, map);
+    }
+    elf64_snapshot_close(&snapshot);
+    if (status != STATUS_OKAY)
+    {
+        elf64_link_map_unload(map);
+    }
+    return status;
+}
+
+/**
+ * Resolve, load, and optionally relocate, an executable and every shared
+ * library it needs.
+ *
+ * @param map The link map to load into. Must be empty.
+ * @param path Path to the executable to load.
+ * @param cache Library cache to resolve needed libraries with, or `NULL`.
+ * @param options Options to load each image with.
+ * @return `STATUS_OKAY` on success, `STATUS_BAD_FILE` if a needed library can
+ * not be found, otherwise an error code. Images loaded before a failure are
+ * left for the caller to unload.
+ */
+static PrimStatus elf64_link_map_load_images(Elf64_Link_Map* map,
+    const char* path, Elf64_Library_Cache* cache,
+    const Elf64_Load_Options* options)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Link_Map_Level level = { NULL, 0, NULL };
+    prim_usize first = 0;
+    prim_usize end = 0;
+    prim_usize i = 0;
+    status = elf64_link_map_append(map, path, NULL, 0);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    elf64_link_map_load_entry(&map->entries[0], NULL, options);
+    status = map->entries[0].status;
+    level.map = map;
+    level.options = options;
+    while (status == STATUS_OKAY && first < map->count)
+    {
+        end = map->count;
+        for (i = first; i < end && status == STATUS_OKAY; i++)
+        {
+            status = elf64_link_map_resolve_needed(map, i, cache);
+        }
+        if (status != STATUS_OKAY || end == map->count)
+        {
+            break;
+        }
+        level.first = end;
+        if (options->flags & ELF64_LOAD_SERIAL)
+        {
+            for (i = end; i < map->count; i++)
+            {
+                elf64_link_map_load_task(&level, i - end);
+            }
+        }
+        else
+        {
+            prim_parallel_for(
+                map->count - end, elf64_link_map_load_task, &level);
+        }
+        status = elf64_link_map_check_level(map, end, cache, options);
+        first = end;
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_link_map_prepare(map);
+    }
+    if (status == STATUS_OKAY && (options->flags & ELF64_LOAD_RELOCATE))
+    {
+        /* Refuse before relocating, rather than part way through. */
+        status = elf64_link_map_check_resolvers(map);
+    }
+    if (status == STATUS_OKAY && (options->flags & ELF64_LOAD_RELOCATE))
+    {
+        status = elf64_link_map_relocate(map, options->flags);
+    }
+    return status;
+}
+
+/**
+ * Load an executable and every shared library it needs.
+ *
+ * The images' static TLS is laid out once they are loaded, so blocks for new
+ * threads can be allocated from the link map's `tls` pool.
+ *
+ * @param map The link map to initialise.
+ * @param path Path to the executable to load.
+ * @param cache Library cache to resolve needed libraries with, or `NULL` to
+ * search for every library.
+ * @param options Options controlling the load, or `NULL` for the defaults.
+ * `ELF64_LOAD_SERIAL` loads one library at a time. `ELF64_LOAD_RELOCATE`
+ * relocates every image, binding PLT entries on first call unless
+ * `ELF64_LOAD_BIND_NOW` is given. `ELF64_LOAD_SNAPSHOT` restores the
+ * relocated images from `snapshot_path` if its fingerprint holds, and
+ * otherwise loads and relocates them, then saves a new snapshot.
+ * @return STATUS_OKAY on success, STATUS_BAD_FILE if a needed library can not
+ * be found, otherwise an error code. Nothing is left loaded on failure.
+ */
+extern PrimStatus elf64_link_map_load(Elf64_Link_Map* map, const char* path,
+    Elf64_Library_Cache* cache, const Elf64_Load_Options* options)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Load_Options image_options = { 0, NULL, NULL,
+        ELF64_READAHEAD_NONE, PRIM_ADVICE_NORMAL, 0, NULL };
+    prim_usize i = 0;
+    memset(map, 0, sizeof(Elf64_Link_Map));
+    /* Profiling output is not thread safe, so it is written at the end. */
+    if (options != NULL)
+    {
+        image_options = *options;
+        image_options.flags &= ~(prim_u32) (ELF64_LOAD_PERF_MAP
+            | ELF64_LOAD_JITDUMP);
+    }
+    if (image_options.flags & ELF64_LOAD_SNAPSHOT)
+    {
+        if (image_options.snapshot_path == NULL)
+        {
+            return STATUS_INVALID;
+        }
+        image_options.flags |= ELF64_LOAD_RELOCATE | ELF64_LOAD_BIND_NOW;
+        status = elf64_link_map_restore(map, path, &image_options);
+    }
+    if (status != STATUS_OKAY)
+    {
+        status = elf64_link_map_load_images(map, path, cache, &image_options);
+        if (status != STATUS_OKAY)
+        {
+            elf64_link_map_unload(map);
+            return status;
+        }
+        if (image_options.flags & ELF64_LOAD_SNAPSHOT)
+        {
+            /* A snapshot only speeds up later loads, so failing is harmless. */
+            elf64_snapshot_save(
+                map, image_options.snapshot_path, image_options.flags);
+        }
+    }
+    if (options != NULL
+        && (options->flags & (ELF64_LOAD_PERF_MAP | ELF64_LOAD_JITDUMP)))
+    {
+        /* Profiling output is best effort: it never fails a load. */
+        for (i = 0; i < map->count; i++)
+        {
+            elf64_perf_register_image(map->entries[i].loaded, options);
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Find the first definition of a symbol in a link map, in search order.
+ *
+ * Definitions are remembered in the link map's symbol cache, so repeated
+ * lookups of a symbol probe one hash table rather than every image.
+ *
+ * A versioned lookup skips images which define versions, but not the one
+ * required. Every version is identified by its ID, so no version names are
+ * compared.
+ *
+ * @param map The link map to search.
+ * @param name The symbol name to find.
+ * @param version The version ID to find, from
+ * `elf64_link_map_get_symbol_version`, or `ELF64_VERSION_ID_NONE` for the
+ * default version.
+ * @param first Index of the first entry to search. One skips the executable.
+ * @param result Location to return the definition.
+ * @return STATUS_OKAY if the symbol is found, STATUS_INVALID otherwise.
+ */
+extern PrimStatus elf64_link_map_find_symbol(Elf64_Link_Map* map,
+    const char* name, const prim_u32 version, const prim_usize first,
+    Elf64_Link_Map_Symbol* result)
+{
+    const Elf64_Symbol_Table* table = NULL;
+    Elf64_Symbol_Cache_Entry definition = { NULL, 0, 0, 0, 0, NULL };
+    Elf64_Word hash = elf64_gnu_hash(name);
+    Elf64_Word index = 0;
+    Elf64_Half local = ELF64_VER_NDX_GLOBAL;
+    prim_usize i = 0;
+    PRIM_STATS_ADD(PRIM_STATS_SYMBOL_LOOKUPS, 1);
+    if (elf64_symbol_cache_lookup(
+            &map->symbols, name, hash, version, first, &definition)
+        == STATUS_OKAY)
+    {
+        PRIM_STATS_ADD(PRIM_STATS_SYMBOL_CACHE_HITS, 1);
+        result->entry = definition.entry;
+        result->symbol = definition.symbol;
+        PRIM_TRACE_SYMBOL_LOOKUP(name, hash, 1);
+        return STATUS_OKAY;
+    }
+    for (i = first; i < map->count; i++)
+    {
+        if (version != ELF64_VERSION_ID_NONE
+            && elf64_link_map_find_version(&map->entries[i], version, &local)
+                != STATUS_OKAY)
+        {
+            continue;
+        }
+        if (elf64_image_find_dynamic_symbol(
+                &map->entries[i].loaded->image, name, hash, local, &index)
+            == STATUS_OKAY)
+        {
+            elf64_image_get_symbol_table(&map->entries[i].loaded->image,
+                ELF64_SECTION_TYPE_DYNSYM, &table);
+            result->entry = i;
+            result->symbol = &table->symbols[index];
+            /* The defining image's copy of the name lives as long as it. */
+            definition.hash = hash;
+            definition.version = version;
+            definition.first = first;
+            definition.entry = i;
+            definition.symbol = result->symbol;
+            if (elf64_symbol_table_get_name(
+                    table, result->symbol, &definition.name)
+                == STATUS_OKAY)
+            {
+                /* Caching is best effort: a failed insert is not an error. */
+                elf64_symbol_cache_insert(&map->symbols, &definition);
+            }
+            PRIM_TRACE_SYMBOL_LOOKUP(name, hash, 1);
+            return STATUS_OKAY;
+        }
+    }
+    PRIM_TRACE_SYMBOL_LOOKUP(name, hash, 0);
+    return STATUS_INVALID;
+}
+
+/**
+ * Get the version ID of a dynamic symbol in one of a link map's images.
+ *
+ * @param map The link map.
+ * @param entry Index of the image in the link map.
+ * @param index Index of the symbol in the image's dynamic symbol table.
+ * @return The ID of the version the symbol defines or requires, or
+ * `ELF64_VERSION_ID_NONE` if it is unversioned.
+ */
+extern prim_u32 elf64_link_map_get_symbol_version(
+    const Elf64_Link_Map* map, const prim_usize entry, const Elf64_Word index)
+{
+    const Elf64_Link_Map_Entry* image = &map->entries[entry];
+    const Elf64_Version_Table* table = &image->loaded->image.version_table;
+    Elf64_Half local = 0;
+    if (table->symbols == NULL || index >= table->symbol_count)
+    {
+        return ELF64_VERSION_ID_NONE;
+    }
+    local = elf64_get_version_index(table->symbols[index]);
+    if (local >= image->version_count)
+    {
+        return ELF64_VERSION_ID_NONE;
+    }
+    return image->versions[local];
+}
+
+/**
+ * Call an `int (void)` function in a link map's images.
+ *
+ * If any image has TLS, the function runs on a thread pointer allocated
+ * from the link map's TLS pool, so its TLS accesses reach the blocks laid
+ * out for the images rather than the host's own TLS. The block is returned
+ * to the pool afterwards.
+ *
+ * @param map The link map, relocated.
+ * @param function The function to call.
+ * @param result Location to return the function's result.
+ * @return STATUS_OKAY if the function was called, STATUS_INVALID if an image
+ * has TLS but the host can not switch thread pointers, otherwise an error
+ * code.
+ */
+extern PrimStatus elf64_link_map_call(
+    Elf64_Link_Map* map, int (*function)(void), int* result)
+{
+    PrimStatus status = STATUS_ERROR;
+    void* thread_pointer = NULL;
+    if (map->tls.module_count == 0)
+    {
+        *result = function();
+        return STATUS_OKAY;
+    }
+    status = prim_thread_pointer_is_supported();
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_tls_allocate(&map->tls, &thread_pointer);
+    }
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    status = prim_thread_pointer_call(thread_pointer, function, result);
+    elf64_tls_release(&map->tls, thread_pointer);
+    return status;
+}
+
+/**
+ * Unload every image in a link map.
+ *
+ * @param map The link map to unload.
+ */
+extern void elf64_link_map_unload(Elf64_Link_Map* map)
+{
+    prim_usize i = 0;
+    for (i = 0; i < map->count; i++)
+    {
+        if (map->entries[i].status == STATUS_OKAY)
+        {
+            elf64_unload_image(map->entries[i].loaded);
+        }
+        if (map->entries[i].binding != NULL)
+        {
+            prim_free(map->entries[i].binding);
+        }
+        if (map->entries[i].versions != NULL)
+        {
+            prim_free(map->entries[i].versions);
+        }
+        prim_free(map->entries[i].loaded);
+        prim_free(map->entries[i].path);
+    }
+    if (map->entries != NULL)
+    {
+        prim_free(map->entries);
+    }
+    elf64_symbol_cache_destroy(&map->symbols);
+    elf64_version_registry_destroy(&map->version_names);
+    elf64_tls_destroy(&map->tls);
+    memset(map, 0, sizeof(Elf64_Link_Map));
+}
@@ -0,0 +1,685 @@
+/**
+ * @file src/loader/loader.c
+ *
+ * Implements loading ELF64 binaries into the current process.
+ *
+ * @see `include/loader/loader.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "loader/loader.h"
+#include "format/elf64/header/machine.h"
+#include "format/elf64/header/type.h"
+#include "format/elf64/image.h"
+#include "format/elf64/segment/flags.h"
+#include "format/elf64/segment/header.h"
+#include "format/elf64/segment/type.h"
+#include "loader/image_registry.h"
+#include "loader/page_profile.h"
+#include "loader/perf.h"
+#include "platform/mapping.h"
+#include "platform/types.h"
+#include "stats.h"
+#include "status.h"
+#include "trace.h"
+#include <string.h>
+
+/**
+ * Round an address down to the start of its page.
+ *
+ * @param address The address to round.
+ * @param page_size The page size. A power of two.
+ * @return The start of the page containing `address`.
+ */
+static prim_usize elf64_loader_page_down(
+    const prim_usize address, const prim_usize page_size)
+{
+    return address & ~(page_size - 1);
+}
+
+/**
+ * Round an address up to the start of the next page.
+ *
+ * @param address The address to round.
+ * @param page_size The page size. A power of two.
+ * @return `address` if it starts a page, otherwise the start of the next page.
+ */
+static prim_usize elf64_loader_page_up(
+    const prim_usize address, const prim_usize page_size)
+{
+    return (address + page_size - 1) & ~(page_size - 1);
+}
+
+/**
+ * Check the binary is an executable or shared object for this machine.
+ *
+ * @param image The binary to check.
+ * @return `STATUS_OKAY` if the binary can be loaded, `STATUS_INVALID`
+ * otherwise.
+ */
+static PrimStatus elf64_loader_check_image(const Elf64_Image* image)
+{
+    ELF64_Type type = elf64_parse_object_type(image->header->type);
+    if (type != ELF64_TYPE_EXECUTABLE && type != ELF64_TYPE_DYNAMIC)
+    {
+        return STATUS_INVALID;
+    }
+    if (elf64_parse_machine(image->header->machine) != ELF64_MACHINE_AMD64)
+    {
+        return STATUS_INVALID;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Reserve an address range covering every loadable segment of an image.
+ *
+ * @param loaded The image to reserve memory for.
+ * @param base Address the range must start at, or `NULL` for anywhere.
+ * @param alignment Alignment of the load bias when `base` is `NULL`. Zero, or
+ * a power of two larger than the page size.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the image has no
+ * loadable segments, a segment extends past the end of the file or the
+ * address space, or its addresses are unavailable, otherwise an error code.
+ */
+static PrimStatus elf64_loader_reserve(
+    Elf64_Loaded_Image* loaded, void* base, const prim_usize alignment)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Segment_Header* segment = NULL;
+    prim_usize page_size = prim_map_page_size();
+    prim_usize low = (prim_usize) -1;
+    prim_usize high = 0;
+    void* address = NULL;
+    void* reserved = NULL;
+    prim_usize skew = 0;
+    Elf64_Word index = 0;
+    for (index = 0; index < loaded->image.header->ph_entry_count; index++)
+    {
+        status
+            = elf64_image_get_segment_header(&loaded->image, index, &segment);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        if (elf64_get_segment_type(segment) != ELF64_PT_LOAD)
+        {
+            continue;
+        }
+        /* Segments must lie in the file, and their ends must not wrap. */
+        if (segment->p_vaddr % page_size != segment->p_offset % page_size
+            || segment->p_filesz > segment->p_memsz
+            || segment->p_offset > loaded->image.mapping.size
+            || segment->p_filesz
+                > loaded->image.mapping.size - segment->p_offset
+            || segment->p_vaddr > (prim_usize) -page_size
+            || segment->p_memsz > (prim_usize) -page_size - segment->p_vaddr)
+        {
+            return STATUS_INVALID;
+        }
+        if (segment->p_vaddr < low)
+        {
+            low = segment->p_vaddr;
+        }
+        if (segment->p_vaddr + segment->p_memsz > high)
+        {
+            high = segment->p_vaddr + segment->p_memsz;
+        }
+    }
+    if (high == 0)
+    {
+        return STATUS_INVALID;
+    }
+    low = elf64_loader_page_down(low, page_size);
+    high = elf64_loader_page_up(high, page_size);
+    address = base;
+    if (elf64_parse_object_type(loaded->image.header->type)
+        == ELF64_TYPE_EXECUTABLE)
+    {
+        if (base != NULL && (prim_usize) base != low)
+        {
+            return STATUS_INVALID;
+        }
+        address = (void*) low;
+    }
+    if (address == NULL && alignment != 0)
+    {
+        /* Start the range as far past an aligned address as `low` is. */
+        skew = low & (alignment - 1);
+        status = prim_map_reserve_aligned(
+            skew + high - low, alignment, &reserved);
+        if (status == STATUS_OKAY && skew != 0)
+        {
+            prim_map_release(reserved, skew);
+            reserved = (prim_u8*) reserved + skew;
+        }
+    }
+    else
+    {
+        status = prim_map_reserve(address, high - low, &reserved);
+    }
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    loaded->base = (prim_u8*) reserved;
+    loaded->size = high - low;
+    loaded->bias = (prim_usize) reserved - low;
+    return STATUS_OKAY;
+}
+
+/**
+ * Checks if a segment can be mapped with its final access rights, because it
+ * is read-only and entirely stored in the file.
+ *
+ * @param segment The segment to check.
+ * @return Non-zero if the segment needs no initialisation after mapping.
+ */
+static int elf64_loader_is_read_only(const Elf64_Segment_Header* segment)
+{
+    return !(elf64_get_segment_flags(segment) & ELF64_PF_W)
+        && segment->p_filesz == segment->p_memsz && segment->p_filesz != 0;
+}
+
+/**
+ * Map a loadable segment into the image's reserved address range.
+ *
+ * Segments are mapped writable so they can be initialised, and their final
+ * access rights are applied by `elf64_loader_protect_segment`. Read-only
+ * segments stored entirely in the file need no initialisation, so they are
+ * mapped with their final access rights.
+ *
+ * @param loaded The image the segment belongs to.
+ * @param segment The segment to map.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_loader_map_segment(
+    Elf64_Loaded_Image* loaded, const Elf64_Segment_Header* segment)
+{
+    PrimStatus status = STATUS_OKAY;
+    prim_usize page_size = prim_map_page_size();
+    prim_usize start = segment->p_vaddr + loaded->bias;
+    prim_usize page_start = elf64_loader_page_down(start, page_size);
+    prim_usize file_end = start + segment->p_filesz;
+    prim_usize zero_start = elf64_loader_page_up(file_end, page_size);
+    prim_usize memory_end
+        = elf64_loader_page_up(start + segment->p_memsz, page_size);
+    prim_u32 protection = PRIM_PROTECT_READ | PRIM_PROTECT_WRITE;
+    if (elf64_loader_is_read_only(segment))
+    {
+        protection
+            = elf64_get_segment_protection(elf64_get_segment_flags(segment));
+    }
+    if (segment->p_filesz != 0)
+    {
+        status = prim_map_file_range(&loaded->image.mapping,
+            elf64_loader_page_down(segment->p_offset, page_size),
+            (void*) page_start, file_end - page_start, protection);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        /* The rest of the last file page belongs to the zero filled part. */
+        if (segment->p_memsz > segment->p_filesz)
+        {
+            memset((void*) file_end, 0, zero_start - file_end);
+        }
+    }
+    else
+    {
+        zero_start = page_start;
+    }
+    if (memory_end > zero_start)
+    {
+        status = prim_map_anonymous(
+            (void*) zero_start, memory_end - zero_start, protection);
+    }
+    PRIM_TRACE_SEGMENT_MAP(start, segment->p_memsz, segment->p_flags);
+    return status;
+}
+
+/**
+ * Apply a loadable segment's access rights.
+ *
+ * @param loaded The image the segment belongs to.
+ * @param segment The segment to protect.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_loader_protect_segment(
+    Elf64_Loaded_Image* loaded, const Elf64_Segment_Header* segment)
+{
+    prim_usize page_size = prim_map_page_size();
+    prim_usize start = elf64_loader_page_down(
+        segment->p_vaddr + loaded->bias, page_size);
+    prim_usize end = elf64_loader_page_up(
+        segment->p_vaddr + loaded->bias + segment->p_memsz, page_size);
+    if (elf64_loader_is_read_only(segment))
+    {
+        return STATUS_OKAY;
+    }
+    return prim_map_protect((void*) start, end - start,
+        elf64_get_segment_protection(elf64_get_segment_flags(segment)));
+}
+
+/**
+ * Back the whole, aligned huge pages of an executable segment's code with
+ * anonymous memory the host may back with huge pages.
+ *
+ * The code is copied in from the binary, so those pages are no longer shared
+ * with other processes mapping the same file.
+ *
+ * @param loaded The image the segment belongs to.
+ * @param segment The segment to back.
+ * @return `STATUS_OKAY` on success, or if no huge pages fit in the segment,
+ * `STATUS_INVALID` if the segment lies outside the binary, otherwise an error
+ * code.
+ */
+static PrimStatus elf64_loader_map_huge_text(
+    Elf64_Loaded_Image* loaded, const Elf64_Segment_Header* segment)
+{
+    PrimStatus status = STATUS_OKAY;
+    prim_usize huge_page_size = prim_map_huge_page_size();
+    prim_usize start = segment->p_vaddr + loaded->bias;
+    prim_usize huge_start = 0;
+    prim_usize huge_end = 0;
+    if (!(elf64_get_segment_flags(segment) & ELF64_PF_X) || huge_page_size == 0)
+    {
+        return STATUS_OKAY;
+    }
+    if (segment->p_offset > loaded->image.mapping.size
+        || segment->p_filesz > loaded->image.mapping.size - segment->p_offset)
+    {
+        return STATUS_INVALID;
+    }
+    huge_start = elf64_loader_page_up(start, huge_page_size);
+    huge_end
+        = elf64_loader_page_down(start + segment->p_filesz, huge_page_size);
+    if (huge_end <= huge_start)
+    {
+        return STATUS_OKAY;
+    }
+    status = prim_map_anonymous((void*) huge_start, huge_end - huge_start,
+        PRIM_PROTECT_READ | PRIM_PROTECT_WRITE);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    /* Hosts without huge pages still get a correct, if ordinary, copy. */
+    prim_map_request_huge_pages((void*) huge_start, huge_end - huge_start);
+    memcpy((void*) huge_start,
+        loaded->image.mapping.data + segment->p_offset + (huge_start - start),
+        huge_end - huge_start);
+    status = prim_map_protect((void*) huge_start, huge_end - huge_start,
+        elf64_get_segment_protection(elf64_get_segment_flags(segment)));
+    loaded->huge_pages
+        += prim_map_count_huge_pages((void*) huge_start, huge_end - huge_start);
+    return status;
+}
+
+/**
+ * Choose how a loadable segment is read ahead.
+ *
+ * Fixed advice is limited to advice which only changes when pages are read.
+ * Advice which discards pages, such as `PRIM_ADVICE_DONTNEED`, would throw
+ * away the zeroed tails and huge page copies made while loading.
+ *
+ * @param options The options the image is loaded with.
+ * @param segment The segment to read ahead.
+ * @param result Location to return the advice for the segment's file backed
+ * pages.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the options give
+ * advice which is not a readahead hint.
+ */
+static PrimStatus elf64_loader_choose_advice(const Elf64_Load_Options* options,
+    const Elf64_Segment_Header* segment, PrimMapAdvice* result)
+{
+    Elf64_Segment_Flag flags = elf64_get_segment_flags(segment);
+    prim_usize threshold = options->readahead_threshold;
+    switch (options->readahead)
+    {
+    case ELF64_READAHEAD_FIXED:
+        switch (options->readahead_advice)
+        {
+        case PRIM_ADVICE_NORMAL:
+        case PRIM_ADVICE_WILLNEED:
+        case PRIM_ADVICE_SEQUENTIAL:
+        case PRIM_ADVICE_RANDOM:
+        case PRIM_ADVICE_POPULATE:
+            *result = options->readahead_advice;
+            return STATUS_OKAY;
+        default:
+            return STATUS_INVALID;
+        }
+    case ELF64_READAHEAD_BY_FLAGS:
+        if (flags & ELF64_PF_W)
+        {
+            *result = PRIM_ADVICE_POPULATE;
+        }
+        else
+        {
+            *result = flags & ELF64_PF_X ? PRIM_ADVICE_WILLNEED
+                                         : PRIM_ADVICE_NORMAL;
+        }
+        return STATUS_OKAY;
+    case ELF64_READAHEAD_BY_SIZE:
+        if (threshold == 0)
+        {
+            threshold = ELF64_READAHEAD_DEFAULT_THRESHOLD;
+        }
+        *result = segment->p_filesz <= threshold ? PRIM_ADVICE_POPULATE
+                                                 : PRIM_ADVICE_WILLNEED;
+        return STATUS_OKAY;
+    default:
+        *result = PRIM_ADVICE_NORMAL;
+        return STATUS_OKAY;
+    }
+}
+
+/**
+ * Read ahead the file backed pages of every loadable segment in an image.
+ *
+ * Zero filled parts of segments are left alone: populating them would only
+ * spend memory.
+ *
+ * @param loaded The image to read ahead.
+ * @param options The options the image is loaded with.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the options give
+ * advice which is not a readahead hint.
+ */
+static PrimStatus elf64_loader_read_ahead(
+    Elf64_Loaded_Image* loaded, const Elf64_Load_Options* options)
+{
+    PrimStatus status = STATUS_OKAY;
+    const Elf64_Segment_Header* segment = NULL;
+    PrimMapAdvice advice = PRIM_ADVICE_NORMAL;
+    Elf64_Word index = 0;
+    for (index = 0; index < loaded->image.header->ph_entry_count; index++)
+    {
+        elf64_image_get_segment_header(&loaded->image, index, &segment);
+        if (elf64_get_segment_type(segment) != ELF64_PT_LOAD)
+        {
+            continue;
+        }
+        status = elf64_loader_choose_advice(options, segment, &advice);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        if (advice == PRIM_ADVICE_NORMAL)
+        {
+            continue;
+        }
+        status = prim_map_advise_memory(
+            elf64_get_loaded_address(loaded, segment->p_vaddr),
+            segment->p_filesz, advice);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Read ahead the pages a profile recorded for an image, then populate the
+ * recorded pages backing its segments.
+ *
+ * Every range is read ahead before any is populated, so the host sees the
+ * whole batch in file order, rather than one synchronous read at a time.
+ *
+ * @param loaded The image to read ahead.
+ * @param path The binary the image was loaded from.
+ * @param profile The page profile to replay.
+ * @return `STATUS_OKAY` on success, or if the binary is not in the profile,
+ * otherwise an error code.
+ */
+static PrimStatus elf64_loader_replay_profile(Elf64_Loaded_Image* loaded,
+    const char* path, const Elf64_Page_Profile* profile)
+{
+    PrimStatus status = STATUS_OKAY;
+    const Elf64_Page_Profile_Image* image = NULL;
+    const Elf64_Page_Profile_Range* ranges = NULL;
+    const Elf64_Segment_Header* segment = NULL;
+    prim_usize page_size = prim_map_page_size();
+    prim_usize file_start = 0;
+    prim_usize file_end = 0;
+    prim_usize start = 0;
+    prim_usize end = 0;
+    prim_usize i = 0;
+    Elf64_Word index = 0;
+    if (profile == NULL
+        || elf64_page_profile_find(profile, path, &image) != STATUS_OKAY)
+    {
+        return STATUS_OKAY;
+    }
+    ranges = profile->ranges + image->first_range;
+    for (i = 0; i < image->range_count; i++)
+    {
+        /* Ranges past the end of the file are only stale hints. */
+        prim_map_advise(&loaded->image.mapping, ranges[i].offset,
+            ranges[i].size, PRIM_ADVICE_WILLNEED);
+    }
+    for (index = 0; index < loaded->image.header->ph_entry_count; index++)
+    {
+        elf64_image_get_segment_header(&loaded->image, index, &segment);
+        if (elf64_get_segment_type(segment) != ELF64_PT_LOAD)
+        {
+            continue;
+        }
+        file_start = elf64_loader_page_down(segment->p_offset, page_size);
+        file_end = segment->p_offset + segment->p_filesz;
+        for (i = 0; i < image->range_count && status == STATUS_OKAY; i++)
+        {
+            start = ranges[i].offset > file_start ? ranges[i].offset
+                                                  : file_start;
+            end = ranges[i].offset + ranges[i].size < file_end
+                ? ranges[i].offset + ranges[i].size
+                : file_end;
+            if (start >= end)
+            {
+                continue;
+            }
+            status = prim_map_advise_memory(
+                elf64_get_loaded_address(loaded,
+                    segment->p_vaddr - segment->p_offset + start),
+                end - start, PRIM_ADVICE_POPULATE);
+        }
+    }
+    return status;
+}
+
+/**
+ * Map, or protect, every loadable segment in an image.
+ *
+ * @param loaded The image to process.
+ * @param action `elf64_loader_map_segment`, `elf64_loader_map_huge_text` or
+ * `elf64_loader_protect_segment`.
+ * @return `STATUS_OKAY` on success, otherwise the first error.
+ */
+static PrimStatus elf64_loader_for_each_segment(Elf64_Loaded_Image* loaded,
+    PrimStatus (*action)(Elf64_Loaded_Image*, const Elf64_Segment_Header*))
+{
+    PrimStatus status = STATUS_OKAY;
+    const Elf64_Segment_Header* segment = NULL;
+    Elf64_Word index = 0;
+    for (index = 0; index < loaded->image.header->ph_entry_count; index++)
+    {
+        elf64_image_get_segment_header(&loaded->image, index, &segment);
+        if (elf64_get_segment_type(segment) != ELF64_PT_LOAD)
+        {
+            continue;
+        }
+        status = action(loaded, segment);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Load an ELF64 executable or shared object into memory.
+ *
+ * @param loaded Location to return the loaded image.
+ * @param path Path to the binary to load.
+ * @param options Options controlling the load, or `NULL` for the defaults.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the binary can not be
+ * loaded on this machine, otherwise an error code.
+ */
+extern PrimStatus elf64_load_image(Elf64_Loaded_Image* loaded, const char* path,
+    const Elf64_Load_Options* options)
+{
+    return elf64_load_image_at(loaded, path, NULL, options);
+}
+
+/**
+ * Load an ELF64 executable or shared object at a chosen address.
+ *
+ * @param loaded Location to return the loaded image.
+ * @param path Path to the binary to load.
+ * @param base Address the image's reserved range must start at, or `NULL`
+ * to load it anywhere. Executables can only be loaded at their link time
+ * addresses.
+ * @param options Options controlling the load, or `NULL` for the defaults.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the binary can not be
+ * loaded on this machine or at `base`, otherwise an error code.
+ */
+extern PrimStatus elf64_load_image_at(Elf64_Loaded_Image* loaded,
+    const char* path, void* base, const Elf64_Load_Options* options)
+{
+    PrimStatus status = STATUS_ERROR;
+    PrimMapping shared;
+    prim_u32 flags = options != NULL ? options->flags : 0;
+    prim_usize alignment = 0;
+    memset(loaded, 0, sizeof(Elf64_Loaded_Image));
+    if (flags & ELF64_LOAD_SHARE_FILES)
+    {
+        status = elf64_image_registry_acquire(path, &shared);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        status = elf64_image_open_mapping(&loaded->image, &shared);
+        if (status != STATUS_OKAY)
+        {
+            elf64_image_registry_release(&shared);
+        }
+    }
+    else
+    {
+        status = elf64_image_open(&loaded->image, path);
+    }
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    status = elf64_loader_check_image(&loaded->image);
+    if (status == STATUS_OKAY)
+    {
+        PRIM_STATS_PHASE_BEGIN(timer);
+        if (flags & ELF64_LOAD_HUGE_TEXT)
+        {
+            alignment = prim_map_huge_page_size();
+        }
+        status = elf64_loader_reserve(loaded, base, alignment);
+        if (status == STATUS_OKAY)
+        {
+            status = elf64_loader_for_each_segment(
+                loaded, elf64_loader_map_segment);
+        }
+        if (status == STATUS_OKAY && (flags & ELF64_LOAD_HUGE_TEXT))
+        {
+            status = elf64_loader_for_each_segment(
+                loaded, elf64_loader_map_huge_text);
+        }
+        if (status == STATUS_OKAY && options != NULL
+            && options->readahead == ELF64_READAHEAD_PROFILE)
+        {
+            status = elf64_loader_replay_profile(
+                loaded, path, options->page_profile);
+        }
+        else if (status == STATUS_OKAY && options != NULL
+            && options->readahead != ELF64_READAHEAD_NONE)
+        {
+            status = elf64_loader_read_ahead(loaded, options);
+        }
+        PRIM_STATS_PHASE_END(timer, PRIM_PHASE_LOAD);
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_loader_for_each_segment(
+            loaded, elf64_loader_protect_segment);
+    }
+    if (status != STATUS_OKAY)
+    {
+        elf64_unload_image(loaded);
+        return status;
+    }
+    if (flags & (ELF64_LOAD_PERF_MAP | ELF64_LOAD_JITDUMP))
+    {
+        /* Profiling output is best effort: it never fails a load. */
+        elf64_perf_register_image(loaded, options);
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Unmap a loaded image, and close its binary.
+ *
+ * @param loaded The loaded image to unload.
+ */
+extern void elf64_unload_image(Elf64_Loaded_Image* loaded)
+{
+    if (loaded->base != NULL)
+    {
+        prim_map_release(loaded->base, loaded->size);
+    }
+    /* Borrowed mappings only ever come from the image registry. */
+    if (loaded->image.borrowed)
+    {
+        elf64_image_registry_release(&loaded->image.mapping);
+    }
+    elf64_image_close(&loaded->image);
+    memset(loaded, 0, sizeof(Elf64_Loaded_Image));
+}
+
+/**
+ * Convert a link time address in an image to its loaded address.
+ *
+ * @param loaded The loaded image.
+ * @param address A link time virtual address from the binary.
+ * @return The address in memory.
+ */
+extern void* elf64_get_loaded_address(
+    const Elf64_Loaded_Image* loaded, const Elf64_Address address)
+{
+    return (void*) (prim_usize) (address + loaded->bias);
+}
+
+/**
+ * Convert ELF64 segment flags to Prim access rights.
+ *
+ * @param flags The segment's flags.
+ * @return The equivalent `PRIM_PROTECT_*` bitfield.
+ */
+extern prim_u32 elf64_get_segment_protection(const Elf64_Segment_Flag flags)
+{
+    prim_u32 protection = 0;
+    if (flags & ELF64_PF_R)
+    {
+        protection |= PRIM_PROTECT_READ;
+    }
+    if (flags & ELF64_PF_W)
+    {
+        protection |= PRIM_PROTECT_WRITE;
+    }
+    if (flags & ELF64_PF_X)
+    {
+        protection |= PRIM_PROTECT_EXECUTE;
+    }
+    return protection;
+}
@@ -0,0 +1,400 @@
+/**
+ * @file src/loader/page_profile.c
+ *
+ * Implements recording and opening page profiles.
+ *
+ * A page profile holds a header, an image record per link map entry, then
+ * every image's ranges, grouped by image and sorted by offset.
+ *
+ * @see `include/loader/page_profile.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "loader/page_profile.h"
+#include "format/elf64/image.h"
+#include "format/elf64/segment/header.h"
+#include "format/elf64/segment/type.h"
+#include "loader/link_map.h"
+#include "loader/loader.h"
+#include "platform/file.h"
+#include "platform/mapping.h"
+#include "platform/memory.h"
+#include "platform/types.h"
+#include "status.h"
+#include <string.h>
+
+/** Ranges of a page profile being recorded. */
+typedef struct
+{
+    /** The ranges. */
+    Elf64_Page_Profile_Range* ranges;
+
+    /** Number of ranges in `ranges`. */
+    prim_usize count;
+
+    /** Number of ranges `ranges` has room for. */
+    prim_usize capacity;
+} Elf64_Page_Profile_Ranges;
+
+/**
+ * Open a page profile.
+ *
+ * @param profile Location to return the opened profile.
+ * @param path The profile file.
+ * @return STATUS_OKAY on success, STATUS_INVALID if it is malformed or was
+ * recorded with another page size, otherwise an error code. Nothing is left
+ * open on failure.
+ */
+extern PrimStatus elf64_page_profile_open(
+    Elf64_Page_Profile* profile, const char* path)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Page_Profile_Header* header = NULL;
+    prim_usize size = 0;
+    prim_usize i = 0;
+    memset(profile, 0, sizeof(Elf64_Page_Profile));
+    status = prim_map_file(path, &profile->mapping);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    header = (const Elf64_Page_Profile_Header*) profile->mapping.data;
+    size = profile->mapping.size;
+    if (size < sizeof(Elf64_Page_Profile_Header)
+        || memcmp(
+               header->magic, ELF64_PAGE_PROFILE_MAGIC, sizeof(header->magic))
+            != 0
+        || header->version != ELF64_PAGE_PROFILE_VERSION
+        || header->page_size != prim_map_page_size())
+    {
+        elf64_page_profile_close(profile);
+        return STATUS_INVALID;
+    }
+    /* Bound each count by the file size before multiplying. */
+    if (header->image_count > size / sizeof(Elf64_Page_Profile_Image)
+        || header->range_count > size / sizeof(Elf64_Page_Profile_Range)
+        || sizeof(Elf64_Page_Profile_Header)
+                + header->image_count * sizeof(Elf64_Page_Profile_Image)
+                + header->range_count * sizeof(Elf64_Page_Profile_Range)
+            > size)
+    {
+        elf64_page_profile_close(profile);
+        return STATUS_INVALID;
+    }
+    profile->header = header;
+    profile->images = (const Elf64_Page_Profile_Image*) (header + 1);
+    profile->ranges = (const Elf64_Page_Profile_Range*) (profile->images
+        + header->image_count);
+    for (i = 0; i < header->image_count; i++)
+    {
+        if (profile->images[i].first_range > header->range_count
+            || profile->images[i].range_count
+                > header->range_count - profile->images[i].first_range)
+        {
+            elf64_page_profile_close(profile);
+            return STATUS_INVALID;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Find the pages recorded for a binary.
+ *
+ * @param profile The profile.
+ * @param path The binary.
+ * @param result Location to return the binary's record.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the binary was not
+ * recorded or has changed since, otherwise an error code.
+ */
+extern PrimStatus elf64_page_profile_find(const Elf64_Page_Profile* profile,
+    const char* path, const Elf64_Page_Profile_Image** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    PrimFileIdentity identity;
+    prim_usize i = 0;
+    status = prim_file_identity(path, &identity);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    for (i = 0; i < profile->header->image_count; i++)
+    {
+        if (memcmp(&profile->images[i].identity, &identity,
+                sizeof(PrimFileIdentity))
+            == 0)
+        {
+            *result = &profile->images[i];
+            return STATUS_OKAY;
+        }
+    }
+    return STATUS_INVALID;
+}
+
+/**
+ * Close a page profile.
+ *
+ * @param profile The profile to close.
+ */
+extern void elf64_page_profile_close(Elf64_Page_Profile* profile)
+{
+    prim_unmap_file(&profile->mapping);
+    memset(profile, 0, sizeof(Elf64_Page_Profile));
+}
+
+/**
+ * Add a range of pages to a profile being recorded.
+ *
+ * @param ranges The ranges to add to.
+ * @param offset Offset of the first page in the file.
+ * @param size Length of the pages, in bytes.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_page_profile_add_range(
+    Elf64_Page_Profile_Ranges* ranges, const prim_usize offset,
+    const prim_usize size)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Page_Profile_Range* grown = NULL;
+    if (ranges->count == ranges->capacity)
+    {
+        ranges->capacity = ranges->capacity == 0 ? 16 : ranges->capacity * 2;
+        status = prim_malloc((void**) &grown,
+            ranges->capacity * sizeof(Elf64_Page_Profile_Range));
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        if (ranges->ranges != NULL)
+        {
+            memcpy(grown, ranges->ranges,
+                ranges->count * sizeof(Elf64_Page_Profile_Range));
+            prim_free(ranges->ranges);
+        }
+        ranges->ranges = grown;
+    }
+    ranges->ranges[ranges->count].offset = offset;
+    ranges->ranges[ranges->count].size = size;
+    ranges->count++;
+    return STATUS_OKAY;
+}
+
+/**
+ * Mark the touched pages of a range of memory backed by a binary.
+ *
+ * @param address Start of the memory. Page aligned.
+ * @param first Index of the file page backing `address`.
+ * @param count Number of pages in the memory.
+ * @param pages One byte per page of the binary, set for each touched page.
+ * @param page_count Number of pages in the binary.
+ * @param touched Scratch space, one byte per page of the binary.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_page_profile_mark(const prim_usize address,
+    const prim_usize first, prim_usize count, prim_u8* pages,
+    const prim_usize page_count, prim_u8* touched)
+{
+    PrimStatus status = STATUS_ERROR;
+    prim_usize i = 0;
+    if (first >= page_count)
+    {
+        return STATUS_OKAY;
+    }
+    if (count > page_count - first)
+    {
+        count = page_count - first;
+    }
+    status = prim_map_get_touched(
+        (const void*) address, count * prim_map_page_size(), touched);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    for (i = 0; i < count; i++)
+    {
+        pages[first + i] |= touched[i];
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Record the touched pages of a loaded image.
+ *
+ * @param ranges The ranges to add the image's pages to.
+ * @param loaded The loaded image.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_page_profile_add_image(
+    Elf64_Page_Profile_Ranges* ranges, Elf64_Loaded_Image* loaded)
+{
+    PrimStatus status = STATUS_OKAY;
+    const Elf64_Segment_Header* segment = NULL;
+    const PrimMapping* mapping = &loaded->image.mapping;
+    prim_usize page_size = prim_map_page_size();
+    prim_usize page_count = (mapping->size + page_size - 1) / page_size;
+    prim_usize start = 0;
+    prim_usize end = 0;
+    prim_usize run = 0;
+    prim_usize page = 0;
+    prim_u8* pages = NULL;
+    Elf64_Word index = 0;
+    if (page_count == 0)
+    {
+        return STATUS_OKAY;
+    }
+    status = prim_malloc((void**) &pages, 2 * page_count);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(pages, 0, page_count);
+    /* Prim's own view of the file is touched while parsing and relocating. */
+    status = elf64_page_profile_mark((prim_usize) mapping->data, 0, page_count,
+        pages, page_count, pages + page_count);
+    for (index = 0;
+         index < loaded->image.header->ph_entry_count && status == STATUS_OKAY;
+         index++)
+    {
+        elf64_image_get_segment_header(&loaded->image, index, &segment);
+        if (elf64_get_segment_type(segment) != ELF64_PT_LOAD
+            || segment->p_filesz == 0)
+        {
+            continue;
+        }
+        start = (segment->p_vaddr + loaded->bias) & ~(page_size - 1);
+        end = segment->p_vaddr + loaded->bias + segment->p_filesz;
+        status = elf64_page_profile_mark(start, segment->p_offset / page_size,
+            (end - start + page_size - 1) / page_size, pages, page_count,
+            pages + page_count);
+    }
+    for (page = 0; page <= page_count && status == STATUS_OKAY; page++)
+    {
+        if (page < page_count && pages[page])
+        {
+            continue;
+        }
+        if (page > run)
+        {
+            status = elf64_page_profile_add_range(
+                ranges, run * page_size, (page - run) * page_size);
+        }
+        run = page + 1;
+    }
+    prim_free(pages);
+    return status;
+}
+
+/**
+ * Write a page profile's records to a file.
+ *
+ * @param file The file to write.
+ * @param header The profile's header.
+ * @param images The profile's image records.
+ * @param ranges The profile's ranges.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_page_profile_write(prim_file_handle file,
+    const Elf64_Page_Profile_Header* header,
+    const Elf64_Page_Profile_Image* images,
+    const Elf64_Page_Profile_Ranges* ranges)
+{
+    PrimStatus status = STATUS_ERROR;
+    status = prim_fwrite(header, sizeof(Elf64_Page_Profile_Header), 1, file);
+    if (status == STATUS_OKAY && header->image_count != 0)
+    {
+        status = prim_fwrite(images, sizeof(Elf64_Page_Profile_Image),
+            header->image_count, file);
+    }
+    if (status == STATUS_OKAY && ranges->count != 0)
+    {
+        status = prim_fwrite(ranges->ranges, sizeof(Elf64_Page_Profile_Range),
+            ranges->count, file);
+    }
+    return status;
+}
+
+/**
+ * Record the pages of every binary in a link map touched so far, and save
+ * them to a page profile.
+ *
+ * The file is written beside `path` and then renamed over it, so processes
+ * with an older profile mapped keep a consistent copy.
+ *
+ * @param map The link map, once it has started.
+ * @param path The profile file to write.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_page_profile_save(
+    const Elf64_Link_Map* map, const char* path)
+{
+    PrimStatus status = STATUS_ERROR;
+    PrimStatus close_status = STATUS_ERROR;
+    Elf64_Page_Profile_Header header;
+    Elf64_Page_Profile_Image* images = NULL;
+    Elf64_Page_Profile_Ranges ranges = { NULL, 0, 0 };
+    prim_file_handle file;
+    char* temporary = NULL;
+    prim_usize i = 0;
+    memset(&header, 0, sizeof(Elf64_Page_Profile_Header));
+    memcpy(header.magic, ELF64_PAGE_PROFILE_MAGIC, sizeof(header.magic));
+    header.version = ELF64_PAGE_PROFILE_VERSION;
+    header.page_size = (prim_u32) prim_map_page_size();
+    header.image_count = map->count;
+    status = prim_malloc(
+        (void**) &images, map->count * sizeof(Elf64_Page_Profile_Image));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(images, 0, map->count * sizeof(Elf64_Page_Profile_Image));
+    for (i = 0; i < map->count && status == STATUS_OKAY; i++)
+    {
+        images[i].first_range = ranges.count;
+        status = prim_file_identity(map->entries[i].path, &images[i].identity);
+        if (status == STATUS_OKAY)
+        {
+            status = elf64_page_profile_add_image(
+                &ranges, map->entries[i].loaded);
+        }
+        images[i].range_count = ranges.count - images[i].first_range;
+    }
+    header.range_count = ranges.count;
+    if (status == STATUS_OKAY)
+    {
+        status = prim_malloc((void**) &temporary, strlen(path) + 5);
+    }
+    if (status == STATUS_OKAY)
+    {
+        strcpy(temporary, path);
+        strcat(temporary, ".new");
+        status = prim_fcreate(temporary, &file);
+        if (status == STATUS_OKAY)
+        {
+            status
+                = elf64_page_profile_write(file, &header, images, &ranges);
+            close_status = prim_fclose(file);
+            if (status == STATUS_OKAY)
+            {
+                status = close_status;
+            }
+            if (status == STATUS_OKAY)
+            {
+                status = prim_frename(temporary, path);
+            }
+            if (status != STATUS_OKAY)
+            {
+                prim_fremove(temporary);
+            }
+        }
+        prim_free(temporary);
+    }
+    if (ranges.ranges != NULL)
+    {
+        prim_free(ranges.ranges);
+    }
+    prim_free(images);
+    return status;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file src/loader/perf.c
+ *
+ * Implements describing loaded images to the host's profiler.
+ *
+ * @see `include/loader/perf.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "loader/perf.h"
+#include "format/elf64/image.h"
+#include "format/elf64/section/symbol.h"
+#include "format/elf64/section/type.h"
+#include "loader/loader.h"
+#include "platform/perf.h"
+#include "status.h"
+#include <stddef.h>
+
+/**
+ * Describe every function in a loaded image to the host's profiler.
+ *
+ * Functions are read from the image's static symbol table, or its dynamic
+ * symbol table if it has been stripped. Only defined functions with a known
+ * size are described.
+ *
+ * @param loaded The loaded image to describe.
+ * @param options The options the image was loaded with. `ELF64_LOAD_PERF_MAP`
+ * and `ELF64_LOAD_JITDUMP` select the outputs to write.
+ * @return STATUS_OKAY on success, otherwise the first error.
+ */
+extern PrimStatus elf64_perf_register_image(
+    Elf64_Loaded_Image* loaded, const Elf64_Load_Options* options)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Symbol_Table* table = NULL;
+    const Elf64_Symbol* symbol = NULL;
+    const char* name = NULL;
+    void* address = NULL;
+    Elf64_Word index = 0;
+    status = elf64_image_get_symbol_table(
+        &loaded->image, ELF64_SECTION_TYPE_SYMBOL_TABLE, &table);
+    if (status != STATUS_OKAY || table->count == 0)
+    {
+        status = elf64_image_get_symbol_table(
+            &loaded->image, ELF64_SECTION_TYPE_DYNSYM, &table);
+    }
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    for (index = 0; index < table->count; index++)
+    {
+        symbol = &table->symbols[index];
+        if (elf64_get_symbol_type(symbol) != ELF64_STT_FUNC
+            || elf64_get_symbol_section(symbol) == ELF64_SHN_UNDEF
+            || elf64_get_symbol_size(symbol) == 0
+            || elf64_symbol_table_get_name(table, symbol, &name) != STATUS_OKAY)
+        {
+            continue;
+        }
+        address = elf64_get_loaded_address(loaded, symbol->value);
+        if (options->flags & ELF64_LOAD_PERF_MAP)
+        {
+            status = prim_perf_map_add(
+                (prim_usize) address, symbol->size, name);
+        }
+        if (status == STATUS_OKAY && (options->flags & ELF64_LOAD_JITDUMP))
+        {
+            status = prim_jitdump_add(
+                options->jitdump_directory, address, symbol->size, name);
+        }
+        if (status != STATUS_OKAY)
+        {
+            break;
+        }
+    }
+    prim_perf_flush();
+    return status;
+}
@@ -0,0 +1,853 @@
+/**
+ * @file src/loader/relocate.c
+ *
+ * Implements applying dynamic relocations to loaded images.
+ *
+ * @see `include/loader/relocate.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "loader/relocate.h"
+#include "format/elf64/image.h"
+#include "format/elf64/section/dynamic.h"
+#include "format/elf64/section/relocation.h"
+#include "format/elf64/section/symbol.h"
+#include "format/elf64/section/type.h"
+#include "format/elf64/segment/header.h"
+#include "format/elf64/segment/type.h"
+#include "loader/link_map.h"
+#include "loader/loader.h"
+#include "platform/mapping.h"
+#include "platform/memory.h"
+#include "platform/plt.h"
+#include "platform/types.h"
+#include "stats.h"
+#include "status.h"
+#include "trace.h"
+#include <string.h>
+
+/** Name prefix of the system dynamic linker, `ld-linux-x86-64.so.2`. */
+#define ELF64_RTLD_PREFIX "ld-linux"
+
+/** Soname prefix of the system C library, `libc.so.6`. */
+#define ELF64_LIBC_PREFIX "libc.so"
+
+/** Number of locations described by each bit of a RELR bitmap word. */
+#define ELF64_RELR_BITMAP_BITS 63
+
+/** The relocations an image's dynamic table describes. */
+typedef struct
+{
+    /** The relocations in `ELF64_DT_RELA`. */
+    const Elf64_Relocation* relocations;
+
+    /** Number of relocations in `relocations`. */
+    Elf64_Xword relocation_count;
+
+    /** The relative relocation bitmaps in `ELF64_DT_RELR`. */
+    const Elf64_Xword* relative;
+
+    /** Number of words in `relative`. */
+    Elf64_Xword relative_count;
+
+    /** The PLT relocations in `ELF64_DT_JMPREL`. */
+    const Elf64_Relocation* plt;
+
+    /** Number of relocations in `plt`. */
+    Elf64_Xword plt_count;
+
+    /** The PLT's global offset table, from `ELF64_DT_PLTGOT`. */
+    Elf64_Xword* got;
+
+    /** Non-zero if the image asks for its PLT to be bound eagerly. */
+    int bind_now;
+} Elf64_Relocation_Tables;
+
+/** The context stored in a lazily bound image's GOT. */
+typedef struct
+{
+    /** The trampoline's view of the context. Must be the first member. */
+    PrimPltContext plt;
+
+    /** The link map the image belongs to. */
+    Elf64_Link_Map* map;
+
+    /** Index of the image in the link map. */
+    prim_usize entry;
+
+    /** The image's PLT relocations. */
+    const Elf64_Relocation* relocations;
+
+    /** Number of relocations in `relocations`. */
+    Elf64_Xword count;
+} Elf64_Lazy_Binding;
+
+/**
+ * Get a pointer to part of a loaded image, checking it lies inside the image.
+ *
+ * @param loaded The loaded image.
+ * @param address The link time address of the range.
+ * @param size The length of the range, in bytes.
+ * @param result Location to return the range's loaded address.
+ * @return `STATUS_OKAY` if the range is inside the image, `STATUS_INVALID`
+ * otherwise.
+ */
+static PrimStatus elf64_relocate_get_range(const Elf64_Loaded_Image* loaded,
+    Elf64_Address address, Elf64_Xword size, void** result)
+{
+    prim_usize start = (prim_usize) address + loaded->bias;
+    prim_usize base = (prim_usize) loaded->base;
+    if (start < base || start - base > loaded->size
+        || size > loaded->size - (start - base))
+    {
+        return STATUS_INVALID;
+    }
+    *result = (void*) start;
+    return STATUS_OKAY;
+}
+
+/**
+ * Find an image's relocations from its dynamic table.
+ *
+ * @param loaded The loaded image.
+ * @param tables Location to return the relocations.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the relocations are
+ * malformed or unsupported.
+ */
+static PrimStatus elf64_relocate_read_tables(
+    Elf64_Loaded_Image* loaded, Elf64_Relocation_Tables* tables)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Dynamic_Table* table = NULL;
+    const Elf64_Dynamic* entry = NULL;
+    Elf64_Address relocations = 0;
+    Elf64_Address relative = 0;
+    Elf64_Address plt = 0;
+    Elf64_Address got = 0;
+    Elf64_Xword relocations_size = 0;
+    Elf64_Xword relative_size = 0;
+    Elf64_Xword plt_size = 0;
+    Elf64_Word index = 0;
+    memset(tables, 0, sizeof(Elf64_Relocation_Tables));
+    status = elf64_image_get_dynamic_table(&loaded->image, &table);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    for (index = 0; index < table->count; index++)
+    {
+        entry = &table->entries[index];
+        switch (elf64_get_dynamic_tag(entry))
+        {
+        case ELF64_DT_RELA:
+            relocations = elf64_get_dynamic_value(entry);
+            break;
+        case ELF64_DT_RELASZ:
+            relocations_size = elf64_get_dynamic_value(entry);
+            break;
+        case ELF64_DT_RELAENT:
+            if (elf64_get_dynamic_value(entry) != sizeof(Elf64_Relocation))
+            {
+                return STATUS_INVALID;
+            }
+            break;
+        case ELF64_DT_RELR:
+            relative = elf64_get_dynamic_value(entry);
+            break;
+        case ELF64_DT_RELRSZ:
+            relative_size = elf64_get_dynamic_value(entry);
+            break;
+        case ELF64_DT_RELRENT:
+            if (elf64_get_dynamic_value(entry) != sizeof(Elf64_Xword))
+            {
+                return STATUS_INVALID;
+            }
+            break;
+        case ELF64_DT_JMPREL:
+            plt = elf64_get_dynamic_value(entry);
+            break;
+        case ELF64_DT_PLTRELSZ:
+            plt_size = elf64_get_dynamic_value(entry);
+            break;
+        case ELF64_DT_PLTREL:
+            if (elf64_get_dynamic_value(entry) != ELF64_DT_RELA)
+            {
+                return STATUS_INVALID;
+            }
+            break;
+        case ELF64_DT_PLTGOT:
+            got = elf64_get_dynamic_value(entry);
+            break;
+        case ELF64_DT_REL:
+        case ELF64_DT_TEXTREL:
+            /* Neither is produced for AMD64 by current toolchains. */
+            return STATUS_INVALID;
+        case ELF64_DT_BIND_NOW:
+            tables->bind_now = 1;
+            break;
+        case ELF64_DT_FLAGS:
+            tables->bind_now |= (elf64_get_dynamic_value(entry)
+                                    & ELF64_DF_BIND_NOW)
+                != 0;
+            break;
+        case ELF64_DT_FLAGS_1:
+            tables->bind_now |= (elf64_get_dynamic_value(entry)
+                                    & ELF64_DF_1_NOW)
+                != 0;
+            break;
+        default:
+            break;
+        }
+    }
+    if ((relocations_size != 0
+            && elf64_relocate_get_range(loaded, relocations,
+                   relocations_size, (void**) &tables->relocations)
+                != STATUS_OKAY)
+        || (relative_size != 0
+            && elf64_relocate_get_range(loaded, relative, relative_size,
+                   (void**) &tables->relative)
+                != STATUS_OKAY)
+        || (plt_size != 0
+            && elf64_relocate_get_range(
+                   loaded, plt, plt_size, (void**) &tables->plt)
+                != STATUS_OKAY)
+        || (got != 0
+            && elf64_relocate_get_range(loaded, got,
+                   3 * sizeof(Elf64_Xword), (void**) &tables->got)
+                != STATUS_OKAY))
+    {
+        return STATUS_INVALID;
+    }
+    if ((prim_usize) tables->relocations % sizeof(Elf64_Xword) != 0
+        || (prim_usize) tables->relative % sizeof(Elf64_Xword) != 0
+        || (prim_usize) tables->plt % sizeof(Elf64_Xword) != 0)
+    {
+        return STATUS_INVALID;
+    }
+    tables->relocation_count = relocations_size / sizeof(Elf64_Relocation);
+    tables->relative_count = relative_size / sizeof(Elf64_Xword);
+    tables->plt_count = plt_size / sizeof(Elf64_Relocation);
+    return STATUS_OKAY;
+}
+
+/**
+ * Find the definition of the symbol a relocation refers to.
+ *
+ * @param map The link map being relocated.
+ * @param entry Index of the image the relocation belongs to.
+ * @param index The symbol's index in the image's dynamic symbol table.
+ * @param first Index of the first link map entry to search.
+ * @param result Location to return the definition. The symbol is `NULL` for
+ * undefined weak references, and for symbol index zero, which refers to the
+ * relocating image itself.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the symbol is
+ * undefined.
+ */
+static PrimStatus elf64_relocate_find_definition(Elf64_Link_Map* map,
+    prim_usize entry, Elf64_Word index, prim_usize first,
+    Elf64_Link_Map_Symbol* result)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Loaded_Image* loaded = map->entries[entry].loaded;
+    const Elf64_Symbol_Table* table = NULL;
+    const Elf64_Symbol* symbol = NULL;
+    const char* name = NULL;
+    result->entry = entry;
+    result->symbol = NULL;
+    if (index == 0)
+    {
+        return STATUS_OKAY;
+    }
+    status = elf64_image_get_symbol_table(
+        &loaded->image, ELF64_SECTION_TYPE_DYNSYM, &table);
+    if (status != STATUS_OKAY || index >= table->count)
+    {
+        return STATUS_INVALID;
+    }
+    symbol = &table->symbols[index];
+    if (elf64_get_symbol_binding(symbol) == ELF64_STB_LOCAL)
+    {
+        result->symbol = symbol;
+        return STATUS_OKAY;
+    }
+    status = elf64_symbol_table_get_name(table, symbol, &name);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    if (elf64_link_map_find_symbol(map, name,
+            elf64_link_map_get_symbol_version(map, entry, index), first,
+            result)
+        != STATUS_OKAY)
+    {
+        /* Undefined weak references are null. */
+        result->symbol = NULL;
+        return elf64_get_symbol_binding(symbol) == ELF64_STB_WEAK
+            ? STATUS_OKAY
+            : STATUS_INVALID;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Check whether an image's IFUNC resolvers can be called.
+ *
+ * The resolvers of the system C library, and of libraries built alongside
+ * it, read the CPU features and other state the system dynamic linker sets
+ * up before any code runs. Prim does not set that state up, so they would
+ * read unset memory. Such images are recognised by being the dynamic linker
+ * or C library, or by needing the dynamic linker.
+ *
+ * @param map The link map being relocated.
+ * @param entry Index of the image defining the resolver.
+ * @return `STATUS_OKAY` if the resolvers can be called, `STATUS_INVALID` if
+ * they need the system dynamic linker's state.
+ */
+static PrimStatus elf64_relocate_check_resolver(
+    Elf64_Link_Map* map, prim_usize entry)
+{
+    const Elf64_Link_Map_Entry* image = &map->entries[entry];
+    const Elf64_Dynamic_Table* table = NULL;
+    const char* name = image->soname;
+    Elf64_Word index = 0;
+    if (name != NULL
+        && (strncmp(name, ELF64_RTLD_PREFIX, strlen(ELF64_RTLD_PREFIX)) == 0
+            || strncmp(name, ELF64_LIBC_PREFIX, strlen(ELF64_LIBC_PREFIX))
+                == 0))
+    {
+        return STATUS_INVALID;
+    }
+    if (elf64_image_get_dynamic_table(&image->loaded->image, &table)
+        != STATUS_OKAY)
+    {
+        return STATUS_INVALID;
+    }
+    for (index = 0; index < table->count; index++)
+    {
+        if (elf64_get_dynamic_tag(&table->entries[index]) == ELF64_DT_NEEDED
+            && elf64_dynamic_table_get_string(
+                   table, &table->entries[index], &name)
+                == STATUS_OKAY
+            && strncmp(name, ELF64_RTLD_PREFIX, strlen(ELF64_RTLD_PREFIX))
+                == 0)
+        {
+            return STATUS_INVALID;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Find the loaded address of the symbol a relocation refers to.
+ *
+ * @param map The link map being relocated.
+ * @param entry Index of the image the relocation belongs to.
+ * @param index The symbol's index in the image's dynamic symbol table.
+ * @param first Index of the first link map entry to search.
+ * @param result Location to return the symbol's address.
+ * @param definition Location to return the symbol's definition, or `NULL`.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the symbol is
+ * undefined, thread local, or an IFUNC whose resolver can not be called.
+ */
+static PrimStatus elf64_relocate_get_symbol(Elf64_Link_Map* map,
+    prim_usize entry, Elf64_Word index, prim_usize first, prim_usize* result,
+    const Elf64_Symbol** definition)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Link_Map_Symbol found = { 0, NULL };
+    *result = 0;
+    status = elf64_relocate_find_definition(map, entry, index, first, &found);
+    if (status != STATUS_OKAY || found.symbol == NULL)
+    {
+        return status;
+    }
+    if (elf64_get_symbol_type(found.symbol) == ELF64_STT_TLS)
+    {
+        return STATUS_INVALID;
+    }
+    *result = (prim_usize) elf64_get_loaded_address(
+        map->entries[found.entry].loaded, found.symbol->value);
+    if (elf64_get_symbol_type(found.symbol) == ELF64_STT_GNU_IFUNC)
+    {
+        if (elf64_relocate_check_resolver(map, found.entry) != STATUS_OKAY)
+        {
+            return STATUS_INVALID;
+        }
+        *result = ((prim_usize (*)(void)) * result)();
+    }
+    if (definition != NULL)
+    {
+        *definition = found.symbol;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Apply one thread local storage relocation.
+ *
+ * @param map The link map being relocated.
+ * @param entry Index of the image the relocation belongs to.
+ * @param relocation The relocation to apply.
+ * @param target The relocation's location.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the symbol is
+ * undefined or has no TLS block.
+ */
+static PrimStatus elf64_relocate_apply_tls(Elf64_Link_Map* map,
+    prim_usize entry, const Elf64_Relocation* relocation, Elf64_Xword* target)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Link_Map_Symbol found = { 0, NULL };
+    const Elf64_Link_Map_Entry* module = NULL;
+    Elf64_Xword value = relocation->addend;
+    status = elf64_relocate_find_definition(map, entry,
+        elf64_get_relocation_symbol(relocation), 0, &found);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    module = &map->entries[found.entry];
+    if (module->tls_module == 0
+        || (found.symbol == NULL
+            && elf64_get_relocation_symbol(relocation) != 0))
+    {
+        return STATUS_INVALID;
+    }
+    if (found.symbol != NULL)
+    {
+        value += found.symbol->value;
+    }
+    switch (elf64_get_relocation_type(relocation))
+    {
+    case ELF64_R_X86_64_DTPMOD64:
+        *target = module->tls_module;
+        break;
+    case ELF64_R_X86_64_DTPOFF64:
+        *target = value;
+        break;
+    default:
+        /* Variant II: static TLS blocks are below the thread pointer. */
+        *target = value - module->tls_offset;
+        break;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Apply one relocation.
+ *
+ * @param map The link map being relocated.
+ * @param entry Index of the image the relocation belongs to.
+ * @param relocation The relocation to apply.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if the relocation is
+ * malformed, unsupported, or refers to an undefined symbol.
+ */
+static PrimStatus elf64_relocate_apply(Elf64_Link_Map* map,
+    prim_usize entry, const Elf64_Relocation* relocation)
+{
+    PrimStatus status = STATUS_OKAY;
+    Elf64_Loaded_Image* loaded = map->entries[entry].loaded;
+    const Elf64_Symbol* definition = NULL;
+    Elf64_Xword* target = NULL;
+    prim_usize value = 0;
+    Elf64_Relocation_Type type = elf64_get_relocation_type(relocation);
+    if (type == ELF64_R_X86_64_NONE)
+    {
+        return STATUS_OKAY;
+    }
+    status = elf64_relocate_get_range(
+        loaded, relocation->offset, sizeof(Elf64_Xword), (void**) &target);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    switch (type)
+    {
+    case ELF64_R_X86_64_RELATIVE:
+        *target = loaded->bias + relocation->addend;
+        break;
+    case ELF64_R_X86_64_IRELATIVE:
+        if (elf64_relocate_check_resolver(map, entry) != STATUS_OKAY)
+        {
+            return STATUS_INVALID;
+        }
+        value = loaded->bias + relocation->addend;
+        *target = ((prim_usize (*)(void)) value)();
+        break;
+    case ELF64_R_X86_64_64:
+    case ELF64_R_X86_64_GLOB_DAT:
+    case ELF64_R_X86_64_JUMP_SLOT:
+        status = elf64_relocate_get_symbol(map, entry,
+            elf64_get_relocation_symbol(relocation), 0, &value, NULL);
+        if (type == ELF64_R_X86_64_64)
+        {
+            value += relocation->addend;
+        }
+        *target = value;
+        break;
+    case ELF64_R_X86_64_DTPMOD64:
+    case ELF64_R_X86_64_DTPOFF64:
+    case ELF64_R_X86_64_TPOFF64:
+        status = elf64_relocate_apply_tls(map, entry, relocation, target);
+        break;
+    case ELF64_R_X86_64_COPY:
+        /* The copy's source is the next definition after the image. */
+        status = elf64_relocate_get_symbol(map, entry,
+            elf64_get_relocation_symbol(relocation), entry + 1, &value,
+            &definition);
+        if (status == STATUS_OKAY
+            && (definition == NULL
+                || elf64_relocate_get_range(loaded, relocation->offset,
+                       definition->size, (void**) &target)
+                    != STATUS_OKAY))
+        {
+            return STATUS_INVALID;
+        }
+        if (status == STATUS_OKAY)
+        {
+            memcpy(target, (const void*) value, definition->size);
+        }
+        break;
+    default:
+        return STATUS_INVALID;
+    }
+    return status;
+}
+
+/**
+ * Apply an image's relative relocation bitmaps.
+ *
+ * Each even word is the link time address of a location to relocate. Each
+ * odd word is a bitmap of the 63 locations following the previous one.
+ *
+ * @param loaded The image to relocate.
+ * @param tables The image's relocations.
+ * @param applied Incremented for every location relocated.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if a location is outside
+ * the image.
+ */
+static PrimStatus elf64_relocate_apply_relative(Elf64_Loaded_Image* loaded,
+    const Elf64_Relocation_Tables* tables, prim_usize* applied)
+{
+    Elf64_Xword* where = NULL;
+    Elf64_Xword* location = NULL;
+    Elf64_Xword word = 0;
+    Elf64_Xword index = 0;
+    unsigned int bit = 0;
+    for (index = 0; index < tables->relative_count; index++)
+    {
+        word = tables->relative[index];
+        if ((word & 1U) == 0)
+        {
+            if (elf64_relocate_get_range(
+                    loaded, word, sizeof(Elf64_Xword), (void**) &location)
+                != STATUS_OKAY)
+            {
+                return STATUS_INVALID;
+            }
+            *location += loaded->bias;
+            where = location + 1;
+            (*applied)++;
+            continue;
+        }
+        if (where == NULL)
+        {
+            return STATUS_INVALID;
+        }
+        for (bit = 0; (word >>= 1U) != 0; bit++)
+        {
+            if ((word & 1U) == 0)
+            {
+                continue;
+            }
+            location = where + bit;
+            if ((prim_usize) (location + 1)
+                > (prim_usize) loaded->base + loaded->size)
+            {
+                return STATUS_INVALID;
+            }
+            *location += loaded->bias;
+            (*applied)++;
+        }
+        where += ELF64_RELR_BITMAP_BITS;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Bind a lazily bound PLT entry. Called by the trampoline.
+ *
+ * @param context The image's `Elf64_Lazy_Binding`.
+ * @param index The index of the relocation in the image's PLT relocations.
+ * @return The bound function's address, or `NULL` if it can not be bound.
+ */
+static void* elf64_relocate_bind(PrimPltContext* context, prim_usize index)
+{
+    Elf64_Lazy_Binding* binding = (Elf64_Lazy_Binding*) context;
+    const Elf64_Relocation* relocation = NULL;
+    Elf64_Xword* slot = NULL;
+    prim_usize value = 0;
+    if (index >= binding->count)
+    {
+        return NULL;
+    }
+    relocation = &binding->relocations[index];
+    if (elf64_relocate_get_symbol(binding->map, binding->entry,
+            elf64_get_relocation_symbol(relocation), 0, &value, NULL)
+            != STATUS_OKAY
+        || value == 0)
+    {
+        return NULL;
+    }
+    /* The slot was checked when the image was relocated. */
+    slot = (Elf64_Xword*) elf64_get_loaded_address(
+        binding->map->entries[binding->entry].loaded, relocation->offset);
+    *slot = value;
+    PRIM_STATS_ADD(PRIM_STATS_LAZY_BINDS, 1);
+    return (void*) value;
+}
+
+/**
+ * Prepare an image's PLT entries to be bound on their first call.
+ *
+ * @param map The link map being relocated.
+ * @param entry Index of the image in the link map.
+ * @param tables The image's relocations.
+ * @param applied Incremented for every relocation applied.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_relocate_prepare_lazy(Elf64_Link_Map* map,
+    prim_usize entry, const Elf64_Relocation_Tables* tables,
+    prim_usize* applied)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Loaded_Image* loaded = map->entries[entry].loaded;
+    Elf64_Lazy_Binding* binding = NULL;
+    const Elf64_Relocation* relocation = NULL;
+    Elf64_Xword* slot = NULL;
+    Elf64_Xword index = 0;
+    status = prim_malloc((void**) &binding, sizeof(Elf64_Lazy_Binding));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    binding->plt.bind = elf64_relocate_bind;
+    binding->map = map;
+    binding->entry = entry;
+    binding->relocations = tables->plt;
+    binding->count = tables->plt_count;
+    map->entries[entry].binding = &binding->plt;
+    tables->got[1] = (Elf64_Xword) binding;
+    tables->got[2] = (Elf64_Xword) prim_plt_trampoline;
+    for (index = 0; index < tables->plt_count; index++)
+    {
+        relocation = &tables->plt[index];
+        if (elf64_get_relocation_type(relocation) != ELF64_R_X86_64_JUMP_SLOT)
+        {
+            status = elf64_relocate_apply(map, entry, relocation);
+        }
+        else
+        {
+            /* Slots start at their PLT entry's link time push instruction. */
+            status = elf64_relocate_get_range(loaded, relocation->offset,
+                sizeof(Elf64_Xword), (void**) &slot);
+            if (status == STATUS_OKAY)
+            {
+                *slot += loaded->bias;
+            }
+        }
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        (*applied)++;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Make an image's `PT_GNU_RELRO` segments read only.
+ *
+ * @param loaded The relocated image.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_protect_relro(Elf64_Loaded_Image* loaded)
+{
+    PrimStatus status = STATUS_OKAY;
+    const Elf64_Segment_Header* segment = NULL;
+    prim_usize page_mask = ~(prim_map_page_size() - 1);
+    prim_usize start = 0;
+    prim_usize end = 0;
+    Elf64_Word index = 0;
+    for (index = 0; index < loaded->image.header->ph_entry_count; index++)
+    {
+        elf64_image_get_segment_header(&loaded->image, index, &segment);
+        if (elf64_get_segment_type(segment) != ELF64_PT_GNU_RELRO)
+        {
+            continue;
+        }
+        /* Partial pages at the end stay writable, as with the system linker. */
+        start = (segment->p_vaddr + loaded->bias) & page_mask;
+        end = (segment->p_vaddr + segment->p_memsz + loaded->bias) & page_mask;
+        if (end > start)
+        {
+            status = prim_map_protect(
+                (void*) start, end - start, PRIM_PROTECT_READ);
+        }
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Relocate one image in a link map.
+ *
+ * @param map The link map being relocated.
+ * @param entry Index of the image in the link map.
+ * @param flags The `ELF64_LOAD_*` flags the link map was loaded with.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_relocate_image(
+    Elf64_Link_Map* map, prim_usize entry, const prim_u32 flags)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Loaded_Image* loaded = map->entries[entry].loaded;
+    Elf64_Relocation_Tables tables;
+    prim_usize applied = 0;
+    Elf64_Xword index = 0;
+    status = elf64_relocate_read_tables(loaded, &tables);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    PRIM_TRACE_RELOC_START(
+        tables.relocation_count + tables.relative_count + tables.plt_count);
+    status = elf64_relocate_apply_relative(loaded, &tables, &applied);
+    for (index = 0; index < tables.relocation_count && status == STATUS_OKAY;
+         index++)
+    {
+        status = elf64_relocate_apply(map, entry, &tables.relocations[index]);
+        applied++;
+    }
+    if (status == STATUS_OKAY && tables.plt_count != 0)
+    {
+        if (!(flags & ELF64_LOAD_BIND_NOW) && !tables.bind_now
+            && tables.got != NULL && prim_plt_is_supported() == STATUS_OKAY)
+        {
+            status = elf64_relocate_prepare_lazy(map, entry, &tables, &applied);
+        }
+        else
+        {
+            for (index = 0; index < tables.plt_count && status == STATUS_OKAY;
+                 index++)
+            {
+                status = elf64_relocate_apply(map, entry, &tables.plt[index]);
+                applied++;
+            }
+        }
+    }
+    PRIM_TRACE_RELOC_END(
+        tables.relocation_count + tables.relative_count + tables.plt_count,
+        applied);
+    PRIM_STATS_ADD(PRIM_STATS_RELOCATIONS, applied);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    return elf64_protect_relro(loaded);
+}
+
+/**
+ * Check that every IFUNC resolver in a link map can be called.
+ *
+ * Only images which define IFUNC symbols, or have `R_X86_64_IRELATIVE`
+ * relocations, have resolvers to check.
+ *
+ * @param map The loaded link map.
+ * @return STATUS_OKAY if every resolver can be called, STATUS_INVALID if an
+ * image's resolvers need the system dynamic linker's state, otherwise an
+ * error code.
+ */
+extern PrimStatus elf64_link_map_check_resolvers(Elf64_Link_Map* map)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Relocation_Tables tables;
+    const Elf64_Symbol_Table* symbols = NULL;
+    int resolvers = 0;
+    prim_usize entry = 0;
+    Elf64_Xword index = 0;
+    for (entry = 0; entry < map->count; entry++)
+    {
+        if (elf64_relocate_check_resolver(map, entry) == STATUS_OKAY)
+        {
+            continue;
+        }
+        status = elf64_relocate_read_tables(map->entries[entry].loaded, &tables);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        resolvers = 0;
+        for (index = 0; index < tables.relocation_count && !resolvers; index++)
+        {
+            resolvers = elf64_get_relocation_type(&tables.relocations[index])
+                == ELF64_R_X86_64_IRELATIVE;
+        }
+        for (index = 0; index < tables.plt_count && !resolvers; index++)
+        {
+            resolvers = elf64_get_relocation_type(&tables.plt[index])
+                == ELF64_R_X86_64_IRELATIVE;
+        }
+        if (!resolvers
+            && elf64_image_get_symbol_table(&map->entries[entry].loaded->image,
+                   ELF64_SECTION_TYPE_DYNSYM, &symbols)
+                == STATUS_OKAY)
+        {
+            for (index = 0; index < symbols->count && !resolvers; index++)
+            {
+                resolvers = elf64_get_symbol_type(&symbols->symbols[index])
+                        == ELF64_STT_GNU_IFUNC
+                    && elf64_get_symbol_section(&symbols->symbols[index])
+                        != ELF64_SHN_UNDEF;
+            }
+        }
+        if (resolvers)
+        {
+            return STATUS_INVALID;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Relocate every image in a link map.
+ *
+ * Images are relocated in reverse search order, so libraries are ready
+ * before the images which depend on them. Each image's `PT_GNU_RELRO`
+ * segment is made read only once it is relocated.
+ *
+ * @param map The link map to relocate.
+ * @param flags The `ELF64_LOAD_*` flags the link map was loaded with.
+ * @return STATUS_OKAY on success, STATUS_INVALID if a relocation is
+ * malformed, unsupported, refers to an undefined symbol, or needs an IFUNC
+ * resolver which can not be called, otherwise an error code.
+ */
+extern PrimStatus elf64_link_map_relocate(
+    Elf64_Link_Map* map, const prim_u32 flags)
+{
+    PrimStatus status = STATUS_OKAY;
+    prim_usize entry = map->count;
+    PRIM_STATS_PHASE_BEGIN(timer);
+    while (entry > 0 && status == STATUS_OKAY)
+    {
+        entry--;
+        status = elf64_relocate_image(map, entry, flags);
+    }
+    PRIM_STATS_PHASE_END(timer, PRIM_PHASE_RELOCATE);
+    return status;
+}
@@ -0,0 +1,702 @@
+/**
+ * @file src/loader/resolver.c
+ *
+ * Implements finding the shared libraries needed by ELF64 images.
+ *
+ * @see `include/loader/resolver.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "loader/resolver.h"
+#include "format/elf64/image.h"
+#include "format/elf64/section/dynamic.h"
+#include "platform/file.h"
+#include "platform/mapping.h"
+#include "platform/memory.h"
+#include "platform/process.h"
+#include "platform/types.h"
+#include "stats.h"
+#include "status.h"
+#include <string.h>
+
+/** First line of a saved library cache, identifying the format. */
+#define ELF64_LIBRARY_CACHE_MAGIC "prim-library-cache 2\n"
+
+/** Smallest number of slots in a non-empty library cache. */
+#define ELF64_LIBRARY_CACHE_MINIMUM_SIZE 16
+
+/** Directories searched after the requester's and the user's paths. */
+static const char* const system_directories[] = {
+    "/lib/x86_64-linux-gnu",
+    "/usr/lib/x86_64-linux-gnu",
+    "/lib64",
+    "/usr/lib64",
+    "/lib",
+    "/usr/lib",
+};
+
+/**
+ * Copy the first `length` characters of a string into a new allocation.
+ *
+ * @param string The string to copy.
+ * @param length The number of characters to copy.
+ * @param result Location to return the null terminated copy.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_resolver_copy_string(
+    const char* string, prim_usize length, char** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    status = prim_malloc((void**) result, length + 1);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memcpy(*result, string, length);
+    (*result)[length] = '\0';
+    return STATUS_OKAY;
+}
+
+/**
+ * Hash a soname for the library cache.
+ *
+ * @param soname The soname to hash.
+ * @return The FNV-1a hash of the soname.
+ */
+static prim_usize elf64_library_cache_hash(const char* soname)
+{
+    prim_u32 hash = 2166136261U;
+    while (*soname != '\0')
+    {
+        hash ^= (unsigned char) *soname;
+        hash *= 16777619U;
+        soname++;
+    }
+    return hash;
+}
+
+/**
+ * Find the slot holding a soname, or the empty slot it would be stored in.
+ *
+ * @param cache The cache to search. Must have at least one empty slot.
+ * @param soname The soname to find.
+ * @return The index of the slot.
+ */
+static prim_usize elf64_library_cache_find_slot(
+    const Elf64_Library_Cache* cache, const char* soname)
+{
+    prim_usize mask = cache->size - 1;
+    prim_usize slot = elf64_library_cache_hash(soname) & mask;
+    while (cache->entries[slot].soname != NULL
+        && strcmp(cache->entries[slot].soname, soname) != 0)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * Double the number of slots in a library cache, re-inserting every entry.
+ *
+ * @param cache The cache to grow.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_library_cache_grow(Elf64_Library_Cache* cache)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Library_Cache grown = { NULL, 0, 0 };
+    prim_usize slot = 0;
+    prim_usize i = 0;
+    grown.size = cache->size * 2;
+    if (grown.size < ELF64_LIBRARY_CACHE_MINIMUM_SIZE)
+    {
+        grown.size = ELF64_LIBRARY_CACHE_MINIMUM_SIZE;
+    }
+    status = prim_malloc((void**) &grown.entries,
+        grown.size * sizeof(Elf64_Library_Cache_Entry));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(grown.entries, 0, grown.size * sizeof(Elf64_Library_Cache_Entry));
+    for (i = 0; i < cache->size; i++)
+    {
+        if (cache->entries[i].soname == NULL)
+        {
+            continue;
+        }
+        slot = elf64_library_cache_find_slot(&grown, cache->entries[i].soname);
+        grown.entries[slot] = cache->entries[i];
+    }
+    grown.count = cache->count;
+    if (cache->entries != NULL)
+    {
+        prim_free(cache->entries);
+    }
+    *cache = grown;
+    return STATUS_OKAY;
+}
+
+/**
+ * Initialise an empty library cache.
+ *
+ * @param cache The cache to initialise.
+ */
+extern void elf64_library_cache_init(Elf64_Library_Cache* cache)
+{
+    memset(cache, 0, sizeof(Elf64_Library_Cache));
+}
+
+/**
+ * Release a library cache and every entry in it.
+ *
+ * @param cache The cache to destroy.
+ */
+extern void elf64_library_cache_destroy(Elf64_Library_Cache* cache)
+{
+    prim_usize i = 0;
+    for (i = 0; i < cache->size; i++)
+    {
+        if (cache->entries[i].soname != NULL)
+        {
+            prim_free(cache->entries[i].soname);
+        }
+        if (cache->entries[i].path != NULL)
+        {
+            prim_free(cache->entries[i].path);
+        }
+    }
+    if (cache->entries != NULL)
+    {
+        prim_free(cache->entries);
+    }
+    memset(cache, 0, sizeof(Elf64_Library_Cache));
+}
+
+/**
+ * Look up a soname in a library cache.
+ *
+ * @param cache The cache to search.
+ * @param soname The soname to look up.
+ * @param result Location to return the cached path.
+ * @return STATUS_OKAY if the soname is cached, STATUS_INVALID otherwise.
+ */
+extern PrimStatus elf64_library_cache_lookup(
+    const Elf64_Library_Cache* cache, const char* soname, const char** result)
+{
+    prim_usize slot = 0;
+    if (cache->size == 0)
+    {
+        return STATUS_INVALID;
+    }
+    slot = elf64_library_cache_find_slot(cache, soname);
+    if (cache->entries[slot].soname == NULL)
+    {
+        return STATUS_INVALID;
+    }
+    *result = cache->entries[slot].path;
+    return STATUS_OKAY;
+}
+
+/**
+ * Remember the path a soname resolved to, replacing any earlier result.
+ *
+ * @param cache The cache to update.
+ * @param soname The soname.
+ * @param path The library's path.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_library_cache_insert(
+    Elf64_Library_Cache* cache, const char* soname, const char* path)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Library_Cache_Entry* entry = NULL;
+    char* path_copy = NULL;
+    /* Keep the table at most half full, so probe sequences stay short. */
+    if (2 * (cache->count + 1) > cache->size)
+    {
+        status = elf64_library_cache_grow(cache);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+    }
+    status = elf64_resolver_copy_string(path, strlen(path), &path_copy);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    entry = &cache->entries[elf64_library_cache_find_slot(cache, soname)];
+    if (entry->soname == NULL)
+    {
+        status = elf64_resolver_copy_string(
+            soname, strlen(soname), &entry->soname);
+        if (status != STATUS_OKAY)
+        {
+            prim_free(path_copy);
+            return status;
+        }
+        cache->count++;
+    }
+    else
+    {
+        prim_free(entry->path);
+    }
+    entry->path = path_copy;
+    return STATUS_OKAY;
+}
+
+/**
+ * Add the entries saved in a file to a library cache.
+ *
+ * A file saved under a different `LD_LIBRARY_PATH` is ignored, because its
+ * results may not hold under the current one.
+ *
+ * @param cache The cache to add to.
+ * @param path The file written by `elf64_library_cache_save`.
+ * @return STATUS_OKAY on success, including when the file is ignored,
+ * STATUS_INVALID if the file is malformed, otherwise an error code.
+ */
+extern PrimStatus elf64_library_cache_load(
+    Elf64_Library_Cache* cache, const char* path)
+{
+    PrimStatus status = STATUS_ERROR;
+    PrimMapping mapping;
+    const char* search_path = prim_get_environment("LD_LIBRARY_PATH");
+    const char* cursor = NULL;
+    const char* end = NULL;
+    const char* line_end = NULL;
+    const char* separator = NULL;
+    char* soname = NULL;
+    char* library = NULL;
+    prim_usize magic_length = strlen(ELF64_LIBRARY_CACHE_MAGIC);
+    prim_usize search_path_length = 0;
+    status = prim_map_file(path, &mapping);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    cursor = (const char*) mapping.data;
+    end = cursor + mapping.size;
+    if (search_path == NULL)
+    {
+        search_path = "";
+    }
+    search_path_length = strlen(search_path);
+    if (mapping.size < magic_length
+        || memcmp(cursor, ELF64_LIBRARY_CACHE_MAGIC, magic_length) != 0)
+    {
+        prim_unmap_file(&mapping);
+        return STATUS_INVALID;
+    }
+    cursor += magic_length;
+    /* The second line records the `LD_LIBRARY_PATH` the file was saved with. */
+    line_end = memchr(cursor, '\n', end - cursor);
+    if (line_end == NULL
+        || (prim_usize) (line_end - cursor) != search_path_length
+        || memcmp(cursor, search_path, search_path_length) != 0)
+    {
+        prim_unmap_file(&mapping);
+        return line_end == NULL ? STATUS_INVALID : STATUS_OKAY;
+    }
+    cursor = line_end + 1;
+    status = STATUS_OKAY;
+    while (cursor < end && status == STATUS_OKAY)
+    {
+        line_end = memchr(cursor, '\n', end - cursor);
+        separator = memchr(cursor, '\t', end - cursor);
+        if (line_end == NULL || separator == NULL || separator > line_end)
+        {
+            status = STATUS_INVALID;
+            break;
+        }
+        status = elf64_resolver_copy_string(
+            cursor, separator - cursor, &soname);
+        if (status != STATUS_OKAY)
+        {
+            break;
+        }
+        status = elf64_resolver_copy_string(
+            separator + 1, line_end - separator - 1, &library);
+        if (status == STATUS_OKAY)
+        {
+            status = elf64_library_cache_insert(cache, soname, library);
+            prim_free(library);
+        }
+        prim_free(soname);
+        cursor = line_end + 1;
+    }
+    prim_unmap_file(&mapping);
+    return status;
+}
+
+/**
+ * Write a string to a file.
+ *
+ * @param file The file to write to.
+ * @param string The string to write, without its terminator.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_resolver_write_string(
+    prim_file_handle file, const char* string)
+{
+    return prim_fwrite(string, 1, strlen(string), file);
+}
+
+/**
+ * Save the entries in a library cache to a file.
+ *
+ * @param cache The cache to save.
+ * @param path The file to write.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_library_cache_save(
+    const Elf64_Library_Cache* cache, const char* path)
+{
+    PrimStatus status = STATUS_ERROR;
+    PrimStatus close_status = STATUS_ERROR;
+    prim_file_handle file;
+    const Elf64_Library_Cache_Entry* entry = NULL;
+    const char* search_path = prim_get_environment("LD_LIBRARY_PATH");
+    prim_usize i = 0;
+    status = prim_fcreate(path, &file);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    status = elf64_resolver_write_string(file, ELF64_LIBRARY_CACHE_MAGIC);
+    if (status == STATUS_OKAY && search_path != NULL)
+    {
+        status = elf64_resolver_write_string(file, search_path);
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_resolver_write_string(file, "\n");
+    }
+    for (i = 0; i < cache->size && status == STATUS_OKAY; i++)
+    {
+        entry = &cache->entries[i];
+        /* Names containing the format's separators can not be saved. */
+        if (entry->soname == NULL || strpbrk(entry->soname, "\t\n") != NULL
+            || strchr(entry->path, '\n') != NULL)
+        {
+            continue;
+        }
+        status = elf64_resolver_write_string(file, entry->soname);
+        if (status == STATUS_OKAY)
+        {
+            status = elf64_resolver_write_string(file, "\t");
+        }
+        if (status == STATUS_OKAY)
+        {
+            status = elf64_resolver_write_string(file, entry->path);
+        }
+        if (status == STATUS_OKAY)
+        {
+            status = elf64_resolver_write_string(file, "\n");
+        }
+    }
+    close_status = prim_fclose(file);
+    if (status == STATUS_OKAY)
+    {
+        status = close_status;
+    }
+    return status;
+}
+
+/**
+ * Check for a library in one search directory.
+ *
+ * `$ORIGIN` and `${ORIGIN}` in the directory are replaced with the directory
+ * containing the requesting image. An empty directory is the current
+ * directory.
+ *
+ * @param directory The directory to check. Need not be null terminated.
+ * @param length The length of `directory`.
+ * @param origin The directory containing the requesting image.
+ * @param origin_length The length of `origin`.
+ * @param soname The library to look for.
+ * @param buffer Location to build the library's path.
+ * @return `STATUS_OKAY` if the library is in the directory, `STATUS_BAD_FILE`
+ * otherwise.
+ */
+static PrimStatus elf64_resolver_try_directory(const char* directory,
+    prim_usize length, const char* origin, prim_usize origin_length,
+    const char* soname, char* buffer)
+{
+    prim_usize used = 0;
+    prim_usize token = 0;
+    prim_usize soname_length = strlen(soname);
+    prim_usize i = 0;
+    if (length == 0)
+    {
+        directory = ".";
+        length = 1;
+    }
+    for (i = 0; i < length; i++)
+    {
+        token = 0;
+        if (length - i >= 7 && memcmp(directory + i, "$ORIGIN", 7) == 0)
+        {
+            token = 7;
+        }
+        else if (length - i >= 9 && memcmp(directory + i, "${ORIGIN}", 9) == 0)
+        {
+            token = 9;
+        }
+        if (token != 0)
+        {
+            if (used + origin_length >= ELF64_LIBRARY_PATH_LENGTH)
+            {
+                return STATUS_BAD_FILE;
+            }
+            memcpy(buffer + used, origin, origin_length);
+            used += origin_length;
+            i += token - 1;
+            continue;
+        }
+        if (used + 1 >= ELF64_LIBRARY_PATH_LENGTH)
+        {
+            return STATUS_BAD_FILE;
+        }
+        buffer[used++] = directory[i];
+    }
+    if (used + 1 + soname_length >= ELF64_LIBRARY_PATH_LENGTH)
+    {
+        return STATUS_BAD_FILE;
+    }
+    buffer[used++] = '/';
+    memcpy(buffer + used, soname, soname_length + 1);
+    return prim_file_exists(buffer);
+}
+
+/**
+ * Check for a library in each directory of a colon separated list.
+ *
+ * @param list The directories to check, in order.
+ * @param origin The directory containing the requesting image.
+ * @param origin_length The length of `origin`.
+ * @param soname The library to look for.
+ * @param buffer Location to build the library's path.
+ * @return `STATUS_OKAY` if the library is found, `STATUS_BAD_FILE` otherwise.
+ */
+static PrimStatus elf64_resolver_try_list(const char* list,
+    const char* origin, prim_usize origin_length, const char* soname,
+    char* buffer)
+{
+    const char* separator = NULL;
+    for (;;)
+    {
+        separator = strchr(list, ':');
+        if (separator == NULL)
+        {
+            separator = list + strlen(list);
+        }
+        if (elf64_resolver_try_directory(list, separator - list, origin,
+                origin_length, soname, buffer)
+            == STATUS_OKAY)
+        {
+            return STATUS_OKAY;
+        }
+        if (*separator == '\0')
+        {
+            return STATUS_BAD_FILE;
+        }
+        list = separator + 1;
+    }
+}
+
+/**
+ * Get a string from the first dynamic table entry with a given tag.
+ *
+ * @param table The dynamic table to search.
+ * @param tag The tag to find.
+ * @return The entry's string, or `NULL` if there is no valid entry.
+ */
+static const char* elf64_resolver_get_dynamic_string(
+    const Elf64_Dynamic_Table* table, Elf64_Dynamic_Tag tag)
+{
+    const Elf64_Dynamic* entry = NULL;
+    const char* string = NULL;
+    if (elf64_dynamic_table_find(table, tag, &entry) != STATUS_OKAY
+        || elf64_dynamic_table_get_string(table, entry, &string)
+            != STATUS_OKAY)
+    {
+        return NULL;
+    }
+    return string;
+}
+
+/**
+ * Check whether a search list expands `$ORIGIN`.
+ *
+ * @param list The colon separated directories.
+ * @return Non-zero if a directory refers to the requesting image's
+ * directory.
+ */
+static int elf64_resolver_uses_origin(const char* list)
+{
+    return strstr(list, "$ORIGIN") != NULL || strstr(list, "${ORIGIN}") != NULL;
+}
+
+/**
+ * Search for a needed library, consulting and updating a cache.
+ *
+ * The requesting image's `ELF64_DT_RPATH` and `ELF64_DT_RUNPATH` are always
+ * searched, because they differ between images. The rest of the search,
+ * `LD_LIBRARY_PATH` and the system library directories, is the same for
+ * every image, so only its results are cached, as `ld.so.cache` caches the
+ * system directories. `LD_LIBRARY_PATH` is searched before an image's
+ * `ELF64_DT_RUNPATH`, so it is searched again afterwards on a cache miss.
+ *
+ * @param cache The cache to consult, or `NULL` to always search.
+ * @param requester The image which needs the library.
+ * @param requester_path The path `requester` was loaded from, used to
+ * expand `$ORIGIN`.
+ * @param soname The needed library, from an `ELF64_DT_NEEDED` entry.
+ * @param buffer Location to build the library's path.
+ * @return `STATUS_OKAY` if the library is found, `STATUS_BAD_FILE` if it is
+ * not, otherwise an error code.
+ */
+static PrimStatus elf64_resolver_search(Elf64_Library_Cache* cache,
+    Elf64_Image* requester, const char* requester_path, const char* soname,
+    char* buffer)
+{
+    PrimStatus status = STATUS_BAD_FILE;
+    const Elf64_Dynamic_Table* table = NULL;
+    const char* runpath = NULL;
+    const char* rpath = NULL;
+    const char* search_path = prim_get_environment("LD_LIBRARY_PATH");
+    const char* origin = requester_path;
+    const char* cached = NULL;
+    prim_usize origin_length = 0;
+    unsigned int i = 0;
+    /* A name with a slash is a path, and is not searched for. */
+    if (strchr(soname, '/') != NULL)
+    {
+        if (strlen(soname) >= ELF64_LIBRARY_PATH_LENGTH)
+        {
+            return STATUS_BAD_FILE;
+        }
+        strcpy(buffer, soname);
+        return prim_file_exists(buffer);
+    }
+    if (strrchr(requester_path, '/') != NULL)
+    {
+        origin_length = strrchr(requester_path, '/') - requester_path;
+    }
+    else
+    {
+        origin = ".";
+        origin_length = 1;
+    }
+    if (elf64_image_get_dynamic_table(requester, &table) == STATUS_OKAY)
+    {
+        runpath = elf64_resolver_get_dynamic_string(table, ELF64_DT_RUNPATH);
+        rpath = elf64_resolver_get_dynamic_string(table, ELF64_DT_RPATH);
+    }
+    if (runpath == NULL && rpath != NULL)
+    {
+        status = elf64_resolver_try_list(
+            rpath, origin, origin_length, soname, buffer);
+    }
+    if (status != STATUS_OKAY && runpath != NULL)
+    {
+        if (search_path != NULL)
+        {
+            status = elf64_resolver_try_list(
+                search_path, origin, origin_length, soname, buffer);
+        }
+        if (status != STATUS_OKAY)
+        {
+            status = elf64_resolver_try_list(
+                runpath, origin, origin_length, soname, buffer);
+        }
+    }
+    if (status == STATUS_OKAY)
+    {
+        return status;
+    }
+    /* Results found through `$ORIGIN` hold only for the requesting image. */
+    if (search_path != NULL && elf64_resolver_uses_origin(search_path))
+    {
+        cache = NULL;
+    }
+    if (cache != NULL
+        && elf64_library_cache_lookup(cache, soname, &cached) == STATUS_OKAY
+        && strlen(cached) < ELF64_LIBRARY_PATH_LENGTH)
+    {
+        strcpy(buffer, cached);
+        return STATUS_OKAY;
+    }
+    if (search_path != NULL)
+    {
+        status = elf64_resolver_try_list(
+            search_path, origin, origin_length, soname, buffer);
+    }
+    for (i = 0; status != STATUS_OKAY
+         && i < sizeof(system_directories) / sizeof(system_directories[0]);
+         i++)
+    {
+        status = elf64_resolver_try_directory(system_directories[i],
+            strlen(system_directories[i]), origin, origin_length, soname,
+            buffer);
+    }
+    /* Only libraries found are cached, so those installed later are found. */
+    if (status == STATUS_OKAY && cache != NULL)
+    {
+        elf64_library_cache_insert(cache, soname, buffer);
+    }
+    return status;
+}
+
+/**
+ * Search the filesystem for a needed library, ignoring any cache.
+ *
+ * @param requester The image which needs the library.
+ * @param requester_path The path `requester` was loaded from, used to
+ * expand `$ORIGIN`.
+ * @param soname The needed library, from an `ELF64_DT_NEEDED` entry.
+ * @param buffer Location to build the library's path, at least
+ * `ELF64_LIBRARY_PATH_LENGTH` bytes long.
+ * @return STATUS_OKAY if the library is found, STATUS_BAD_FILE if it is not,
+ * otherwise an error code.
+ */
+extern PrimStatus elf64_search_library(Elf64_Image* requester,
+    const char* requester_path, const char* soname, char* buffer)
+{
+    return elf64_resolver_search(
+        NULL, requester, requester_path, soname, buffer);
+}
+
+/**
+ * Find a needed library, consulting and updating a cache.
+ *
+ * Only the part of the search shared by every requesting image is cached:
+ * `LD_LIBRARY_PATH` and the system library directories. The requester's
+ * `ELF64_DT_RPATH` and `ELF64_DT_RUNPATH` are always searched first.
+ *
+ * @param cache The cache to consult, or `NULL` to always search.
+ * @param requester The image which needs the library.
+ * @param requester_path The path `requester` was loaded from, used to
+ * expand `$ORIGIN`.
+ * @param soname The needed library, from an `ELF64_DT_NEEDED` entry.
+ * @param buffer Location to build the library's path, at least
+ * `ELF64_LIBRARY_PATH_LENGTH` bytes long.
+ * @return STATUS_OKAY if the library is found, STATUS_BAD_FILE if it is not,
+ * otherwise an error code.
+ */
+extern PrimStatus elf64_resolve_library(Elf64_Library_Cache* cache,
+    Elf64_Image* requester, const char* requester_path, const char* soname,
+    char* buffer)
+{
+    PrimStatus status = STATUS_ERROR;
+    PRIM_STATS_PHASE_BEGIN(timer);
+    status = elf64_resolver_search(
+        cache, requester, requester_path, soname, buffer);
+    PRIM_STATS_PHASE_END(timer, PRIM_PHASE_RESOLVE);
+    return status;
+}
@@ -0,0 +1,634 @@
+/**
+ * @file src/loader/snapshot.c
+ *
+ * Implements saving and restoring relocated link maps.
+ *
+ * A snapshot file holds a header, an image record per link map entry, the
+ * saved page ranges, and a string table. The ranges' contents follow,
+ * starting at the next page boundary, so each can be mapped straight from
+ * the file.
+ *
+ * @see `include/loader/snapshot.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "loader/snapshot.h"
+#include "format/elf64/image.h"
+#include "format/elf64/section/dynamic.h"
+#include "format/elf64/segment/flags.h"
+#include "format/elf64/segment/header.h"
+#include "format/elf64/segment/type.h"
+#include "loader/link_map.h"
+#include "loader/loader.h"
+#include "loader/relocate.h"
+#include "platform/exec.h"
+#include "platform/file.h"
+#include "platform/mapping.h"
+#include "platform/memory.h"
+#include "platform/process.h"
+#include "platform/types.h"
+#include "status.h"
+#include <string.h>
+
+/** The `ELF64_LOAD_*` flags which change the contents of a snapshot. */
+#define ELF64_SNAPSHOT_FLAGS (ELF64_LOAD_RELOCATE | ELF64_LOAD_BIND_NOW)
+
+/** Ranges of a snapshot being saved. */
+typedef struct
+{
+    /** The ranges. */
+    Elf64_Snapshot_Range* ranges;
+
+    /** Number of ranges in `ranges`. */
+    prim_usize count;
+
+    /** Number of ranges `ranges` has room for. */
+    prim_usize capacity;
+
+    /** Total length of the ranges' contents, in bytes. */
+    prim_usize size;
+} Elf64_Snapshot_Ranges;
+
+/**
+ * Round a value up to a multiple of the page size.
+ *
+ * @param value The value to round.
+ * @return The rounded value.
+ */
+static prim_usize elf64_snapshot_page_up(const prim_usize value)
+{
+    prim_usize page_size = prim_map_page_size();
+    return (value + page_size - 1) & ~(page_size - 1);
+}
+
+/**
+ * Get the `LD_LIBRARY_PATH` a snapshot is saved and restored under.
+ *
+ * @return The search path, or an empty string if it is not set.
+ */
+static const char* elf64_snapshot_get_search_path(void)
+{
+    const char* search_path = prim_get_environment("LD_LIBRARY_PATH");
+    return search_path != NULL ? search_path : "";
+}
+
+/**
+ * Read the processor capabilities which select IFUNC implementations.
+ *
+ * @param hardware Location to return `AT_HWCAP` and `AT_HWCAP2`.
+ */
+static void elf64_snapshot_get_hardware(prim_u64 hardware[2])
+{
+    hardware[0] = prim_exec_get_auxiliary(PRIM_AT_HWCAP);
+    hardware[1] = prim_exec_get_auxiliary(PRIM_AT_HWCAP2);
+}
+
+/**
+ * Check a string table offset names a terminated string.
+ *
+ * @param snapshot The snapshot being opened.
+ * @param offset The offset to check.
+ * @return STATUS_OKAY if it does, STATUS_INVALID otherwise.
+ */
+static PrimStatus elf64_snapshot_check_string(
+    const Elf64_Snapshot* snapshot, const prim_u64 offset)
+{
+    prim_u64 size = snapshot->header->strings_size;
+    if (offset >= size
+        || memchr(snapshot->strings + offset, '\0', size - offset) == NULL)
+    {
+        return STATUS_INVALID;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Check a snapshot's records are well formed, and its fingerprint holds.
+ *
+ * @param snapshot The snapshot being opened.
+ * @param executable The executable being loaded.
+ * @param flags The `ELF64_LOAD_*` flags the link map is being loaded with.
+ * @return STATUS_OKAY if the snapshot can be restored, STATUS_INVALID
+ * otherwise.
+ */
+static PrimStatus elf64_snapshot_check(const Elf64_Snapshot* snapshot,
+    const char* executable, const prim_u32 flags)
+{
+    const Elf64_Snapshot_Header* header = snapshot->header;
+    const Elf64_Snapshot_Image* image = NULL;
+    const Elf64_Snapshot_Range* range = NULL;
+    PrimFileIdentity identity;
+    prim_u64 hardware[2] = { 0, 0 };
+    prim_usize i = 0;
+    elf64_snapshot_get_hardware(hardware);
+    if (header->version != ELF64_SNAPSHOT_VERSION
+        || header->flags != (flags & ELF64_SNAPSHOT_FLAGS)
+        || header->hardware[0] != hardware[0]
+        || header->hardware[1] != hardware[1] || header->image_count == 0
+        || elf64_snapshot_check_string(snapshot, 0) != STATUS_OKAY
+        || strcmp(snapshot->strings, elf64_snapshot_get_search_path()) != 0)
+    {
+        return STATUS_INVALID;
+    }
+    for (i = 0; i < header->image_count; i++)
+    {
+        image = &snapshot->images[i];
+        if (elf64_snapshot_check_string(snapshot, image->path) != STATUS_OKAY
+            || (i != 0 && image->requester >= i)
+            || prim_file_identity(snapshot->strings + image->path, &identity)
+                != STATUS_OKAY
+            || memcmp(&identity, &image->identity, sizeof(PrimFileIdentity))
+                != 0)
+        {
+            return STATUS_INVALID;
+        }
+    }
+    if (strcmp(elf64_snapshot_get_path(snapshot, 0), executable) != 0)
+    {
+        return STATUS_INVALID;
+    }
+    for (i = 0; i < header->range_count; i++)
+    {
+        range = &snapshot->ranges[i];
+        if (range->image >= header->image_count
+            || range->offset % prim_map_page_size() != 0
+            || range->offset > snapshot->mapping.size
+            || range->size > snapshot->mapping.size - range->offset)
+        {
+            return STATUS_INVALID;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Open a snapshot, and check its fingerprint still holds.
+ *
+ * @param snapshot Location to return the opened snapshot.
+ * @param path The snapshot file.
+ * @param executable The executable being loaded.
+ * @param flags The `ELF64_LOAD_*` flags the link map is being loaded with.
+ * @return STATUS_OKAY if the snapshot can be restored, STATUS_INVALID if it
+ * is malformed or out of date, otherwise an error code. Nothing is left open
+ * on failure.
+ */
+extern PrimStatus elf64_snapshot_open(Elf64_Snapshot* snapshot,
+    const char* path, const char* executable, const prim_u32 flags)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Snapshot_Header* header = NULL;
+    prim_usize size = 0;
+    memset(snapshot, 0, sizeof(Elf64_Snapshot));
+    status = prim_map_file(path, &snapshot->mapping);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    header = (const Elf64_Snapshot_Header*) snapshot->mapping.data;
+    if (snapshot->mapping.size < sizeof(Elf64_Snapshot_Header)
+        || memcmp(header->magic, ELF64_SNAPSHOT_MAGIC, sizeof(header->magic))
+            != 0)
+    {
+        elf64_snapshot_close(snapshot);
+        return STATUS_INVALID;
+    }
+    /* Bound each count by the file size before multiplying. */
+    size = snapshot->mapping.size;
+    if (header->image_count > size / sizeof(Elf64_Snapshot_Image)
+        || header->range_count > size / sizeof(Elf64_Snapshot_Range)
+        || header->strings_size > size
+        || sizeof(Elf64_Snapshot_Header)
+                + header->image_count * sizeof(Elf64_Snapshot_Image)
+                + header->range_count * sizeof(Elf64_Snapshot_Range)
+                + header->strings_size
+            > size)
+    {
+        elf64_snapshot_close(snapshot);
+        return STATUS_INVALID;
+    }
+    snapshot->header = header;
+    snapshot->images = (const Elf64_Snapshot_Image*) (header + 1);
+    snapshot->ranges = (const Elf64_Snapshot_Range*) (snapshot->images
+        + header->image_count);
+    snapshot->strings
+        = (const char*) (snapshot->ranges + header->range_count);
+    status = elf64_snapshot_check(snapshot, executable, flags);
+    if (status != STATUS_OKAY)
+    {
+        elf64_snapshot_close(snapshot);
+    }
+    return status;
+}
+
+/**
+ * Get the path of an image in an open snapshot.
+ *
+ * @param snapshot The snapshot.
+ * @param index Index of the image.
+ * @return The image's path.
+ */
+extern const char* elf64_snapshot_get_path(
+    const Elf64_Snapshot* snapshot, const prim_usize index)
+{
+    return snapshot->strings + snapshot->images[index].path;
+}
+
+/**
+ * Map a snapshot's saved pages over the images of a link map, in place of
+ * relocating them, then make each image's `PT_GNU_RELRO` segments read only.
+ *
+ * @param snapshot The snapshot.
+ * @param map The link map, with every image loaded at its snapshot's base.
+ * @return STATUS_OKAY on success, STATUS_INVALID if a range lies outside its
+ * image, otherwise an error code.
+ */
+extern PrimStatus elf64_snapshot_apply(
+    const Elf64_Snapshot* snapshot, Elf64_Link_Map* map)
+{
+    PrimStatus status = STATUS_OKAY;
+    const Elf64_Snapshot_Range* range = NULL;
+    const Elf64_Loaded_Image* loaded = NULL;
+    prim_usize start = 0;
+    prim_usize i = 0;
+    for (i = 0; i < snapshot->header->range_count; i++)
+    {
+        range = &snapshot->ranges[i];
+        if (range->image >= map->count)
+        {
+            return STATUS_INVALID;
+        }
+        loaded = map->entries[range->image].loaded;
+        start = (prim_usize) loaded->base;
+        if (range->address < start || range->address > start + loaded->size
+            || range->size > start + loaded->size - range->address)
+        {
+            return STATUS_INVALID;
+        }
+        status = prim_map_file_range(&snapshot->mapping, range->offset,
+            (void*) (prim_usize) range->address, range->size,
+            (prim_u32) range->protection);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+    }
+    for (i = 0; i < map->count && status == STATUS_OKAY; i++)
+    {
+        status = elf64_protect_relro(map->entries[i].loaded);
+    }
+    return status;
+}
+
+/**
+ * Close a snapshot. Pages already mapped by `elf64_snapshot_apply` stay
+ * mapped.
+ *
+ * @param snapshot The snapshot to close.
+ */
+extern void elf64_snapshot_close(Elf64_Snapshot* snapshot)
+{
+    prim_unmap_file(&snapshot->mapping);
+    memset(snapshot, 0, sizeof(Elf64_Snapshot));
+}
+
+/**
+ * Add a range of pages to a snapshot being saved.
+ *
+ * @param ranges The ranges to add to.
+ * @param image Index of the image the pages belong to.
+ * @param start Address of the first page.
+ * @param end Address after the last page.
+ * @param protection The pages' `PRIM_PROTECT_*` access rights.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_snapshot_add_range(Elf64_Snapshot_Ranges* ranges,
+    const prim_usize image, const prim_usize start, const prim_usize end,
+    const prim_u32 protection)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Snapshot_Range* grown = NULL;
+    Elf64_Snapshot_Range* range = NULL;
+    if (ranges->count == ranges->capacity)
+    {
+        ranges->capacity = ranges->capacity == 0 ? 16 : ranges->capacity * 2;
+        status = prim_malloc((void**) &grown,
+            ranges->capacity * sizeof(Elf64_Snapshot_Range));
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        if (ranges->ranges != NULL)
+        {
+            memcpy(grown, ranges->ranges,
+                ranges->count * sizeof(Elf64_Snapshot_Range));
+            prim_free(ranges->ranges);
+        }
+        ranges->ranges = grown;
+    }
+    range = &ranges->ranges[ranges->count];
+    range->image = image;
+    range->address = start;
+    range->size = end - start;
+    range->offset = ranges->size;
+    range->protection = protection;
+    ranges->size += end - start;
+    ranges->count++;
+    return STATUS_OKAY;
+}
+
+/**
+ * Check if a page holds only zero bytes.
+ *
+ * @param page The page.
+ * @return Non-zero if it does.
+ */
+static int elf64_snapshot_is_zero_page(const prim_usize page)
+{
+    const prim_usize* word = (const prim_usize*) page;
+    prim_usize count = prim_map_page_size() / sizeof(prim_usize);
+    prim_usize i = 0;
+    for (i = 0; i < count; i++)
+    {
+        if (word[i] != 0)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Add the pages of an image's writable segments to a snapshot being saved.
+ *
+ * Pages backed by the file are always saved. Zero filled pages past the end
+ * of the file are only saved if relocation wrote to them, for example to
+ * hold a copy relocation.
+ *
+ * @param ranges The ranges to add to.
+ * @param loaded The relocated image.
+ * @param image Index of the image in its link map.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_snapshot_add_image(Elf64_Snapshot_Ranges* ranges,
+    Elf64_Loaded_Image* loaded, const prim_usize image)
+{
+    PrimStatus status = STATUS_OKAY;
+    const Elf64_Segment_Header* segment = NULL;
+    prim_usize page_size = prim_map_page_size();
+    prim_usize start = 0;
+    prim_usize file_end = 0;
+    prim_usize end = 0;
+    prim_usize run = 0;
+    prim_usize page = 0;
+    prim_u32 protection = 0;
+    Elf64_Word index = 0;
+    for (index = 0; index < loaded->image.header->ph_entry_count; index++)
+    {
+        elf64_image_get_segment_header(&loaded->image, index, &segment);
+        if (elf64_get_segment_type(segment) != ELF64_PT_LOAD
+            || !(elf64_get_segment_flags(segment) & ELF64_PF_W))
+        {
+            continue;
+        }
+        protection
+            = elf64_get_segment_protection(elf64_get_segment_flags(segment));
+        start = (segment->p_vaddr + loaded->bias) & ~(page_size - 1);
+        file_end = elf64_snapshot_page_up(
+            segment->p_vaddr + loaded->bias + segment->p_filesz);
+        end = elf64_snapshot_page_up(
+            segment->p_vaddr + loaded->bias + segment->p_memsz);
+        if (segment->p_filesz == 0)
+        {
+            file_end = start;
+        }
+        if (file_end > start)
+        {
+            status = elf64_snapshot_add_range(
+                ranges, image, start, file_end, protection);
+        }
+        run = file_end;
+        for (page = file_end; page <= end && status == STATUS_OKAY;
+             page += page_size)
+        {
+            if (page < end && !elf64_snapshot_is_zero_page(page))
+            {
+                continue;
+            }
+            if (page > run)
+            {
+                status = elf64_snapshot_add_range(
+                    ranges, image, run, page, protection);
+            }
+            run = page + page_size;
+        }
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Find the `ELF64_DT_NEEDED` entry an image was needed by.
+ *
+ * @param map The link map.
+ * @param entry Index of the needed image.
+ * @param result Location to return the index of the requester's dynamic
+ * table entry.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if no entry names the
+ * image.
+ */
+static PrimStatus elf64_snapshot_find_needed(
+    const Elf64_Link_Map* map, const prim_usize entry, prim_u64* result)
+{
+    const Elf64_Link_Map_Entry* needed = &map->entries[entry];
+    const Elf64_Dynamic_Table* table = NULL;
+    const char* name = NULL;
+    Elf64_Word index = 0;
+    *result = 0;
+    if (entry == 0)
+    {
+        return STATUS_OKAY;
+    }
+    if (elf64_image_get_dynamic_table(
+            &map->entries[needed->requester].loaded->image, &table)
+        != STATUS_OKAY)
+    {
+        return STATUS_INVALID;
+    }
+    for (index = 0; index < table->count; index++)
+    {
+        if (elf64_get_dynamic_tag(&table->entries[index]) == ELF64_DT_NEEDED
+            && elf64_dynamic_table_get_string(
+                   table, &table->entries[index], &name)
+                == STATUS_OKAY
+            && strcmp(name, needed->name) == 0)
+        {
+            *result = index;
+            return STATUS_OKAY;
+        }
+    }
+    return STATUS_INVALID;
+}
+
+/**
+ * Write a snapshot's records, string table and page contents to a file.
+ *
+ * @param file The file to write.
+ * @param map The link map being saved.
+ * @param header The snapshot's header.
+ * @param images The snapshot's image records.
+ * @param ranges The snapshot's ranges, with offsets relative to the start of
+ * the contents.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_snapshot_write(prim_file_handle file,
+    const Elf64_Link_Map* map, const Elf64_Snapshot_Header* header,
+    const Elf64_Snapshot_Image* images, const Elf64_Snapshot_Ranges* ranges)
+{
+    PrimStatus status = STATUS_ERROR;
+    const char* search_path = elf64_snapshot_get_search_path();
+    prim_usize written = 0;
+    prim_usize padding = 0;
+    prim_usize i = 0;
+    status = prim_fwrite(header, sizeof(Elf64_Snapshot_Header), 1, file);
+    if (status == STATUS_OKAY)
+    {
+        status = prim_fwrite(
+            images, sizeof(Elf64_Snapshot_Image), map->count, file);
+    }
+    if (status == STATUS_OKAY && ranges->count != 0)
+    {
+        status = prim_fwrite(
+            ranges->ranges, sizeof(Elf64_Snapshot_Range), ranges->count, file);
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = prim_fwrite(search_path, 1, strlen(search_path) + 1, file);
+    }
+    for (i = 0; i < map->count && status == STATUS_OKAY; i++)
+    {
+        status = prim_fwrite(
+            map->entries[i].path, 1, strlen(map->entries[i].path) + 1, file);
+    }
+    written = sizeof(Elf64_Snapshot_Header)
+        + map->count * sizeof(Elf64_Snapshot_Image)
+        + ranges->count * sizeof(Elf64_Snapshot_Range) + header->strings_size;
+    padding = elf64_snapshot_page_up(written) - written;
+    for (i = 0; i < padding && status == STATUS_OKAY; i++)
+    {
+        status = prim_fwrite("", 1, 1, file);
+    }
+    for (i = 0; i < ranges->count && status == STATUS_OKAY; i++)
+    {
+        status = prim_fwrite(
+            (const void*) (prim_usize) ranges->ranges[i].address, 1,
+            ranges->ranges[i].size, file);
+    }
+    return status;
+}
+
+/**
+ * Save a freshly relocated link map to a snapshot file.
+ *
+ * The file is written beside `path` and then renamed over it, so processes
+ * with an older snapshot mapped keep a consistent copy.
+ *
+ * @param map The link map, relocated but not yet run.
+ * @param path The snapshot file to write.
+ * @param flags The `ELF64_LOAD_*` flags the link map was loaded with.
+ * @return STATUS_OKAY on success, STATUS_INVALID if an image can not be
+ * described by a snapshot, otherwise an error code.
+ */
+extern PrimStatus elf64_snapshot_save(
+    const Elf64_Link_Map* map, const char* path, const prim_u32 flags)
+{
+    PrimStatus status = STATUS_ERROR;
+    PrimStatus close_status = STATUS_ERROR;
+    Elf64_Snapshot_Header header;
+    Elf64_Snapshot_Image* images = NULL;
+    Elf64_Snapshot_Ranges ranges = { NULL, 0, 0, 0 };
+    prim_file_handle file;
+    char* temporary = NULL;
+    prim_usize strings = 0;
+    prim_usize contents = 0;
+    prim_usize i = 0;
+    memset(&header, 0, sizeof(Elf64_Snapshot_Header));
+    memcpy(header.magic, ELF64_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = ELF64_SNAPSHOT_VERSION;
+    header.flags = flags & ELF64_SNAPSHOT_FLAGS;
+    elf64_snapshot_get_hardware(header.hardware);
+    header.image_count = map->count;
+    status = prim_malloc(
+        (void**) &images, map->count * sizeof(Elf64_Snapshot_Image));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(images, 0, map->count * sizeof(Elf64_Snapshot_Image));
+    strings = strlen(elf64_snapshot_get_search_path()) + 1;
+    for (i = 0; i < map->count && status == STATUS_OKAY; i++)
+    {
+        images[i].base = (prim_usize) map->entries[i].loaded->base;
+        images[i].requester = map->entries[i].requester;
+        images[i].path = strings;
+        strings += strlen(map->entries[i].path) + 1;
+        status = prim_file_identity(map->entries[i].path, &images[i].identity);
+        if (status == STATUS_OKAY)
+        {
+            status = elf64_snapshot_find_needed(map, i, &images[i].needed);
+        }
+        if (status == STATUS_OKAY)
+        {
+            status = elf64_snapshot_add_image(
+                &ranges, map->entries[i].loaded, i);
+        }
+    }
+    header.range_count = ranges.count;
+    header.strings_size = strings;
+    contents = elf64_snapshot_page_up(sizeof(Elf64_Snapshot_Header)
+        + map->count * sizeof(Elf64_Snapshot_Image)
+        + ranges.count * sizeof(Elf64_Snapshot_Range) + strings);
+    for (i = 0; i < ranges.count; i++)
+    {
+        ranges.ranges[i].offset += contents;
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = prim_malloc((void**) &temporary, strlen(path) + 5);
+    }
+    if (status == STATUS_OKAY)
+    {
+        strcpy(temporary, path);
+        strcat(temporary, ".new");
+        status = prim_fcreate(temporary, &file);
+        if (status == STATUS_OKAY)
+        {
+            status = elf64_snapshot_write(file, map, &header, images, &ranges);
+            close_status = prim_fclose(file);
+            if (status == STATUS_OKAY)
+            {
+                status = close_status;
+            }
+            if (status == STATUS_OKAY)
+            {
+                status = prim_frename(temporary, path);
+            }
+            if (status != STATUS_OKAY)
+            {
+                prim_fremove(temporary);
+            }
+        }
+        prim_free(temporary);
+    }
+    if (ranges.ranges != NULL)
+    {
+        prim_free(ranges.ranges);
+    }
+    prim_free(images);
+    return status;
+}
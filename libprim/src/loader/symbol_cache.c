@@ -0,0 +1,193 @@
+/**
+ * @file src/loader/symbol_cache.c
+ *
+ * Implements the cache of symbol definitions found in a link map.
+ *
+ * @see `include/loader/symbol_cache.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "loader/symbol_cache.h"
+#include "format/elf64/section/symbol.h"
+#include "format/elf64/types.h"
+#include "platform/memory.h"
+#include "platform/thread.h"
+#include "platform/types.h"
+#include "status.h"
+#include <string.h>
+
+/** Smallest number of slots in a non-empty symbol cache. */
+#define ELF64_SYMBOL_CACHE_MINIMUM_SIZE 256
+
+/**
+ * Find the slot holding a lookup, or the empty slot it would be stored in.
+ *
+ * @param cache The cache to search. Must have at least one empty slot.
+ * @param name The symbol name to find.
+ * @param hash The GNU hash of `name`.
+ * @param version The version ID the lookup requires.
+ * @param first Index of the first link map entry the lookup searches.
+ * @return The index of the slot.
+ */
+static prim_usize elf64_symbol_cache_find_slot(const Elf64_Symbol_Cache* cache,
+    const char* name, const Elf64_Word hash, const prim_u32 version,
+    const prim_usize first)
+{
+    const Elf64_Symbol_Cache_Entry* entry = NULL;
+    prim_usize mask = cache->size - 1;
+    prim_usize slot = (hash + version + first) & mask;
+    for (;;)
+    {
+        entry = &cache->entries[slot];
+        /* Compare the hash first, so most mismatches skip the string. */
+        if (entry->name == NULL
+            || (entry->hash == hash && entry->version == version
+                && entry->first == first && strcmp(entry->name, name) == 0))
+        {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+/**
+ * Double the number of slots in a symbol cache, re-inserting every entry.
+ * The caller must hold the cache's lock.
+ *
+ * @param cache The cache to grow.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_symbol_cache_grow(Elf64_Symbol_Cache* cache)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Symbol_Cache grown;
+    const Elf64_Symbol_Cache_Entry* entry = NULL;
+    prim_usize slot = 0;
+    prim_usize i = 0;
+    memset(&grown, 0, sizeof(Elf64_Symbol_Cache));
+    grown.size = cache->size * 2;
+    if (grown.size < ELF64_SYMBOL_CACHE_MINIMUM_SIZE)
+    {
+        grown.size = ELF64_SYMBOL_CACHE_MINIMUM_SIZE;
+    }
+    status = prim_malloc((void**) &grown.entries,
+        grown.size * sizeof(Elf64_Symbol_Cache_Entry));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(grown.entries, 0, grown.size * sizeof(Elf64_Symbol_Cache_Entry));
+    for (i = 0; i < cache->size; i++)
+    {
+        entry = &cache->entries[i];
+        if (entry->name == NULL)
+        {
+            continue;
+        }
+        slot = elf64_symbol_cache_find_slot(
+            &grown, entry->name, entry->hash, entry->version, entry->first);
+        grown.entries[slot] = *entry;
+    }
+    if (cache->entries != NULL)
+    {
+        prim_free(cache->entries);
+    }
+    cache->entries = grown.entries;
+    cache->size = grown.size;
+    return STATUS_OKAY;
+}
+
+/**
+ * Initialise an empty symbol cache.
+ *
+ * @param cache The cache to initialise.
+ */
+extern void elf64_symbol_cache_init(Elf64_Symbol_Cache* cache)
+{
+    memset(cache, 0, sizeof(Elf64_Symbol_Cache));
+}
+
+/**
+ * Release a symbol cache.
+ *
+ * @param cache The cache to destroy.
+ */
+extern void elf64_symbol_cache_destroy(Elf64_Symbol_Cache* cache)
+{
+    if (cache->entries != NULL)
+    {
+        prim_free(cache->entries);
+    }
+    memset(cache, 0, sizeof(Elf64_Symbol_Cache));
+}
+
+/**
+ * Look up a symbol in a symbol cache.
+ *
+ * @param cache The cache to search.
+ * @param name The symbol name to look up.
+ * @param hash The GNU hash of `name`.
+ * @param version The version ID the lookup requires, or
+ * `ELF64_VERSION_ID_NONE`.
+ * @param first Index of the first link map entry the lookup searches.
+ * @param result Location to copy the cached definition to.
+ * @return STATUS_OKAY if the symbol is cached, STATUS_INVALID otherwise.
+ */
+extern PrimStatus elf64_symbol_cache_lookup(Elf64_Symbol_Cache* cache,
+    const char* name, const Elf64_Word hash, const prim_u32 version,
+    const prim_usize first, Elf64_Symbol_Cache_Entry* result)
+{
+    PrimStatus status = STATUS_INVALID;
+    const Elf64_Symbol_Cache_Entry* entry = NULL;
+    prim_lock_acquire(&cache->lock);
+    if (cache->size != 0)
+    {
+        entry = &cache->entries[elf64_symbol_cache_find_slot(
+            cache, name, hash, version, first)];
+        if (entry->name != NULL)
+        {
+            *result = *entry;
+            status = STATUS_OKAY;
+        }
+    }
+    prim_lock_release(&cache->lock);
+    return status;
+}
+
+/**
+ * Remember the definition a symbol lookup found.
+ *
+ * @note The entry's name is not copied. It must outlive the cache, which it
+ * does if it is the defining image's name for the symbol.
+ *
+ * @param cache The cache to update.
+ * @param entry The lookup and its definition.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_symbol_cache_insert(
+    Elf64_Symbol_Cache* cache, const Elf64_Symbol_Cache_Entry* entry)
+{
+    PrimStatus status = STATUS_OKAY;
+    prim_usize slot = 0;
+    prim_lock_acquire(&cache->lock);
+    /* Keep the table at most half full, so probe sequences stay short. */
+    if (2 * (cache->count + 1) > cache->size)
+    {
+        status = elf64_symbol_cache_grow(cache);
+    }
+    if (status == STATUS_OKAY)
+    {
+        slot = elf64_symbol_cache_find_slot(
+            cache, entry->name, entry->hash, entry->version, entry->first);
+        if (cache->entries[slot].name == NULL)
+        {
+            cache->count++;
+        }
+        cache->entries[slot] = *entry;
+    }
+    prim_lock_release(&cache->lock);
+    return status;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file src/loader/tls.c
+ *
+ * Implements static TLS layout and the pooled TLS block allocator.
+ *
+ * @see `include/loader/tls.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "loader/tls.h"
+#include "platform/memory.h"
+#include "platform/types.h"
+#include "status.h"
+#include <string.h>
+
+/**
+ * Round a value up to a multiple of a power of two.
+ *
+ * @param value The value to round.
+ * @param align The power of two.
+ * @return The rounded value.
+ */
+static prim_usize elf64_tls_align_up(prim_usize value, prim_usize align)
+{
+    return (value + align - 1) & ~(align - 1);
+}
+
+/**
+ * Get the word of a TCB which links free blocks.
+ *
+ * The first word is the TCB's self pointer, so the second is used.
+ *
+ * @param thread_pointer The block's thread pointer.
+ * @return The free list link.
+ */
+static void** elf64_tls_free_link(void* thread_pointer)
+{
+    return (void**) thread_pointer + 1;
+}
+
+/**
+ * Allocate another chunk of blocks, and add them to the free list.
+ *
+ * @param tls The layout to grow the pool of.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_tls_grow(Elf64_Tls* tls)
+{
+    PrimStatus status = STATUS_ERROR;
+    prim_u8* chunk = NULL;
+    prim_usize first = 0;
+    prim_usize thread_pointer = 0;
+    unsigned int i = 0;
+    /* Room for the chunk link, and to align the first block. */
+    status = prim_malloc((void**) &chunk,
+        sizeof(void*) + tls->align + ELF64_TLS_POOL_BLOCKS * tls->block_size);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    *(void**) chunk = tls->chunks;
+    tls->chunks = chunk;
+    first = elf64_tls_align_up((prim_usize) chunk + sizeof(void*), tls->align);
+    for (i = 0; i < ELF64_TLS_POOL_BLOCKS; i++)
+    {
+        thread_pointer = first + i * tls->block_size + tls->size;
+        *elf64_tls_free_link((void*) thread_pointer) = tls->free;
+        tls->free = (void*) thread_pointer;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Initialise an empty TLS layout, with no modules.
+ *
+ * @param tls The layout to initialise.
+ */
+extern void elf64_tls_init(Elf64_Tls* tls)
+{
+    memset(tls, 0, sizeof(Elf64_Tls));
+    tls->align = sizeof(void*);
+}
+
+/**
+ * Add an image's TLS segment to a layout.
+ *
+ * Modules must be added in link map order, before the template is built.
+ *
+ * @param tls The layout to add to.
+ * @param size The segment's size in memory.
+ * @param align The segment's alignment. Zero or one for none.
+ * @param address The segment's link time address.
+ * @param offset Location to return the module's block offset below the
+ * thread pointer.
+ * @return The module's ID. Never zero.
+ */
+extern prim_usize elf64_tls_add_module(Elf64_Tls* tls, const prim_usize size,
+    prim_usize align, const prim_usize address, prim_usize* offset)
+{
+    prim_usize first_byte = 0;
+    if (align == 0)
+    {
+        align = 1;
+    }
+    /* Keep the block's address congruent to its link time address. */
+    first_byte = (0 - address) & (align - 1);
+    *offset = elf64_tls_align_up(tls->size + size - first_byte, align)
+        + first_byte;
+    tls->size = *offset;
+    if (align > tls->align)
+    {
+        tls->align = align;
+    }
+    tls->module_count++;
+    return tls->module_count;
+}
+
+/**
+ * Allocate a layout's template, once every module has been added.
+ *
+ * The template starts zero filled. Copy each module's initialisation image
+ * in with `elf64_tls_set_initial`.
+ *
+ * @param tls The layout.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_tls_build_template(Elf64_Tls* tls)
+{
+    PrimStatus status = STATUS_ERROR;
+    tls->size = elf64_tls_align_up(tls->size, tls->align);
+    tls->block_size
+        = elf64_tls_align_up(tls->size + ELF64_TLS_TCB_SIZE, tls->align);
+    if (tls->size == 0)
+    {
+        return STATUS_OKAY;
+    }
+    status = prim_malloc((void**) &tls->initial, tls->size);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(tls->initial, 0, tls->size);
+    return STATUS_OKAY;
+}
+
+/**
+ * Copy a module's initialisation image into a layout's template.
+ *
+ * @param tls The layout.
+ * @param offset The module's block offset below the thread pointer.
+ * @param data The module's initialised TLS data.
+ * @param size Size of `data`, in bytes.
+ */
+extern void elf64_tls_set_initial(Elf64_Tls* tls, const prim_usize offset,
+    const void* data, const prim_usize size)
+{
+    prim_usize start = tls->size - offset;
+    if (size == 0)
+    {
+        return;
+    }
+    memcpy(tls->initial + start, data, size);
+    if (start + size > tls->initialised)
+    {
+        tls->initialised = start + size;
+    }
+}
+
+/**
+ * Allocate and initialise a thread's static TLS block.
+ *
+ * The TCB's first word holds the thread pointer itself, as the ABI requires.
+ * The rest of the TCB is zeroed.
+ *
+ * @param tls The layout to allocate for.
+ * @param result Location to return the block's thread pointer.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_tls_allocate(Elf64_Tls* tls, void** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    prim_u8* thread_pointer = NULL;
+    prim_u8* block = NULL;
+    if (tls->free == NULL)
+    {
+        status = elf64_tls_grow(tls);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+    }
+    thread_pointer = (prim_u8*) tls->free;
+    tls->free = *elf64_tls_free_link(thread_pointer);
+    block = thread_pointer - tls->size;
+    if (tls->initialised != 0)
+    {
+        memcpy(block, tls->initial, tls->initialised);
+    }
+    memset(block + tls->initialised, 0, tls->size - tls->initialised);
+    memset(thread_pointer, 0, ELF64_TLS_TCB_SIZE);
+    *(void**) thread_pointer = thread_pointer;
+    *result = thread_pointer;
+    return STATUS_OKAY;
+}
+
+/**
+ * Return a thread's static TLS block to its pool.
+ *
+ * @param tls The layout the block was allocated for.
+ * @param thread_pointer The block's thread pointer.
+ */
+extern void elf64_tls_release(Elf64_Tls* tls, void* thread_pointer)
+{
+    *elf64_tls_free_link(thread_pointer) = tls->free;
+    tls->free = thread_pointer;
+}
+
+/**
+ * Release a layout's template and every block in its pool.
+ *
+ * @param tls The layout to destroy.
+ */
+extern void elf64_tls_destroy(Elf64_Tls* tls)
+{
+    void* chunk = tls->chunks;
+    void* next = NULL;
+    while (chunk != NULL)
+    {
+        next = *(void**) chunk;
+        prim_free(chunk);
+        chunk = next;
+    }
+    if (tls->initial != NULL)
+    {
+        prim_free(tls->initial);
+    }
+    memset(tls, 0, sizeof(Elf64_Tls));
+}
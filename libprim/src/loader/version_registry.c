@@ -0,0 +1,164 @@
+/**
+ * @file src/loader/version_registry.c
+ *
+ * Implements the link map wide table of symbol version IDs.
+ *
+ * @see `include/loader/version_registry.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "loader/version_registry.h"
+#include "platform/memory.h"
+#include "platform/types.h"
+#include "status.h"
+#include <string.h>
+
+/** Smallest number of slots in a non-empty version registry. */
+#define ELF64_VERSION_REGISTRY_MINIMUM_SIZE 64
+
+/**
+ * Hash a version name.
+ *
+ * @param name The name to hash.
+ * @return The FNV-1a hash of the name.
+ */
+static prim_usize elf64_version_registry_hash(const char* name)
+{
+    prim_u32 hash = 2166136261U;
+    while (*name != '\0')
+    {
+        hash ^= (unsigned char) *name;
+        hash *= 16777619U;
+        name++;
+    }
+    return hash;
+}
+
+/**
+ * Find the slot holding a name, or the empty slot it would be stored in.
+ *
+ * @param registry The registry to search. Must have at least one empty slot.
+ * @param name The name to find.
+ * @return The index of the slot.
+ */
+static prim_usize elf64_version_registry_find_slot(
+    const Elf64_Version_Registry* registry, const char* name)
+{
+    prim_usize mask = registry->size - 1;
+    prim_usize slot = elf64_version_registry_hash(name) & mask;
+    while (registry->entries[slot].name != NULL
+        && strcmp(registry->entries[slot].name, name) != 0)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * Double the number of slots in a version registry, re-inserting every entry.
+ *
+ * @param registry The registry to grow.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus elf64_version_registry_grow(Elf64_Version_Registry* registry)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Version_Registry grown = { NULL, 0, 0 };
+    prim_usize slot = 0;
+    prim_usize i = 0;
+    grown.size = registry->size * 2;
+    if (grown.size < ELF64_VERSION_REGISTRY_MINIMUM_SIZE)
+    {
+        grown.size = ELF64_VERSION_REGISTRY_MINIMUM_SIZE;
+    }
+    status = prim_malloc((void**) &grown.entries,
+        grown.size * sizeof(Elf64_Version_Registry_Entry));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(
+        grown.entries, 0, grown.size * sizeof(Elf64_Version_Registry_Entry));
+    for (i = 0; i < registry->size; i++)
+    {
+        if (registry->entries[i].name == NULL)
+        {
+            continue;
+        }
+        slot = elf64_version_registry_find_slot(
+            &grown, registry->entries[i].name);
+        grown.entries[slot] = registry->entries[i];
+    }
+    grown.count = registry->count;
+    if (registry->entries != NULL)
+    {
+        prim_free(registry->entries);
+    }
+    *registry = grown;
+    return STATUS_OKAY;
+}
+
+/**
+ * Initialise an empty version registry.
+ *
+ * @param registry The registry to initialise.
+ */
+extern void elf64_version_registry_init(Elf64_Version_Registry* registry)
+{
+    memset(registry, 0, sizeof(Elf64_Version_Registry));
+}
+
+/**
+ * Release a version registry.
+ *
+ * @param registry The registry to destroy.
+ */
+extern void elf64_version_registry_destroy(Elf64_Version_Registry* registry)
+{
+    if (registry->entries != NULL)
+    {
+        prim_free(registry->entries);
+    }
+    memset(registry, 0, sizeof(Elf64_Version_Registry));
+}
+
+/**
+ * Get the ID of a version name, giving it the next ID if it has none.
+ *
+ * @note The name is not copied. It must outlive the registry, which it does
+ * if it belongs to an image in the same link map.
+ *
+ * @param registry The registry to update.
+ * @param name The version name.
+ * @param result Location to return the name's ID. Never
+ * `ELF64_VERSION_ID_NONE`.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus elf64_version_registry_intern(
+    Elf64_Version_Registry* registry, const char* name, prim_u32* result)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Version_Registry_Entry* entry = NULL;
+    /* Keep the table at most half full, so probe sequences stay short. */
+    if (2 * (registry->count + 1) > registry->size)
+    {
+        status = elf64_version_registry_grow(registry);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+    }
+    entry = &registry->entries[elf64_version_registry_find_slot(
+        registry, name)];
+    if (entry->name == NULL)
+    {
+        registry->count++;
+        entry->name = name;
+        entry->id = (prim_u32) registry->count;
+    }
+    *result = entry->id;
+    return STATUS_OKAY;
+}
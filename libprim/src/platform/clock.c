@@ -0,0 +1,36 @@
+/**
+ * @file src/platform/clock.c
+ *
+ * Implements access to the host's monotonic clock.
+ *
+ * @note This file is currently setup for a POSIX userspace.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "platform/clock.h"
+#include "platform/types.h"
+#include <time.h>
+
+/** Nanoseconds per second. */
+#define NANOSECONDS_PER_SECOND 1000000000ULL
+
+/**
+ * Read the host's monotonic clock.
+ *
+ * The clock's epoch is unspecified, so readings are only meaningful relative
+ * to each other.
+ *
+ * @return The current time, in nanoseconds.
+ */
+extern prim_u64 prim_clock_now(void)
+{
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (prim_u64) now.tv_sec * NANOSECONDS_PER_SECOND
+        + (prim_u64) now.tv_nsec;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file src/platform/exec.c
+ *
+ * Implements starting a loaded program in the current process.
+ *
+ * @note This file is currently setup for Linux and the AMD64 System V ABI.
+ * Other hosts report userspace exec as unsupported.
+ *
+ * @see `include/platform/exec.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "platform/exec.h"
+#include "platform/types.h"
+#include "status.h"
+#include <unistd.h>
+
+/** The current process's environment. Declared by POSIX, not `unistd.h`. */
+extern char** environ;
+
+#if defined(__x86_64__) && defined(__GNUC__) && defined(__linux__)
+
+#include <sys/auxv.h>
+#include <sys/random.h>
+
+/*
+ * The ABI gives a new process's entry point a stack pointer addressing the
+ * argument count, and %rdx holding a function for `atexit`, or zero. %rbp is
+ * cleared to mark the outermost frame.
+ */
+__asm__(".text\n"
+        ".globl prim_exec_jump\n"
+        ".type prim_exec_jump, @function\n"
+        "prim_exec_jump:\n"
+        "    movq %rsi, %rsp\n"
+        "    xorl %edx, %edx\n"
+        "    xorl %ebp, %ebp\n"
+        "    jmpq *%rdi\n"
+        ".size prim_exec_jump, .-prim_exec_jump\n");
+
+/**
+ * Checks if the host can start programs with `prim_exec_jump`.
+ *
+ * @return `STATUS_OKAY` if it can, `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus prim_exec_is_supported(void)
+{
+    return STATUS_OKAY;
+}
+
+/**
+ * Read an entry of the current process's auxiliary vector.
+ *
+ * @param type The entry's `PRIM_AT_*` type.
+ * @return The entry's value, or zero if the process has no such entry.
+ */
+extern prim_usize prim_exec_get_auxiliary(const prim_usize type)
+{
+    return getauxval(type);
+}
+
+/**
+ * Fill a buffer with random bytes from the host.
+ *
+ * @param buffer The buffer to fill.
+ * @param size Length of the buffer, in bytes.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+extern PrimStatus prim_exec_get_random(void* buffer, const prim_usize size)
+{
+    if (getrandom(buffer, size, 0) != (ssize_t) size)
+    {
+        return STATUS_ERROR;
+    }
+    return STATUS_OKAY;
+}
+
+#else
+
+/**
+ * Switch to a program's initial stack and jump to its entry point. Unused on
+ * this host.
+ *
+ * @param entry The program's entry point.
+ * @param stack The initial stack pointer.
+ */
+extern void prim_exec_jump(void* entry, void* stack)
+{
+    (void) entry;
+    (void) stack;
+}
+
+/**
+ * Checks if the host can start programs with `prim_exec_jump`.
+ *
+ * @return `STATUS_OKAY` if it can, `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus prim_exec_is_supported(void)
+{
+    return STATUS_INVALID;
+}
+
+/**
+ * Read an entry of the current process's auxiliary vector. Unused on this
+ * host.
+ *
+ * @param type The entry's `PRIM_AT_*` type.
+ * @return Zero.
+ */
+extern prim_usize prim_exec_get_auxiliary(const prim_usize type)
+{
+    (void) type;
+    return 0;
+}
+
+/**
+ * Fill a buffer with random bytes from the host. Unused on this host.
+ *
+ * @param buffer The buffer to fill.
+ * @param size Length of the buffer, in bytes.
+ * @return `STATUS_ERROR`.
+ */
+extern PrimStatus prim_exec_get_random(void* buffer, const prim_usize size)
+{
+    (void) buffer;
+    (void) size;
+    return STATUS_ERROR;
+}
+
+#endif
+
+/**
+ * Get the current process's environment.
+ *
+ * @return The environment, as a `NULL` terminated array of `name=value`
+ * strings.
+ */
+extern char** prim_exec_get_environment(void)
+{
+    return environ;
+}
@@ -12,7 +12,9 @@
  * interface.
  *
  * @note This version of `file.c` is an implimentation for
- * a hosted platform with access to a C standard library.
+ * a hosted platform with access to a C standard library,
+ * POSIX for `prim_file_exists` and `prim_file_identity`, and Linux's
+ * `getdents64` for `prim_list_files`.
  *
  * @see `include/platform/file.h`
  *
@@ -21,9 +23,62 @@
  * @date May 2020.
  */
 
+#define _DEFAULT_SOURCE
+
 #include "platform/file.h"
+#include "platform/memory.h"
+#include "platform/thread.h"
+#include "stats.h"
 #include "status.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/** Size of the buffer each directory is read into, in bytes. */
+#define PRIM_DIRECTORY_BUFFER_SIZE 32768
+
+/** A directory entry, as returned by `getdents64`. */
+typedef struct
+{
+    /** The entry's inode. */
+    prim_u64 inode;
+
+    /** Offset of the next entry in the directory. */
+    prim_s64 offset;
+
+    /** Length of this record, in bytes. */
+    prim_u16 length;
+
+    /** The entry's file type, as a `DT_*` value. */
+    prim_u8 type;
+
+    /** The entry's name, with its terminator. */
+    char name[];
+} PrimDirectoryEntry;
+
+/** One level of a directory walk. */
+typedef struct
+{
+    /** The directories to read in this level. */
+    PrimFileList* level;
+
+    /** The directories found, to read in the next level. */
+    PrimFileList* next;
+
+    /** The files found so far. */
+    PrimFileList* files;
+
+    /** Guards `next`, `files` and `status`. */
+    PrimLock lock;
+
+    /** STATUS_OKAY, unless memory ran out. */
+    PrimStatus status;
+} PrimDirectoryWalk;
 
 /**
  * Open the file specified by `path`.
@@ -36,6 +91,7 @@
 extern PrimStatus prim_fopen(const char* path, prim_file_handle* file_handle)
 {
     FILE* native_file = fopen(path, "r");
+    PRIM_STATS_ADD(PRIM_STATS_OPENS, 1);
     if (native_file == NULL)
     {
         return STATUS_BAD_FILE;
@@ -58,6 +114,8 @@ extern PrimStatus prim_fread(
 {
     size_t read_count = 0;
     read_count = fread(destination, size, count, (FILE*) file_handle);
+    PRIM_STATS_ADD(PRIM_STATS_READS, 1);
+    PRIM_STATS_ADD(PRIM_STATS_BYTES_READ, read_count * size);
     if (read_count == 0 && count != 0)
     {
         return STATUS_FILE_IO_ERROR;
@@ -78,9 +136,387 @@ extern PrimStatus prim_fseek(prim_file_handle file_handle, const size_t offset)
 {
     int seek_status = 1;
     seek_status = fseek((FILE*) file_handle, offset, SEEK_SET);
+    PRIM_STATS_ADD(PRIM_STATS_SEEKS, 1);
     if (seek_status != 0)
     {
         return STATUS_FILE_IO_ERROR;
     }
     return STATUS_OKAY;
 }
+
+/**
+ * Create the file specified by `path` for writing, replacing any existing
+ * file.
+ *
+ * @param path Path to a file to create.
+ * @param file_handle Location to return a handle to the
+ * file.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_fcreate(const char* path, prim_file_handle* file_handle)
+{
+    FILE* native_file = fopen(path, "w");
+    PRIM_STATS_ADD(PRIM_STATS_OPENS, 1);
+    if (native_file == NULL)
+    {
+        return STATUS_BAD_FILE;
+    }
+    *file_handle = (prim_file_handle) native_file;
+    return STATUS_OKAY;
+}
+
+/**
+ * Write data from memory to a file.
+ *
+ * @param source Data to write.
+ * @param size Size of a data record.
+ * @param count Number of records (of size `size`) to write.
+ * @param file_handle File to write to.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_fwrite(const void* source, size_t size, size_t count,
+    prim_file_handle file_handle)
+{
+    if (fwrite(source, size, count, (FILE*) file_handle) != count)
+    {
+        return STATUS_FILE_IO_ERROR;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Close a file opened by `prim_fopen` or `prim_fcreate`.
+ *
+ * @param file_handle The file to close.
+ * @return STATUS_OKAY on success, otherwise an error code. Buffered writes
+ * which fail to reach the file are reported here.
+ */
+extern PrimStatus prim_fclose(prim_file_handle file_handle)
+{
+    if (fclose((FILE*) file_handle) != 0)
+    {
+        return STATUS_FILE_IO_ERROR;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Rename a file, replacing any file already at `to`.
+ *
+ * @param from The file's current path.
+ * @param to The file's new path.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_frename(const char* from, const char* to)
+{
+    if (rename(from, to) != 0)
+    {
+        return STATUS_FILE_IO_ERROR;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Delete a file.
+ *
+ * @param path The file to delete.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_fremove(const char* path)
+{
+    if (remove(path) != 0)
+    {
+        return STATUS_FILE_IO_ERROR;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Check if a readable file exists at `path`, without opening it.
+ *
+ * @param path Path to check.
+ * @return STATUS_OKAY if the file exists and is readable, STATUS_BAD_FILE
+ * otherwise.
+ */
+extern PrimStatus prim_file_exists(const char* path)
+{
+    PRIM_STATS_ADD(PRIM_STATS_PROBES, 1);
+    if (access(path, R_OK) != 0)
+    {
+        return STATUS_BAD_FILE;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Read the identity of the file at `path`.
+ *
+ * @param path Path to the file.
+ * @param identity Location to return the file's identity.
+ * @return STATUS_OKAY on success, STATUS_BAD_FILE if the file does not exist.
+ */
+extern PrimStatus prim_file_identity(
+    const char* path, PrimFileIdentity* identity)
+{
+    struct stat info;
+    if (stat(path, &info) != 0)
+    {
+        return STATUS_BAD_FILE;
+    }
+    memset(identity, 0, sizeof(PrimFileIdentity));
+    identity->device = (prim_u64) info.st_dev;
+    identity->inode = (prim_u64) info.st_ino;
+    identity->size = (prim_u64) info.st_size;
+    identity->modified = (prim_u64) info.st_mtim.tv_sec * 1000000000
+        + (prim_u64) info.st_mtim.tv_nsec;
+    return STATUS_OKAY;
+}
+
+/**
+ * Move the paths of one file list to the end of another.
+ *
+ * @param list The list to add to.
+ * @param paths The list to take paths from. Left empty.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+static PrimStatus prim_file_list_take(PrimFileList* list, PrimFileList* paths)
+{
+    PrimStatus status = STATUS_ERROR;
+    char** grown = NULL;
+    prim_usize capacity = list->capacity == 0 ? 64 : list->capacity;
+    if (paths->count == 0)
+    {
+        return STATUS_OKAY;
+    }
+    while (capacity - list->count < paths->count)
+    {
+        capacity *= 2;
+    }
+    if (capacity != list->capacity)
+    {
+        status = prim_malloc((void**) &grown, capacity * sizeof(char*));
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        if (list->paths != NULL)
+        {
+            memcpy(grown, list->paths, list->count * sizeof(char*));
+            prim_free(list->paths);
+        }
+        list->paths = grown;
+        list->capacity = capacity;
+    }
+    memcpy(
+        list->paths + list->count, paths->paths, paths->count * sizeof(char*));
+    list->count += paths->count;
+    paths->count = 0;
+    return STATUS_OKAY;
+}
+
+/**
+ * Add the path of a directory entry to a file list.
+ *
+ * @param list The list to add to.
+ * @param directory The directory's path.
+ * @param name The entry's name.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+static PrimStatus prim_file_list_add(
+    PrimFileList* list, const char* directory, const char* name)
+{
+    PrimStatus status = STATUS_ERROR;
+    PrimFileList single = { NULL, 1, 1 };
+    prim_usize length = strlen(directory);
+    char* path = NULL;
+    int separator = length != 0 && directory[length - 1] != '/';
+    status = prim_malloc(
+        (void**) &path, length + separator + strlen(name) + 1);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memcpy(path, directory, length);
+    if (separator)
+    {
+        path[length] = '/';
+    }
+    strcpy(path + length + separator, name);
+    single.paths = &path;
+    status = prim_file_list_take(list, &single);
+    if (status != STATUS_OKAY)
+    {
+        prim_free(path);
+    }
+    return status;
+}
+
+/**
+ * Read one directory of a walk, adding the files it holds to the walk's
+ * files and its subdirectories to the walk's next level.
+ *
+ * Entries are gathered without the walk's lock, then added under it at once.
+ *
+ * @param context The walk.
+ * @param index Index of the directory in the walk's level.
+ */
+static void prim_list_directory(void* context, prim_usize index)
+{
+    PrimDirectoryWalk* walk = (PrimDirectoryWalk*) context;
+    PrimStatus status = STATUS_OKAY;
+    prim_u64 buffer[PRIM_DIRECTORY_BUFFER_SIZE / sizeof(prim_u64)];
+    const PrimDirectoryEntry* entry = NULL;
+    const char* directory = walk->level->paths[index];
+    PrimFileList files = { NULL, 0, 0 };
+    PrimFileList directories = { NULL, 0, 0 };
+    PrimFileList* list = NULL;
+    struct stat info;
+    long length = 0;
+    long offset = 0;
+    int fd = open(directory, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        /* A root which is not a directory is listed itself. */
+        if (errno == ENOTDIR)
+        {
+            files.paths = &walk->level->paths[index];
+            files.count = 1;
+            prim_lock_acquire(&walk->lock);
+            status = prim_file_list_take(walk->files, &files);
+            if (status == STATUS_OKAY)
+            {
+                walk->level->paths[index] = NULL;
+            }
+            else
+            {
+                walk->status = status;
+            }
+            prim_lock_release(&walk->lock);
+        }
+        return;
+    }
+    while (status == STATUS_OKAY)
+    {
+        length = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+        if (length <= 0)
+        {
+            break;
+        }
+        for (offset = 0; offset < length && status == STATUS_OKAY;
+             offset += entry->length)
+        {
+            entry = (const PrimDirectoryEntry*) ((const char*) buffer
+                + offset);
+            if (strcmp(entry->name, ".") == 0 || strcmp(entry->name, "..") == 0)
+            {
+                continue;
+            }
+            list = entry->type == DT_DIR ? &directories
+                : entry->type == DT_REG  ? &files
+                                         : NULL;
+            /* Some file systems leave the type for the reader to stat. */
+            if (entry->type == DT_UNKNOWN
+                && fstatat(fd, entry->name, &info, AT_SYMLINK_NOFOLLOW) == 0)
+            {
+                list = S_ISDIR(info.st_mode) ? &directories
+                    : S_ISREG(info.st_mode)  ? &files
+                                             : NULL;
+            }
+            if (list != NULL)
+            {
+                status = prim_file_list_add(list, directory, entry->name);
+            }
+        }
+    }
+    close(fd);
+    prim_lock_acquire(&walk->lock);
+    if (status == STATUS_OKAY)
+    {
+        status = prim_file_list_take(walk->files, &files);
+    }
+    if (status == STATUS_OKAY)
+    {
+        status = prim_file_list_take(walk->next, &directories);
+    }
+    if (status != STATUS_OKAY)
+    {
+        walk->status = status;
+    }
+    prim_lock_release(&walk->lock);
+    prim_free_file_list(&files);
+    prim_free_file_list(&directories);
+}
+
+/**
+ * List the regular files under a set of directories.
+ *
+ * Directories are walked a level at a time, with each level's directories
+ * read in parallel. Symbolic links beneath the roots are not followed, and
+ * directories which cannot be read are skipped. A root which is not a
+ * directory is listed as it is. Files are listed in no particular order.
+ *
+ * @param roots Paths of the directories to walk.
+ * @param root_count Number of paths in `roots`.
+ * @param files Location to return the files found. Each path begins with the
+ * root it was found under.
+ * @return STATUS_OKAY on success, otherwise an error code. Nothing is left
+ * allocated on failure.
+ */
+extern PrimStatus prim_list_files(
+    const char* const* roots, prim_usize root_count, PrimFileList* files)
+{
+    PrimStatus status = STATUS_OKAY;
+    PrimDirectoryWalk walk;
+    PrimFileList level = { NULL, 0, 0 };
+    PrimFileList next = { NULL, 0, 0 };
+    prim_usize i = 0;
+    memset(files, 0, sizeof(PrimFileList));
+    memset(&walk, 0, sizeof(PrimDirectoryWalk));
+    for (i = 0; i < root_count && status == STATUS_OKAY; i++)
+    {
+        status = prim_file_list_add(&level, "", roots[i]);
+    }
+    while (status == STATUS_OKAY && level.count != 0)
+    {
+        walk.level = &level;
+        walk.next = &next;
+        walk.files = files;
+        walk.status = STATUS_OKAY;
+        status = prim_parallel_for(level.count, prim_list_directory, &walk);
+        if (status == STATUS_OKAY)
+        {
+            status = walk.status;
+        }
+        prim_free_file_list(&level);
+        level = next;
+        memset(&next, 0, sizeof(PrimFileList));
+    }
+    prim_free_file_list(&level);
+    if (status != STATUS_OKAY)
+    {
+        prim_free_file_list(files);
+    }
+    return status;
+}
+
+/**
+ * Release a file list.
+ *
+ * @param files The list to release.
+ */
+extern void prim_free_file_list(PrimFileList* files)
+{
+    prim_usize i = 0;
+    for (i = 0; i < files->count; i++)
+    {
+        if (files->paths[i] != NULL)
+        {
+            prim_free(files->paths[i]);
+        }
+    }
+    if (files->paths != NULL)
+    {
+        prim_free(files->paths);
+    }
+    memset(files, 0, sizeof(PrimFileList));
+}
@@ -0,0 +1,138 @@
+/**
+ * @file src/platform/fork.c
+ *
+ * Implements forking the current process, and pipe messages.
+ *
+ * @note This file is currently setup for a POSIX userspace.
+ *
+ * @see `include/platform/fork.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "platform/fork.h"
+#include "platform/types.h"
+#include "status.h"
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * Fork the current process.
+ *
+ * Flush buffered output first, or the child will write it again.
+ *
+ * @param child Location to return the child's ID in the parent, and zero in
+ * the child.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_fork(prim_process_id* child)
+{
+    pid_t id = fork();
+    if (id < 0)
+    {
+        return STATUS_ERROR;
+    }
+    *child = id;
+    return STATUS_OKAY;
+}
+
+/**
+ * Wait for a child process to exit.
+ *
+ * @param child The child to wait for.
+ * @param result Location to return the child's wait status, as the host
+ * encodes it.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_wait(const prim_process_id child, prim_s32* result)
+{
+    int status = 0;
+    while (waitpid((pid_t) child, &status, 0) < 0)
+    {
+        if (errno != EINTR)
+        {
+            return STATUS_ERROR;
+        }
+    }
+    *result = status;
+    return STATUS_OKAY;
+}
+
+/**
+ * Read exactly `size` bytes from a pipe.
+ *
+ * @param descriptor The pipe to read from.
+ * @param buffer Location to store the bytes read.
+ * @param size Number of bytes to read.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the pipe was closed
+ * before any bytes were read, otherwise an error code.
+ */
+extern PrimStatus prim_pipe_read(
+    const int descriptor, void* buffer, const prim_usize size)
+{
+    prim_usize done = 0;
+    ssize_t count = 0;
+    while (done < size)
+    {
+        count = read(descriptor, (prim_u8*) buffer + done, size - done);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count == 0 && done == 0)
+        {
+            return STATUS_INVALID;
+        }
+        if (count <= 0)
+        {
+            return STATUS_FILE_IO_ERROR;
+        }
+        done += (prim_usize) count;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Write exactly `size` bytes to a pipe.
+ *
+ * @param descriptor The pipe to write to.
+ * @param buffer The bytes to write.
+ * @param size Number of bytes to write.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_pipe_write(
+    const int descriptor, const void* buffer, const prim_usize size)
+{
+    prim_usize done = 0;
+    ssize_t count = 0;
+    while (done < size)
+    {
+        count = write(descriptor, (const prim_u8*) buffer + done, size - done);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            return STATUS_FILE_IO_ERROR;
+        }
+        done += (prim_usize) count;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Close a pipe.
+ *
+ * @param descriptor The pipe to close.
+ */
+extern void prim_pipe_close(const int descriptor)
+{
+    close(descriptor);
+}
@@ -0,0 +1,806 @@
+/**
+ * @file src/platform/mapping.c
+ *
+ * Implements memory mapped file access for the host platform.
+ *
+ * @note This version of `mapping.c` is an implementation for a POSIX
+ * userspace with `mmap` and `madvise`. Huge page sizes and counts, and the
+ * pages a process has touched, are read from Linux's `/sys` and `/proc`
+ * files.
+ *
+ * @see `include/platform/mapping.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "platform/mapping.h"
+#include "platform/memory.h"
+#include "platform/types.h"
+#include "stats.h"
+#include "status.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** Maps Prim's access advice to the host's `madvise` advice. */
+static const int advice_codes[] = {
+    [PRIM_ADVICE_NORMAL] = MADV_NORMAL,
+    [PRIM_ADVICE_WILLNEED] = MADV_WILLNEED,
+    [PRIM_ADVICE_SEQUENTIAL] = MADV_SEQUENTIAL,
+    [PRIM_ADVICE_RANDOM] = MADV_RANDOM,
+    [PRIM_ADVICE_DONTNEED] = MADV_DONTNEED,
+#ifdef MADV_POPULATE_READ
+    [PRIM_ADVICE_POPULATE] = MADV_POPULATE_READ,
+#else
+    [PRIM_ADVICE_POPULATE] = MADV_WILLNEED,
+#endif
+};
+
+/**
+ * Convert Prim access rights to the host's `mmap` protection flags.
+ *
+ * @param protection Bitfield of `PRIM_PROTECT_*` access rights.
+ * @return The equivalent `PROT_*` flags.
+ */
+static int prim_map_get_native_protection(const prim_u32 protection)
+{
+    int native = PROT_NONE;
+    if (protection & PRIM_PROTECT_READ)
+    {
+        native |= PROT_READ;
+    }
+    if (protection & PRIM_PROTECT_WRITE)
+    {
+        native |= PROT_WRITE;
+    }
+    if (protection & PRIM_PROTECT_EXECUTE)
+    {
+        native |= PROT_EXEC;
+    }
+    return native;
+}
+
+/**
+ * Map the file specified by `path` into memory, read-only.
+ *
+ * @note Mapping an empty file produces a mapping with `NULL` data and a size
+ * of zero.
+ *
+ * @param path Path to the file to map.
+ * @param mapping Location to return the mapping.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_file(const char* path, PrimMapping* mapping)
+{
+    int fd = -1;
+    struct stat file_info;
+    void* data = MAP_FAILED;
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    PRIM_STATS_ADD(PRIM_STATS_OPENS, 1);
+    if (fd < 0)
+    {
+        return STATUS_BAD_FILE;
+    }
+    if (fstat(fd, &file_info) != 0)
+    {
+        close(fd);
+        return STATUS_FILE_IO_ERROR;
+    }
+    mapping->data = NULL;
+    mapping->file = -1;
+    mapping->size = (prim_usize) file_info.st_size;
+    if (mapping->size == 0)
+    {
+        close(fd);
+        return STATUS_OKAY;
+    }
+    data = mmap(NULL, mapping->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    PRIM_STATS_ADD(PRIM_STATS_MAPS, 1);
+    if (data == MAP_FAILED)
+    {
+        close(fd);
+        mapping->size = 0;
+        return STATUS_FILE_IO_ERROR;
+    }
+    mapping->data = (const prim_u8*) data;
+    mapping->file = fd;
+    return STATUS_OKAY;
+}
+
+/**
+ * Release a mapping created by `prim_map_file`.
+ *
+ * @param mapping The mapping to release.
+ */
+extern void prim_unmap_file(PrimMapping* mapping)
+{
+    if (mapping->data != NULL)
+    {
+        munmap((void*) mapping->data, mapping->size);
+        close(mapping->file);
+    }
+    mapping->data = NULL;
+    mapping->size = 0;
+    mapping->file = -1;
+}
+
+/**
+ * Open the file specified by `path` to be mapped a window at a time.
+ *
+ * @param path Path to the file to open.
+ * @param file Location to return the opened file.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_open_windowed(
+    const char* path, PrimWindowedFile* file)
+{
+    int fd = -1;
+    struct stat file_info;
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    PRIM_STATS_ADD(PRIM_STATS_OPENS, 1);
+    if (fd < 0)
+    {
+        return STATUS_BAD_FILE;
+    }
+    if (fstat(fd, &file_info) != 0)
+    {
+        close(fd);
+        return STATUS_FILE_IO_ERROR;
+    }
+    file->file = fd;
+    file->size = (prim_usize) file_info.st_size;
+    return STATUS_OKAY;
+}
+
+/**
+ * Close a file opened by `prim_map_open_windowed`. Windows mapped from it
+ * stay mapped.
+ *
+ * @param file The file to close.
+ */
+extern void prim_map_close_windowed(PrimWindowedFile* file)
+{
+    if (file->file >= 0)
+    {
+        close(file->file);
+    }
+    file->file = -1;
+    file->size = 0;
+}
+
+/**
+ * Map a window of a file into memory, read-only.
+ *
+ * @param file The file to map from.
+ * @param offset Offset of the window in the file. A multiple of the page
+ * size.
+ * @param size Length of the window, in bytes. Must not extend past the end
+ * of the file.
+ * @param window Location to return the window. Its data starts at `offset`
+ * in the file, and it does not own the file's descriptor.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the window is outside the
+ * file, otherwise an error code.
+ */
+extern PrimStatus prim_map_window(const PrimWindowedFile* file,
+    const prim_usize offset, const prim_usize size, PrimMapping* window)
+{
+    void* data = MAP_FAILED;
+    if (size == 0 || offset > file->size || size > file->size - offset
+        || offset % prim_map_page_size() != 0)
+    {
+        return STATUS_INVALID;
+    }
+    data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file->file, (off_t) offset);
+    PRIM_STATS_ADD(PRIM_STATS_MAPS, 1);
+    if (data == MAP_FAILED)
+    {
+        return STATUS_FILE_IO_ERROR;
+    }
+    window->data = (const prim_u8*) data;
+    window->size = size;
+    window->file = -1;
+    return STATUS_OKAY;
+}
+
+/**
+ * Release a window mapped by `prim_map_window`.
+ *
+ * @param window The window to release.
+ */
+extern void prim_unmap_window(PrimMapping* window)
+{
+    if (window->data != NULL)
+    {
+        munmap((void*) window->data, window->size);
+    }
+    window->data = NULL;
+    window->size = 0;
+    window->file = -1;
+}
+
+/**
+ * Open a file as a windowed view.
+ *
+ * @param path Path to the file to open.
+ * @param window_size Length of each window, in bytes. Rounded up to the page
+ * size.
+ * @param window_count Number of windows to keep mapped. At least one.
+ * @param view Location to return the view.
+ * @return STATUS_OKAY on success, STATUS_INVALID if `window_count` is zero,
+ * otherwise an error code.
+ */
+extern PrimStatus prim_map_open_view(const char* path,
+    const prim_usize window_size, const prim_usize window_count,
+    PrimWindowedView* view)
+{
+    PrimStatus status = STATUS_ERROR;
+    prim_usize page_size = prim_map_page_size();
+    memset(view, 0, sizeof(PrimWindowedView));
+    view->file.file = -1;
+    if (window_count == 0)
+    {
+        return STATUS_INVALID;
+    }
+    status = prim_malloc(
+        (void**) &view->windows, window_count * sizeof(PrimWindow));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    memset(view->windows, 0, window_count * sizeof(PrimWindow));
+    status = prim_map_open_windowed(path, &view->file);
+    if (status != STATUS_OKAY)
+    {
+        prim_free(view->windows);
+        view->windows = NULL;
+        return status;
+    }
+    view->window_count = window_count;
+    view->window_size = window_size == 0
+        ? page_size
+        : (window_size + page_size - 1) & ~(page_size - 1);
+    return STATUS_OKAY;
+}
+
+/**
+ * Close a windowed view, and unmap its windows.
+ *
+ * @param view The view to close.
+ */
+extern void prim_map_close_view(PrimWindowedView* view)
+{
+    prim_usize i = 0;
+    for (i = 0; i < view->window_count; i++)
+    {
+        prim_unmap_window(&view->windows[i].mapping);
+    }
+    if (view->windows != NULL)
+    {
+        prim_free(view->windows);
+    }
+    if (view->stitched != NULL)
+    {
+        prim_free(view->stitched);
+    }
+    prim_map_close_windowed(&view->file);
+    memset(view, 0, sizeof(PrimWindowedView));
+    view->file.file = -1;
+}
+
+/**
+ * Get the window holding an offset in a view's file, mapping it in place of
+ * the least recently used window if it is not already mapped.
+ *
+ * @param view The view.
+ * @param offset An offset in the file.
+ * @param result Location to return the window.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+static PrimStatus prim_map_view_window(
+    PrimWindowedView* view, const prim_usize offset, const PrimWindow** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    PrimWindow* victim = &view->windows[0];
+    prim_usize start = offset - offset % view->window_size;
+    prim_usize size = view->file.size - start;
+    prim_usize i = 0;
+    view->clock++;
+    for (i = 0; i < view->window_count; i++)
+    {
+        if (view->windows[i].mapping.data != NULL
+            && view->windows[i].offset == start)
+        {
+            view->windows[i].used = view->clock;
+            *result = &view->windows[i];
+            return STATUS_OKAY;
+        }
+        if (view->windows[i].used < victim->used)
+        {
+            victim = &view->windows[i];
+        }
+    }
+    prim_unmap_window(&victim->mapping);
+    victim->used = 0;
+    status = prim_map_window(&view->file, start,
+        size < view->window_size ? size : view->window_size, &victim->mapping);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    victim->offset = start;
+    victim->used = view->clock;
+    *result = victim;
+    return STATUS_OKAY;
+}
+
+/**
+ * Copy a range of a file through a windowed view.
+ *
+ * @param view The view to read through.
+ * @param offset Offset of the range in the file.
+ * @param buffer Location to copy the range to.
+ * @param size Length of the range, in bytes.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the range is outside the
+ * file, otherwise an error code.
+ */
+extern PrimStatus prim_map_view_read(PrimWindowedView* view, prim_usize offset,
+    void* buffer, prim_usize size)
+{
+    PrimStatus status = STATUS_ERROR;
+    const PrimWindow* window = NULL;
+    prim_u8* destination = (prim_u8*) buffer;
+    prim_usize within = 0;
+    prim_usize length = 0;
+    if (offset > view->file.size || size > view->file.size - offset)
+    {
+        return STATUS_INVALID;
+    }
+    while (size > 0)
+    {
+        status = prim_map_view_window(view, offset, &window);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        within = offset - window->offset;
+        length = window->mapping.size - within;
+        length = length < size ? length : size;
+        memcpy(destination, window->mapping.data + within, length);
+        destination += length;
+        offset += length;
+        size -= length;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Get a range of a file through a windowed view.
+ *
+ * The range is served straight from a mapped window when it fits in one, and
+ * is otherwise copied into the view's stitching buffer.
+ *
+ * @param view The view to read through.
+ * @param offset Offset of the range in the file.
+ * @param size Length of the range, in bytes.
+ * @param result Location to return the range. Valid until the next access
+ * through the view.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the range is outside the
+ * file, otherwise an error code.
+ */
+extern PrimStatus prim_map_view_get(PrimWindowedView* view,
+    const prim_usize offset, const prim_usize size, const prim_u8** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    const PrimWindow* window = NULL;
+    if (offset > view->file.size || size > view->file.size - offset)
+    {
+        return STATUS_INVALID;
+    }
+    if (size != 0 && offset % view->window_size + size <= view->window_size)
+    {
+        status = prim_map_view_window(view, offset, &window);
+        if (status == STATUS_OKAY)
+        {
+            *result = window->mapping.data + (offset - window->offset);
+        }
+        return status;
+    }
+    if (size > view->stitched_size)
+    {
+        if (view->stitched != NULL)
+        {
+            prim_free(view->stitched);
+            view->stitched = NULL;
+            view->stitched_size = 0;
+        }
+        status = prim_malloc((void**) &view->stitched, size);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        view->stitched_size = size;
+    }
+    status = prim_map_view_read(view, offset, view->stitched, size);
+    if (status == STATUS_OKAY)
+    {
+        *result = view->stitched;
+    }
+    return status;
+}
+
+/**
+ * Advise the platform how a range of a mapping will be accessed.
+ *
+ * The range is widened to page boundaries as required by the platform. Advice
+ * is only a hint: platforms which cannot act on it report success.
+ *
+ * @param mapping The mapping the range belongs to.
+ * @param offset Offset to the start of the range, in bytes.
+ * @param length Length of the range, in bytes.
+ * @param advice The expected access pattern.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the range is outside the
+ * mapping.
+ */
+extern PrimStatus prim_map_advise(const PrimMapping* mapping,
+    const prim_usize offset, const prim_usize length,
+    const PrimMapAdvice advice)
+{
+    if (offset > mapping->size || length > mapping->size - offset)
+    {
+        return STATUS_INVALID;
+    }
+    return prim_map_advise_memory(
+        (void*) (mapping->data + offset), length, advice);
+}
+
+/**
+ * Advise the platform how a range of mapped memory will be accessed.
+ *
+ * The range is widened to page boundaries as required by the platform. Advice
+ * is only a hint: platforms which cannot act on it report success.
+ *
+ * Hosts without `MADV_POPULATE_READ` read populated ranges ahead, but leave
+ * them to be mapped on first access.
+ *
+ * @param address Start of the memory.
+ * @param size Length of the memory, in bytes.
+ * @param advice The expected access pattern.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the advice is unknown.
+ */
+extern PrimStatus prim_map_advise_memory(
+    void* address, const prim_usize size, const PrimMapAdvice advice)
+{
+    prim_usize page_size = prim_map_page_size();
+    prim_usize start = (prim_usize) address;
+    prim_usize end = start + size;
+    if (advice > PRIM_ADVICE_POPULATE)
+    {
+        return STATUS_INVALID;
+    }
+    if (size == 0)
+    {
+        return STATUS_OKAY;
+    }
+    start &= ~(page_size - 1);
+    /* Advice is a hint, so a refusal from the host is not an error. */
+    madvise((void*) start, end - start, advice_codes[advice]);
+    return STATUS_OKAY;
+}
+
+/**
+ * Get the size of a page of memory on the host.
+ *
+ * @return The page size, in bytes.
+ */
+extern prim_usize prim_map_page_size(void)
+{
+    return (prim_usize) sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * Reserve a range of address space, without backing memory.
+ *
+ * Reserved memory can not be accessed until part of it is replaced by
+ * `prim_map_file_range` or `prim_map_anonymous`.
+ *
+ * @param address Address the range must start at, or `NULL` to let the
+ * platform choose.
+ * @param size Length of the range, in bytes. A multiple of the page size.
+ * @param result Location to return the start of the range.
+ * @return STATUS_OKAY on success, STATUS_INVALID if the requested address is
+ * unavailable, otherwise an error code.
+ */
+extern PrimStatus prim_map_reserve(
+    void* address, const prim_usize size, void** result)
+{
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+    void* reserved = MAP_FAILED;
+#ifdef MAP_FIXED_NOREPLACE
+    if (address != NULL)
+    {
+        flags |= MAP_FIXED_NOREPLACE;
+    }
+#endif
+    reserved = mmap(address, size, PROT_NONE, flags, -1, 0);
+    PRIM_STATS_ADD(PRIM_STATS_MAPS, 1);
+    if (reserved == MAP_FAILED)
+    {
+        return address == NULL ? STATUS_ERROR : STATUS_INVALID;
+    }
+    /* Older hosts treat the address as a hint, so check it was honoured. */
+    if (address != NULL && reserved != address)
+    {
+        munmap(reserved, size);
+        return STATUS_INVALID;
+    }
+    *result = reserved;
+    return STATUS_OKAY;
+}
+
+/**
+ * Reserve a range of address space starting at a multiple of `alignment`,
+ * without backing memory.
+ *
+ * @param size Length of the range, in bytes. A multiple of the page size.
+ * @param alignment Alignment of the range's start. A power of two, and a
+ * multiple of the page size.
+ * @param result Location to return the start of the range.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_reserve_aligned(
+    const prim_usize size, const prim_usize alignment, void** result)
+{
+    PrimStatus status = STATUS_ERROR;
+    void* reserved = NULL;
+    prim_usize start = 0;
+    prim_usize aligned = 0;
+    /* Over-reserve, then trim the unaligned head and the excess tail. */
+    status = prim_map_reserve(NULL, size + alignment, &reserved);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    start = (prim_usize) reserved;
+    aligned = (start + alignment - 1) & ~(alignment - 1);
+    if (aligned != start)
+    {
+        munmap(reserved, aligned - start);
+    }
+    if (start + alignment != aligned)
+    {
+        munmap((void*) (aligned + size), start + alignment - aligned);
+    }
+    *result = (void*) aligned;
+    return STATUS_OKAY;
+}
+
+/**
+ * Map part of a mapped file privately at a fixed address.
+ *
+ * Writes to the memory are private, and never reach the file.
+ *
+ * @param mapping The mapped file to map from.
+ * @param offset Offset of the range in the file. A multiple of the page size.
+ * @param address Address to map the range at. A multiple of the page size.
+ * @param size Length of the range, in bytes.
+ * @param protection Bitfield of `PRIM_PROTECT_*` access rights.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_file_range(const PrimMapping* mapping,
+    const prim_usize offset, void* address, const prim_usize size,
+    const prim_u32 protection)
+{
+    void* mapped = MAP_FAILED;
+    mapped = mmap(address, size, prim_map_get_native_protection(protection),
+        MAP_PRIVATE | MAP_FIXED, mapping->file, (off_t) offset);
+    PRIM_STATS_ADD(PRIM_STATS_MAPS, 1);
+    if (mapped == MAP_FAILED)
+    {
+        return STATUS_FILE_IO_ERROR;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Map zero filled memory at a fixed address.
+ *
+ * @param address Address to map the memory at. A multiple of the page size.
+ * @param size Length of the memory, in bytes.
+ * @param protection Bitfield of `PRIM_PROTECT_*` access rights.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_anonymous(
+    void* address, const prim_usize size, const prim_u32 protection)
+{
+    void* mapped = MAP_FAILED;
+    mapped = mmap(address, size, prim_map_get_native_protection(protection),
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+    PRIM_STATS_ADD(PRIM_STATS_MAPS, 1);
+    if (mapped == MAP_FAILED)
+    {
+        return STATUS_ERROR;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Change the access rights of mapped memory.
+ *
+ * @param address Start of the memory. A multiple of the page size.
+ * @param size Length of the memory, in bytes.
+ * @param protection Bitfield of `PRIM_PROTECT_*` access rights.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_protect(
+    void* address, const prim_usize size, const prim_u32 protection)
+{
+    if (mprotect(address, size, prim_map_get_native_protection(protection))
+        != 0)
+    {
+        return STATUS_ERROR;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Get the size of the huge pages the host can back anonymous memory with.
+ *
+ * @return The huge page size, in bytes, or zero if the host has none.
+ */
+extern prim_usize prim_map_huge_page_size(void)
+{
+    FILE* file = NULL;
+    unsigned long size = 0;
+#ifdef MADV_HUGEPAGE
+    file = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+#endif
+    if (file == NULL)
+    {
+        return 0;
+    }
+    if (fscanf(file, "%lu", &size) != 1)
+    {
+        size = 0;
+    }
+    fclose(file);
+    return (prim_usize) size;
+}
+
+/**
+ * Ask the host to back anonymous memory with huge pages when it is first
+ * touched. Only whole, aligned huge pages in the range can be backed.
+ *
+ * @param address Start of the memory. A multiple of the page size.
+ * @param size Length of the memory, in bytes.
+ * @return STATUS_OKAY if the host accepted the request, STATUS_INVALID if it
+ * does not support huge pages.
+ */
+extern PrimStatus prim_map_request_huge_pages(
+    void* address, const prim_usize size)
+{
+#ifdef MADV_HUGEPAGE
+    if (madvise(address, size, MADV_HUGEPAGE) == 0)
+    {
+        return STATUS_OKAY;
+    }
+#else
+    (void) address;
+    (void) size;
+#endif
+    return STATUS_INVALID;
+}
+
+/**
+ * Count the huge pages currently backing a range of memory.
+ *
+ * The host reports huge pages per mapping, in `/proc/self/smaps`, so every
+ * mapping which starts inside the range is counted.
+ *
+ * @param address Start of the memory. A multiple of the page size.
+ * @param size Length of the memory, in bytes.
+ * @return The number of huge pages, or zero if the host can not tell.
+ */
+extern prim_usize prim_map_count_huge_pages(
+    void* address, const prim_usize size)
+{
+    FILE* smaps = NULL;
+    char line[256];
+    unsigned long start = 0;
+    unsigned long end = 0;
+    unsigned long kilobytes = 0;
+    prim_usize total = 0;
+    prim_usize huge_page_size = prim_map_huge_page_size();
+    int inside = 0;
+    if (huge_page_size == 0)
+    {
+        return 0;
+    }
+    smaps = fopen("/proc/self/smaps", "r");
+    if (smaps == NULL)
+    {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), smaps) != NULL)
+    {
+        if (sscanf(line, "%lx-%lx ", &start, &end) == 2)
+        {
+            inside = start >= (prim_usize) address
+                && start < (prim_usize) address + size;
+        }
+        else if (inside
+            && sscanf(line, "AnonHugePages: %lu kB", &kilobytes) == 1)
+        {
+            total += kilobytes * 1024;
+        }
+    }
+    fclose(smaps);
+    return total / huge_page_size;
+}
+
+/**
+ * Find which pages of a range of mapped memory this process has touched.
+ *
+ * A page is touched once it is mapped into the process, which
+ * `/proc/self/pagemap` reports as present or swapped. Hosts without it fall
+ * back to `mincore`, which also counts pages another process brought into
+ * the page cache.
+ *
+ * @param address Start of the memory. A multiple of the page size.
+ * @param size Length of the memory, in bytes.
+ * @param touched Location to return one byte per page, non-zero if the page
+ * has been touched.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_map_get_touched(
+    const void* address, const prim_usize size, prim_u8* touched)
+{
+    prim_usize page_size = prim_map_page_size();
+    prim_usize count = (size + page_size - 1) / page_size;
+    prim_u64 entries[512];
+    prim_usize batch = 0;
+    prim_usize done = 0;
+    prim_usize i = 0;
+    off_t offset = (off_t) ((prim_usize) address / page_size * sizeof(prim_u64));
+    int pagemap = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+    if (pagemap < 0)
+    {
+        return mincore((void*) address, size, touched) == 0 ? STATUS_OKAY
+                                                            : STATUS_ERROR;
+    }
+    for (done = 0; done < count; done += batch)
+    {
+        batch = count - done < 512 ? count - done : 512;
+        if (pread(pagemap, entries, batch * sizeof(prim_u64),
+                offset + (off_t) (done * sizeof(prim_u64)))
+            != (ssize_t) (batch * sizeof(prim_u64)))
+        {
+            close(pagemap);
+            return STATUS_FILE_IO_ERROR;
+        }
+        /* Bit 63 marks a present page, and bit 62 a swapped one. */
+        for (i = 0; i < batch; i++)
+        {
+            touched[done + i] = (entries[i] >> 62) != 0;
+        }
+    }
+    close(pagemap);
+    return STATUS_OKAY;
+}
+
+/**
+ * Release reserved or mapped memory.
+ *
+ * @param address Start of the memory. A multiple of the page size.
+ * @param size Length of the memory, in bytes.
+ */
+extern void prim_map_release(void* address, const prim_usize size)
+{
+    munmap(address, size);
+}
@@ -11,6 +11,7 @@
  */
 
 #include "platform/types.h"
+#include "stats.h"
 #include "status.h"
 #include <stdlib.h>
 
@@ -23,6 +24,8 @@
 PrimStatus prim_malloc(void** result, prim_usize size)
 {
     *result = malloc(size);
+    PRIM_STATS_ADD(PRIM_STATS_ALLOCATIONS, 1);
+    PRIM_STATS_ADD(PRIM_STATS_BYTES_ALLOCATED, size);
     if (*result == 0)
     {
         return STATUS_ERROR;
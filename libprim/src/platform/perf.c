@@ -0,0 +1,261 @@
+/**
+ * @file src/platform/perf.c
+ *
+ * Implements perf map and jitdump output for code loaded by Prim.
+ *
+ * @note This version of `perf.c` is an implementation for Linux `perf`.
+ *
+ * @see `include/platform/perf.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "platform/perf.h"
+#include "platform/clock.h"
+#include "platform/types.h"
+#include "status.h"
+#include <stdio.h>
+#include <stdio_ext.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/** Maximum length of a perf file path. */
+#define PERF_PATH_LENGTH 4096
+
+/** Jitdump file magic number: "JiTD". */
+#define JITDUMP_MAGIC 0x4A695444U
+
+/** Jitdump format version. */
+#define JITDUMP_VERSION 1U
+
+/** Jitdump record type describing loaded code. */
+#define JITDUMP_CODE_LOAD 0U
+
+/** ELF machine code for x86-64, recorded in the jitdump header. */
+#define JITDUMP_MACHINE_AMD64 62U
+
+/** Jitdump file header. */
+struct JitdumpHeader
+{
+    prim_u32 magic;
+    prim_u32 version;
+    prim_u32 total_size;
+    prim_u32 machine;
+    prim_u32 padding;
+    prim_u32 process;
+    prim_u64 timestamp;
+    prim_u64 flags;
+};
+
+/** Jitdump code load record, followed by the name and the code. */
+struct JitdumpCodeLoad
+{
+    prim_u32 id;
+    prim_u32 total_size;
+    prim_u64 timestamp;
+    prim_u32 process;
+    prim_u32 thread;
+    prim_u64 virtual_address;
+    prim_u64 code_address;
+    prim_u64 code_size;
+    prim_u64 code_index;
+};
+
+/** The perf map for `perf_process`, once opened. */
+static FILE* perf_map = NULL;
+
+/** The jitdump for `perf_process`, once opened. */
+static FILE* jitdump = NULL;
+
+/** Executable mapping of the jitdump, which announces it to `perf`. */
+static void* jitdump_marker = NULL;
+
+/** Index of the next code load record. */
+static prim_u64 jitdump_code_index = 0;
+
+/** The process the open files belong to. */
+static pid_t perf_process = 0;
+
+/**
+ * Close a stream inherited from a parent process, without writing anything
+ * the parent had buffered.
+ *
+ * @param stream The stream to close, or `NULL`.
+ */
+static void prim_perf_close_inherited(FILE* stream)
+{
+    if (stream == NULL)
+    {
+        return;
+    }
+    /* The parent writes its own buffered records. */
+    __fpurge(stream);
+    fclose(stream);
+}
+
+/**
+ * Close files opened by a parent process, so a forked child writes its own.
+ */
+static void prim_perf_check_process(void)
+{
+    long page_size = 0;
+    if (perf_process == getpid())
+    {
+        return;
+    }
+    prim_perf_close_inherited(perf_map);
+    prim_perf_close_inherited(jitdump);
+    if (jitdump_marker != NULL)
+    {
+        page_size = sysconf(_SC_PAGESIZE);
+        munmap(jitdump_marker, (size_t) page_size);
+    }
+    perf_map = NULL;
+    jitdump = NULL;
+    jitdump_marker = NULL;
+    jitdump_code_index = 0;
+    perf_process = getpid();
+}
+
+/**
+ * Open the jitdump, write its header and announce it to `perf`.
+ *
+ * @param directory Directory to create the jitdump in, or `NULL` for `/tmp`.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+static PrimStatus prim_jitdump_open(const char* directory)
+{
+    char path[PERF_PATH_LENGTH];
+    struct JitdumpHeader header = { 0 };
+    long page_size = sysconf(_SC_PAGESIZE);
+    snprintf(path, sizeof(path), "%s/jit-%d.dump",
+        directory == NULL ? "/tmp" : directory, (int) getpid());
+    jitdump = fopen(path, "w+");
+    if (jitdump == NULL)
+    {
+        return STATUS_BAD_FILE;
+    }
+    header.magic = JITDUMP_MAGIC;
+    header.version = JITDUMP_VERSION;
+    header.total_size = sizeof(header);
+    header.machine = JITDUMP_MACHINE_AMD64;
+    header.process = (prim_u32) getpid();
+    header.timestamp = prim_clock_now();
+    if (fwrite(&header, sizeof(header), 1, jitdump) == 1
+        && fflush(jitdump) == 0)
+    {
+        /* perf finds the jitdump through an executable mapping of the file. */
+        jitdump_marker = mmap(NULL, (size_t) page_size, PROT_READ | PROT_EXEC,
+            MAP_PRIVATE, fileno(jitdump), 0);
+        if (jitdump_marker != MAP_FAILED)
+        {
+            return STATUS_OKAY;
+        }
+    }
+    /* Leave nothing behind, so a later record tries again from scratch. */
+    jitdump_marker = NULL;
+    fclose(jitdump);
+    jitdump = NULL;
+    remove(path);
+    return STATUS_FILE_IO_ERROR;
+}
+
+/**
+ * Add a function to the process's perf map.
+ *
+ * @param address Address of the function in memory.
+ * @param size Length of the function, in bytes.
+ * @param name Name of the function.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_perf_map_add(
+    const prim_usize address, const prim_usize size, const char* name)
+{
+    char path[PERF_PATH_LENGTH];
+    prim_perf_check_process();
+    if (perf_map == NULL)
+    {
+        snprintf(path, sizeof(path), "/tmp/perf-%d.map", (int) getpid());
+        perf_map = fopen(path, "a");
+        if (perf_map == NULL)
+        {
+            return STATUS_BAD_FILE;
+        }
+    }
+    if (fprintf(perf_map, "%lx %lx %s\n", (unsigned long) address,
+            (unsigned long) size, name)
+        < 0)
+    {
+        return STATUS_FILE_IO_ERROR;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Add a function to the process's jitdump.
+ *
+ * @param directory Directory to create the jitdump in, if it is not already
+ * open. `NULL` selects `/tmp`.
+ * @param code Address of the function in memory.
+ * @param size Length of the function, in bytes.
+ * @param name Name of the function.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+extern PrimStatus prim_jitdump_add(const char* directory, const void* code,
+    const prim_usize size, const char* name)
+{
+    PrimStatus status = STATUS_OKAY;
+    struct JitdumpCodeLoad record = { 0 };
+    prim_usize name_size = 0;
+    prim_perf_check_process();
+    if (jitdump == NULL)
+    {
+        status = prim_jitdump_open(directory);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+    }
+    while (name[name_size] != '\0')
+    {
+        name_size++;
+    }
+    name_size++;
+    record.id = JITDUMP_CODE_LOAD;
+    record.total_size = (prim_u32) (sizeof(record) + name_size + size);
+    record.timestamp = prim_clock_now();
+    record.process = (prim_u32) getpid();
+    record.thread = (prim_u32) syscall(SYS_gettid);
+    record.virtual_address = (prim_u64) (prim_usize) code;
+    record.code_address = (prim_u64) (prim_usize) code;
+    record.code_size = size;
+    record.code_index = jitdump_code_index++;
+    if (fwrite(&record, sizeof(record), 1, jitdump) != 1
+        || fwrite(name, name_size, 1, jitdump) != 1
+        || (size != 0 && fwrite(code, size, 1, jitdump) != 1))
+    {
+        return STATUS_FILE_IO_ERROR;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Flush any buffered perf map and jitdump records to their files.
+ */
+extern void prim_perf_flush(void)
+{
+    prim_perf_check_process();
+    if (perf_map != NULL)
+    {
+        fflush(perf_map);
+    }
+    if (jitdump != NULL)
+    {
+        fflush(jitdump);
+    }
+}
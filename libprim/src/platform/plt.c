@@ -0,0 +1,200 @@
+/**
+ * @file src/platform/plt.c
+ *
+ * Implements the lazy binding trampoline.
+ *
+ * @note This file is currently setup for the AMD64 System V ABI. Other hosts
+ * report lazy binding as unsupported.
+ *
+ * @see `include/platform/plt.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "platform/plt.h"
+#include "platform/types.h"
+#include "status.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+#include <cpuid.h>
+
+/** CPUID leaf 1 `ECX` bit: the host has enabled `xsave` and `xgetbv`. */
+#define PRIM_PLT_CPUID_OSXSAVE (1U << 27)
+
+/** CPUID leaf describing the `xsave` state components. */
+#define PRIM_PLT_CPUID_XSAVE 0xd
+
+/** Size of the `xsave` legacy area and header, which every area holds. */
+#define PRIM_PLT_XSAVE_MINIMUM_SIZE 576
+
+/**
+ * Bytes the trampoline reserves for `xsave`, from CPUID. Zero until
+ * `prim_plt_is_supported` has found `xsave` usable.
+ */
+__attribute__((visibility("hidden"))) prim_usize prim_plt_xsave_size = 0;
+
+/*
+ * On entry the stack holds the context pushed by the PLT's first entry, the
+ * relocation index pushed by the called entry, and the caller's return
+ * address. Every register which may carry an argument is saved, including
+ * %rax (the vector register count for variadic calls) and %r10 (the static
+ * chain). The vector registers are saved whole with `xsave`, as the system
+ * dynamic linker does: x87, SSE, AVX and AVX-512 state (mask 0xe7), so
+ * arguments in the upper halves of %ymm and %zmm registers, in %xmm8-31, and
+ * in the opmask registers survive binding. The save area is sized by CPUID
+ * and 64-byte aligned below the saved registers, with %rbx keeping the frame.
+ * Its header is cleared first, as `xrstor` requires of the standard format.
+ *
+ * Loaded code may run on a thread pointer from `prim_thread_pointer_call`,
+ * whose TCB holds the host's thread pointer at offset 16 and the address of
+ * `prim_thread_pointer_tag` at offset 24. Binding runs Prim's code, so the
+ * trampoline switches to the host's thread pointer with `arch_prctl(ARCH_SET_FS)` for
+ * the call to `bind`, keeping the loaded code's in %r12, and switches back
+ * before the tail call.
+ */
+__asm__(".text\n"
+        ".globl prim_plt_trampoline\n"
+        ".type prim_plt_trampoline, @function\n"
+        "prim_plt_trampoline:\n"
+        "    .cfi_startproc\n"
+        "    .cfi_adjust_cfa_offset 16\n"
+        "    pushq %rbx\n"
+        "    .cfi_adjust_cfa_offset 8\n"
+        "    .cfi_rel_offset %rbx, 0\n"
+        "    movq %rsp, %rbx\n"
+        "    .cfi_def_cfa_register %rbx\n"
+        "    pushq %r12\n"
+        "    .cfi_rel_offset %r12, -8\n"
+        "    pushq %r13\n"
+        "    .cfi_rel_offset %r13, -16\n"
+        "    pushq %rax\n"
+        "    pushq %rdi\n"
+        "    pushq %rsi\n"
+        "    pushq %rdx\n"
+        "    pushq %rcx\n"
+        "    pushq %r8\n"
+        "    pushq %r9\n"
+        "    pushq %r10\n"
+        "    subq prim_plt_xsave_size(%rip), %rsp\n"
+        "    andq $-64, %rsp\n"
+        "    movq $0, 512(%rsp)\n"
+        "    movq $0, 520(%rsp)\n"
+        "    movq $0, 528(%rsp)\n"
+        "    movq $0, 536(%rsp)\n"
+        "    movq $0, 544(%rsp)\n"
+        "    movq $0, 552(%rsp)\n"
+        "    movq $0, 560(%rsp)\n"
+        "    movq $0, 568(%rsp)\n"
+        "    movl $0xe7, %eax\n"
+        "    xorl %edx, %edx\n"
+        "    xsave (%rsp)\n"
+        "    xorl %r12d, %r12d\n"
+        "    leaq prim_thread_pointer_tag(%rip), %rax\n"
+        "    cmpq %fs:24, %rax\n"
+        "    jne 2f\n"
+        "    movq %fs:0, %r12\n"
+        "    movq %fs:16, %rsi\n"
+        "    movl $158, %eax\n"
+        "    movl $0x1002, %edi\n"
+        "    syscall\n"
+        "2:\n"
+        "    movq 8(%rbx), %rdi\n"
+        "    movq 16(%rbx), %rsi\n"
+        "    call *(%rdi)\n"
+        "    testq %r12, %r12\n"
+        "    jz 3f\n"
+        "    movq %rax, %r13\n"
+        "    movq %r12, %rsi\n"
+        "    movl $158, %eax\n"
+        "    movl $0x1002, %edi\n"
+        "    syscall\n"
+        "    movq %r13, %rax\n"
+        "3:\n"
+        "    testq %rax, %rax\n"
+        "    jz 1f\n"
+        "    movq %rax, %r11\n"
+        "    movl $0xe7, %eax\n"
+        "    xorl %edx, %edx\n"
+        "    xrstor (%rsp)\n"
+        "    leaq -80(%rbx), %rsp\n"
+        "    popq %r10\n"
+        "    popq %r9\n"
+        "    popq %r8\n"
+        "    popq %rcx\n"
+        "    popq %rdx\n"
+        "    popq %rsi\n"
+        "    popq %rdi\n"
+        "    popq %rax\n"
+        "    popq %r13\n"
+        "    popq %r12\n"
+        "    popq %rbx\n"
+        "    .cfi_def_cfa %rsp, 24\n"
+        "    .cfi_restore %rbx\n"
+        "    .cfi_restore %r12\n"
+        "    .cfi_restore %r13\n"
+        "    addq $16, %rsp\n"
+        "    .cfi_adjust_cfa_offset -16\n"
+        "    jmpq *%r11\n"
+        "1:\n"
+        "    ud2\n"
+        "    .cfi_endproc\n"
+        ".size prim_plt_trampoline, .-prim_plt_trampoline\n");
+
+/**
+ * Checks if the host supports lazy binding with `prim_plt_trampoline`.
+ *
+ * The trampoline needs `xsave` enabled by the host. Hosts without it bind
+ * every PLT entry eagerly instead.
+ *
+ * @return `STATUS_OKAY` if lazy binding is supported, `STATUS_INVALID`
+ * otherwise.
+ */
+extern PrimStatus prim_plt_is_supported(void)
+{
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (prim_plt_xsave_size != 0)
+    {
+        return STATUS_OKAY;
+    }
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)
+        || !(ecx & PRIM_PLT_CPUID_OSXSAVE))
+    {
+        return STATUS_INVALID;
+    }
+    /* `EBX` is the size of the state components the host has enabled. */
+    if (!__get_cpuid_count(PRIM_PLT_CPUID_XSAVE, 0, &eax, &ebx, &ecx, &edx)
+        || ebx < PRIM_PLT_XSAVE_MINIMUM_SIZE)
+    {
+        return STATUS_INVALID;
+    }
+    prim_plt_xsave_size = ebx;
+    return STATUS_OKAY;
+}
+
+#else
+
+/**
+ * The lazy binding trampoline. Unused on this host.
+ */
+extern void prim_plt_trampoline(void)
+{
+}
+
+/**
+ * Checks if the host supports lazy binding with `prim_plt_trampoline`.
+ *
+ * @return `STATUS_OKAY` if lazy binding is supported, `STATUS_INVALID`
+ * otherwise.
+ */
+extern PrimStatus prim_plt_is_supported(void)
+{
+    return STATUS_INVALID;
+}
+
+#endif
@@ -0,0 +1,27 @@
+/**
+ * @file src/platform/process.c
+ *
+ * Implements access to the host's description of the current process.
+ *
+ * @note This file is currently setup for a hosted C standard library.
+ *
+ * @see `include/platform/process.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "platform/process.h"
+#include <stdlib.h>
+
+/**
+ * Read an environment variable of the current process.
+ *
+ * @param name The variable to read, for example `LD_LIBRARY_PATH`.
+ * @return The variable's value, or `NULL` if it is not set.
+ */
+extern const char* prim_get_environment(const char* name)
+{
+    return getenv(name);
+}
@@ -0,0 +1,154 @@
+/**
+ * @file src/platform/thread.c
+ *
+ * Implements access to the host's threads.
+ *
+ * @note This file is currently setup for a POSIX userspace.
+ *
+ * @see `include/platform/thread.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "platform/thread.h"
+#include "platform/memory.h"
+#include "platform/types.h"
+#include "status.h"
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+/** Work shared between the threads of one `prim_parallel_for` call. */
+typedef struct
+{
+    /** The next work item to hand out. */
+    prim_usize next;
+
+    /** The number of work items. */
+    prim_usize count;
+
+    /** The task to run for each item. */
+    PrimTask task;
+
+    /** Passed unchanged to every call of `task`. */
+    void* context;
+} PrimParallelWork;
+
+/**
+ * Run work items until every item has been handed out.
+ *
+ * @param argument The shared `PrimParallelWork`.
+ * @return Always `NULL`.
+ */
+static void* prim_parallel_worker(void* argument)
+{
+    PrimParallelWork* work = (PrimParallelWork*) argument;
+    prim_usize index = 0;
+    for (;;)
+    {
+        index = __atomic_fetch_add(&work->next, 1, __ATOMIC_RELAXED);
+        if (index >= work->count)
+        {
+            return NULL;
+        }
+        work->task(work->context, index);
+    }
+}
+
+/**
+ * Get the number of threads the host can run at once.
+ *
+ * @return The number of online processors, and at least one.
+ */
+extern prim_usize prim_thread_count(void)
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (count < 1)
+    {
+        return 1;
+    }
+    return (prim_usize) count;
+}
+
+/**
+ * Run a task once for every index in `[0, count)`, spread across threads.
+ *
+ * The calling thread takes part in the work, and the function returns once
+ * every index has run. Indexes are handed out in increasing order, but may
+ * complete in any order.
+ *
+ * @param count The number of work items.
+ * @param task The task to run for each item.
+ * @param context Passed unchanged to every call of `task`.
+ * @return STATUS_OKAY once every item has run. Items run on the calling
+ * thread alone if no more threads can be started.
+ */
+extern PrimStatus prim_parallel_for(
+    const prim_usize count, const PrimTask task, void* const context)
+{
+    PrimParallelWork work = { 0, 0, NULL, NULL };
+    pthread_t* threads = NULL;
+    prim_usize thread_count = prim_thread_count();
+    prim_usize started = 0;
+    prim_usize i = 0;
+    work.count = count;
+    work.task = task;
+    work.context = context;
+    if (thread_count > count)
+    {
+        thread_count = count;
+    }
+    /* The calling thread is one of the workers. */
+    if (thread_count > 1
+        && prim_malloc((void**) &threads,
+               (thread_count - 1) * sizeof(pthread_t))
+            == STATUS_OKAY)
+    {
+        for (started = 0; started < thread_count - 1; started++)
+        {
+            if (pthread_create(
+                    &threads[started], NULL, prim_parallel_worker, &work)
+                != 0)
+            {
+                break;
+            }
+        }
+    }
+    prim_parallel_worker(&work);
+    for (i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    if (threads != NULL)
+    {
+        prim_free(threads);
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Take a lock, waiting until it is free.
+ *
+ * @param lock The lock to take.
+ */
+extern void prim_lock_acquire(PrimLock* lock)
+{
+    while (__atomic_exchange_n(&lock->held, 1, __ATOMIC_ACQUIRE) != 0)
+    {
+        sched_yield();
+    }
+}
+
+/**
+ * Release a lock held by the calling thread.
+ *
+ * @param lock The lock to release.
+ */
+extern void prim_lock_release(PrimLock* lock)
+{
+    __atomic_store_n(&lock->held, 0, __ATOMIC_RELEASE);
+}
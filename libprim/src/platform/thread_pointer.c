@@ -0,0 +1,159 @@
+/**
+ * @file src/platform/thread_pointer.c
+ *
+ * Implements running loaded code on a switched thread pointer.
+ *
+ * @note This file is currently setup for Linux on AMD64, where the thread
+ * pointer is the `%fs` base. Other hosts report switching as unsupported.
+ *
+ * @see `include/platform/thread_pointer.h`
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "platform/thread_pointer.h"
+#include "platform/types.h"
+#include "status.h"
+#include <stddef.h>
+
+/** Marks the TCBs of thread pointers switched to by Prim. Never read. */
+__attribute__((visibility("hidden"))) const prim_u8 prim_thread_pointer_tag = 0;
+
+#if defined(__x86_64__) && defined(__GNUC__) && defined(__linux__)
+
+/**
+ * Switch the thread pointer, call a function, and switch back.
+ *
+ * @param thread_pointer The thread pointer to call the function on.
+ * @param function The function to call.
+ * @param result Location to return the function's result.
+ * @return Zero on success, or the negated error of the failed switch.
+ */
+extern long prim_thread_pointer_switch_call(
+    void* thread_pointer, int (*function)(void), int* result);
+
+/*
+ * `arch_prctl(ARCH_SET_FS)` is made directly, because the C library relies
+ * on the thread pointer it set up, so must not run while it is switched. The
+ * host's thread pointer is read from the first word of its TCB, and kept in
+ * %r12 across the call. Three pushes keep the stack 16-byte aligned.
+ */
+__asm__(".text\n"
+        ".globl prim_thread_pointer_switch_call\n"
+        ".hidden prim_thread_pointer_switch_call\n"
+        ".type prim_thread_pointer_switch_call, @function\n"
+        "prim_thread_pointer_switch_call:\n"
+        "    .cfi_startproc\n"
+        "    pushq %rbx\n"
+        "    .cfi_adjust_cfa_offset 8\n"
+        "    .cfi_rel_offset %rbx, 0\n"
+        "    pushq %r12\n"
+        "    .cfi_adjust_cfa_offset 8\n"
+        "    .cfi_rel_offset %r12, 0\n"
+        "    pushq %r13\n"
+        "    .cfi_adjust_cfa_offset 8\n"
+        "    .cfi_rel_offset %r13, 0\n"
+        "    movq %fs:0, %r12\n"
+        "    movq %rsi, %rbx\n"
+        "    movq %rdx, %r13\n"
+        "    movq %rdi, %rsi\n"
+        "    movl $158, %eax\n"
+        "    movl $0x1002, %edi\n"
+        "    syscall\n"
+        "    testq %rax, %rax\n"
+        "    jnz 1f\n"
+        "    call *%rbx\n"
+        "    movl %eax, (%r13)\n"
+        "    movl $158, %eax\n"
+        "    movl $0x1002, %edi\n"
+        "    movq %r12, %rsi\n"
+        "    syscall\n"
+        "1:\n"
+        "    popq %r13\n"
+        "    .cfi_adjust_cfa_offset -8\n"
+        "    .cfi_restore %r13\n"
+        "    popq %r12\n"
+        "    .cfi_adjust_cfa_offset -8\n"
+        "    .cfi_restore %r12\n"
+        "    popq %rbx\n"
+        "    .cfi_adjust_cfa_offset -8\n"
+        "    .cfi_restore %rbx\n"
+        "    ret\n"
+        "    .cfi_endproc\n"
+        ".size prim_thread_pointer_switch_call, "
+        ".-prim_thread_pointer_switch_call\n");
+
+/**
+ * Checks if the host supports switching the thread pointer.
+ *
+ * @return `STATUS_OKAY` if the thread pointer can be switched,
+ * `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus prim_thread_pointer_is_supported(void)
+{
+    return STATUS_OKAY;
+}
+
+/**
+ * Call an `int (void)` function with the thread pointer switched, then
+ * switch back to the host's thread pointer.
+ *
+ * @param thread_pointer The thread pointer to call the function on. Its TCB
+ * must be at least `PRIM_THREAD_POINTER_TCB_SIZE` bytes, with its first word
+ * pointing to itself.
+ * @param function The function to call.
+ * @param result Location to return the function's result.
+ * @return STATUS_OKAY if the function was called, STATUS_INVALID if the host
+ * does not support switching the thread pointer, otherwise an error code.
+ */
+extern PrimStatus prim_thread_pointer_call(
+    void* thread_pointer, int (*function)(void), int* result)
+{
+    prim_u8* tcb = (prim_u8*) thread_pointer;
+    void* host = NULL;
+    __asm__ volatile("movq %%fs:0, %0" : "=r"(host));
+    *(void**) (tcb + PRIM_THREAD_POINTER_HOST_OFFSET) = host;
+    *(const void**) (tcb + PRIM_THREAD_POINTER_TAG_OFFSET)
+        = &prim_thread_pointer_tag;
+    if (prim_thread_pointer_switch_call(thread_pointer, function, result)
+        != 0)
+    {
+        return STATUS_ERROR;
+    }
+    return STATUS_OKAY;
+}
+
+#else
+
+/**
+ * Checks if the host supports switching the thread pointer.
+ *
+ * @return `STATUS_OKAY` if the thread pointer can be switched,
+ * `STATUS_INVALID` otherwise.
+ */
+extern PrimStatus prim_thread_pointer_is_supported(void)
+{
+    return STATUS_INVALID;
+}
+
+/**
+ * Call an `int (void)` function with the thread pointer switched. Not
+ * supported on this host.
+ *
+ * @param thread_pointer Unused.
+ * @param function Unused.
+ * @param result Unused.
+ * @return STATUS_INVALID.
+ */
+extern PrimStatus prim_thread_pointer_call(
+    void* thread_pointer, int (*function)(void), int* result)
+{
+    (void) thread_pointer;
+    (void) function;
+    (void) result;
+    return STATUS_INVALID;
+}
+
+#endif
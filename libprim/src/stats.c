@@ -0,0 +1,194 @@
+/**
+ * @file stats.c
+ *
+ * Counters and per-phase timers describing where Prim spends its time.
+ *
+ * @see stats.h
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "stats.h"
+#include "platform/types.h"
+#include "status.h"
+#include <string.h>
+
+/** Associates a counter with a human readable name. */
+struct CounterString
+{
+    const PrimStatsCounter counter;
+    const char* const name;
+};
+
+/** Associates a phase with a human readable name. */
+struct PhaseString
+{
+    const PrimStatsPhase phase;
+    const char* const name;
+};
+
+/** Maps counters to human readable names. */
+static const struct CounterString counter_strings[] = {
+    { PRIM_STATS_OPENS, "opens" },
+    { PRIM_STATS_PROBES, "probes" },
+    { PRIM_STATS_READS, "reads" },
+    { PRIM_STATS_SEEKS, "seeks" },
+    { PRIM_STATS_MAPS, "maps" },
+    { PRIM_STATS_BYTES_READ, "bytes read" },
+    { PRIM_STATS_ALLOCATIONS, "allocations" },
+    { PRIM_STATS_BYTES_ALLOCATED, "bytes allocated" },
+    { PRIM_STATS_RELOCATIONS, "relocations" },
+    { PRIM_STATS_SYMBOL_LOOKUPS, "symbol lookups" },
+    { PRIM_STATS_SYMBOL_CACHE_HITS, "symbol cache hits" },
+    { PRIM_STATS_LAZY_BINDS, "lazy binds" },
+};
+
+/** Maps phases to human readable names. */
+static const struct PhaseString phase_strings[] = {
+    { PRIM_PHASE_HEADER, "header" },
+    { PRIM_PHASE_TABLES, "tables" },
+    { PRIM_PHASE_STRINGS, "strings" },
+    { PRIM_PHASE_SYMBOLS, "symbols" },
+    { PRIM_PHASE_RESOLVE, "resolve" },
+    { PRIM_PHASE_LOAD, "load" },
+    { PRIM_PHASE_RELOCATE, "relocate" },
+};
+
+/** Process wide statistics. */
+static PrimStats prim_stats;
+
+/**
+ * Atomically add to a statistic, so parallel work is counted correctly.
+ *
+ * @param total The statistic to add to.
+ * @param amount The amount to add.
+ */
+static void prim_stats_add(prim_u64* total, const prim_u64 amount)
+{
+    __atomic_fetch_add(total, amount, __ATOMIC_RELAXED);
+}
+
+/**
+ * Add to one of Prim's counters.
+ *
+ * @note Use `PRIM_STATS_ADD`, which compiles away when statistics are
+ * disabled, rather than calling this function directly.
+ *
+ * @param counter The counter to add to.
+ * @param amount The amount to add.
+ */
+extern void prim_stats_add_count(
+    const PrimStatsCounter counter, const prim_u64 amount)
+{
+    if (counter < PRIM_STATS_COUNTER_COUNT)
+    {
+        prim_stats_add(&prim_stats.counters[counter], amount);
+    }
+}
+
+/**
+ * Charge time to one of Prim's phases.
+ *
+ * @note Use `PRIM_STATS_PHASE_BEGIN` and `PRIM_STATS_PHASE_END`, which compile
+ * away when statistics are disabled, rather than calling this function
+ * directly.
+ *
+ * @param phase The phase to charge.
+ * @param time The time spent in the phase, in nanoseconds.
+ */
+extern void prim_stats_add_phase_time(
+    const PrimStatsPhase phase, const prim_u64 time)
+{
+    if (phase < PRIM_PHASE_COUNT)
+    {
+        prim_stats_add(&prim_stats.phase_time[phase], time);
+        prim_stats_add(&prim_stats.phase_entries[phase], 1);
+    }
+}
+
+/**
+ * Checks if Prim was built to collect statistics.
+ *
+ * @return `STATUS_OKAY` if statistics are collected, `STATUS_INVALID`
+ * otherwise.
+ */
+extern PrimStatus prim_stats_is_enabled(void)
+{
+#ifdef PRIM_ENABLE_STATS
+    return STATUS_OKAY;
+#else
+    return STATUS_INVALID;
+#endif
+}
+
+/**
+ * Take a snapshot of Prim's statistics.
+ *
+ * @param stats Location to return the snapshot.
+ */
+extern void prim_stats_get(PrimStats* stats)
+{
+    unsigned int i = 0;
+    for (i = 0; i < PRIM_STATS_COUNTER_COUNT; i++)
+    {
+        stats->counters[i]
+            = __atomic_load_n(&prim_stats.counters[i], __ATOMIC_RELAXED);
+    }
+    for (i = 0; i < PRIM_PHASE_COUNT; i++)
+    {
+        stats->phase_time[i]
+            = __atomic_load_n(&prim_stats.phase_time[i], __ATOMIC_RELAXED);
+        stats->phase_entries[i]
+            = __atomic_load_n(&prim_stats.phase_entries[i], __ATOMIC_RELAXED);
+    }
+}
+
+/** Reset all of Prim's statistics to zero. */
+extern void prim_stats_reset(void)
+{
+    memset(&prim_stats, 0, sizeof(PrimStats));
+}
+
+/**
+ * Get a string with a human readable counter name.
+ *
+ * @param counter The counter to string-ify.
+ * @return A human readable counter name.
+ */
+extern const char* prim_stats_get_counter_string(
+    const PrimStatsCounter counter)
+{
+    static const char* const unrecognised_counter = "<STATS_COUNTER_INVALID>";
+    unsigned int i = 0;
+    for (i = 0; i < sizeof(counter_strings) / sizeof(struct CounterString);
+         i++)
+    {
+        if (counter_strings[i].counter == counter)
+        {
+            return counter_strings[i].name;
+        }
+    }
+    return unrecognised_counter;
+}
+
+/**
+ * Get a string with a human readable phase name.
+ *
+ * @param phase The phase to string-ify.
+ * @return A human readable phase name.
+ */
+extern const char* prim_stats_get_phase_string(const PrimStatsPhase phase)
+{
+    static const char* const unrecognised_phase = "<STATS_PHASE_INVALID>";
+    unsigned int i = 0;
+    for (i = 0; i < sizeof(phase_strings) / sizeof(struct PhaseString); i++)
+    {
+        if (phase_strings[i].phase == phase)
+        {
+            return phase_strings[i].name;
+        }
+    }
+    return unrecognised_phase;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file commands.h
+ *
+ * Sub-commands provided by the Prim driver application, in addition to the
+ * default binary dump.
+ *
+ * Each command receives the arguments following the command name, with the
+ * command name itself in `argv[0]`, and returns a process exit status.
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+/**
+ * `prim archive [--find=<symbol>] <archive>`
+ *
+ * List the members of an `ar` archive, with the global symbols each defines
+ * and needs. Members are parsed in parallel. With `--find`, only report the
+ * member which defines a symbol, from the archive's symbol index.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` if the archive was read, and any symbol found,
+ * `EXIT_FAILURE` otherwise.
+ */
+extern int prim_command_archive(int argc, char* argv[]);
+
+/**
+ * `prim core [--read=<address>:<length>] <core>`
+ *
+ * Summarise an ELF64 core file: its threads, with the signal each stopped
+ * with and its instruction and stack pointers, and the files mapped into the
+ * process. The core is read a window at a time. With `--read`, also print a
+ * range of the saved memory.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` if the core, and any requested memory, was read,
+ * `EXIT_FAILURE` otherwise.
+ */
+extern int prim_command_core(int argc, char* argv[]);
+
+/**
+ * `prim diff <file> <file>`
+ *
+ * Report which sections and exported symbols changed between two binaries.
+ * Sections are matched by name and compared by content hash, hashed in
+ * parallel; only sections whose hashes differ are compared byte by byte, to
+ * count the changed chunks. Symbols are matched by name, and reported when
+ * added, removed or resized.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` if both binaries were compared, `EXIT_FAILURE`
+ * otherwise.
+ */
+extern int prim_command_diff(int argc, char* argv[]);
+
+/**
+ * `prim hash <file>`
+ *
+ * Print a fingerprint table for a binary: the 128-bit content hash of each
+ * section and each `PT_LOAD` segment, as stored in the file. Sections are
+ * hashed in parallel. Identical fingerprints across binaries mark contents
+ * which can be deduplicated.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` if every section and segment was hashed,
+ * `EXIT_FAILURE` otherwise.
+ */
+extern int prim_command_hash(int argc, char* argv[]);
+
+/**
+ * `prim index [--update] <index> <path>...`
+ * `prim index --find=<symbol> <index>`
+ *
+ * Build an index of the global symbols a set of binaries define and import.
+ * Directories are walked for the files beneath them, and the binaries are
+ * parsed in parallel. With `--update`, the binaries already in the index are
+ * kept, and only those whose identity and build ID have both changed since
+ * are parsed again. With `--find`, list the binaries which define or import
+ * a symbol, from the index alone.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` if the index was written, or the symbol found,
+ * `EXIT_FAILURE` otherwise.
+ */
+extern int prim_command_index(int argc, char* argv[]);
+
+/**
+ * `prim load [--perf-map] [--jitdump[=<directory>]] [--deps [--serial]
+ * [--library-cache=<file>] [--relocate] [--bind-now] [--snapshot=<file>]
+ * [--call=<symbol>] [--record-profile=<file>]] [--instances=<n>]
+ * [--share-files] [--huge-text] [--readahead=<policy>
+ * [--readahead-threshold=<bytes>]] [--page-profile=<file>] <file>`
+ *
+ * Load a binary into the Prim process, report where it was loaded, and
+ * unload it. With `--deps`, the libraries it needs are loaded too, and
+ * `--relocate` relocates them, binding PLT entries on first call unless
+ * `--bind-now` is given. `--snapshot` restores the relocated images from a
+ * snapshot file, or relocates them and saves one. `--call` relocates the
+ * images and calls an `int (void)` function from them before unloading.
+ * Without `--deps`, `--instances` loads the binary several times at once.
+ * `--share-files` shares each binary's file mapping between the images
+ * loaded from it. `--huge-text` backs code with huge pages where it can,
+ * and reports how many each image got. `--readahead` reads each segment
+ * ahead once mapped: `populate`, `willneed`, `sequential` and `random` give
+ * every segment that advice, `flags` chooses from the segment's flags, and
+ * `size` populates segments up to `--readahead-threshold` bytes.
+ * `--record-profile` records the pages each image touched by the time it
+ * was loaded, or its function returned, in a page profile, and
+ * `--page-profile` replays one in place of `--readahead`.
+ *
+ * Binaries which need the system C library can be loaded, but not relocated:
+ * its IFUNC resolvers need state only the system dynamic linker sets up, so
+ * `--relocate`, `--bind-now`, `--snapshot` and `--call` fail for them.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` if the binary was loaded, `EXIT_FAILURE` otherwise.
+ */
+extern int prim_command_load(int argc, char* argv[]);
+
+/**
+ * `prim run <file> [<argument>...]`
+ *
+ * Load a static executable with the Prim loader, and run it in place of Prim
+ * with the given arguments and Prim's environment. The executable's exit
+ * status becomes Prim's.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_FAILURE` if the executable could not be run. Does not return
+ * otherwise.
+ */
+extern int prim_command_run(int argc, char* argv[]);
+
+/**
+ * `prim serve [--library-cache=<file>] [--bind-now] [--snapshot=<file>]
+ * [--huge-text] --call=<symbol> <file>`
+ *
+ * Load and relocate a binary and the libraries it needs once, then serve
+ * run requests as a fork server. Each run forks a child which calls an
+ * `int (void)` function and exits with its result. `--bind-now` binds every
+ * PLT entry in the server, rather than again in each child. `--snapshot`
+ * restores the relocated images from a snapshot file, or saves one.
+ * `--huge-text` backs code with huge pages, which every child shares.
+ *
+ * As with `prim load`, binaries which need the system C library can not be
+ * relocated, so can not be served.
+ *
+ * The server talks to its client through two inherited descriptors, each
+ * message a native endian 32 bit word:
+ *
+ * - Once loaded, the server writes a word to descriptor 199.
+ * - Each word the client writes to descriptor 198 requests a run. The server
+ *   replies on 199 with the child's process ID, then its wait status.
+ * - The server unloads the binary and exits when 198 is closed.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` once the client closes the control pipe,
+ * `EXIT_FAILURE` otherwise.
+ */
+extern int prim_command_serve(int argc, char* argv[]);
+
+#endif
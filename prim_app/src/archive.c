@@ -0,0 +1,159 @@
+/**
+ * @file archive.c
+ *
+ * Implements the `prim archive` command.
+ *
+ * @see commands.h
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "commands.h"
+#include "format/ar/archive.h"
+#include "format/elf64/image.h"
+#include "format/elf64/section/symbol.h"
+#include "format/elf64/section/type.h"
+#include "platform/types.h"
+#include "status.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** What `prim archive` learned about a member. */
+struct Member_Summary
+{
+    /** The result of parsing the member. */
+    PrimStatus status;
+
+    /** Number of global symbols the member defines. */
+    prim_usize defined;
+
+    /** Number of symbols the member needs from elsewhere. */
+    prim_usize undefined;
+};
+
+/**
+ * Count the global symbols an archive member defines and needs.
+ *
+ * @param context The array of `Member_Summary`s to fill in.
+ * @param archive The archive.
+ * @param index Index of the member.
+ */
+static void prim_archive_summarise(
+    void* context, const Ar_Archive* archive, const prim_usize index)
+{
+    struct Member_Summary* summary = (struct Member_Summary*) context + index;
+    const Elf64_Symbol_Table* table = NULL;
+    Elf64_Image image;
+    Elf64_Word i = 0;
+    summary->status = ar_member_open_image(&archive->members[index], &image);
+    if (summary->status != STATUS_OKAY)
+    {
+        return;
+    }
+    summary->status = elf64_image_get_symbol_table(
+        &image, ELF64_SECTION_TYPE_SYMBOL_TABLE, &table);
+    for (i = 0; summary->status == STATUS_OKAY && i < table->count; i++)
+    {
+        if (elf64_get_symbol_binding(&table->symbols[i]) == ELF64_STB_LOCAL)
+        {
+            continue;
+        }
+        if (elf64_get_symbol_section(&table->symbols[i]) == ELF64_SHN_UNDEF)
+        {
+            summary->undefined++;
+        }
+        else
+        {
+            summary->defined++;
+        }
+    }
+    elf64_image_close(&image);
+}
+
+/**
+ * `prim archive [--find=<symbol>] <archive>`
+ *
+ * List the members of an `ar` archive, with the global symbols each defines
+ * and needs. Members are parsed in parallel. With `--find`, only report the
+ * member which defines a symbol, from the archive's symbol index.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` if the archive was read, and any symbol found,
+ * `EXIT_FAILURE` otherwise.
+ */
+extern int prim_command_archive(int argc, char* argv[])
+{
+    PrimStatus status = STATUS_ERROR;
+    Ar_Archive archive;
+    struct Member_Summary* summaries = NULL;
+    const Ar_Member* member = NULL;
+    const char* symbol = NULL;
+    prim_usize index = 0;
+    int arg = 1;
+    if (argc == 3 && strncmp(argv[1], "--find=", strlen("--find=")) == 0)
+    {
+        symbol = argv[1] + strlen("--find=");
+        arg = 2;
+    }
+    if (arg != argc - 1)
+    {
+        printf("Usage: prim archive [--find=<symbol>] <archive>\n");
+        return EXIT_FAILURE;
+    }
+    status = ar_archive_open(&archive, argv[arg]);
+    if (status != STATUS_OKAY)
+    {
+        printf("Open failed: %s\n", get_status_string(status));
+        return EXIT_FAILURE;
+    }
+    if (symbol != NULL)
+    {
+        status = ar_archive_find_symbol(&archive, symbol, &index);
+        if (status == STATUS_OKAY)
+        {
+            member = &archive.members[index];
+            printf("%s is defined by %.*s\n", symbol, (int) member->name_length,
+                member->name);
+        }
+        else
+        {
+            printf("%s is not in the symbol index\n", symbol);
+        }
+        ar_archive_close(&archive);
+        return status == STATUS_OKAY ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    summaries = (struct Member_Summary*) calloc(
+        archive.member_count + 1, sizeof(struct Member_Summary));
+    if (summaries == NULL)
+    {
+        printf("Open failed: %s\n", get_status_string(STATUS_ERROR));
+        ar_archive_close(&archive);
+        return EXIT_FAILURE;
+    }
+    ar_archive_parse_members(&archive, prim_archive_summarise, summaries);
+    printf("%lu members, %lu indexed symbols\n", archive.member_count,
+        archive.symbol_count);
+    for (index = 0; index < archive.member_count; index++)
+    {
+        member = &archive.members[index];
+        if (summaries[index].status == STATUS_OKAY)
+        {
+            printf("  %.*s: 0x%lx bytes, %lu defined, %lu undefined\n",
+                (int) member->name_length, member->name, member->size,
+                summaries[index].defined, summaries[index].undefined);
+        }
+        else
+        {
+            printf("  %.*s: 0x%lx bytes, %s\n", (int) member->name_length,
+                member->name, member->size,
+                get_status_string(summaries[index].status));
+        }
+    }
+    free(summaries);
+    ar_archive_close(&archive);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file core.c
+ *
+ * Implements the `prim core` command.
+ *
+ * @see commands.h
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "commands.h"
+#include "format/elf64/core.h"
+#include "platform/types.h"
+#include "status.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Bytes printed on each line of a memory dump. */
+#define PRIM_CORE_DUMP_WIDTH 16
+
+/**
+ * Print a range of process memory saved in a core, in hexadecimal.
+ *
+ * @param core The core to read.
+ * @param address The first address to print.
+ * @param size Number of bytes to print.
+ * @return `STATUS_OKAY` on success, `STATUS_INVALID` if any of the range was
+ * not saved, otherwise an error code.
+ */
+static PrimStatus prim_core_dump(
+    Elf64_Core* core, Elf64_Address address, prim_usize size)
+{
+    PrimStatus status = STATUS_ERROR;
+    prim_u8 line[PRIM_CORE_DUMP_WIDTH];
+    prim_usize length = 0;
+    prim_usize i = 0;
+    while (size > 0)
+    {
+        length = size < PRIM_CORE_DUMP_WIDTH ? size : PRIM_CORE_DUMP_WIDTH;
+        status = elf64_core_read(core, address, line, length);
+        if (status != STATUS_OKAY)
+        {
+            return status;
+        }
+        printf("  0x%016lx:", address);
+        for (i = 0; i < length; i++)
+        {
+            printf(" %02x", line[i]);
+        }
+        printf("\n");
+        address += length;
+        size -= length;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * `prim core [--read=<address>:<length>] <core>`
+ *
+ * Summarise an ELF64 core file: its threads, with the signal each stopped
+ * with and its instruction and stack pointers, and the files mapped into the
+ * process. The core is read a window at a time. With `--read`, also print a
+ * range of the saved memory.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` if the core, and any requested memory, was read,
+ * `EXIT_FAILURE` otherwise.
+ */
+extern int prim_command_core(int argc, char* argv[])
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Core core;
+    const Elf64_Core_Thread* thread = NULL;
+    const Elf64_Core_File* file = NULL;
+    Elf64_Address address = 0;
+    prim_usize length = 0;
+    prim_usize i = 0;
+    char* end = NULL;
+    int arg = 1;
+    if (argc == 3 && strncmp(argv[1], "--read=", strlen("--read=")) == 0)
+    {
+        address = strtoul(argv[1] + strlen("--read="), &end, 0);
+        length = *end == ':' ? strtoul(end + 1, &end, 0) : 0;
+        arg = *end == '\0' && length != 0 ? 2 : argc;
+    }
+    if (arg != argc - 1)
+    {
+        printf("Usage: prim core [--read=<address>:<length>] <core>\n");
+        return EXIT_FAILURE;
+    }
+    status = elf64_core_open(&core, argv[arg], 0, 0);
+    if (status != STATUS_OKAY)
+    {
+        printf("Open failed: %s\n", get_status_string(status));
+        return EXIT_FAILURE;
+    }
+    printf("%lu threads, %lu saved ranges, %lu mapped files\n",
+        core.thread_count, core.segment_count, core.file_count);
+    for (i = 0; i < core.thread_count; i++)
+    {
+        thread = &core.threads[i];
+        printf("  Thread %u: signal %u, rip 0x%lx, rsp 0x%lx\n", thread->pid,
+            thread->signal, thread->registers[ELF64_CORE_REGISTER_RIP],
+            thread->registers[ELF64_CORE_REGISTER_RSP]);
+    }
+    for (i = 0; i < core.file_count; i++)
+    {
+        file = &core.files[i];
+        printf("  0x%lx-0x%lx at 0x%lx: %s\n", file->start, file->end,
+            file->offset, file->path);
+    }
+    if (length != 0)
+    {
+        status = prim_core_dump(&core, address, length);
+        if (status != STATUS_OKAY)
+        {
+            printf("Read failed: %s\n", get_status_string(status));
+        }
+    }
+    elf64_core_close(&core);
+    return status == STATUS_OKAY ? EXIT_SUCCESS : EXIT_FAILURE;
+}
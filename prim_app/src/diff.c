@@ -0,0 +1,417 @@
+/**
+ * @file diff.c
+ *
+ * Implements the `prim diff` command.
+ *
+ * @see commands.h
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "commands.h"
+#include "format/elf64/image.h"
+#include "format/elf64/section/hash.h"
+#include "format/elf64/section/symbol.h"
+#include "format/elf64/section/type.h"
+#include "hash.h"
+#include "platform/types.h"
+#include "status.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Changed sections are compared in chunks of this many bytes. */
+#define PRIM_DIFF_CHUNK_SIZE 64
+
+/** A binary being compared. */
+struct Diff_Side
+{
+    /** The binary. */
+    Elf64_Image image;
+
+    /** Each section's content hash. */
+    PrimHash128* hashes;
+
+    /** Non-zero for each section matched by name in the other binary. */
+    char* matched;
+
+    /** The symbol table compared. */
+    const Elf64_Symbol_Table* symbols;
+
+    /**
+     * Open addressed hash table of exported symbols, keyed by name. Slots
+     * hold a symbol index plus one, so zero marks an empty slot.
+     */
+    Elf64_Word* slots;
+
+    /** One less than the number of slots, a power of two. */
+    prim_usize mask;
+};
+
+/**
+ * Checks if a symbol is one a binary defines for others.
+ *
+ * @param symbol The symbol to check.
+ * @return Non-zero if the symbol is defined and not local.
+ */
+static int prim_diff_is_exported(const Elf64_Symbol* symbol)
+{
+    return elf64_get_symbol_section(symbol) != ELF64_SHN_UNDEF
+        && elf64_get_symbol_binding(symbol) != ELF64_STB_LOCAL;
+}
+
+/**
+ * Find an exported symbol by name.
+ *
+ * @param side The binary to search.
+ * @param name The name to find.
+ * @return The symbol, or `NULL` if the binary does not export it.
+ */
+static const Elf64_Symbol* prim_diff_find_symbol(
+    const struct Diff_Side* side, const char* name)
+{
+    const Elf64_Symbol* symbol = NULL;
+    const char* candidate = NULL;
+    prim_usize slot = elf64_gnu_hash(name) & side->mask;
+    while (side->slots[slot] != 0)
+    {
+        symbol = &side->symbols->symbols[side->slots[slot] - 1];
+        if (elf64_symbol_table_get_name(side->symbols, symbol, &candidate)
+                == STATUS_OKAY
+            && strcmp(candidate, name) == 0)
+        {
+            return symbol;
+        }
+        slot = (slot + 1) & side->mask;
+    }
+    return NULL;
+}
+
+/**
+ * Open a binary to compare, hash its sections, and index its exported
+ * symbols by name. The static symbol table is used if the binary has one,
+ * otherwise the dynamic symbol table.
+ *
+ * @param side The binary to initialise.
+ * @param path Path to the binary.
+ * @return `STATUS_OKAY` on success, otherwise an error code.
+ */
+static PrimStatus prim_diff_open(struct Diff_Side* side, const char* path)
+{
+    PrimStatus status = STATUS_ERROR;
+    const Elf64_Symbol* symbol = NULL;
+    const char* name = NULL;
+    prim_usize count = 0;
+    prim_usize slot = 0;
+    Elf64_Word i = 0;
+    memset(side, 0, sizeof(struct Diff_Side));
+    status = elf64_image_open(&side->image, path);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    count = side->image.header->sh_entry_count;
+    side->hashes = (PrimHash128*) calloc(count + 1, sizeof(PrimHash128));
+    side->matched = (char*) calloc(count + 1, sizeof(char));
+    if (side->hashes == NULL || side->matched == NULL)
+    {
+        return STATUS_ERROR;
+    }
+    /* Sections which can not be hashed lie outside the binary; see below. */
+    elf64_image_hash_sections(&side->image, side->hashes);
+    status = elf64_image_get_symbol_table(
+        &side->image, ELF64_SECTION_TYPE_SYMBOL_TABLE, &side->symbols);
+    if (status == STATUS_OKAY && side->symbols->count == 0)
+    {
+        status = elf64_image_get_symbol_table(
+            &side->image, ELF64_SECTION_TYPE_DYNSYM, &side->symbols);
+    }
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    for (count = 1; count < 2 * (prim_usize) side->symbols->count; count <<= 1)
+        ;
+    side->mask = count - 1;
+    side->slots = (Elf64_Word*) calloc(count, sizeof(Elf64_Word));
+    if (side->slots == NULL)
+    {
+        return STATUS_ERROR;
+    }
+    for (i = 0; i < side->symbols->count; i++)
+    {
+        symbol = &side->symbols->symbols[i];
+        if (!prim_diff_is_exported(symbol)
+            || elf64_symbol_table_get_name(side->symbols, symbol, &name)
+                != STATUS_OKAY
+            || *name == '\0' || prim_diff_find_symbol(side, name) != NULL)
+        {
+            continue;
+        }
+        slot = elf64_gnu_hash(name) & side->mask;
+        while (side->slots[slot] != 0)
+        {
+            slot = (slot + 1) & side->mask;
+        }
+        side->slots[slot] = i + 1;
+    }
+    return STATUS_OKAY;
+}
+
+/**
+ * Release a binary opened by `prim_diff_open`, even if opening it failed.
+ *
+ * @param side The binary to close.
+ */
+static void prim_diff_close(struct Diff_Side* side)
+{
+    free(side->hashes);
+    free(side->matched);
+    free(side->slots);
+    elf64_image_close(&side->image);
+}
+
+/**
+ * Count the chunks of a section which changed between two binaries.
+ *
+ * Chunks past the end of the shorter section all count as changed.
+ *
+ * @param a The section in the first binary, or `NULL` if it has no contents.
+ * @param a_size Length of the first section.
+ * @param b The section in the second binary, or `NULL` if it has no contents.
+ * @param b_size Length of the second section.
+ * @param first Location to return the offset of the first changed chunk.
+ * @return The number of changed chunks.
+ */
+static prim_usize prim_diff_compare(const prim_u8* a, const prim_usize a_size,
+    const prim_u8* b, const prim_usize b_size, prim_usize* first)
+{
+    prim_usize common = a_size < b_size ? a_size : b_size;
+    prim_usize longest = a_size < b_size ? b_size : a_size;
+    prim_usize changed = 0;
+    prim_usize offset = 0;
+    prim_usize length = 0;
+    if (a == NULL || b == NULL)
+    {
+        common = 0;
+    }
+    *first = common;
+    for (offset = 0; offset < common; offset += PRIM_DIFF_CHUNK_SIZE)
+    {
+        length = common - offset;
+        length = length < PRIM_DIFF_CHUNK_SIZE ? length : PRIM_DIFF_CHUNK_SIZE;
+        if (memcmp(a + offset, b + offset, length) != 0)
+        {
+            *first = changed == 0 ? offset : *first;
+            changed++;
+        }
+    }
+    return changed
+        + (longest + PRIM_DIFF_CHUNK_SIZE - 1) / PRIM_DIFF_CHUNK_SIZE
+        - (common + PRIM_DIFF_CHUNK_SIZE - 1) / PRIM_DIFF_CHUNK_SIZE;
+}
+
+/**
+ * Report the sections which were added, removed or changed between two
+ * binaries. Sections are matched by name, and only sections whose hashes
+ * differ are compared byte by byte. Sections which occupy no space in the
+ * binary are compared by size, and sections which lie outside the binary are
+ * reported as unreadable.
+ *
+ * @param a The first binary.
+ * @param b The second binary.
+ */
+static void prim_diff_sections(struct Diff_Side* a, struct Diff_Side* b)
+{
+    const ELF64_Section_Header* a_header = NULL;
+    const ELF64_Section_Header* b_header = NULL;
+    const void* a_data = NULL;
+    const void* b_data = NULL;
+    const char* name = NULL;
+    prim_usize unchanged = 0;
+    prim_usize changed = 0;
+    prim_usize longest = 0;
+    prim_usize first = 0;
+    Elf64_Word i = 0;
+    Elf64_Word j = 0;
+    printf("Sections:\n");
+    for (i = 1; i < a->image.header->sh_entry_count; i++)
+    {
+        if (elf64_image_get_section_name(&a->image, i, &name) != STATUS_OKAY
+            || *name == '\0')
+        {
+            continue;
+        }
+        elf64_image_get_section_header(&a->image, i, &a_header);
+        if (elf64_image_find_section(&b->image, name, &j) != STATUS_OKAY)
+        {
+            printf("  removed  %-24s 0x%lx\n", name, a_header->size);
+            continue;
+        }
+        b->matched[j] = 1;
+        elf64_image_get_section_header(&b->image, j, &b_header);
+        if (elf64_image_get_section_data(&a->image, i, &a_data) != STATUS_OKAY
+            || elf64_image_get_section_data(&b->image, j, &b_data)
+                != STATUS_OKAY)
+        {
+            printf("  unreadable %-22s 0x%lx -> 0x%lx\n", name,
+                a_header->size, b_header->size);
+            continue;
+        }
+        if (a_header->size == b_header->size
+            && a->hashes[i].low == b->hashes[j].low
+            && a->hashes[i].high == b->hashes[j].high)
+        {
+            unchanged++;
+            continue;
+        }
+        if (a_header->type == ELF64_SECTION_TYPE_NOBITS
+            && b_header->type == ELF64_SECTION_TYPE_NOBITS)
+        {
+            printf("  changed  %-24s 0x%lx -> 0x%lx\n", name, a_header->size,
+                b_header->size);
+            continue;
+        }
+        changed = prim_diff_compare((const prim_u8*) a_data, a_header->size,
+            (const prim_u8*) b_data, b_header->size, &first);
+        longest = a_header->size < b_header->size ? b_header->size
+                                                  : a_header->size;
+        printf("  changed  %-24s 0x%lx -> 0x%lx, %lu of %lu chunks differ, "
+               "first at 0x%lx\n",
+            name, a_header->size, b_header->size, changed,
+            (longest + PRIM_DIFF_CHUNK_SIZE - 1) / PRIM_DIFF_CHUNK_SIZE,
+            first);
+    }
+    for (j = 1; j < b->image.header->sh_entry_count; j++)
+    {
+        if (!b->matched[j]
+            && elf64_image_get_section_name(&b->image, j, &name)
+                == STATUS_OKAY
+            && *name != '\0')
+        {
+            elf64_image_get_section_header(&b->image, j, &b_header);
+            printf("  added    %-24s 0x%lx\n", name, b_header->size);
+        }
+    }
+    printf("  %lu sections unchanged\n", unchanged);
+}
+
+/**
+ * Get a binary's exported symbol, if it is the one indexed under its name.
+ *
+ * @param side The binary.
+ * @param index The index of the symbol in the binary's symbol table.
+ * @param name Location to return the symbol's name.
+ * @return The symbol, or `NULL` if it is not exported or is shadowed by an
+ * earlier symbol of the same name.
+ */
+static const Elf64_Symbol* prim_diff_get_indexed(
+    const struct Diff_Side* side, const Elf64_Word index, const char** name)
+{
+    const Elf64_Symbol* symbol = &side->symbols->symbols[index];
+    if (!prim_diff_is_exported(symbol)
+        || elf64_symbol_table_get_name(side->symbols, symbol, name)
+            != STATUS_OKAY
+        || prim_diff_find_symbol(side, *name) != symbol)
+    {
+        return NULL;
+    }
+    return symbol;
+}
+
+/**
+ * Report the exported symbols which were added, removed or resized between
+ * two binaries, matched by name, in symbol table order.
+ *
+ * @param a The first binary.
+ * @param b The second binary.
+ */
+static void prim_diff_symbols(
+    const struct Diff_Side* a, const struct Diff_Side* b)
+{
+    const Elf64_Symbol* a_symbol = NULL;
+    const Elf64_Symbol* b_symbol = NULL;
+    const char* name = NULL;
+    prim_usize unchanged = 0;
+    Elf64_Word i = 0;
+    printf("Symbols:\n");
+    for (i = 0; i < a->symbols->count; i++)
+    {
+        a_symbol = prim_diff_get_indexed(a, i, &name);
+        if (a_symbol == NULL)
+        {
+            continue;
+        }
+        b_symbol = prim_diff_find_symbol(b, name);
+        if (b_symbol == NULL)
+        {
+            printf("  removed  %s 0x%lx\n", name, a_symbol->size);
+        }
+        else if (b_symbol->size != a_symbol->size)
+        {
+            printf("  resized  %s 0x%lx -> 0x%lx\n", name, a_symbol->size,
+                b_symbol->size);
+        }
+        else
+        {
+            unchanged++;
+        }
+    }
+    for (i = 0; i < b->symbols->count; i++)
+    {
+        b_symbol = prim_diff_get_indexed(b, i, &name);
+        if (b_symbol != NULL && prim_diff_find_symbol(a, name) == NULL)
+        {
+            printf("  added    %s 0x%lx\n", name, b_symbol->size);
+        }
+    }
+    printf("  %lu symbols unchanged in size\n", unchanged);
+}
+
+/**
+ * `prim diff <file> <file>`
+ *
+ * Report which sections and exported symbols changed between two binaries.
+ * Sections are matched by name and compared by content hash, hashed in
+ * parallel; only sections whose hashes differ are compared byte by byte, to
+ * count the changed chunks. Symbols are matched by name, and reported when
+ * added, removed or resized.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` if both binaries were compared, `EXIT_FAILURE`
+ * otherwise.
+ */
+extern int prim_command_diff(int argc, char* argv[])
+{
+    PrimStatus status = STATUS_ERROR;
+    struct Diff_Side a;
+    struct Diff_Side b;
+    if (argc != 3)
+    {
+        printf("Usage: prim diff <file> <file>\n");
+        return EXIT_FAILURE;
+    }
+    status = prim_diff_open(&a, argv[1]);
+    if (status != STATUS_OKAY)
+    {
+        printf("Open failed: %s: %s\n", argv[1], get_status_string(status));
+        prim_diff_close(&a);
+        return EXIT_FAILURE;
+    }
+    status = prim_diff_open(&b, argv[2]);
+    if (status != STATUS_OKAY)
+    {
+        printf("Open failed: %s: %s\n", argv[2], get_status_string(status));
+        prim_diff_close(&b);
+        prim_diff_close(&a);
+        return EXIT_FAILURE;
+    }
+    prim_diff_sections(&a, &b);
+    prim_diff_symbols(&a, &b);
+    prim_diff_close(&b);
+    prim_diff_close(&a);
+    return EXIT_SUCCESS;
+}
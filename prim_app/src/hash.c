@@ -0,0 +1,107 @@
+/**
+ * @file hash.c
+ *
+ * Implements the `prim hash` command.
+ *
+ * @see commands.h
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "commands.h"
+#include "format/elf64/image.h"
+#include "format/elf64/segment/type.h"
+#include "hash.h"
+#include "platform/types.h"
+#include "status.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * `prim hash <file>`
+ *
+ * Print a fingerprint table for a binary: the 128-bit content hash of each
+ * section and each `PT_LOAD` segment, as stored in the file. Sections are
+ * hashed in parallel. Identical fingerprints across binaries mark contents
+ * which can be deduplicated.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` if every section and segment was hashed,
+ * `EXIT_FAILURE` otherwise.
+ */
+extern int prim_command_hash(int argc, char* argv[])
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Image image;
+    PrimHash128* hashes = NULL;
+    PrimHash128 hash;
+    const ELF64_Section_Header* section = NULL;
+    const Elf64_Segment_Header* segment = NULL;
+    const char* name = NULL;
+    Elf64_Word index = 0;
+    int exit_status = EXIT_SUCCESS;
+    if (argc != 2)
+    {
+        printf("Usage: prim hash <file>\n");
+        return EXIT_FAILURE;
+    }
+    status = elf64_image_open(&image, argv[1]);
+    if (status != STATUS_OKAY)
+    {
+        printf("Open failed: %s\n", get_status_string(status));
+        return EXIT_FAILURE;
+    }
+    hashes = (PrimHash128*) calloc(
+        (prim_usize) image.header->sh_entry_count + 1, sizeof(PrimHash128));
+    if (hashes == NULL)
+    {
+        printf("Hash failed: %s\n", get_status_string(STATUS_ERROR));
+        elf64_image_close(&image);
+        return EXIT_FAILURE;
+    }
+    if (elf64_image_hash_sections(&image, hashes) != STATUS_OKAY)
+    {
+        exit_status = EXIT_FAILURE;
+    }
+    printf("Sections:\n");
+    for (index = 0; index < image.header->sh_entry_count; index++)
+    {
+        if (elf64_image_get_section_header(&image, index, &section)
+                != STATUS_OKAY
+            || elf64_image_get_section_name(&image, index, &name)
+                != STATUS_OKAY)
+        {
+            name = "";
+        }
+        printf("  [%2u] %-24s 0x%08lx %016lx%016lx\n", index, name,
+            section != NULL ? section->size : 0, hashes[index].high,
+            hashes[index].low);
+    }
+    printf("Segments:\n");
+    for (index = 0; index < image.header->ph_entry_count; index++)
+    {
+        if (elf64_image_get_segment_header(&image, index, &segment)
+            != STATUS_OKAY)
+        {
+            exit_status = EXIT_FAILURE;
+            break;
+        }
+        if (elf64_get_segment_type(segment) != ELF64_PT_LOAD)
+        {
+            continue;
+        }
+        if (elf64_image_hash_segment(&image, index, &hash) != STATUS_OKAY)
+        {
+            exit_status = EXIT_FAILURE;
+            continue;
+        }
+        printf("  [%2u] LOAD at 0x%08lx         0x%08lx %016lx%016lx\n", index,
+            segment->p_offset, segment->p_filesz, hash.high, hash.low);
+    }
+    free(hashes);
+    elf64_image_close(&image);
+    return exit_status;
+}
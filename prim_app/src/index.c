@@ -0,0 +1,144 @@
+/**
+ * @file index.c
+ *
+ * Implements the `prim index` command.
+ *
+ * @see commands.h
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "commands.h"
+#include "format/elf64/symbol_index.h"
+#include "platform/file.h"
+#include "platform/types.h"
+#include "status.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Print the binaries which define or import a symbol.
+ *
+ * @param path The symbol index.
+ * @param name The symbol name.
+ * @return `EXIT_SUCCESS` if any binary uses the symbol, `EXIT_FAILURE`
+ * otherwise.
+ */
+static int prim_index_find(const char* path, const char* name)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Symbol_Index index;
+    const Elf64_Symbol_Index_Posting* posting = NULL;
+    prim_usize first = 0;
+    prim_usize count = 0;
+    prim_usize i = 0;
+    status = elf64_symbol_index_open(&index, path);
+    if (status != STATUS_OKAY)
+    {
+        printf("Open failed: %s\n", get_status_string(status));
+        return EXIT_FAILURE;
+    }
+    status = elf64_symbol_index_find(&index, name, &first, &count);
+    if (status != STATUS_OKAY)
+    {
+        printf("Find failed: %s\n", get_status_string(status));
+        elf64_symbol_index_close(&index);
+        return EXIT_FAILURE;
+    }
+    printf("%lu binaries use %s\n", count, name);
+    for (i = first; i < first + count; i++)
+    {
+        posting = &index.postings[i];
+        printf("  %-7s %-4s %s\n",
+            posting->flags & ELF64_SYMBOL_INDEX_DEFINED ? "defines" : "imports",
+            posting->flags & ELF64_SYMBOL_INDEX_WEAK ? "weak" : "",
+            elf64_symbol_index_get_path(&index, posting->file));
+    }
+    elf64_symbol_index_close(&index);
+    return count != 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * `prim index [--update] <index> <path>...`
+ * `prim index --find=<symbol> <index>`
+ *
+ * Build an index of the global symbols a set of binaries define and import.
+ * Directories are walked for the files beneath them, and the binaries are
+ * parsed in parallel. With `--update`, the binaries already in the index are
+ * kept, and only those whose identity and build ID have both changed since
+ * are parsed again. With `--find`, list the binaries which define or import
+ * a symbol, from the index alone.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` if the index was written, or the symbol found,
+ * `EXIT_FAILURE` otherwise.
+ */
+extern int prim_command_index(int argc, char* argv[])
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Symbol_Index previous;
+    Elf64_Symbol_Index index;
+    PrimFileList files;
+    prim_usize scanned = 0;
+    int update = 0;
+    int arg = 1;
+    if (argc == 3 && strncmp(argv[1], "--find=", strlen("--find=")) == 0)
+    {
+        return prim_index_find(argv[2], argv[1] + strlen("--find="));
+    }
+    if (arg < argc && strcmp(argv[arg], "--update") == 0)
+    {
+        update = 1;
+        arg++;
+    }
+    if (arg >= argc || (!update && arg == argc - 1))
+    {
+        printf("Usage: prim index [--update] <index> <path>...\n");
+        printf("       prim index --find=<symbol> <index>\n");
+        return EXIT_FAILURE;
+    }
+    status = prim_list_files(
+        (const char* const*) argv + arg + 1, argc - arg - 1, &files);
+    if (status != STATUS_OKAY)
+    {
+        printf("List failed: %s\n", get_status_string(status));
+        return EXIT_FAILURE;
+    }
+    if (update)
+    {
+        status = elf64_symbol_index_open(&previous, argv[arg]);
+        if (status != STATUS_OKAY && status != STATUS_BAD_FILE)
+        {
+            printf("Open failed: %s\n", get_status_string(status));
+            prim_free_file_list(&files);
+            return EXIT_FAILURE;
+        }
+        update = status == STATUS_OKAY;
+    }
+    status = elf64_symbol_index_save(argv[arg],
+        (const char* const*) files.paths, files.count,
+        update ? &previous : NULL, &scanned);
+    if (update)
+    {
+        elf64_symbol_index_close(&previous);
+    }
+    prim_free_file_list(&files);
+    if (status == STATUS_OKAY)
+    {
+        status = elf64_symbol_index_open(&index, argv[arg]);
+    }
+    if (status != STATUS_OKAY)
+    {
+        printf("Index failed: %s\n", get_status_string(status));
+        return EXIT_FAILURE;
+    }
+    printf("%lu binaries (%lu parsed), %lu postings, %lu buckets\n",
+        index.header->file_count, scanned, index.header->posting_count,
+        index.header->bucket_count);
+    elf64_symbol_index_close(&index);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,415 @@
+/**
+ * @file load.c
+ *
+ * Implements the `prim load` command.
+ *
+ * @see commands.h
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "commands.h"
+#include "loader/link_map.h"
+#include "loader/loader.h"
+#include "loader/page_profile.h"
+#include "loader/resolver.h"
+#include "status.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Associates a `--readahead` policy name with its load options. */
+struct Readahead
+{
+    const char* const name;
+    const Elf64_Readahead_Policy policy;
+    const PrimMapAdvice advice;
+};
+
+/** Maps `--readahead` policy names to their load options. */
+static const struct Readahead readahead_policies[] = {
+    { "populate", ELF64_READAHEAD_FIXED, PRIM_ADVICE_POPULATE },
+    { "willneed", ELF64_READAHEAD_FIXED, PRIM_ADVICE_WILLNEED },
+    { "sequential", ELF64_READAHEAD_FIXED, PRIM_ADVICE_SEQUENTIAL },
+    { "random", ELF64_READAHEAD_FIXED, PRIM_ADVICE_RANDOM },
+    { "flags", ELF64_READAHEAD_BY_FLAGS, PRIM_ADVICE_NORMAL },
+    { "size", ELF64_READAHEAD_BY_SIZE, PRIM_ADVICE_NORMAL },
+};
+
+/**
+ * Set the readahead policy named by a `--readahead` argument.
+ *
+ * @param name The policy's name.
+ * @param options The load options to set the policy in.
+ * @return Non-zero if the policy was found.
+ */
+static int prim_load_set_readahead(
+    const char* name, Elf64_Load_Options* options)
+{
+    prim_usize i = 0;
+    for (i = 0; i < sizeof(readahead_policies) / sizeof(struct Readahead); i++)
+    {
+        if (strcmp(name, readahead_policies[i].name) == 0)
+        {
+            options->readahead = readahead_policies[i].policy;
+            options->readahead_advice = readahead_policies[i].advice;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Report the huge pages backing a loaded image's code, if they were asked
+ * for.
+ *
+ * @param loaded The loaded image.
+ * @param options The options the image was loaded with.
+ */
+static void prim_load_print_huge_pages(
+    const Elf64_Loaded_Image* loaded, const Elf64_Load_Options* options)
+{
+    if (options->flags & ELF64_LOAD_HUGE_TEXT)
+    {
+        printf("    code backed by %lu huge pages\n", loaded->huge_pages);
+    }
+}
+
+/**
+ * Load a binary and the libraries it needs, report where each was loaded, and
+ * unload them.
+ *
+ * @param path The binary to load.
+ * @param cache_path File to load and save the library cache in, or `NULL`.
+ * @param call A function to call once the images are relocated, or `NULL`.
+ * @param record_path File to record a page profile in once the images have
+ * started, or `NULL`.
+ * @param options Options controlling the load.
+ * @return `EXIT_SUCCESS` if every image was loaded, `EXIT_FAILURE` otherwise.
+ */
+static int prim_load_dependencies(const char* path, const char* cache_path,
+    const char* call, const char* record_path,
+    const Elf64_Load_Options* options)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Library_Cache cache;
+    Elf64_Link_Map map;
+    Elf64_Link_Map_Symbol symbol = { 0, NULL };
+    prim_usize address = 0;
+    int result = 0;
+    prim_usize i = 0;
+    elf64_library_cache_init(&cache);
+    if (cache_path != NULL)
+    {
+        status = elf64_library_cache_load(&cache, cache_path);
+        if (status != STATUS_OKAY && status != STATUS_BAD_FILE)
+        {
+            printf("Ignoring library cache: %s\n", get_status_string(status));
+        }
+    }
+    status = elf64_link_map_load(&map, path, &cache, options);
+    if (status != STATUS_OKAY)
+    {
+        printf("Load failed: %s\n", get_status_string(status));
+        elf64_library_cache_destroy(&cache);
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < map.count; i++)
+    {
+        printf("Loaded %s => %s at %p (0x%lx bytes, bias 0x%lx)\n",
+            map.entries[i].name, map.entries[i].path,
+            (void*) map.entries[i].loaded->base, map.entries[i].loaded->size,
+            map.entries[i].loaded->bias);
+        prim_load_print_huge_pages(map.entries[i].loaded, options);
+    }
+    if (map.tls.module_count != 0)
+    {
+        printf("Static TLS: %lu modules, 0x%lx bytes, aligned to 0x%lx\n",
+            map.tls.module_count, map.tls.size, map.tls.align);
+    }
+    if (call != NULL)
+    {
+        if (elf64_link_map_find_symbol(
+                &map, call, ELF64_VERSION_ID_NONE, 0, &symbol)
+            == STATUS_OKAY)
+        {
+            address = (prim_usize) elf64_get_loaded_address(
+                map.entries[symbol.entry].loaded, symbol.symbol->value);
+            status = elf64_link_map_call(
+                &map, (int (*)(void)) address, &result);
+            if (status == STATUS_OKAY)
+            {
+                printf("%s returned %d\n", call, result);
+            }
+            else
+            {
+                printf("Call failed: %s\n", get_status_string(status));
+            }
+        }
+        else
+        {
+            printf("Symbol %s not found\n", call);
+        }
+    }
+    if (record_path != NULL)
+    {
+        status = elf64_page_profile_save(&map, record_path);
+        if (status != STATUS_OKAY)
+        {
+            printf("Failed to save page profile: %s\n",
+                get_status_string(status));
+        }
+    }
+    elf64_link_map_unload(&map);
+    if (cache_path != NULL)
+    {
+        status = elf64_library_cache_save(&cache, cache_path);
+        if (status != STATUS_OKAY)
+        {
+            printf("Failed to save library cache: %s\n",
+                get_status_string(status));
+        }
+    }
+    elf64_library_cache_destroy(&cache);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Load several instances of a binary at once, report where each was loaded,
+ * and unload them.
+ *
+ * @param path The binary to load.
+ * @param instances Number of instances to load.
+ * @param options Options controlling the load.
+ * @return `EXIT_SUCCESS` if every instance was loaded, `EXIT_FAILURE`
+ * otherwise.
+ */
+static int prim_load_instances(const char* path, const prim_usize instances,
+    const Elf64_Load_Options* options)
+{
+    PrimStatus status = STATUS_OKAY;
+    Elf64_Loaded_Image* loaded = NULL;
+    prim_usize count = 0;
+    loaded = (Elf64_Loaded_Image*) calloc(instances, sizeof(*loaded));
+    if (loaded == NULL)
+    {
+        printf("Load failed: %s\n", get_status_string(STATUS_ERROR));
+        return EXIT_FAILURE;
+    }
+    for (count = 0; count < instances; count++)
+    {
+        status = elf64_load_image(&loaded[count], path, options);
+        if (status != STATUS_OKAY)
+        {
+            printf("Load failed: %s\n", get_status_string(status));
+            break;
+        }
+        printf("Loaded %s at %p (0x%lx bytes, bias 0x%lx)\n", path,
+            (void*) loaded[count].base, loaded[count].size,
+            loaded[count].bias);
+        prim_load_print_huge_pages(&loaded[count], options);
+    }
+    while (count > 0)
+    {
+        elf64_unload_image(&loaded[--count]);
+    }
+    free(loaded);
+    return status == STATUS_OKAY ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * `prim load [--perf-map] [--jitdump[=<directory>]] [--deps [--serial]
+ * [--library-cache=<file>] [--relocate] [--bind-now] [--snapshot=<file>]
+ * [--call=<symbol>] [--record-profile=<file>]] [--instances=<n>]
+ * [--share-files] [--huge-text] [--readahead=<policy>
+ * [--readahead-threshold=<bytes>]] [--page-profile=<file>] <file>`
+ *
+ * Load a binary into the Prim process, report where it was loaded, and
+ * unload it. With `--deps`, the libraries it needs are loaded too, and
+ * `--relocate` relocates them, binding PLT entries on first call unless
+ * `--bind-now` is given. `--snapshot` restores the relocated images from a
+ * snapshot file, or relocates them and saves one. `--call` relocates the
+ * images and calls an `int (void)` function from them before unloading.
+ * Without `--deps`, `--instances` loads the binary several times at once.
+ * `--share-files` shares each binary's file mapping between the images
+ * loaded from it. `--huge-text` backs code with huge pages where it can,
+ * and reports how many each image got. `--readahead` reads each segment
+ * ahead once mapped: `populate`, `willneed`, `sequential` and `random` give
+ * every segment that advice, `flags` chooses from the segment's flags, and
+ * `size` populates segments up to `--readahead-threshold` bytes.
+ * `--record-profile` records the pages each image touched by the time it
+ * was loaded, or its function returned, in a page profile, and
+ * `--page-profile` replays one in place of `--readahead`.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` if the binary was loaded, `EXIT_FAILURE` otherwise.
+ */
+extern int prim_command_load(int argc, char* argv[])
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Load_Options options = { 0 };
+    Elf64_Loaded_Image loaded;
+    Elf64_Page_Profile profile;
+    const char* cache_path = NULL;
+    const char* call = NULL;
+    const char* profile_path = NULL;
+    const char* record_path = NULL;
+    int exit_status = EXIT_FAILURE;
+    long instances = 1;
+    int dependencies = 0;
+    int arg = 1;
+    for (arg = 1; arg < argc - 1; arg++)
+    {
+        if (strcmp(argv[arg], "--perf-map") == 0)
+        {
+            options.flags |= ELF64_LOAD_PERF_MAP;
+        }
+        else if (strcmp(argv[arg], "--jitdump") == 0)
+        {
+            options.flags |= ELF64_LOAD_JITDUMP;
+        }
+        else if (strncmp(argv[arg], "--jitdump=", strlen("--jitdump=")) == 0)
+        {
+            options.flags |= ELF64_LOAD_JITDUMP;
+            options.jitdump_directory = argv[arg] + strlen("--jitdump=");
+        }
+        else if (strcmp(argv[arg], "--deps") == 0)
+        {
+            dependencies = 1;
+        }
+        else if (strcmp(argv[arg], "--serial") == 0)
+        {
+            options.flags |= ELF64_LOAD_SERIAL;
+        }
+        else if (strncmp(argv[arg], "--library-cache=",
+                     strlen("--library-cache="))
+            == 0)
+        {
+            cache_path = argv[arg] + strlen("--library-cache=");
+        }
+        else if (strcmp(argv[arg], "--relocate") == 0)
+        {
+            options.flags |= ELF64_LOAD_RELOCATE;
+        }
+        else if (strcmp(argv[arg], "--bind-now") == 0)
+        {
+            options.flags |= ELF64_LOAD_RELOCATE | ELF64_LOAD_BIND_NOW;
+        }
+        else if (strncmp(argv[arg], "--call=", strlen("--call=")) == 0)
+        {
+            options.flags |= ELF64_LOAD_RELOCATE;
+            call = argv[arg] + strlen("--call=");
+        }
+        else if (strncmp(argv[arg], "--snapshot=", strlen("--snapshot="))
+            == 0)
+        {
+            options.flags |= ELF64_LOAD_RELOCATE | ELF64_LOAD_SNAPSHOT;
+            options.snapshot_path = argv[arg] + strlen("--snapshot=");
+        }
+        else if (strncmp(argv[arg], "--instances=", strlen("--instances="))
+            == 0)
+        {
+            instances = strtol(argv[arg] + strlen("--instances="), NULL, 10);
+        }
+        else if (strcmp(argv[arg], "--share-files") == 0)
+        {
+            options.flags |= ELF64_LOAD_SHARE_FILES;
+        }
+        else if (strcmp(argv[arg], "--huge-text") == 0)
+        {
+            options.flags |= ELF64_LOAD_HUGE_TEXT;
+        }
+        else if (strncmp(argv[arg], "--readahead=", strlen("--readahead="))
+            == 0)
+        {
+            if (!prim_load_set_readahead(
+                    argv[arg] + strlen("--readahead="), &options))
+            {
+                break;
+            }
+        }
+        else if (strncmp(argv[arg], "--readahead-threshold=",
+                     strlen("--readahead-threshold="))
+            == 0)
+        {
+            options.readahead_threshold = strtoul(
+                argv[arg] + strlen("--readahead-threshold="), NULL, 0);
+        }
+        else if (strncmp(argv[arg], "--page-profile=",
+                     strlen("--page-profile="))
+            == 0)
+        {
+            profile_path = argv[arg] + strlen("--page-profile=");
+        }
+        else if (strncmp(argv[arg], "--record-profile=",
+                     strlen("--record-profile="))
+            == 0)
+        {
+            record_path = argv[arg] + strlen("--record-profile=");
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (arg != argc - 1 || instances < 1 || (dependencies && instances != 1)
+        || (!dependencies
+            && ((options.flags & ELF64_LOAD_RELOCATE) || record_path != NULL)))
+    {
+        printf("Usage: prim load [--perf-map] [--jitdump[=<directory>]] "
+               "[--deps [--serial] [--library-cache=<file>] [--relocate] "
+               "[--bind-now] [--snapshot=<file>] [--call=<symbol>] "
+               "[--record-profile=<file>]] "
+               "[--instances=<n>] [--share-files] [--huge-text] "
+               "[--readahead=<policy> [--readahead-threshold=<bytes>]] "
+               "[--page-profile=<file>] <file>\n");
+        return EXIT_FAILURE;
+    }
+    if (profile_path != NULL)
+    {
+        status = elf64_page_profile_open(&profile, profile_path);
+        if (status == STATUS_OKAY)
+        {
+            options.readahead = ELF64_READAHEAD_PROFILE;
+            options.page_profile = &profile;
+        }
+        else
+        {
+            printf("Ignoring page profile: %s\n", get_status_string(status));
+        }
+    }
+    if (dependencies)
+    {
+        exit_status = prim_load_dependencies(
+            argv[arg], cache_path, call, record_path, &options);
+    }
+    else if (instances != 1)
+    {
+        exit_status = prim_load_instances(
+            argv[arg], (prim_usize) instances, &options);
+    }
+    else
+    {
+        status = elf64_load_image(&loaded, argv[arg], &options);
+        if (status == STATUS_OKAY)
+        {
+            printf("Loaded %s at %p (0x%lx bytes, bias 0x%lx)\n", argv[arg],
+                (void*) loaded.base, loaded.size, loaded.bias);
+            prim_load_print_huge_pages(&loaded, &options);
+            elf64_unload_image(&loaded);
+            exit_status = EXIT_SUCCESS;
+        }
+        else
+        {
+            printf("Load failed: %s\n", get_status_string(status));
+        }
+    }
+    if (options.page_profile != NULL)
+    {
+        elf64_page_profile_close(&profile);
+    }
+    return exit_status;
+}
@@ -1,3 +1,4 @@
+#include "commands.h"
 #include "format/elf64/header/header.h"
 #include "format/elf64/header/ident.h"
 #include "format/elf64/header/machine.h"
@@ -11,9 +12,30 @@
 #include "format/elf64/segment/type.h"
 #include "platform/file.h"
 #include "platform/memory.h"
+#include "stats.h"
 #include "status.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+/** Associates a sub-command name with its implementation. */
+struct Command
+{
+    const char* const name;
+    int (*const run)(int argc, char* argv[]);
+};
+
+/** Maps sub-command names to their implementations. */
+static const struct Command commands[] = {
+    { "archive", prim_command_archive },
+    { "core", prim_command_core },
+    { "diff", prim_command_diff },
+    { "hash", prim_command_hash },
+    { "index", prim_command_index },
+    { "load", prim_command_load },
+    { "run", prim_command_run },
+    { "serve", prim_command_serve },
+};
 
 /**
  * Prints an ELF64 sections data to the standard out.
@@ -81,6 +103,34 @@ void elf64_print_segment_info(const Elf64_Segment_Header* const header)
     printf("ELF64 sement alignment: 0x%lx\n", elf64_get_segment_align(header));
 }
 
+/**
+ * Prints Prim's statistics to the standard out.
+ */
+void prim_print_stats(void)
+{
+    PrimStats stats = { 0 };
+    unsigned int i = 0;
+    printf("--- Prim Statistics ---\n");
+    if (prim_stats_is_enabled() != STATUS_OKAY)
+    {
+        printf("Statistics disabled. Rebuild with -DPRIM_STATS=ON.\n");
+        return;
+    }
+    prim_stats_get(&stats);
+    for (i = 0; i < PRIM_STATS_COUNTER_COUNT; i++)
+    {
+        printf("%s: %lu\n",
+            prim_stats_get_counter_string((PrimStatsCounter) i),
+            stats.counters[i]);
+    }
+    for (i = 0; i < PRIM_PHASE_COUNT; i++)
+    {
+        printf("%s phase: %lu ns over %lu entries\n",
+            prim_stats_get_phase_string((PrimStatsPhase) i),
+            stats.phase_time[i], stats.phase_entries[i]);
+    }
+}
+
 int main(int argc, char* argv[])
 {
     prim_file_handle handle = NULL;
@@ -91,11 +141,57 @@ int main(int argc, char* argv[])
     Elf64_Segment_Header segment_header = { 0 };
     char* str_table_data = 0;
     unsigned char* ident = NULL;
+    int print_stats = 0;
+    int exit_status = EXIT_FAILURE;
+    unsigned int command = 0;
+    if (argc > 1 && strcmp(argv[1], "--stats") == 0)
+    {
+        print_stats = 1;
+        argc--;
+        argv++;
+    }
     if (argc < 2)
     {
-        printf("Usage: prim <file>\n");
+        printf("Usage: prim [--stats] <file>\n");
+        printf("       prim [--stats] load [--perf-map] "
+               "[--jitdump[=<directory>]]\n"
+               "                  [--deps [--serial] [--library-cache=<file>]\n"
+               "                   [--relocate] [--bind-now] "
+               "[--snapshot=<file>]\n"
+               "                   [--call=<symbol>] "
+               "[--record-profile=<file>]]\n"
+               "                  [--instances=<n>] [--share-files] "
+               "[--huge-text]\n"
+               "                  [--readahead=<policy> "
+               "[--readahead-threshold=<bytes>]]\n"
+               "                  [--page-profile=<file>] <file>\n");
+        printf("       prim run <file> [<argument>...]\n");
+        printf("       prim archive [--find=<symbol>] <archive>\n");
+        printf("       prim core [--read=<address>:<length>] <core>\n");
+        printf("       prim diff <file> <file>\n");
+        printf("       prim hash <file>\n");
+        printf("       prim index [--update] <index> <path>...\n");
+        printf("       prim index --find=<symbol> <index>\n");
+        printf("       prim [--stats] serve [--library-cache=<file>] "
+               "[--bind-now]\n"
+               "                   [--snapshot=<file>] [--huge-text] "
+               "--call=<symbol> <file>\n");
         exit(EXIT_FAILURE);
     }
+    for (command = 0; command < sizeof(commands) / sizeof(struct Command);
+         command++)
+    {
+        if (strcmp(argv[1], commands[command].name) == 0)
+        {
+            exit_status = commands[command].run(argc - 1, argv + 1);
+            if (print_stats)
+            {
+                prim_print_stats();
+            }
+            return exit_status;
+        }
+    }
+    PRIM_STATS_PHASE_BEGIN(header_timer);
     status = prim_fopen(argv[1], &handle);
     if (status != STATUS_OKAY)
     {
@@ -108,6 +204,8 @@ int main(int argc, char* argv[])
         printf("Read failed: %s\n", get_status_string(status));
         exit(EXIT_FAILURE);
     }
+    PRIM_STATS_PHASE_END(header_timer, PRIM_PHASE_HEADER);
+    PRIM_STATS_PHASE_BEGIN(strings_timer);
     status = prim_fseek(handle,
         header.sh_offset
             + header.header_name_strs_index * sizeof(ELF64_Section_Header));
@@ -146,6 +244,7 @@ int main(int argc, char* argv[])
             get_status_string(status));
         exit(EXIT_FAILURE);
     }
+    PRIM_STATS_PHASE_END(strings_timer, PRIM_PHASE_STRINGS);
     ident = header.ident;
     status = elf64_is_magic_okay(ident);
     printf("ELF64 magic: %s\n", get_status_string(status));
@@ -220,5 +319,9 @@ int main(int argc, char* argv[])
         }
         elf64_print_segment_info(&segment_header);
     }
+    if (print_stats)
+    {
+        prim_print_stats();
+    }
     return 0;
 }
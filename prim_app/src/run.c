@@ -0,0 +1,55 @@
+/**
+ * @file run.c
+ *
+ * Implements the `prim run` command.
+ *
+ * @see commands.h
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "commands.h"
+#include "loader/exec.h"
+#include "loader/loader.h"
+#include "platform/exec.h"
+#include "status.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * `prim run <file> [<argument>...]`
+ *
+ * Load a static executable with the Prim loader, and run it in place of Prim
+ * with the given arguments and Prim's environment. The executable's exit
+ * status becomes Prim's.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_FAILURE` if the executable could not be run. Does not return
+ * otherwise.
+ */
+extern int prim_command_run(int argc, char* argv[])
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Loaded_Image loaded;
+    if (argc < 2)
+    {
+        printf("Usage: prim run <file> [<argument>...]\n");
+        return EXIT_FAILURE;
+    }
+    status = elf64_load_image(&loaded, argv[1], NULL);
+    if (status != STATUS_OKAY)
+    {
+        printf("Load failed: %s\n", get_status_string(status));
+        return EXIT_FAILURE;
+    }
+    /* The executable takes over without running Prim's exit handlers. */
+    fflush(NULL);
+    status = elf64_exec(
+        &loaded, argv[1], argc - 1, argv + 1, prim_exec_get_environment());
+    printf("Run failed: %s\n", get_status_string(status));
+    elf64_unload_image(&loaded);
+    return EXIT_FAILURE;
+}
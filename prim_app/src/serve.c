@@ -0,0 +1,212 @@
+/**
+ * @file serve.c
+ *
+ * Implements the `prim serve` command.
+ *
+ * @see commands.h
+ *
+ * @author H Paterson.
+ * @copyright BSL-1.0.
+ * @date October 2026.
+ */
+
+#include "commands.h"
+#include "loader/link_map.h"
+#include "loader/loader.h"
+#include "loader/resolver.h"
+#include "platform/fork.h"
+#include "platform/perf.h"
+#include "platform/types.h"
+#include "status.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Descriptor the fork server reads run requests from. */
+#define PRIM_SERVE_CONTROL_FD 198
+
+/** Descriptor the fork server writes child IDs and exit statuses to. */
+#define PRIM_SERVE_STATUS_FD 199
+
+/**
+ * Run one request: fork a child which calls the entry function and exits
+ * with its result, then report the child's ID and wait status.
+ *
+ * @param map The loaded and relocated link map.
+ * @param entry The function each child calls.
+ * @return STATUS_OKAY on success, otherwise an error code.
+ */
+static PrimStatus prim_serve_run(Elf64_Link_Map* map, int (*entry)(void))
+{
+    PrimStatus status = STATUS_ERROR;
+    prim_process_id child = 0;
+    prim_s32 reply = 0;
+    int result = 0;
+    /* Buffered output would otherwise be written by every child. */
+    fflush(NULL);
+    prim_perf_flush();
+    status = prim_fork(&child);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    if (child == 0)
+    {
+        prim_pipe_close(PRIM_SERVE_CONTROL_FD);
+        prim_pipe_close(PRIM_SERVE_STATUS_FD);
+        status = elf64_link_map_call(map, entry, &result);
+        if (status != STATUS_OKAY)
+        {
+            printf("Call failed: %s\n", get_status_string(status));
+            exit(EXIT_FAILURE);
+        }
+        exit(result);
+    }
+    reply = (prim_s32) child;
+    status = prim_pipe_write(PRIM_SERVE_STATUS_FD, &reply, sizeof(reply));
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    status = prim_wait(child, &reply);
+    if (status != STATUS_OKAY)
+    {
+        return status;
+    }
+    return prim_pipe_write(PRIM_SERVE_STATUS_FD, &reply, sizeof(reply));
+}
+
+/**
+ * Serve run requests until the control pipe is closed.
+ *
+ * @param map The loaded and relocated link map.
+ * @param call The function each child calls.
+ * @return `EXIT_SUCCESS` if the control pipe was closed, `EXIT_FAILURE` on
+ * any other error.
+ */
+static int prim_serve(Elf64_Link_Map* map, const char* call)
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Link_Map_Symbol symbol = { 0, NULL };
+    int (*entry)(void) = NULL;
+    prim_u32 request = 0;
+    status = elf64_link_map_find_symbol(
+        map, call, ELF64_VERSION_ID_NONE, 0, &symbol);
+    if (status != STATUS_OKAY)
+    {
+        printf("Symbol %s not found\n", call);
+        return EXIT_FAILURE;
+    }
+    entry = (int (*)(void)) (prim_usize) elf64_get_loaded_address(
+        map->entries[symbol.entry].loaded, symbol.symbol->value);
+    /* Tell the client the image is ready. */
+    status = prim_pipe_write(PRIM_SERVE_STATUS_FD, &request, sizeof(request));
+    while (status == STATUS_OKAY)
+    {
+        status = prim_pipe_read(
+            PRIM_SERVE_CONTROL_FD, &request, sizeof(request));
+        if (status == STATUS_INVALID)
+        {
+            return EXIT_SUCCESS;
+        }
+        if (status == STATUS_OKAY)
+        {
+            status = prim_serve_run(map, entry);
+        }
+    }
+    printf("Fork server failed: %s\n", get_status_string(status));
+    return EXIT_FAILURE;
+}
+
+/**
+ * `prim serve [--library-cache=<file>] [--bind-now] [--snapshot=<file>]
+ * [--huge-text] --call=<symbol> <file>`
+ *
+ * Load and relocate a binary and the libraries it needs once, then serve
+ * run requests as a fork server. Each run forks a child which calls an
+ * `int (void)` function and exits with its result. `--bind-now` binds every
+ * PLT entry in the server, rather than again in each child. `--snapshot`
+ * restores the relocated images from a snapshot file, or saves one.
+ * `--huge-text` backs code with huge pages, which every child shares.
+ *
+ * The server talks to its client through two inherited descriptors, each
+ * message a native endian 32 bit word:
+ *
+ * - Once loaded, the server writes a word to descriptor 199.
+ * - Each word the client writes to descriptor 198 requests a run. The server
+ *   replies on 199 with the child's process ID, then its wait status.
+ * - The server unloads the binary and exits when 198 is closed.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments, starting with the command name.
+ * @return `EXIT_SUCCESS` once the client closes the control pipe,
+ * `EXIT_FAILURE` otherwise.
+ */
+extern int prim_command_serve(int argc, char* argv[])
+{
+    PrimStatus status = STATUS_ERROR;
+    Elf64_Load_Options options = { ELF64_LOAD_RELOCATE, NULL, NULL,
+        ELF64_READAHEAD_NONE, PRIM_ADVICE_NORMAL, 0, NULL };
+    Elf64_Library_Cache cache;
+    Elf64_Link_Map map;
+    const char* cache_path = NULL;
+    const char* call = NULL;
+    int exit_status = EXIT_FAILURE;
+    int arg = 1;
+    for (arg = 1; arg < argc - 1; arg++)
+    {
+        if (strncmp(argv[arg], "--library-cache=", strlen("--library-cache="))
+            == 0)
+        {
+            cache_path = argv[arg] + strlen("--library-cache=");
+        }
+        else if (strcmp(argv[arg], "--bind-now") == 0)
+        {
+            options.flags |= ELF64_LOAD_BIND_NOW;
+        }
+        else if (strncmp(argv[arg], "--snapshot=", strlen("--snapshot="))
+            == 0)
+        {
+            options.flags |= ELF64_LOAD_SNAPSHOT;
+            options.snapshot_path = argv[arg] + strlen("--snapshot=");
+        }
+        else if (strcmp(argv[arg], "--huge-text") == 0)
+        {
+            options.flags |= ELF64_LOAD_HUGE_TEXT;
+        }
+        else if (strncmp(argv[arg], "--call=", strlen("--call=")) == 0)
+        {
+            call = argv[arg] + strlen("--call=");
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (arg != argc - 1 || call == NULL)
+    {
+        printf("Usage: prim serve [--library-cache=<file>] [--bind-now] "
+               "[--snapshot=<file>] [--huge-text] --call=<symbol> "
+               "<file>\n");
+        return EXIT_FAILURE;
+    }
+    elf64_library_cache_init(&cache);
+    if (cache_path != NULL)
+    {
+        status = elf64_library_cache_load(&cache, cache_path);
+        if (status != STATUS_OKAY && status != STATUS_BAD_FILE)
+        {
+            printf("Ignoring library cache: %s\n", get_status_string(status));
+        }
+    }
+    status = elf64_link_map_load(&map, argv[arg], &cache, &options);
+    elf64_library_cache_destroy(&cache);
+    if (status != STATUS_OKAY)
+    {
+        printf("Load failed: %s\n", get_status_string(status));
+        return EXIT_FAILURE;
+    }
+    exit_status = prim_serve(&map, call);
+    elf64_link_map_unload(&map);
+    return exit_status;
+}